@@ -0,0 +1,308 @@
+/**
+ * @file evlog_decode.c
+ * @brief Render the firmware's binary event records as log text.
+ *
+ * Reads shell output captured from `motor_evlog dump` (a build with
+ * CONFIG_MOTOR_SIM_EVLOG, see docs/evlog.md) from a file or stdin, checks the
+ * CRC of every ':'-prefixed hex frame and prints each event record as the
+ * log line the firmware would have printed:
+ *
+ *     [00:00:12.350,000] <inf> telemetry: T[telemetry] SP=1500 rpm, ...
+ *
+ * Other lines are ignored. The summary on stderr reports the records
+ * rendered, the records lost (from gaps in the record sequence numbers) and
+ * the frames rejected.
+ *
+ * --self-test encodes one record of each event, renders it through the same
+ * frame parser and compares the text with the firmware's format strings.
+ */
+
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "motor_evlog.h"
+
+/* Shell hex frame: SOF, type, payload length, payload, CRC16 (console_shell.c). */
+#define ED_FRAME_SOF   0xA5U
+#define ED_FRAME_EVENT 5U
+#define ED_FRAME_MAX   (3U + 64U + 2U)
+#define ED_LINE_MAX    512U
+
+static const char *const level_names[] = {"???", "err", "wrn", "inf"};
+
+struct ed_summary {
+    unsigned long records;
+    unsigned long lost;
+    unsigned long bad_frames;
+    bool have_seq;
+    uint32_t next_seq;
+};
+
+/* Same algorithm as Zephyr's crc16_ccitt() (reflected 0x1021). */
+static uint16_t crc16_ccitt(uint16_t seed, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t e = (uint8_t)(seed ^ data[i]);
+        uint8_t f = (uint8_t)(e ^ (e << 4));
+
+        seed = (uint16_t)((seed >> 8) ^ ((uint16_t)f << 8) ^ ((uint16_t)f << 3) ^ (f >> 4));
+    }
+    return seed;
+}
+
+static int hex_nibble(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/* Hex text after the ':' to bytes; returns the length or -1. */
+static int parse_hex(const char *hex, uint8_t *out, size_t max)
+{
+    size_t len = strcspn(hex, "\r\n");
+
+    if (((len % 2U) != 0U) || ((len / 2U) > max)) {
+        return -1;
+    }
+    for (size_t i = 0; i < len; i += 2U) {
+        int hi = hex_nibble(hex[i]);
+        int lo = hex_nibble(hex[i + 1U]);
+
+        if ((hi < 0) || (lo < 0)) {
+            return -1;
+        }
+        out[i / 2U] = (uint8_t)((hi << 4) | lo);
+    }
+    return (int)(len / 2U);
+}
+
+/* Log line of @p rec, with the timestamp and prefix of the Zephyr text log. */
+static void render(const struct motor_evlog_record *rec, char *line, size_t size)
+{
+    char text[MOTOR_EVLOG_TEXT_MAX];
+    const char *module;
+    enum motor_evlog_level level = motor_evlog_level(rec->id, &module);
+    uint32_t ms = rec->uptime_ms;
+
+    (void)motor_evlog_format(rec, text, sizeof(text));
+    snprintf(line, size, "[%02u:%02u:%02u.%03u,000] <%s> %s: %s", ms / 3600000U,
+             (ms / 60000U) % 60U, (ms / 1000U) % 60U, ms % 1000U, level_names[level], module,
+             text);
+}
+
+/*
+ * Decode one line of shell output. Returns 1 and fills @p rec for an event
+ * record, 0 for any other line, -1 for a malformed frame.
+ */
+static int decode_line(const char *line, struct motor_evlog_record *rec)
+{
+    uint8_t frame[ED_FRAME_MAX];
+    int len;
+
+    if (line[0] != ':') {
+        return 0;
+    }
+
+    len = parse_hex(&line[1], frame, sizeof(frame));
+    if ((len < 5) || (frame[0] != ED_FRAME_SOF) || (frame[2] != (unsigned int)(len - 5))) {
+        return -1;
+    }
+
+    uint16_t crc = (uint16_t)(frame[len - 2] | (frame[len - 1] << 8));
+
+    if (crc != crc16_ccitt(0xffffU, &frame[1], (size_t)len - 3U)) {
+        return -1;
+    }
+    if (frame[1] != ED_FRAME_EVENT) {
+        return 0;
+    }
+
+    return (motor_evlog_decode(&frame[3], frame[2], rec) == 0) ? 1 : -1;
+}
+
+static void count_record(struct ed_summary *sum, const struct motor_evlog_record *rec)
+{
+    if (sum->have_seq && (rec->seq != sum->next_seq)) {
+        sum->lost += rec->seq - sum->next_seq;
+    }
+    sum->have_seq = true;
+    sum->next_seq = rec->seq + 1U;
+    sum->records++;
+}
+
+static int decode_stream(FILE *in)
+{
+    char line[ED_LINE_MAX];
+    struct ed_summary sum = {0};
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        /* Shell output may carry the prompt or colour codes before the frame. */
+        char *start = strstr(line, ":a5");
+        struct motor_evlog_record rec;
+        char text[ED_LINE_MAX];
+
+        if (start == NULL) {
+            start = strstr(line, ":A5");
+        }
+
+        int ret = (start != NULL) ? decode_line(start, &rec) : 0;
+
+        if (ret < 0) {
+            sum.bad_frames++;
+        } else if (ret > 0) {
+            render(&rec, text, sizeof(text));
+            puts(text);
+            count_record(&sum, &rec);
+        }
+    }
+
+    fprintf(stderr, "records=%lu lost=%lu bad_frames=%lu\n", sum.records, sum.lost,
+            sum.bad_frames);
+    return (sum.bad_frames == 0UL) ? 0 : 1;
+}
+
+/* Build the shell's hex frame line for @p rec. */
+static void frame_line(const struct motor_evlog_record *rec, char *line, size_t size)
+{
+    uint8_t frame[3U + MOTOR_EVLOG_RECORD_LEN + 2U];
+    size_t pos = 0;
+
+    frame[0] = ED_FRAME_SOF;
+    frame[1] = ED_FRAME_EVENT;
+    frame[2] = MOTOR_EVLOG_RECORD_LEN;
+    motor_evlog_encode(&frame[3], rec);
+
+    uint16_t crc = crc16_ccitt(0xffffU, &frame[1], MOTOR_EVLOG_RECORD_LEN + 2U);
+
+    frame[sizeof(frame) - 2U] = (uint8_t)crc;
+    frame[sizeof(frame) - 1U] = (uint8_t)(crc >> 8);
+
+    pos += (size_t)snprintf(&line[pos], size - pos, ":");
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        pos += (size_t)snprintf(&line[pos], size - pos, "%02X", frame[i]);
+    }
+}
+
+static int self_test(void)
+{
+    static const struct {
+        uint32_t id;
+        const char *text;
+    } cases[] = {
+        {MOTOR_EVLOG_TELEMETRY,
+         "[00:01:02.345,000] <inf> telemetry: "
+         "T[telemetry] SP=1500 rpm, MEAS=1849 rpm, OUT=42%, T=71 C"},
+        {MOTOR_EVLOG_FAULT_SPEED,
+         "[00:01:02.345,000] <wrn> fault_monitor: "
+         "Fault(speed): |SP-MEAS|=349 rpm (OUT=42%, T=71 C)"},
+        {MOTOR_EVLOG_FAULT_TEMP_HARD,
+         "[00:01:02.345,000] <err> fault_monitor: "
+         "Fault(temp hard): T=71 C (OUT=42%, SP=1500 rpm)"},
+        {MOTOR_EVLOG_FAULT_TEMP_SOFT,
+         "[00:01:02.345,000] <wrn> fault_monitor: "
+         "Fault(temp soft): T=71 C (OUT=42%, SP=1500 rpm)"},
+    };
+    int failures = 0;
+
+    for (size_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); i++) {
+        const struct motor_evlog_record rec = {
+            .id = cases[i].id,
+            .seq = (uint32_t)i,
+            .uptime_ms = 62345U,
+            .state = {1500.0f, 1849.9f, 42.7f, 71.6f},
+        };
+        struct motor_evlog_record got;
+        char line[ED_LINE_MAX];
+        char text[ED_LINE_MAX];
+
+        frame_line(&rec, line, sizeof(line));
+        if (decode_line(line, &got) != 1) {
+            fprintf(stderr, "event %u: frame not decoded\n", cases[i].id);
+            failures++;
+            continue;
+        }
+
+        render(&got, text, sizeof(text));
+        if (strcmp(text, cases[i].text) != 0) {
+            fprintf(stderr, "event %u:\n  got  %s\n  want %s\n", cases[i].id, text,
+                    cases[i].text);
+            failures++;
+        }
+    }
+
+    /* A corrupted frame must be rejected, not rendered. */
+    char line[ED_LINE_MAX];
+    struct motor_evlog_record got;
+    const struct motor_evlog_record rec = {.id = MOTOR_EVLOG_TELEMETRY};
+
+    frame_line(&rec, line, sizeof(line));
+    line[10] = (line[10] == '0') ? '1' : '0';
+    if (decode_line(line, &got) != -1) {
+        fprintf(stderr, "corrupted frame accepted\n");
+        failures++;
+    }
+
+    printf("self-test: %s\n", (failures == 0) ? "ok" : "FAILED");
+    return (failures == 0) ? 0 : 1;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [FILE]\n"
+            "       %s --self-test\n"
+            "  Renders the event records of captured `motor_evlog dump` output in FILE\n"
+            "  (default: stdin) as log lines; other lines are ignored.\n"
+            "  --self-test: round-trip one record of each event through the frame\n"
+            "  parser and compare the text with the firmware's (used by ctest).\n",
+            prog, prog);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"self-test", no_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int c;
+
+    while ((c = getopt_long(argc, argv, "sh", opts, NULL)) != -1) {
+        if (c == 's') {
+            return self_test();
+        }
+        usage(argv[0]);
+        return (c == 'h') ? 0 : 2;
+    }
+
+    if (optind == argc) {
+        return decode_stream(stdin);
+    }
+    if (optind != (argc - 1)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *in = fopen(argv[optind], "r");
+
+    if (in == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    int ret = decode_stream(in);
+
+    fclose(in);
+    return ret;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file large_step.c
+ * @brief Accuracy and stability of the motor model at large step sizes.
+ *
+ * Runs a setpoint profile with the 50 ms per-period model (motor_model_step)
+ * as the reference, then again with larger steps for each discretization and
+ * compares the trajectories at the common sample times:
+ *
+ * - "euler": the per-period recurrence with every per-period gain scaled by
+ *   dt / 50 ms, i.e. what changing the control period does to the original
+ *   update. Goes unstable once the scaled gains get large.
+ * - "exp" and "zoh": motor_model_step_dt() (see motor_model.h).
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "motor_model.h"
+
+/* Firmware control period (MOTOR_CONTROL_PERIOD_MS in src/motor_control.h). */
+#define LS_PERIOD_MS 50U
+
+/* Setpoint profile: one segment every LS_SEGMENT_MS. */
+#define LS_SEGMENT_MS 60000U
+
+static const float profile_rpm[] = {3000.0f, 8000.0f, 500.0f, 6000.0f, 0.0f, 4000.0f};
+
+#define LS_DURATION_MS ((uint32_t)(sizeof(profile_rpm) / sizeof(profile_rpm[0])) * LS_SEGMENT_MS)
+
+/* Step sizes to compare, all multiples of LS_PERIOD_MS. */
+static const uint32_t steps_ms[] = {50, 100, 250, 500, 1000, 2000, 5000};
+
+#define LS_NUM_STEPS (sizeof(steps_ms) / sizeof(steps_ms[0]))
+
+/* Timing: best of this many full runs. */
+#define LS_TIMING_ROUNDS 5
+
+/* A run whose speed leaves this band has diverged. */
+#define LS_DIVERGED_RPM 1.0e6f
+
+enum ls_method {
+    LS_EULER,
+    LS_EXP,
+    LS_ZOH,
+};
+
+static const char *const method_names[] = {"euler", "exp", "zoh"};
+
+#define LS_NUM_METHODS (sizeof(method_names) / sizeof(method_names[0]))
+
+struct ls_result {
+    bool diverged;
+    double max_rpm_err;
+    double max_temp_err_c;
+    double final_rpm_err;
+    double final_temp_err_c;
+    double us_per_run;
+};
+
+static double now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e6) + ((double)ts.tv_nsec * 1e-3);
+}
+
+static float ls_setpoint(uint32_t t_ms)
+{
+    return profile_rpm[t_ms / LS_SEGMENT_MS];
+}
+
+/* Per-period gains scaled to a period of n firmware periods. */
+static struct motor_model_params ls_euler_params(const struct motor_model_params *p, float n)
+{
+    struct motor_model_params s = *p;
+
+    s.kp_percent = p->kp_percent * n;
+    s.speed_filter_alpha = p->speed_filter_alpha * n;
+    s.heat_gain = p->heat_gain * n;
+    s.cool_gain = p->cool_gain * n;
+    return s;
+}
+
+/* Reference states at every LS_PERIOD_MS, index 0 is the initial state. */
+static void ls_reference(const struct motor_model_params *p, struct motor_state *ref)
+{
+    struct motor_state st = {.temperature_c = p->ambient_temp_c};
+
+    ref[0] = st;
+    for (uint32_t i = 1; i <= LS_DURATION_MS / LS_PERIOD_MS; i++) {
+        st.setpoint_rpm = ls_setpoint((i - 1U) * LS_PERIOD_MS);
+        motor_model_step(p, &st);
+        ref[i] = st;
+    }
+}
+
+/* Simulate the profile with one method; compares against ref when r is not NULL. */
+static void ls_simulate(const struct motor_model_params *p, enum ls_method method,
+                        uint32_t step_ms, const struct motor_model_params *euler,
+                        const struct motor_model_disc_coeffs *c, const struct motor_state *ref,
+                        struct ls_result *r)
+{
+    struct motor_state st = ref[0];
+
+    for (uint32_t t_ms = 0; t_ms < LS_DURATION_MS; t_ms += step_ms) {
+        st.setpoint_rpm = ls_setpoint(t_ms);
+        if (method == LS_EULER) {
+            motor_model_step(euler, &st);
+        } else {
+            motor_model_step_dt(p, c, &st);
+        }
+
+        if (!(fabsf(st.measured_rpm) < LS_DIVERGED_RPM)) {
+            if (r != NULL) {
+                r->diverged = true;
+            }
+            break;
+        }
+        if (r == NULL) {
+            continue;
+        }
+
+        const struct motor_state *want = &ref[(t_ms + step_ms) / LS_PERIOD_MS];
+        double dr = fabs((double)st.measured_rpm - (double)want->measured_rpm);
+        double dt = fabs((double)st.temperature_c - (double)want->temperature_c);
+
+        r->max_rpm_err = fmax(r->max_rpm_err, dr);
+        r->max_temp_err_c = fmax(r->max_temp_err_c, dt);
+        r->final_rpm_err = dr;
+        r->final_temp_err_c = dt;
+    }
+}
+
+static int ls_run(const struct motor_model_params *p, enum ls_method method, uint32_t step_ms,
+                  const struct motor_state *ref, struct ls_result *r)
+{
+    float n = (float)step_ms / (float)LS_PERIOD_MS;
+    struct motor_model_params euler = ls_euler_params(p, n);
+    struct motor_model_disc_coeffs c;
+
+    if (method != LS_EULER) {
+        enum motor_model_disc disc = (method == LS_EXP) ? MOTOR_MODEL_DISC_EXP
+                                                        : MOTOR_MODEL_DISC_ZOH;
+        int ret = motor_model_disc_prepare(p, LS_PERIOD_MS / 1000.0f, disc, step_ms / 1000.0f,
+                                           &c);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    memset(r, 0, sizeof(*r));
+    ls_simulate(p, method, step_ms, &euler, &c, ref, r);
+
+    r->us_per_run = INFINITY;
+    for (int round = 0; round < LS_TIMING_ROUNDS; round++) {
+        double t0 = now_us();
+        ls_simulate(p, method, step_ms, &euler, &c, ref, NULL);
+        r->us_per_run = fmin(r->us_per_run, now_us() - t0);
+    }
+
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--check-step-ms N --max-rpm-err X --max-temp-err-c Y]\n"
+            "  Prints method,step_ms,diverged,max_rpm_err,max_temp_err_c,final_rpm_err,\n"
+            "  final_temp_err_c,us_per_run against the %u ms reference over a %u s profile.\n"
+            "  --check-step-ms: exit 1 unless zoh stays within the limits at that step\n"
+            "  and stable at every step (used by ctest).\n",
+            prog, LS_PERIOD_MS, LS_DURATION_MS / 1000U);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"check-step-ms", required_argument, NULL, 's'},
+        {"max-rpm-err", required_argument, NULL, 'r'},
+        {"max-temp-err-c", required_argument, NULL, 'e'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    unsigned long check_step_ms = 0;
+    double max_rpm_err = 0.0;
+    double max_temp_err_c = 0.0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "s:r:e:h", opts, NULL)) != -1) {
+        char *end = NULL;
+
+        errno = 0;
+        switch (c) {
+            case 's':
+                check_step_ms = strtoul(optarg, &end, 0);
+                break;
+            case 'r':
+                max_rpm_err = strtod(optarg, &end);
+                break;
+            case 'e':
+                max_temp_err_c = strtod(optarg, &end);
+                break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 2;
+        }
+        if ((errno != 0) || (end == optarg) || (*end != '\0')) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_state *ref = calloc((LS_DURATION_MS / LS_PERIOD_MS) + 1U, sizeof(*ref));
+
+    if (ref == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    ls_reference(&p, ref);
+
+    printf("# %u s profile, reference %u ms\n", LS_DURATION_MS / 1000U, LS_PERIOD_MS);
+    printf("method,step_ms,diverged,max_rpm_err,max_temp_err_c,final_rpm_err,final_temp_err_c,"
+           "us_per_run\n");
+
+    int ret = 0;
+    for (size_t m = 0; m < LS_NUM_METHODS; m++) {
+        for (size_t s = 0; s < LS_NUM_STEPS; s++) {
+            struct ls_result r;
+
+            if (ls_run(&p, (enum ls_method)m, steps_ms[s], ref, &r) != 0) {
+                fprintf(stderr, "%s: invalid parameters\n", method_names[m]);
+                free(ref);
+                return 1;
+            }
+
+            printf("%s,%u,%d,%.3f,%.4f,%.3f,%.4f,%.1f\n", method_names[m], steps_ms[s],
+                   r.diverged ? 1 : 0, r.max_rpm_err, r.max_temp_err_c, r.final_rpm_err,
+                   r.final_temp_err_c, r.us_per_run);
+
+            if ((check_step_ms == 0U) || (m != LS_ZOH)) {
+                continue;
+            }
+            if (r.diverged) {
+                fprintf(stderr, "zoh diverged at %u ms\n", steps_ms[s]);
+                ret = 1;
+            }
+            if ((steps_ms[s] == check_step_ms) &&
+                (r.diverged || (r.max_rpm_err > max_rpm_err) ||
+                 (r.max_temp_err_c > max_temp_err_c))) {
+                fprintf(stderr, "%s at %u ms: rpm error %.3f, temperature error %.4f\n",
+                        method_names[m], steps_ms[s], r.max_rpm_err, r.max_temp_err_c);
+                ret = 1;
+            }
+        }
+    }
+
+    free(ref);
+    return ret;
+}
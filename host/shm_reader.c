@@ -0,0 +1,371 @@
+/**
+ * @file shm_reader.c
+ * @brief Follow the firmware's shared-memory telemetry ring from the host.
+ *
+ * Maps the ring file written by the native_sim build with
+ * CONFIG_MOTOR_SIM_SHM_EXPORT (see docs/shm_telemetry.md) read-only and
+ * prints each sample as CSV, or with --quiet only counts them, reading them
+ * in place. The summary on stderr reports samples read, samples lost because
+ * the reader fell a whole ring behind, and the sample rate.
+ *
+ * --bench measures the ring itself: a forked writer process appends samples
+ * as fast as it can (or at a fixed --rate) while this process reads them
+ * zero-copy from the same shared mapping. Every sample is checked for
+ * tearing (all fields derive from the sequence number) and read + lost must
+ * add up to written.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "motor_shm_ring.h"
+
+/* Poll interval while the ring is empty or not created yet. */
+#define SR_POLL_NS 1000000L
+
+/* Ring capacity used by --bench (the firmware default). */
+#define SR_BENCH_SLOTS 4096U
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static void poll_sleep(void)
+{
+    const struct timespec ts = {.tv_nsec = SR_POLL_NS};
+
+    (void)nanosleep(&ts, NULL);
+}
+
+/* Map the whole file read-only. */
+static const void *map_file(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    const void *mem = NULL;
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+        mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) {
+            mem = NULL;
+        } else {
+            *size = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+
+    return mem;
+}
+
+/* Wait up to timeout_s for the firmware to create and format the ring. */
+static int attach_file(const char *path, double timeout_s, struct motor_shm_reader *rd)
+{
+    double deadline = now_s() + timeout_s;
+
+    while (!stop) {
+        size_t size = 0;
+        const void *mem = map_file(path, &size);
+
+        if ((mem != NULL) && (motor_shm_reader_attach(rd, mem, size) == 0)) {
+            return 0;
+        }
+        if (mem != NULL) {
+            munmap((void *)mem, size);
+        }
+        if (now_s() >= deadline) {
+            fprintf(stderr, "%s: no telemetry ring after %.1f s\n", path, timeout_s);
+            return -1;
+        }
+        poll_sleep();
+    }
+
+    return -1;
+}
+
+static int follow(const char *path, unsigned long count, double timeout_s, bool quiet)
+{
+    struct motor_shm_reader rd;
+    unsigned long n = 0;
+
+    if (attach_file(path, timeout_s, &rd) != 0) {
+        return 1;
+    }
+
+    if (!quiet) {
+        printf("seq,uptime_ms,setpoint_rpm,measured_rpm,control_output_pct,temperature_c\n");
+    }
+
+    double t0 = now_s();
+    double idle_since = t0;
+
+    while (!stop && ((count == 0UL) || (n < count))) {
+        const struct motor_shm_sample *p;
+        struct motor_shm_sample s;
+
+        if (quiet) {
+            /* Zero-copy: only look at the sample in place. */
+            if (motor_shm_reader_peek(&rd, &p) == 0) {
+                if (motor_shm_reader_commit(&rd) == 0) {
+                    n++;
+                }
+                idle_since = now_s();
+                continue;
+            }
+        } else if (motor_shm_reader_next(&rd, &s) == 0) {
+            printf("%u,%u,%.1f,%.1f,%.2f,%.2f\n", s.seq, s.uptime_ms,
+                   (double)s.state.setpoint_rpm, (double)s.state.measured_rpm,
+                   (double)s.state.control_output_pct, (double)s.state.temperature_c);
+            n++;
+            idle_since = now_s();
+            continue;
+        }
+
+        if ((now_s() - idle_since) >= timeout_s) {
+            fprintf(stderr, "no new samples for %.1f s\n", timeout_s);
+            break;
+        }
+        poll_sleep();
+    }
+
+    double dt = now_s() - t0;
+
+    fflush(stdout);
+    fprintf(stderr, "samples=%lu,lost=%u,seconds=%.2f,samples_per_s=%.1f\n", n, rd.lost, dt,
+            (dt > 0.0) ? ((double)n / dt) : 0.0);
+
+    return 0;
+}
+
+/* Every field derives from the sequence number, so a torn read shows. */
+static void bench_fill(struct motor_shm_sample *s, uint32_t seq)
+{
+    s->seq = seq;
+    s->uptime_ms = seq * 3U;
+    s->state.setpoint_rpm = (float)(seq & 0xffffU);
+    s->state.measured_rpm = (float)((seq >> 16) & 0xffffU);
+    s->state.control_output_pct = (float)(seq & 0xffU);
+    s->state.temperature_c = (float)((seq >> 8) & 0xffU);
+}
+
+static bool bench_check(const struct motor_shm_sample *s)
+{
+    struct motor_shm_sample want;
+
+    bench_fill(&want, s->seq);
+    return memcmp(&want, s, sizeof(want)) == 0;
+}
+
+/* Writer side of --bench: as fast as possible, or rate_hz samples per second. */
+static void bench_write(struct motor_shm_ring *ring, unsigned long samples, double rate_hz)
+{
+    struct motor_shm_sample s;
+    double t0 = now_s();
+
+    for (uint32_t i = 1; i <= samples; i++) {
+        if (rate_hz > 0.0) {
+            double due = t0 + ((double)i / rate_hz);
+
+            while (now_s() < due) {
+            }
+        }
+        bench_fill(&s, i);
+        motor_shm_ring_write(ring, &s);
+    }
+}
+
+static int bench(unsigned long samples, double rate_hz)
+{
+    size_t size = motor_shm_ring_size(SR_BENCH_SLOTS);
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (mem == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    struct motor_shm_ring *ring = motor_shm_ring_init(mem, size, SR_BENCH_SLOTS);
+    struct motor_shm_reader rd;
+
+    (void)motor_shm_reader_attach(&rd, mem, size);
+
+    double t0 = now_s();
+    pid_t pid = fork();
+
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0) {
+        bench_write(ring, samples, rate_hz);
+        _exit(0);
+    }
+
+    unsigned long read = 0;
+    unsigned long torn = 0;
+    unsigned long stale = 0;
+
+    while (rd.next != samples) {
+        const struct motor_shm_sample *p;
+
+        if (motor_shm_reader_peek(&rd, &p) != 0) {
+            continue; /* Caught up with the writer: spin. */
+        }
+
+        /* Checked in place; only trusted if the slot survived the check. */
+        bool ok = bench_check(p);
+
+        if (motor_shm_reader_commit(&rd) != 0) {
+            stale++;
+            continue;
+        }
+        read++;
+        if (!ok) {
+            torn++;
+        }
+    }
+
+    double t_read_end = now_s();
+    int status = 0;
+
+    waitpid(pid, &status, 0);
+    double t_write_end = now_s();
+
+    unsigned long lost = rd.lost;
+    double read_s = t_read_end - t0;
+
+    printf("rate_hz=%.0f,slots=%u,samples=%lu,read=%lu,lost=%lu,stale=%lu,torn=%lu,"
+           "seconds=%.3f,writes_per_s=%.0f,reads_per_s=%.0f\n",
+           rate_hz, SR_BENCH_SLOTS, samples, read, lost, stale, torn, t_write_end - t0,
+           (double)samples / read_s, (double)read / read_s);
+
+    munmap(mem, size);
+
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+        fprintf(stderr, "writer failed\n");
+        return 1;
+    }
+    if (torn != 0UL) {
+        fprintf(stderr, "%lu torn samples returned\n", torn);
+        return 1;
+    }
+    if ((read + lost) != samples) {
+        fprintf(stderr, "read %lu + lost %lu != written %lu\n", read, lost, samples);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--count N] [--timeout-s S] [--quiet] FILE\n"
+            "       %s --bench [--samples N] [--rate HZ]\n"
+            "  Follows the telemetry ring in FILE (CONFIG_MOTOR_SIM_SHM_FILE, or the\n"
+            "  native_sim -shm-file option) and prints one CSV row per sample, until\n"
+            "  N samples (0 = no limit), S seconds without samples or Ctrl+C.\n"
+            "  --quiet: count the samples in place without printing them.\n"
+            "  --bench: writer and reader processes on one ring, the writer as fast as\n"
+            "  possible or at HZ samples per second (0 = unpaced);\n"
+            "  exits 1 on a torn sample or if read + lost != written (used by ctest).\n",
+            prog, prog);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"count", required_argument, NULL, 'c'},
+        {"timeout-s", required_argument, NULL, 't'},
+        {"quiet", no_argument, NULL, 'q'},
+        {"bench", no_argument, NULL, 'b'},
+        {"samples", required_argument, NULL, 'n'},
+        {"rate", required_argument, NULL, 'r'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    unsigned long count = 0;
+    unsigned long samples = 20000000UL;
+    double timeout_s = 10.0;
+    double rate_hz = 0.0;
+    bool quiet = false;
+    bool do_bench = false;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "c:t:qbn:r:h", opts, NULL)) != -1) {
+        char *end = NULL;
+
+        errno = 0;
+        switch (c) {
+            case 'c':
+                count = strtoul(optarg, &end, 0);
+                break;
+            case 't':
+                timeout_s = strtod(optarg, &end);
+                break;
+            case 'n':
+                samples = strtoul(optarg, &end, 0);
+                break;
+            case 'r':
+                rate_hz = strtod(optarg, &end);
+                break;
+            case 'q':
+                quiet = true;
+                continue;
+            case 'b':
+                do_bench = true;
+                continue;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 2;
+        }
+        if ((errno != 0) || (end == optarg) || (*end != '\0')) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (do_bench) {
+        if ((samples == 0UL) || (samples > UINT32_MAX) || (rate_hz < 0.0)) {
+            usage(argv[0]);
+            return 2;
+        }
+        return bench(samples, rate_hz);
+    }
+
+    if (optind != (argc - 1)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    return follow(argv[optind], count, timeout_s, quiet);
+}
@@ -0,0 +1,264 @@
+/**
+ * @file thermal_multirate.c
+ * @brief Accuracy against cost of running the thermal model at a sub-rate.
+ *
+ * Simulates a 1 kHz control loop (the firmware tuning rescaled from 50 ms to
+ * 1 ms periods) through a setpoint profile that heats the motor and lets it
+ * cool again. Each thermal divider is compared against the single-rate
+ * reference (motor_model_step) and timed per control step.
+ *
+ * Two scenarios: "nominal" stays below the overtemperature limits, so the
+ * step-by-step temperature error is meaningful. "hot" doubles the heating so
+ * the output limits engage; the loop then chatters around the limit and
+ * step-by-step errors mostly measure when a switch happens, so the peak
+ * temperature is the figure to compare.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "motor_model.h"
+
+/* Simulated control period and the period the firmware tuning is written for. */
+#define MR_PERIOD_MS    1.0
+#define MR_FW_PERIOD_MS 50.0
+
+/* Setpoint profile: one segment every MR_SEGMENT_STEPS control periods. */
+#define MR_SEGMENT_STEPS 20000U
+
+static const float profile_rpm[] = {3000.0f, 8000.0f, 500.0f, 6000.0f, 0.0f, 4000.0f};
+
+#define MR_STEPS ((uint32_t)(sizeof(profile_rpm) / sizeof(profile_rpm[0])) * MR_SEGMENT_STEPS)
+
+/* Timing: best of this many full runs. */
+#define MR_TIMING_ROUNDS 15
+
+static const uint32_t dividers[] = {1, 2, 5, 10, 20, 50, 100, 200, 500};
+
+#define MR_NUM_DIVIDERS (sizeof(dividers) / sizeof(dividers[0]))
+
+struct mr_result {
+    uint32_t divider;
+    double peak_temp_err_c;
+    double max_temp_err_c;
+    double rms_temp_err_c;
+    double max_rpm_err;
+    double ns_per_step;
+};
+
+/* Heating relative to the firmware tuning. */
+struct mr_scenario {
+    const char *name;
+    double heat_scale;
+};
+
+static const struct mr_scenario scenarios[] = {
+    {"nominal", 1.0},
+    {"hot", 2.0},
+};
+
+#define MR_NUM_SCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/* Rescale per-period gains from the firmware period to MR_PERIOD_MS. */
+static struct motor_model_params mr_params(const struct mr_scenario *sc)
+{
+    const struct motor_model_params fw = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_model_params p = fw;
+    double r = MR_PERIOD_MS / MR_FW_PERIOD_MS;
+
+    p.kp_percent = (float)(fw.kp_percent * r);
+    p.speed_filter_alpha = (float)(1.0 - pow(1.0 - fw.speed_filter_alpha, r));
+    p.heat_gain = (float)(fw.heat_gain * sc->heat_scale * r);
+    p.cool_gain = (float)(1.0 - pow(1.0 - fw.cool_gain, r));
+
+    return p;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*
+ * Run the profile. divider 0 selects the single-rate reference. When trace is
+ * not NULL, the state after each step is stored there.
+ */
+static float mr_run(const struct motor_model_params *p, uint32_t divider,
+                    struct motor_state *trace)
+{
+    const struct motor_model_params nominal = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_state st = {.temperature_c = nominal.ambient_temp_c};
+    float sink = 0.0f;
+
+    for (uint32_t i = 0; i < MR_STEPS; i++) {
+        st.setpoint_rpm = profile_rpm[i / MR_SEGMENT_STEPS];
+
+        if (divider == 0U) {
+            motor_model_step(p, &st);
+        } else {
+            motor_model_step_multirate(p, &st, i, divider);
+        }
+
+        if (trace != NULL) {
+            trace[i] = st;
+        }
+        sink += st.temperature_c;
+    }
+
+    return sink;
+}
+
+static double mr_time_ns_per_step(const struct motor_model_params *p, uint32_t divider)
+{
+    double best = INFINITY;
+    volatile float sink = 0.0f;
+
+    for (int round = 0; round < MR_TIMING_ROUNDS; round++) {
+        double t0 = now_ns();
+        sink += mr_run(p, divider, NULL);
+        double dt = now_ns() - t0;
+
+        best = fmin(best, dt / MR_STEPS);
+    }
+
+    (void)sink;
+    return best;
+}
+
+static double mr_peak_c(const struct motor_state *trace)
+{
+    float peak_c = trace[0].temperature_c;
+
+    for (uint32_t i = 1; i < MR_STEPS; i++) {
+        peak_c = fmaxf(peak_c, trace[i].temperature_c);
+    }
+
+    return peak_c;
+}
+
+static void mr_scenario_run(const struct mr_scenario *sc, struct motor_state *ref,
+                            struct motor_state *run, struct mr_result *results, double *ref_ns)
+{
+    struct motor_model_params p = mr_params(sc);
+
+    (void)mr_run(&p, 0U, ref);
+    *ref_ns = mr_time_ns_per_step(&p, 0U);
+
+    double ref_peak_c = mr_peak_c(ref);
+
+    for (size_t d = 0; d < MR_NUM_DIVIDERS; d++) {
+        struct mr_result *r = &results[d];
+        double sq = 0.0;
+
+        r->divider = dividers[d];
+        r->max_temp_err_c = 0.0;
+        r->max_rpm_err = 0.0;
+
+        (void)mr_run(&p, r->divider, run);
+        for (uint32_t i = 0; i < MR_STEPS; i++) {
+            double dt = fabs((double)run[i].temperature_c - (double)ref[i].temperature_c);
+            double dr = fabs((double)run[i].measured_rpm - (double)ref[i].measured_rpm);
+
+            r->max_temp_err_c = fmax(r->max_temp_err_c, dt);
+            r->max_rpm_err = fmax(r->max_rpm_err, dr);
+            sq += dt * dt;
+        }
+        r->peak_temp_err_c = fabs(mr_peak_c(run) - ref_peak_c);
+        r->rms_temp_err_c = sqrt(sq / MR_STEPS);
+        r->ns_per_step = mr_time_ns_per_step(&p, r->divider);
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--check-divider N --max-err-c X]\n"
+            "  Prints scenario,divider,thermal_period_ms,peak_temp_err_c,max_temp_err_c,\n"
+            "  rms_temp_err_c,max_rpm_err,ns_per_step,speedup for a 1 kHz loop.\n"
+            "  --check-divider/--max-err-c: exit 1 if, for that divider, the nominal\n"
+            "  worst temperature error or the hot peak temperature error exceeds X degC\n"
+            "  (used by ctest).\n",
+            prog);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"check-divider", required_argument, NULL, 'd'},
+        {"max-err-c", required_argument, NULL, 'e'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    unsigned long check_divider = 0;
+    double max_err_c = 0.0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "d:e:h", opts, NULL)) != -1) {
+        char *end = NULL;
+
+        errno = 0;
+        switch (c) {
+            case 'd':
+                check_divider = strtoul(optarg, &end, 0);
+                break;
+            case 'e':
+                max_err_c = strtod(optarg, &end);
+                break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 2;
+        }
+        if ((errno != 0) || (end == optarg) || (*end != '\0')) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    struct motor_state *ref = calloc(MR_STEPS, sizeof(*ref));
+    struct motor_state *run = calloc(MR_STEPS, sizeof(*run));
+
+    if ((ref == NULL) || (run == NULL)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("# %u steps of %.0f ms\n", MR_STEPS, MR_PERIOD_MS);
+    printf("scenario,divider,thermal_period_ms,peak_temp_err_c,max_temp_err_c,rms_temp_err_c,"
+           "max_rpm_err,ns_per_step,speedup\n");
+
+    int ret = 0;
+    for (size_t sc = 0; sc < MR_NUM_SCENARIOS; sc++) {
+        struct mr_result results[MR_NUM_DIVIDERS];
+        double ref_ns;
+
+        mr_scenario_run(&scenarios[sc], ref, run, results, &ref_ns);
+
+        for (size_t d = 0; d < MR_NUM_DIVIDERS; d++) {
+            const struct mr_result *r = &results[d];
+
+            printf("%s,%u,%.0f,%.4f,%.4f,%.4f,%.3f,%.2f,%.2f\n", scenarios[sc].name, r->divider,
+                   r->divider * MR_PERIOD_MS, r->peak_temp_err_c, r->max_temp_err_c,
+                   r->rms_temp_err_c, r->max_rpm_err, r->ns_per_step, ref_ns / r->ns_per_step);
+
+            /* Nominal: step-by-step error. Hot: peak error (see file comment). */
+            double err = (sc == 0U) ? r->max_temp_err_c : r->peak_temp_err_c;
+            if ((r->divider == check_divider) && (err > max_err_c)) {
+                fprintf(stderr, "%s, divider %u: temperature error %.4f > %.4f degC\n",
+                        scenarios[sc].name, r->divider, err, max_err_c);
+                ret = 1;
+            }
+        }
+    }
+
+    free(ref);
+    free(run);
+    return ret;
+}
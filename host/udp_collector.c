@@ -0,0 +1,276 @@
+/**
+ * @file udp_collector.c
+ * @brief Receive the firmware's UDP telemetry and send it setpoint commands.
+ *
+ * Listens on the collector port of a build with CONFIG_MOTOR_SIM_UDP (see
+ * docs/udp_link.md) and prints every sample of every telemetry datagram as
+ * CSV. The summary on stderr reports datagrams and samples received, the
+ * datagrams lost or reordered on the way (from gaps in the datagram sequence
+ * numbers) and the sample rate.
+ *
+ * --set sends one setpoint command to the command port instead, waits for
+ * its ack and prints the status and the round-trip time.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "motor_udp_proto.h"
+
+/* Defaults of CONFIG_MOTOR_SIM_UDP_COLLECTOR_PORT and CONFIG_MOTOR_SIM_UDP_CMD_PORT. */
+#define UC_COLLECTOR_PORT 47101
+#define UC_CMD_PORT 47100
+
+/* Poll interval, so Ctrl+C and the idle timeout are noticed. */
+#define UC_POLL_MS 100
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static int open_socket(const char *addr, int port, struct sockaddr_in *sa)
+{
+    *sa = (struct sockaddr_in){.sin_family = AF_INET, .sin_port = htons((uint16_t)port)};
+    if (inet_pton(AF_INET, addr, &sa->sin_addr) != 1) {
+        fprintf(stderr, "not an IPv4 address: %s\n", addr);
+        return -1;
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (sock < 0) {
+        perror("socket");
+    }
+    return sock;
+}
+
+static int collect(const char *addr, int port, unsigned long count, double timeout_s)
+{
+    struct sockaddr_in sa;
+    int sock = open_socket(addr, port, &sa);
+
+    if (sock < 0) {
+        return 1;
+    }
+    if (bind(sock, (struct sockaddr *)&sa, sizeof(sa)) != 0) {
+        fprintf(stderr, "bind %s:%d: %s\n", addr, port, strerror(errno));
+        close(sock);
+        return 1;
+    }
+
+    printf("seq,uptime_ms,setpoint_rpm,measured_rpm,control_output_pct,temperature_c\n");
+
+    static uint8_t buf[MOTOR_UDP_MAX_LEN];
+    unsigned long samples = 0;
+    unsigned long datagrams = 0;
+    unsigned long lost = 0;
+    unsigned long bad = 0;
+    uint32_t next_seq = 0;
+    double t0 = 0.0;
+    double idle_since = now_s();
+
+    while (!stop && ((count == 0UL) || (samples < count))) {
+        struct pollfd pfd = {.fd = sock, .events = POLLIN};
+
+        if (poll(&pfd, 1, UC_POLL_MS) <= 0) {
+            if ((now_s() - idle_since) >= timeout_s) {
+                fprintf(stderr, "no datagrams for %.1f s\n", timeout_s);
+                break;
+            }
+            continue;
+        }
+
+        ssize_t len = recv(sock, buf, sizeof(buf), 0);
+        struct motor_udp_msg msg;
+
+        if ((len < 0) || (motor_udp_decode(buf, (size_t)len, &msg) != 0) ||
+            (msg.type != MOTOR_UDP_TELEMETRY)) {
+            bad++;
+            continue;
+        }
+
+        idle_since = now_s();
+        if (datagrams == 0UL) {
+            t0 = idle_since;
+        } else if (msg.seq != next_seq) {
+            /* Counts datagrams skipped over; a late one after a gap is counted as lost. */
+            lost += (uint32_t)(msg.seq - next_seq);
+        }
+        next_seq = msg.seq + 1U;
+        datagrams++;
+
+        for (uint16_t i = 0; i < msg.count; i++) {
+            struct motor_udp_sample s;
+
+            motor_udp_get_sample(buf, i, &s);
+            printf("%u,%u,%.1f,%.1f,%.2f,%.2f\n", s.seq, s.uptime_ms,
+                   (double)s.state.setpoint_rpm, (double)s.state.measured_rpm,
+                   (double)s.state.control_output_pct, (double)s.state.temperature_c);
+        }
+        samples += msg.count;
+    }
+
+    double dt = (datagrams > 0UL) ? (idle_since - t0) : 0.0;
+
+    fflush(stdout);
+    fprintf(stderr,
+            "datagrams=%lu,samples=%lu,lost_datagrams=%lu,bad=%lu,seconds=%.2f,"
+            "samples_per_s=%.1f\n",
+            datagrams, samples, lost, bad, dt, (dt > 0.0) ? ((double)samples / dt) : 0.0);
+
+    close(sock);
+    return 0;
+}
+
+static int set_rpm(const char *addr, int port, float rpm, double timeout_s)
+{
+    struct sockaddr_in sa;
+    int sock = open_socket(addr, port, &sa);
+
+    if (sock < 0) {
+        return 1;
+    }
+
+    static uint8_t buf[MOTOR_UDP_MAX_LEN];
+    uint32_t cmd_id = (uint32_t)getpid();
+    size_t len = motor_udp_encode_setpoint(buf, 0U, cmd_id, rpm);
+    double t0 = now_s();
+
+    if (sendto(sock, buf, len, 0, (struct sockaddr *)&sa, sizeof(sa)) != (ssize_t)len) {
+        perror("sendto");
+        close(sock);
+        return 1;
+    }
+
+    int ret = 1;
+
+    while (!stop && ((now_s() - t0) < timeout_s)) {
+        struct pollfd pfd = {.fd = sock, .events = POLLIN};
+        struct motor_udp_msg msg;
+
+        if (poll(&pfd, 1, UC_POLL_MS) <= 0) {
+            continue;
+        }
+
+        ssize_t rlen = recv(sock, buf, sizeof(buf), 0);
+
+        if ((rlen < 0) || (motor_udp_decode(buf, (size_t)rlen, &msg) != 0) ||
+            (msg.type != MOTOR_UDP_ACK) || (msg.cmd_id != cmd_id)) {
+            continue;
+        }
+
+        printf("setpoint=%.1f,status=%d,uptime_ms=%u,rtt_us=%.0f\n", (double)rpm, msg.status,
+               msg.uptime_ms, (now_s() - t0) * 1e6);
+        ret = (msg.status == 0) ? 0 : 1;
+        break;
+    }
+
+    if (ret != 0) {
+        fprintf(stderr, "no ack from %s:%d within %.1f s\n", addr, port, timeout_s);
+    }
+
+    close(sock);
+    return ret;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--addr A] [--port P] [--count N] [--timeout-s S]\n"
+            "       %s --set RPM [--addr A] [--port P] [--timeout-s S]\n"
+            "  Receives telemetry datagrams on A:P (default 127.0.0.1:%d) and prints\n"
+            "  one CSV row per sample, until N samples (0 = no limit), S seconds\n"
+            "  without datagrams or Ctrl+C.\n"
+            "  --set: send one setpoint command to A:P (default 127.0.0.1:%d) and\n"
+            "  print its ack and round-trip time; exits 1 on no ack or an error status.\n",
+            prog, prog, UC_COLLECTOR_PORT, UC_CMD_PORT);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"addr", required_argument, NULL, 'a'},
+        {"port", required_argument, NULL, 'p'},
+        {"count", required_argument, NULL, 'c'},
+        {"timeout-s", required_argument, NULL, 't'},
+        {"set", required_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    const char *addr = "127.0.0.1";
+    long port = 0;
+    unsigned long count = 0;
+    double timeout_s = 10.0;
+    double rpm = 0.0;
+    bool do_set = false;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "a:p:c:t:s:h", opts, NULL)) != -1) {
+        char *end = NULL;
+
+        errno = 0;
+        switch (c) {
+            case 'a':
+                addr = optarg;
+                continue;
+            case 'p':
+                port = strtol(optarg, &end, 0);
+                break;
+            case 'c':
+                count = strtoul(optarg, &end, 0);
+                break;
+            case 't':
+                timeout_s = strtod(optarg, &end);
+                break;
+            case 's':
+                rpm = strtod(optarg, &end);
+                do_set = true;
+                break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 2;
+        }
+        if ((errno != 0) || (end == optarg) || (*end != '\0')) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if ((optind != argc) || (port < 0) || (port > 65535) || (timeout_s <= 0.0)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (do_set) {
+        return set_rpm(addr, (port != 0) ? (int)port : UC_CMD_PORT, (float)rpm, timeout_s);
+    }
+
+    return collect(addr, (port != 0) ? (int)port : UC_COLLECTOR_PORT, count, timeout_s);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file motor_dc.h
+ * @brief DC motor electrical model with an inner PI current loop.
+ *
+ * Optional plant for the motor model: an RL winding with back-EMF driving a
+ * rotor with inertia, viscous friction and a load torque, under a PI current
+ * controller that runs many times per speed-loop period (10 kHz against the
+ * 50 ms speed loop by default). The speed controller of motor_model.h sets
+ * the current reference, so the pair forms a cascaded speed/current loop.
+ *
+ * The current step is the hot path: every division and unit conversion is
+ * folded into struct motor_dc_coeffs by motor_dc_prepare(), and the step is
+ * branch-free multiply-adds and min/max clamps, sized to stay within
+ * MOTOR_DC_STEP_CYCLE_BUDGET.
+ */
+
+#ifndef MOTOR_DC_H_
+#define MOTOR_DC_H_
+
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Cycle budget of one current-loop step: 1% of a 100 MHz core at 10 kHz.
+ * tests/benchmark/hot_path fails if motor_dc_current_step() exceeds it.
+ */
+#define MOTOR_DC_STEP_CYCLE_BUDGET 100
+
+/**
+ * @brief Physical parameters and current-loop tuning.
+ */
+struct motor_dc_params {
+    float resistance_ohm;        /**< Winding resistance (ohm). */
+    float inductance_h;          /**< Winding inductance (H). */
+    float ke_v_s_per_rad;        /**< Back-EMF constant (V per rad/s). */
+    float kt_nm_per_a;           /**< Torque constant (Nm/A). */
+    float inertia_kg_m2;         /**< Rotor and load inertia (kg m^2). */
+    float friction_nm_s;         /**< Viscous friction (Nm per rad/s). */
+    float load_nm;               /**< Constant load torque opposing rotation (Nm). */
+    float bus_voltage_v;         /**< Supply voltage, the PI output is clamped to +/- this (V). */
+    float max_current_a;         /**< Current reference at 100% speed-loop output (A). */
+    float current_kp_v_per_a;    /**< Current loop proportional gain (V/A). */
+    float current_ki_v_per_as;   /**< Current loop integral gain (V/(A s)). */
+};
+
+/**
+ * Initializer matching the first-order model: 100% output settles at
+ * 10000 rpm with a 0.22 s mechanical time constant, electrical time constant
+ * 1 ms, current loop bandwidth about 500 Hz.
+ */
+#define MOTOR_DC_PARAMS_DEFAULT                                                                    \
+    {                                                                                              \
+        .resistance_ohm = 1.0f, .inductance_h = 1.0e-3f, .ke_v_s_per_rad = 0.02f,                  \
+        .kt_nm_per_a = 0.02f, .inertia_kg_m2 = 4.3e-5f, .friction_nm_s = 1.91e-4f,                 \
+        .load_nm = 0.0f, .bus_voltage_v = 36.0f, .max_current_a = 10.0f,                           \
+        .current_kp_v_per_a = 3.0f, .current_ki_v_per_as = 3000.0f,                                \
+    }
+
+/**
+ * @brief Discretized coefficients, filled by motor_dc_prepare().
+ */
+struct motor_dc_coeffs {
+    float dt_over_l;       /**< dt / L. */
+    float resistance_ohm;  /**< R. */
+    float ke;              /**< Back-EMF constant. */
+    float dt_kt_over_j;    /**< dt * kt / J. */
+    float dt_b_over_j;     /**< dt * b / J. */
+    float dt_load_over_j;  /**< dt * load / J. */
+    float kp;              /**< Current loop proportional gain. */
+    float ki_dt;           /**< Current loop integral gain times dt. */
+    float bus_v;           /**< Voltage clamp. */
+    float pct_to_a;        /**< Speed-loop output (%) to current reference (A). */
+    float rad_s_to_rpm;    /**< Speed conversion. */
+    uint32_t inner_steps;  /**< Current-loop steps per speed-loop period. */
+};
+
+/**
+ * @brief Electrical and mechanical state.
+ */
+struct motor_dc_state {
+    float current_a;   /**< Winding current (A). */
+    float omega_rad_s; /**< Rotor speed (rad/s), never negative. */
+    float integ_v;     /**< Current loop integrator (V). */
+    float voltage_v;   /**< Last applied winding voltage (V). */
+};
+
+/**
+ * @brief Precompute the discretized coefficients.
+ *
+ * @param params          Physical parameters. Must not be NULL.
+ * @param current_loop_hz Current loop rate (Hz).
+ * @param speed_period_s  Speed loop period (s); sets the inner steps per period.
+ * @param out             Coefficients to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if a rate, period, R, L, J or the bus voltage
+ *         is not positive, or the period is shorter than one current step.
+ */
+int motor_dc_prepare(const struct motor_dc_params *params, float current_loop_hz,
+                     float speed_period_s, struct motor_dc_coeffs *out);
+
+/**
+ * @brief Run one current-loop step.
+ *
+ * PI on the current error with the integrator and output clamped to the bus
+ * voltage (anti-windup), then a semi-implicit Euler step of the winding and
+ * the rotor. The rotor is one-directional: speed is floored at zero.
+ *
+ * @param c           Coefficients from motor_dc_prepare().
+ * @param s           In/out electrical and mechanical state.
+ * @param current_ref Current reference (A).
+ */
+void motor_dc_current_step(const struct motor_dc_coeffs *c, struct motor_dc_state *s,
+                           float current_ref);
+
+/**
+ * @brief Plant stage of a speed-loop period with the DC plant.
+ *
+ * `control_output_pct` becomes the current reference for `inner_steps`
+ * current-loop steps, and the resulting rotor speed is written to
+ * `measured_rpm`. Used after a speed controller other than
+ * motor_model_speed_control() (see motor_pid.h).
+ *
+ * @param c     Coefficients from motor_dc_prepare().
+ * @param dc    In/out electrical and mechanical state.
+ * @param state In/out motor state.
+ */
+void motor_dc_plant_step(const struct motor_dc_coeffs *c, struct motor_dc_state *dc,
+                         struct motor_state *state);
+
+/**
+ * @brief Run one speed-loop period with the DC plant.
+ *
+ * The motor_model speed controller sets `control_output_pct`, then
+ * motor_dc_plant_step() runs the current loop and rotor, then the thermal
+ * stage runs as in motor_model_step_multirate().
+ *
+ * @param params          Speed controller and thermal tuning.
+ * @param c               Coefficients from motor_dc_prepare().
+ * @param dc              In/out electrical and mechanical state.
+ * @param state           In/out motor state.
+ * @param step            Index of this speed-loop period.
+ * @param thermal_divider Speed-loop periods per thermal update.
+ */
+void motor_dc_step(const struct motor_model_params *params, const struct motor_dc_coeffs *c,
+                   struct motor_dc_state *dc, struct motor_state *state, uint32_t step,
+                   uint32_t thermal_divider);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_DC_H_ */
@@ -0,0 +1,116 @@
+/**
+ * @file motor_evlog.h
+ * @brief Binary event records with host-side text rendering.
+ *
+ * The telemetry snapshot and the fault reports are stored as fixed-size
+ * records of raw values instead of formatted log text. The firmware copies a
+ * record into a ring; the text is rendered later, on the host, from the
+ * record's event id:
+ *
+ * - 1 TELEMETRY (inf, telemetry):
+ *   `T[telemetry] SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C`
+ * - 2 FAULT_SPEED (wrn, fault_monitor):
+ *   `Fault(speed): |SP-MEAS|=%d rpm (OUT=%d%%, T=%d C)`
+ * - 3 FAULT_TEMP_HARD (err, fault_monitor):
+ *   `Fault(temp hard): T=%d C (OUT=%d%%, SP=%d rpm)`
+ * - 4 FAULT_TEMP_SOFT (wrn, fault_monitor):
+ *   `Fault(temp soft): T=%d C (OUT=%d%%, SP=%d rpm)`
+ *
+ * Each value is truncated to int as the log statements did, so the rendered
+ * text is the one the firmware used to print.
+ *
+ * Encoded record, 28 bytes, all fields little-endian:
+ *
+ * | Offset | Size | Field                                     |
+ * |--------|------|-------------------------------------------|
+ * | 0      | 4    | event id (enum motor_evlog_id)            |
+ * | 4      | 4    | record sequence number                    |
+ * | 8      | 4    | firmware uptime_ms                        |
+ * | 12     | 16   | the four motor_state floats               |
+ *
+ * Plain C with explicit byte order, so the firmware and host tools share it.
+ */
+
+#ifndef MOTOR_EVLOG_H_
+#define MOTOR_EVLOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Encoded record size. */
+#define MOTOR_EVLOG_RECORD_LEN 28U
+
+/** Buffer size that holds any rendered text, terminator included. */
+#define MOTOR_EVLOG_TEXT_MAX 96U
+
+/**
+ * @brief Event ids.
+ */
+enum motor_evlog_id {
+    MOTOR_EVLOG_TELEMETRY = 1,       /**< Periodic state snapshot. */
+    MOTOR_EVLOG_FAULT_SPEED = 2,     /**< Speed error above the threshold. */
+    MOTOR_EVLOG_FAULT_TEMP_HARD = 3, /**< Temperature above the hard limit. */
+    MOTOR_EVLOG_FAULT_TEMP_SOFT = 4, /**< Temperature above the soft limit. */
+};
+
+/**
+ * @brief Severity of an event, as the Zephyr log levels.
+ */
+enum motor_evlog_level {
+    MOTOR_EVLOG_LEVEL_ERR = 1,
+    MOTOR_EVLOG_LEVEL_WRN = 2,
+    MOTOR_EVLOG_LEVEL_INF = 3,
+};
+
+/**
+ * @brief One event record, in host byte order.
+ */
+struct motor_evlog_record {
+    uint32_t id;              /**< Event (enum motor_evlog_id). */
+    uint32_t seq;             /**< Record sequence number, gaps mark lost records. */
+    uint32_t uptime_ms;       /**< Firmware uptime when the event was recorded. */
+    struct motor_state state; /**< Raw values the text is rendered from. */
+};
+
+/**
+ * @brief Encode @p rec into @p buf (MOTOR_EVLOG_RECORD_LEN bytes).
+ */
+void motor_evlog_encode(uint8_t *buf, const struct motor_evlog_record *rec);
+
+/**
+ * @brief Decode a record.
+ *
+ * @return 0 on success, -EINVAL if @p len is not MOTOR_EVLOG_RECORD_LEN or
+ *         the event id is unknown.
+ */
+int motor_evlog_decode(const uint8_t *buf, size_t len, struct motor_evlog_record *out);
+
+/**
+ * @brief Severity and module name of an event.
+ *
+ * @return The level, or 0 if the id is unknown (@p module is then "?").
+ */
+enum motor_evlog_level motor_evlog_level(uint32_t id, const char **module);
+
+/**
+ * @brief Render the log text of a record.
+ *
+ * @param rec  Record with a known event id.
+ * @param buf  Output, MOTOR_EVLOG_TEXT_MAX bytes are always enough.
+ * @param size Size of @p buf.
+ *
+ * @return Text length (as snprintf()), or -EINVAL if the id is unknown.
+ */
+int motor_evlog_format(const struct motor_evlog_record *rec, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_EVLOG_H_ */
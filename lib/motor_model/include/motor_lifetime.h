@@ -0,0 +1,110 @@
+/**
+ * @file motor_lifetime.h
+ * @brief Incremental lifetime statistics of a motor.
+ *
+ * Accumulators updated once per control period, from the state at the end of
+ * the period, each in constant time:
+ *
+ * - periods spent in each temperature band (below the soft limit, between the
+ *   soft and hard limits, above the hard limit), with the model's strict
+ *   `>` comparisons;
+ * - periods with the output saturated at 100%, and periods with the output
+ *   held at the soft or hard overtemperature cap (derated);
+ * - energy, as the sum of the electrical power times the period, in whole mJ
+ *   with the fraction carried from period to period;
+ * - setpoint changes, counted when the setpoint differs from the previous
+ *   period's (the first period after a reset has nothing to compare with);
+ * - histograms of the temperature and of the output, in periods per bin.
+ *
+ * Times are counted in periods so that nothing drifts; multiply by the period
+ * to get the time. Every period is sampled, so the figures are exact for the
+ * simulated run rather than estimated from a decimated log. Plain C, so the
+ * firmware and host tools share it.
+ */
+
+#ifndef MOTOR_LIFETIME_H_
+#define MOTOR_LIFETIME_H_
+
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Temperature histogram: bins of 10 C from 20 C. The first bin also counts
+ * everything below 30 C and the last everything from 120 C, so the limits of
+ * MOTOR_MODEL_PARAMS_DEFAULT (80 and 100 C) fall on bin edges.
+ */
+#define MOTOR_LIFETIME_TEMP_BINS        11U
+#define MOTOR_LIFETIME_TEMP_BIN_BASE_C  20.0f
+#define MOTOR_LIFETIME_TEMP_BIN_WIDTH_C 10.0f
+
+/** Output histogram: bins of 10%, 100% counts in the last one. */
+#define MOTOR_LIFETIME_OUT_BINS          10U
+#define MOTOR_LIFETIME_OUT_BIN_WIDTH_PCT 10.0f
+
+/**
+ * Electrical power drawn at 100% output by a plant without an electrical
+ * model: the DC model's bus voltage times its maximum current (W). The
+ * energy is then this power scaled by the output.
+ */
+#define MOTOR_LIFETIME_RATED_POWER_W 360.0f
+
+/**
+ * @brief Temperature bands, split at the overtemperature limits.
+ */
+enum motor_lifetime_band {
+    MOTOR_LIFETIME_BAND_NORMAL = 0, /**< At or below the soft limit. */
+    MOTOR_LIFETIME_BAND_SOFT,       /**< Above the soft limit, at or below the hard limit. */
+    MOTOR_LIFETIME_BAND_HARD,       /**< Above the hard limit. */
+    MOTOR_LIFETIME_BAND_COUNT,
+};
+
+/**
+ * @brief Accumulators, cleared with motor_lifetime_reset().
+ */
+struct motor_lifetime {
+    uint32_t periods;                                 /**< Periods accumulated. */
+    uint32_t band_periods[MOTOR_LIFETIME_BAND_COUNT]; /**< Periods per temperature band. */
+    uint32_t saturated_periods;                       /**< Periods with the output at 100%. */
+    uint32_t derated_periods;                         /**< Periods at an overtemperature cap. */
+    uint32_t setpoint_changes;                        /**< Setpoint changes between periods. */
+    float last_setpoint_rpm;                          /**< Setpoint of the previous period. */
+    int64_t energy_mj;                                /**< Electrical energy (mJ). */
+    float energy_frac_mj;                             /**< Energy below 1 mJ, not yet counted. */
+    uint32_t temp_hist[MOTOR_LIFETIME_TEMP_BINS];     /**< Periods per temperature bin. */
+    uint32_t out_hist[MOTOR_LIFETIME_OUT_BINS];       /**< Periods per output bin. */
+};
+
+/**
+ * @brief Clear all accumulators.
+ */
+void motor_lifetime_reset(struct motor_lifetime *lt);
+
+/**
+ * @brief Account for one control period.
+ *
+ * @param params    Model tuning, for the overtemperature limits.
+ * @param lt        Accumulators to update.
+ * @param state     State at the end of the period.
+ * @param power_w   Electrical power drawn during the period (W), negative
+ *                  when the motor feeds energy back.
+ * @param period_ms Period length (ms).
+ */
+void motor_lifetime_update(const struct motor_model_params *params, struct motor_lifetime *lt,
+                           const struct motor_state *state, float power_w, uint32_t period_ms);
+
+/**
+ * @brief Temperature band of @p temperature_c.
+ */
+enum motor_lifetime_band motor_lifetime_band(const struct motor_model_params *params,
+                                             float temperature_c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_LIFETIME_H_ */
@@ -0,0 +1,245 @@
+/**
+ * @file motor_model.h
+ * @brief Portable motor/temperature model and fault evaluation.
+ *
+ * Pure C99 with no Zephyr dependency: the same code runs in the firmware
+ * (through motor_control and fault_monitor) and in host tools such as the
+ * parameter sweep in host/.
+ */
+
+#ifndef MOTOR_MODEL_H_
+#define MOTOR_MODEL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Motor state snapshot.
+ *
+ * All values are represented in physical units (rpm, °C, percent).
+ */
+struct motor_state {
+    float setpoint_rpm;       /**< Target speed in rpm. */
+    float measured_rpm;       /**< Simulated measured speed in rpm. */
+    float control_output_pct; /**< Control output in percent (0..100). */
+    float temperature_c;      /**< Simulated motor temperature in °C. */
+};
+
+/**
+ * @brief Tuning of the controller, dynamics and thermal model.
+ */
+struct motor_model_params {
+    float max_rpm;               /**< Speed at 100% output (rpm). */
+    float kp_percent;            /**< Proportional effect as % of full output. */
+    float speed_filter_alpha;    /**< First-order speed response per step (0..1). */
+    float temp_norm_rpm;         /**< Speed at which heating saturates (rpm). */
+    float heat_gain;             /**< Heating per step at full normalized speed (°C). */
+    float cool_gain;             /**< Cooling per step per °C above ambient. */
+    float ambient_temp_c;        /**< Ambient (minimum) temperature (°C). */
+    float max_temp_c;            /**< Temperature clamp (°C). */
+    float soft_limit_temp_c;     /**< Above this, output is capped at soft_limit_output_pct. */
+    float soft_limit_output_pct; /**< Output cap above the soft limit (%). */
+    float hard_limit_temp_c;     /**< Above this, output is capped at hard_limit_output_pct. */
+    float hard_limit_output_pct; /**< Output cap above the hard limit (%). */
+};
+
+/** Speed controller gain of the default tuning (motor_model_params::kp_percent). */
+#define MOTOR_MODEL_KP_PERCENT_DEFAULT 10.0f
+
+/** Initializer for the tuning the firmware uses. */
+#define MOTOR_MODEL_PARAMS_DEFAULT                                                                 \
+    {                                                                                              \
+        .max_rpm = 10000.0f, .kp_percent = MOTOR_MODEL_KP_PERCENT_DEFAULT,                         \
+        .speed_filter_alpha = 0.2f, .temp_norm_rpm = 4000.0f, .heat_gain = 1.0f,                   \
+        .cool_gain = 0.02f, .ambient_temp_c = 25.0f, .max_temp_c = 130.0f,                         \
+        .soft_limit_temp_c = 80.0f, .soft_limit_output_pct = 60.0f, .hard_limit_temp_c = 100.0f,   \
+        .hard_limit_output_pct = 10.0f,                                                            \
+    }
+
+/**
+ * @brief Discretization used by motor_model_step_dt().
+ */
+enum motor_model_disc {
+    /**
+     * Each stage advanced on its own with its input held over the step: the
+     * controller integrates the current speed error, then speed and
+     * temperature follow their exponential responses. Identical to
+     * motor_model_step() at one period; with the default tuning the loop
+     * rings and then goes unstable as steps approach 1 s.
+     */
+    MOTOR_MODEL_DISC_EXP = 0,
+    /**
+     * The speed loop (controller and plant together) advanced exactly for the
+     * setpoint held over the step, so it matches motor_model_step() at every
+     * step boundary and stays stable for any step size. Steps where the loop
+     * is not linear (the output saturates, or the temperature is above the
+     * soft limit so the output limits may engage) fall back to per-stage
+     * updates of at most one period.
+     */
+    MOTOR_MODEL_DISC_ZOH,
+};
+
+/**
+ * @brief Per-stage coefficients for one step size.
+ */
+struct motor_model_stage_coeffs {
+    float ki_dt;         /**< Output change per rpm of speed error over the step (%). */
+    float plant_decay;   /**< Speed response decay over the step. */
+    float thermal_decay; /**< Temperature response decay over the step. */
+    float heat_weight;   /**< Weight of the start-of-step heating (0: end only). */
+};
+
+/**
+ * @brief Step coefficients for one step size, filled by motor_model_disc_prepare().
+ */
+struct motor_model_disc_coeffs {
+    enum motor_model_disc method;         /**< Discretization. */
+    struct motor_model_stage_coeffs step; /**< Per-stage update over the whole step. */
+    struct motor_model_stage_coeffs sub;  /**< Per-stage update over one ZOH fallback sub-step. */
+    uint32_t substeps;                    /**< ZOH fallback sub-steps, each at most one period. */
+    float phi[2][2];                      /**< Speed loop transition of output/speed deviations. */
+    float rpm_to_pct;                     /**< Steady-state output per rpm of setpoint (%). */
+};
+
+/**
+ * @brief Fault flags reported by the fault evaluation.
+ */
+enum fault_flags {
+    /** No fault condition. */
+    FAULT_NONE = 0,
+    /** Absolute speed error exceeds threshold. */
+    FAULT_SPEED_ERROR = (1u << 0),
+    /** Temperature exceeds soft limit. */
+    FAULT_TEMP_SOFT = (1u << 1),
+    /** Temperature exceeds hard limit. */
+    FAULT_TEMP_HARD = (1u << 2),
+};
+
+/**
+ * @brief Run one control period of the controller and plant model.
+ *
+ * - computes a proportional correction from the speed error,
+ * - simulates first-order motor dynamics,
+ * - updates temperature and applies overtemperature output limits.
+ *
+ * @param params Model tuning. Must not be NULL.
+ * @param state  In/out state. Must not be NULL.
+ */
+void motor_model_step(const struct motor_model_params *params, struct motor_state *state);
+
+/**
+ * @brief Run one control period with the thermal model at a sub-rate.
+ *
+ * Same as motor_model_step(), except that the temperature update and clamp
+ * only run on steps where `step % thermal_divider == 0`, and then advance the
+ * temperature by `thermal_divider` periods at once. The multi-period update is
+ * the exact composition of the per-step recurrence for the current speed, so
+ * the only error against motor_model_step() comes from holding the speed
+ * constant between thermal updates. The overtemperature output limits are
+ * still applied every step, from the latest temperature.
+ *
+ * @param params          Model tuning. Must not be NULL.
+ * @param state           In/out state. Must not be NULL.
+ * @param step            Index of this control period (counts up by one per call).
+ * @param thermal_divider Control periods per thermal update (0 or 1: every period).
+ */
+void motor_model_step_multirate(const struct motor_model_params *params, struct motor_state *state,
+                                uint32_t step, uint32_t thermal_divider);
+
+/**
+ * @brief Speed controller stage of a control period.
+ *
+ * Updates `control_output_pct` from the speed error and clamps it to 0..100.
+ * Used with a plant other than the built-in first-order one (see motor_dc.h).
+ *
+ * @param params Model tuning. Must not be NULL.
+ * @param state  In/out state. Must not be NULL.
+ */
+void motor_model_speed_control(const struct motor_model_params *params, struct motor_state *state);
+
+/**
+ * @brief Plant stage of a control period with the built-in first-order model.
+ *
+ * Moves `measured_rpm` towards the speed of `control_output_pct`. Used after
+ * a speed controller other than motor_model_speed_control() (see motor_pid.h).
+ *
+ * @param params Model tuning. Must not be NULL.
+ * @param state  In/out state. Must not be NULL.
+ */
+void motor_model_first_order_plant(const struct motor_model_params *params,
+                                   struct motor_state *state);
+
+/**
+ * @brief Thermal stage of a control period.
+ *
+ * Runs the thermal update at the sub-rate described for
+ * motor_model_step_multirate(), then applies the overtemperature output
+ * limits.
+ *
+ * @param params          Model tuning. Must not be NULL.
+ * @param state           In/out state. Must not be NULL.
+ * @param step            Index of this control period.
+ * @param thermal_divider Control periods per thermal update (0 or 1: every period).
+ */
+void motor_model_thermal_step(const struct motor_model_params *params, struct motor_state *state,
+                              uint32_t step, uint32_t thermal_divider);
+
+/**
+ * @brief Precompute the coefficients to step the model by an arbitrary dt.
+ *
+ * The tuning in @p params is per control period (@p period_s). This maps it
+ * to the equivalent continuous-time loop and discretizes that for @p dt_s,
+ * so motor_model_step_dt() advances the model by dt_s with dynamics that do
+ * not depend on the step size.
+ *
+ * @param params   Model tuning. Must not be NULL.
+ * @param period_s Control period the tuning is written for (s).
+ * @param method   Discretization.
+ * @param dt_s     Step size (s).
+ * @param out      Coefficients to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if a period or max_rpm is not positive,
+ *         speed_filter_alpha or cool_gain is outside (0, 1), the method is
+ *         unknown, or the speed loop alternates sign every period (no
+ *         continuous-time equivalent).
+ */
+int motor_model_disc_prepare(const struct motor_model_params *params, float period_s,
+                             enum motor_model_disc method, float dt_s,
+                             struct motor_model_disc_coeffs *out);
+
+/**
+ * @brief Advance the controller and plant model by one step of the prepared size.
+ *
+ * The temperature follows its exact response to a heating interpolated
+ * between the start and the end of the step. The temperature clamp and the
+ * overtemperature output limits are applied at the end of the step.
+ *
+ * @param params Model tuning. Must not be NULL.
+ * @param c      Coefficients from motor_model_disc_prepare().
+ * @param state  In/out state. Must not be NULL.
+ */
+void motor_model_step_dt(const struct motor_model_params *params,
+                         const struct motor_model_disc_coeffs *c, struct motor_state *state);
+
+/**
+ * @brief Evaluate fault flags for a state snapshot.
+ *
+ * @param state            State snapshot to evaluate.
+ * @param speed_err_th_rpm Speed error threshold in rpm (absolute diff).
+ * @param soft_temp_c      Soft temperature threshold in °C.
+ * @param hard_temp_c      Hard temperature threshold in °C.
+ *
+ * @return Bitmask of @ref fault_flags. Hard and soft temperature faults are
+ *         exclusive.
+ */
+uint32_t motor_model_fault_eval(const struct motor_state *state, float speed_err_th_rpm,
+                                float soft_temp_c, float hard_temp_c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_MODEL_H_ */
@@ -0,0 +1,203 @@
+/**
+ * @file motor_pid.h
+ * @brief Speed PID controller with runtime gains and a relay auto-tuner.
+ *
+ * The controller runs in velocity form: each period it adds a correction to
+ * the output actually applied in the previous period (after the 0..100 clamp
+ * and the overtemperature limits), so the integral cannot wind up while the
+ * output is limited. With MOTOR_PID_GAINS_DEFAULT it is the legacy
+ * motor_model_speed_control() law, which only has the integral term.
+ *
+ * The tuner identifies the plant around the current operating point with a
+ * relay feedback experiment: the output toggles by +/- an amplitude around its
+ * starting value whenever the speed crosses the setpoint (with hysteresis),
+ * which settles into a limit cycle. Its period and amplitude, and the static
+ * gain, give a first-order-plus-dead-time model, from which the SIMC rules
+ * with the tightest recommended closed-loop time constant (equal to the dead
+ * time) compute PI gains for the fastest settling without overshoot. All times
+ * are in control periods. See docs/autotune.md.
+ */
+
+#ifndef MOTOR_PID_H_
+#define MOTOR_PID_H_
+
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Controller gains.
+ *
+ * Each gain is the output change per period (%) for a speed of max_rpm in
+ * its term: the error for ki_pct, the error change for kp_pct and the speed
+ * curvature for kd_pct.
+ */
+struct motor_pid_gains {
+    float kp_pct; /**< Proportional gain. */
+    float ki_pct; /**< Integral gain. */
+    float kd_pct; /**< Derivative gain, on the measured speed. */
+};
+
+/** Gains of the legacy controller (motor_model_params::kp_percent, integral only). */
+#define MOTOR_PID_GAINS_DEFAULT                                                                    \
+    {                                                                                              \
+        .kp_pct = 0.0f, .ki_pct = MOTOR_MODEL_KP_PERCENT_DEFAULT, .kd_pct = 0.0f,                  \
+    }
+
+/**
+ * @brief Controller memory between two periods.
+ */
+struct motor_pid_state {
+    float prev_error_rpm; /**< Speed error of the previous period. */
+    float prev_rpm[2];    /**< Measured speed one and two periods ago. */
+    uint32_t primed;      /**< 0 after motor_pid_reset(): the history is not valid yet. */
+};
+
+/**
+ * @brief Relay experiment settings.
+ */
+struct motor_pid_tune_config {
+    float amplitude_pct;  /**< Relay output swing around the start output (%). */
+    float hysteresis_rpm; /**< Speed error band the relay ignores (noise margin). */
+    uint32_t cycles;      /**< Limit cycles averaged, after a discarded first one. */
+    uint32_t max_periods; /**< Periods after which the experiment fails. */
+};
+
+/** Relay settings used when none are given. */
+#define MOTOR_PID_TUNE_CONFIG_DEFAULT                                                              \
+    {                                                                                              \
+        .amplitude_pct = 10.0f, .hysteresis_rpm = 50.0f, .cycles = 4U, .max_periods = 400U,        \
+    }
+
+/**
+ * @brief Tuner state.
+ */
+enum motor_pid_tune_status {
+    MOTOR_PID_TUNE_IDLE = 0, /**< No experiment run since the tuner was cleared. */
+    MOTOR_PID_TUNE_RUNNING,  /**< Relay experiment in progress. */
+    MOTOR_PID_TUNE_DONE,     /**< Plant identified, gains computed. */
+    MOTOR_PID_TUNE_FAILED,   /**< No usable limit cycle within max_periods. */
+};
+
+/**
+ * @brief First-order-plus-dead-time model identified by the relay experiment.
+ */
+struct motor_pid_ident {
+    float gain_rpm_per_pct; /**< Static gain K (rpm per % of output). */
+    float time_constant;    /**< Time constant T (periods). */
+    float dead_time;        /**< Dead time L (periods). */
+    float cycle_periods;    /**< Measured limit cycle period (periods). */
+    float cycle_amp_rpm;    /**< Measured limit cycle amplitude (rpm, half peak-to-peak). */
+};
+
+/**
+ * @brief Relay auto-tuner.
+ */
+struct motor_pid_tuner {
+    enum motor_pid_tune_status status; /**< Experiment state. */
+    struct motor_pid_tune_config cfg;  /**< Settings given to motor_pid_tune_start(). */
+    float setpoint_rpm;                /**< Operating point speed. */
+    float bias_pct;                    /**< Operating point output. */
+    float relay_pct;                   /**< Relay swing actually used (%). */
+    uint32_t high;                     /**< 1 while the relay output is above the bias. */
+    uint32_t periods;                  /**< Periods since the start. */
+    uint32_t up_switches;              /**< Relay switches to high so far. */
+    uint32_t last_up;                  /**< Period of the last switch to high. */
+    uint32_t cycles;                   /**< Limit cycles accumulated. */
+    float peak_max_rpm;                /**< Highest speed in the current cycle. */
+    float peak_min_rpm;                /**< Lowest speed in the current cycle. */
+    float cycle_rpm_sum;               /**< Speed summed over the current cycle. */
+    float cycle_pct_sum;               /**< Output summed over the current cycle. */
+    float amp_sum;                     /**< Accumulated cycle amplitudes (rpm). */
+    float period_sum;                  /**< Accumulated cycle periods. */
+    float rpm_sum;                     /**< Speed summed over the accumulated cycles. */
+    float pct_sum;                     /**< Output summed over the accumulated cycles. */
+    struct motor_pid_ident ident;      /**< Identified model, once DONE. */
+    struct motor_pid_gains gains;      /**< Computed gains, once DONE. */
+};
+
+/**
+ * @brief Forget the controller history.
+ *
+ * The next motor_pid_speed_control() call has no proportional or derivative
+ * kick, as if the speed had been steady.
+ *
+ * @param pid Controller memory. Must not be NULL.
+ */
+void motor_pid_reset(struct motor_pid_state *pid);
+
+/**
+ * @brief Speed controller stage of a control period.
+ *
+ * Same role as motor_model_speed_control(): updates `control_output_pct`
+ * from the speed error and clamps it to 0..100. With MOTOR_PID_GAINS_DEFAULT
+ * (and the default kp_percent) the result is bit-identical to it.
+ *
+ * @param params Model tuning (max_rpm). Must not be NULL.
+ * @param gains  Controller gains. Must not be NULL.
+ * @param pid    In/out controller memory. Must not be NULL.
+ * @param state  In/out state. Must not be NULL.
+ */
+void motor_pid_speed_control(const struct motor_model_params *params,
+                             const struct motor_pid_gains *gains, struct motor_pid_state *pid,
+                             struct motor_state *state);
+
+/**
+ * @brief Start a relay experiment at the current operating point.
+ *
+ * The speed should be settled at the setpoint: the output is the bias the
+ * relay toggles around. The swing is reduced so the output stays in 0..100.
+ *
+ * @param t     Tuner. Must not be NULL.
+ * @param cfg   Relay settings. Must not be NULL.
+ * @param state Current state. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if a setting is out of range (amplitude not
+ *         positive or above 100, negative hysteresis, no cycles or no
+ *         periods), or the output is at 0 or 100% (no room for the relay).
+ *         The tuner is left unchanged on error.
+ */
+int motor_pid_tune_start(struct motor_pid_tuner *t, const struct motor_pid_tune_config *cfg,
+                         const struct motor_state *state);
+
+/**
+ * @brief Run one period of the relay experiment.
+ *
+ * Replaces the speed controller while the tuner is RUNNING: sets
+ * `control_output_pct` to the relay output. When the experiment ends the
+ * output is put back to the bias, and on success the identified model and
+ * gains are stored in @p t.
+ *
+ * @param t      Tuner. Must not be NULL.
+ * @param params Model tuning (max_rpm). Must not be NULL.
+ * @param state  In/out state. Must not be NULL.
+ *
+ * @return Tuner status after this period.
+ */
+enum motor_pid_tune_status motor_pid_tune_step(struct motor_pid_tuner *t,
+                                               const struct motor_model_params *params,
+                                               struct motor_state *state);
+
+/**
+ * @brief Compute PI gains from an identified model.
+ *
+ * SIMC rules with the closed-loop time constant equal to the dead time:
+ * Kc = T / (2 K L), Ti = min(T, 8 L); the dead time is taken as at least half
+ * a period (the zero-order hold of the output).
+ *
+ * @param params Model tuning (max_rpm). Must not be NULL.
+ * @param ident  Identified model, K and T positive. Must not be NULL.
+ * @param out    Gains to fill. Must not be NULL.
+ */
+void motor_pid_gains_from_ident(const struct motor_model_params *params,
+                                const struct motor_pid_ident *ident, struct motor_pid_gains *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_PID_H_ */
@@ -0,0 +1,148 @@
+/**
+ * @file motor_shm_ring.h
+ * @brief Single-writer, multi-reader sample ring for shared memory.
+ *
+ * Fixed binary layout so a ring placed in a file-backed mapping by the
+ * firmware can be read by a separate host process (host/shm_reader). The
+ * writer never waits for readers: readers that fall behind lose the oldest
+ * samples and can tell how many.
+ *
+ * Each slot carries a sequence word. The writer clears it, writes the sample
+ * and then publishes the slot's position + 1; readers check the word before
+ * and after reading, so a slot overwritten mid-read is detected rather than
+ * returned torn. Samples can be read in place (motor_shm_reader_peek() and
+ * motor_shm_reader_commit()) or copied out (motor_shm_reader_next()).
+ *
+ * Uses the GCC/Clang __atomic builtins on naturally aligned 32-bit words, so
+ * the layout and the protocol are the same in the firmware and on the host.
+ */
+
+#ifndef MOTOR_SHM_RING_H_
+#define MOTOR_SHM_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** "MSRG" in a little-endian dump. */
+#define MOTOR_SHM_RING_MAGIC   0x4752534dU
+#define MOTOR_SHM_RING_VERSION 1U
+
+/**
+ * @brief One exported sample (24 bytes, little-endian on all supported hosts).
+ */
+struct motor_shm_sample {
+    uint32_t seq;             /**< app_state sample sequence number. */
+    uint32_t uptime_ms;       /**< Firmware uptime when the sample was taken. */
+    struct motor_state state; /**< State right after the feedback update. */
+};
+
+/**
+ * @brief Ring slot: sample guarded by a sequence word.
+ */
+struct motor_shm_slot {
+    uint32_t seq;                   /**< 0 while being written, else ring position + 1. */
+    uint32_t reserved;              /**< Keeps the sample 8-byte aligned. */
+    struct motor_shm_sample sample; /**< Payload. */
+};
+
+/**
+ * @brief Ring header, followed by `capacity` slots.
+ *
+ * The write position lives on its own 64-byte line so readers polling it do
+ * not share a line with the constant fields.
+ */
+struct motor_shm_ring {
+    uint32_t magic;         /**< MOTOR_SHM_RING_MAGIC. */
+    uint16_t version;       /**< MOTOR_SHM_RING_VERSION. */
+    uint16_t slot_size;     /**< sizeof(struct motor_shm_slot). */
+    uint32_t capacity;      /**< Number of slots, a power of two. */
+    uint32_t reserved0[13]; /**< Pads the header line to 64 bytes. */
+    uint32_t head;          /**< Samples written so far (wraps at 2^32). */
+    uint32_t reserved1[15]; /**< Pads the write position line to 64 bytes. */
+    struct motor_shm_slot slots[]; /**< Sample slots. */
+};
+
+/**
+ * @brief Reader cursor, private to each reader.
+ */
+struct motor_shm_reader {
+    const struct motor_shm_ring *ring; /**< Attached ring. */
+    uint32_t next;                     /**< Position of the next sample to read. */
+    uint32_t lost;                     /**< Samples overwritten before they were read. */
+};
+
+/**
+ * @brief Bytes needed for a ring of @p capacity slots.
+ */
+size_t motor_shm_ring_size(uint32_t capacity);
+
+/**
+ * @brief Format @p mem as an empty ring (writer side).
+ *
+ * @param mem      Memory to use, at least 8-byte aligned.
+ * @param size     Size of @p mem in bytes.
+ * @param capacity Number of slots, a non-zero power of two.
+ *
+ * @return The ring on success, NULL if @p capacity is not a power of two or
+ *         @p size is smaller than motor_shm_ring_size(@p capacity).
+ */
+struct motor_shm_ring *motor_shm_ring_init(void *mem, size_t size, uint32_t capacity);
+
+/**
+ * @brief Append one sample, overwriting the oldest one when full.
+ *
+ * Only one thread may write to a ring. Never blocks.
+ */
+void motor_shm_ring_write(struct motor_shm_ring *ring, const struct motor_shm_sample *sample);
+
+/**
+ * @brief Attach a reader to a ring in @p mem.
+ *
+ * The reader starts at the oldest sample still in the ring.
+ *
+ * @return 0 on success, -EINVAL if @p mem is too small for the header or the
+ *         slots it announces, or the magic, version or slot size do not match.
+ */
+int motor_shm_reader_attach(struct motor_shm_reader *rd, const void *mem, size_t size);
+
+/**
+ * @brief Point at the next unread sample without copying it.
+ *
+ * The sample may be overwritten while it is being read; only trust what was
+ * read if motor_shm_reader_commit() then returns 0. Skips (and counts in
+ * `lost`) samples the writer has already overwritten.
+ *
+ * @param rd  Reader.
+ * @param out Set to the sample inside the ring.
+ *
+ * @return 0 if a sample is available, -EAGAIN if the reader is up to date.
+ */
+int motor_shm_reader_peek(struct motor_shm_reader *rd, const struct motor_shm_sample **out);
+
+/**
+ * @brief Finish reading the sample returned by motor_shm_reader_peek().
+ *
+ * @return 0 if the sample was stable for the whole read (the reader moves on
+ *         to the next one), -ESTALE if the writer overwrote it meanwhile (the
+ *         reader stays put; the next peek skips past it).
+ */
+int motor_shm_reader_commit(struct motor_shm_reader *rd);
+
+/**
+ * @brief Copy out the next unread sample.
+ *
+ * @return 0 on success, -EAGAIN if the reader is up to date.
+ */
+int motor_shm_reader_next(struct motor_shm_reader *rd, struct motor_shm_sample *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_SHM_RING_H_ */
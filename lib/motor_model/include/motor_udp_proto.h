@@ -0,0 +1,136 @@
+/**
+ * @file motor_udp_proto.h
+ * @brief Binary datagram format of the UDP telemetry and command link.
+ *
+ * Every datagram starts with a 12-byte header, all fields little-endian:
+ *
+ * | Offset | Size | Field                                              |
+ * |--------|------|----------------------------------------------------|
+ * | 0      | 2    | magic 0x534d ("MS")                                |
+ * | 2      | 1    | version (1)                                        |
+ * | 3      | 1    | type (enum motor_udp_type)                         |
+ * | 4      | 4    | datagram sequence number, per sender and type      |
+ * | 8      | 2    | record count                                       |
+ * | 10     | 2    | reserved, 0                                        |
+ *
+ * followed by `count` records of the type's fixed size. Telemetry records are
+ * the 24-byte sample of the shell's hex `hist` frame: u32 seq, u32 uptime_ms
+ * and the four motor_state floats. A receiver detects lost datagrams from gaps
+ * in the datagram sequence and lost samples from gaps in the sample sequence.
+ *
+ * Plain C with explicit byte order, so the firmware and host tools share it.
+ */
+
+#ifndef MOTOR_UDP_PROTO_H_
+#define MOTOR_UDP_PROTO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "motor_model.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_UDP_MAGIC      0x534dU
+#define MOTOR_UDP_VERSION    1U
+#define MOTOR_UDP_HEADER_LEN 12U
+
+/** Telemetry record size. */
+#define MOTOR_UDP_SAMPLE_LEN 24U
+/** Setpoint record: u32 command id, f32 rpm. */
+#define MOTOR_UDP_SETPOINT_LEN 8U
+/** Ack record: u32 command id, i32 status (0 or negative errno), u32 uptime_ms. */
+#define MOTOR_UDP_ACK_LEN 12U
+
+/** Samples per telemetry datagram so it fits a 1500-byte MTU unfragmented. */
+#define MOTOR_UDP_MAX_SAMPLES 60U
+
+/** Largest datagram of the protocol. */
+#define MOTOR_UDP_MAX_LEN (MOTOR_UDP_HEADER_LEN + (MOTOR_UDP_MAX_SAMPLES * MOTOR_UDP_SAMPLE_LEN))
+
+/**
+ * @brief Datagram types.
+ */
+enum motor_udp_type {
+    MOTOR_UDP_TELEMETRY = 1, /**< Firmware to collector: batch of samples. */
+    MOTOR_UDP_SETPOINT = 2,  /**< Collector to firmware: setpoint command. */
+    MOTOR_UDP_ACK = 3,       /**< Firmware to command sender: result of a command. */
+};
+
+/**
+ * @brief One telemetry sample.
+ */
+struct motor_udp_sample {
+    uint32_t seq;             /**< Sample sequence number. */
+    uint32_t uptime_ms;       /**< Firmware uptime when the sample was taken. */
+    struct motor_state state; /**< State right after the feedback update. */
+};
+
+/**
+ * @brief A decoded datagram. Fields past `count` are valid for their type only.
+ */
+struct motor_udp_msg {
+    enum motor_udp_type type; /**< Datagram type. */
+    uint32_t seq;             /**< Datagram sequence number. */
+    uint16_t count;           /**< Records (telemetry samples; 1 otherwise). */
+    uint32_t cmd_id;          /**< SETPOINT and ACK: command id chosen by the sender. */
+    float rpm;                /**< SETPOINT: requested setpoint. */
+    int32_t status;           /**< ACK: 0 if accepted, else a negative errno. */
+    uint32_t uptime_ms;       /**< ACK: firmware uptime when the command was queued. */
+};
+
+/**
+ * @brief Length of a telemetry datagram with @p count samples.
+ */
+size_t motor_udp_telemetry_len(uint16_t count);
+
+/**
+ * @brief Write a datagram header at the start of @p buf.
+ */
+void motor_udp_put_header(uint8_t *buf, enum motor_udp_type type, uint32_t seq, uint16_t count);
+
+/**
+ * @brief Write telemetry sample number @p index of the datagram in @p buf.
+ *
+ * @p buf must hold motor_udp_telemetry_len(@p index + 1) bytes.
+ */
+void motor_udp_put_sample(uint8_t *buf, uint16_t index, const struct motor_udp_sample *s);
+
+/**
+ * @brief Read telemetry sample number @p index of a decoded datagram.
+ */
+void motor_udp_get_sample(const uint8_t *buf, uint16_t index, struct motor_udp_sample *out);
+
+/**
+ * @brief Encode a setpoint command into @p buf (MOTOR_UDP_MAX_LEN bytes).
+ *
+ * @return Datagram length.
+ */
+size_t motor_udp_encode_setpoint(uint8_t *buf, uint32_t seq, uint32_t cmd_id, float rpm);
+
+/**
+ * @brief Encode a command acknowledgement into @p buf (MOTOR_UDP_MAX_LEN bytes).
+ *
+ * @return Datagram length.
+ */
+size_t motor_udp_encode_ack(uint8_t *buf, uint32_t seq, uint32_t cmd_id, int32_t status,
+                            uint32_t uptime_ms);
+
+/**
+ * @brief Check and decode a received datagram.
+ *
+ * For telemetry only the header is decoded; read the samples with
+ * motor_udp_get_sample().
+ *
+ * @return 0 on success, -EINVAL if the magic, version or type is unknown, the
+ *         count is out of range or the length does not match the count.
+ */
+int motor_udp_decode(const uint8_t *buf, size_t len, struct motor_udp_msg *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_UDP_PROTO_H_ */
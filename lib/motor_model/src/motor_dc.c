@@ -0,0 +1,83 @@
+/**
+ * @file motor_dc.c
+ * @brief DC motor electrical model with an inner PI current loop.
+ */
+
+#include <errno.h>
+#include <math.h>
+
+#include "motor_dc.h"
+
+#define MOTOR_DC_RAD_S_TO_RPM (60.0f / (2.0f * 3.14159265f))
+
+int motor_dc_prepare(const struct motor_dc_params *params, float current_loop_hz,
+                     float speed_period_s, struct motor_dc_coeffs *out)
+{
+    if (!(current_loop_hz > 0.0f) || !(speed_period_s > 0.0f) ||
+        !(params->resistance_ohm > 0.0f) || !(params->inductance_h > 0.0f) ||
+        !(params->inertia_kg_m2 > 0.0f) || !(params->bus_voltage_v > 0.0f)) {
+        return -EINVAL;
+    }
+
+    float steps = roundf(speed_period_s * current_loop_hz);
+    if (steps < 1.0f) {
+        return -EINVAL;
+    }
+
+    float dt = 1.0f / current_loop_hz;
+
+    out->dt_over_l = dt / params->inductance_h;
+    out->resistance_ohm = params->resistance_ohm;
+    out->ke = params->ke_v_s_per_rad;
+    out->dt_kt_over_j = dt * params->kt_nm_per_a / params->inertia_kg_m2;
+    out->dt_b_over_j = dt * params->friction_nm_s / params->inertia_kg_m2;
+    out->dt_load_over_j = dt * params->load_nm / params->inertia_kg_m2;
+    out->kp = params->current_kp_v_per_a;
+    out->ki_dt = params->current_ki_v_per_as * dt;
+    out->bus_v = params->bus_voltage_v;
+    out->pct_to_a = params->max_current_a / 100.0f;
+    out->rad_s_to_rpm = MOTOR_DC_RAD_S_TO_RPM;
+    out->inner_steps = (uint32_t)steps;
+
+    return 0;
+}
+
+void motor_dc_current_step(const struct motor_dc_coeffs *c, struct motor_dc_state *s,
+                           float current_ref)
+{
+    float err = current_ref - s->current_a;
+
+    /* PI with the integrator clamped to the bus voltage (anti-windup). */
+    s->integ_v = fminf(fmaxf(s->integ_v + (c->ki_dt * err), -c->bus_v), c->bus_v);
+    s->voltage_v = fminf(fmaxf((c->kp * err) + s->integ_v, -c->bus_v), c->bus_v);
+
+    /* Winding: L di/dt = v - R i - ke w. */
+    s->current_a += c->dt_over_l *
+                    (s->voltage_v - (c->resistance_ohm * s->current_a) - (c->ke * s->omega_rad_s));
+
+    /* Rotor, with the updated current: J dw/dt = kt i - b w - load. */
+    float omega = s->omega_rad_s + (c->dt_kt_over_j * s->current_a) -
+                  (c->dt_b_over_j * s->omega_rad_s) - c->dt_load_over_j;
+    s->omega_rad_s = fmaxf(omega, 0.0f);
+}
+
+void motor_dc_plant_step(const struct motor_dc_coeffs *c, struct motor_dc_state *dc,
+                         struct motor_state *state)
+{
+    float current_ref = state->control_output_pct * c->pct_to_a;
+
+    for (uint32_t i = 0; i < c->inner_steps; i++) {
+        motor_dc_current_step(c, dc, current_ref);
+    }
+
+    state->measured_rpm = dc->omega_rad_s * c->rad_s_to_rpm;
+}
+
+void motor_dc_step(const struct motor_model_params *params, const struct motor_dc_coeffs *c,
+                   struct motor_dc_state *dc, struct motor_state *state, uint32_t step,
+                   uint32_t thermal_divider)
+{
+    motor_model_speed_control(params, state);
+    motor_dc_plant_step(c, dc, state);
+    motor_model_thermal_step(params, state, step, thermal_divider);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file motor_evlog.c
+ * @brief Binary event records with host-side text rendering.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "motor_evlog.h"
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void put_f32(uint8_t *p, float f)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+    put_le32(p, bits);
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static float get_f32(const uint8_t *p)
+{
+    uint32_t bits = get_le32(p);
+    float f;
+
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+void motor_evlog_encode(uint8_t *buf, const struct motor_evlog_record *rec)
+{
+    put_le32(&buf[0], rec->id);
+    put_le32(&buf[4], rec->seq);
+    put_le32(&buf[8], rec->uptime_ms);
+    put_f32(&buf[12], rec->state.setpoint_rpm);
+    put_f32(&buf[16], rec->state.measured_rpm);
+    put_f32(&buf[20], rec->state.control_output_pct);
+    put_f32(&buf[24], rec->state.temperature_c);
+}
+
+int motor_evlog_decode(const uint8_t *buf, size_t len, struct motor_evlog_record *out)
+{
+    const char *module;
+
+    if ((len != MOTOR_EVLOG_RECORD_LEN) || (motor_evlog_level(get_le32(&buf[0]), &module) == 0)) {
+        return -EINVAL;
+    }
+
+    out->id = get_le32(&buf[0]);
+    out->seq = get_le32(&buf[4]);
+    out->uptime_ms = get_le32(&buf[8]);
+    out->state.setpoint_rpm = get_f32(&buf[12]);
+    out->state.measured_rpm = get_f32(&buf[16]);
+    out->state.control_output_pct = get_f32(&buf[20]);
+    out->state.temperature_c = get_f32(&buf[24]);
+
+    return 0;
+}
+
+enum motor_evlog_level motor_evlog_level(uint32_t id, const char **module)
+{
+    switch (id) {
+        case MOTOR_EVLOG_TELEMETRY:
+            *module = "telemetry";
+            return MOTOR_EVLOG_LEVEL_INF;
+        case MOTOR_EVLOG_FAULT_SPEED:
+        case MOTOR_EVLOG_FAULT_TEMP_SOFT:
+            *module = "fault_monitor";
+            return MOTOR_EVLOG_LEVEL_WRN;
+        case MOTOR_EVLOG_FAULT_TEMP_HARD:
+            *module = "fault_monitor";
+            return MOTOR_EVLOG_LEVEL_ERR;
+        default:
+            *module = "?";
+            return (enum motor_evlog_level)0;
+    }
+}
+
+int motor_evlog_format(const struct motor_evlog_record *rec, char *buf, size_t size)
+{
+    const struct motor_state *s = &rec->state;
+    float diff = s->setpoint_rpm - s->measured_rpm;
+
+    switch (rec->id) {
+        case MOTOR_EVLOG_TELEMETRY:
+            return snprintf(buf, size, "T[telemetry] SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C",
+                            (int)s->setpoint_rpm, (int)s->measured_rpm,
+                            (int)s->control_output_pct, (int)s->temperature_c);
+        case MOTOR_EVLOG_FAULT_SPEED:
+            return snprintf(buf, size, "Fault(speed): |SP-MEAS|=%d rpm (OUT=%d%%, T=%d C)",
+                            (int)((diff < 0.0f) ? -diff : diff), (int)s->control_output_pct,
+                            (int)s->temperature_c);
+        case MOTOR_EVLOG_FAULT_TEMP_HARD:
+            return snprintf(buf, size, "Fault(temp hard): T=%d C (OUT=%d%%, SP=%d rpm)",
+                            (int)s->temperature_c, (int)s->control_output_pct,
+                            (int)s->setpoint_rpm);
+        case MOTOR_EVLOG_FAULT_TEMP_SOFT:
+            return snprintf(buf, size, "Fault(temp soft): T=%d C (OUT=%d%%, SP=%d rpm)",
+                            (int)s->temperature_c, (int)s->control_output_pct,
+                            (int)s->setpoint_rpm);
+        default:
+            return -EINVAL;
+    }
+}
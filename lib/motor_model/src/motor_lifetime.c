@@ -0,0 +1,81 @@
+/**
+ * @file motor_lifetime.c
+ * @brief Incremental lifetime statistics of a motor.
+ */
+
+#include "motor_lifetime.h"
+
+/*
+ * Bin of @p value in bins from @p base, the outer bins take the rest. Takes
+ * the inverse of the bin width: a constant multiply instead of a division.
+ */
+static uint32_t motor_lifetime_bin(float value, float base, float inv_width, uint32_t bins)
+{
+    float pos = (value - base) * inv_width;
+
+    if (!(pos > 0.0f)) {
+        return 0U;
+    }
+    if (pos >= (float)bins) {
+        return bins - 1U;
+    }
+
+    return (uint32_t)pos;
+}
+
+void motor_lifetime_reset(struct motor_lifetime *lt)
+{
+    *lt = (struct motor_lifetime){0};
+}
+
+enum motor_lifetime_band motor_lifetime_band(const struct motor_model_params *params,
+                                             float temperature_c)
+{
+    if (temperature_c > params->hard_limit_temp_c) {
+        return MOTOR_LIFETIME_BAND_HARD;
+    }
+    if (temperature_c > params->soft_limit_temp_c) {
+        return MOTOR_LIFETIME_BAND_SOFT;
+    }
+
+    return MOTOR_LIFETIME_BAND_NORMAL;
+}
+
+void motor_lifetime_update(const struct motor_model_params *params, struct motor_lifetime *lt,
+                           const struct motor_state *state, float power_w, uint32_t period_ms)
+{
+    enum motor_lifetime_band band = motor_lifetime_band(params, state->temperature_c);
+    float out = state->control_output_pct;
+
+    if ((lt->periods > 0U) && (state->setpoint_rpm != lt->last_setpoint_rpm)) {
+        lt->setpoint_changes++;
+    }
+    lt->last_setpoint_rpm = state->setpoint_rpm;
+    lt->periods++;
+    lt->band_periods[band]++;
+
+    /* The output limits run after the thermal update, so the cap is the one of this band. */
+    if (out >= 100.0f) {
+        lt->saturated_periods++;
+    } else if (((band == MOTOR_LIFETIME_BAND_SOFT) && (out >= params->soft_limit_output_pct)) ||
+               ((band == MOTOR_LIFETIME_BAND_HARD) && (out >= params->hard_limit_output_pct))) {
+        lt->derated_periods++;
+    }
+
+    /*
+     * W x ms = mJ: integer accumulation does not lose resolution as the total
+     * grows. The fraction of a millijoule is carried to the next period, so
+     * powers below 1 mJ per period still add up.
+     */
+    float energy_mj = (power_w * (float)period_ms) + lt->energy_frac_mj;
+    int64_t whole_mj = (int64_t)energy_mj;
+
+    lt->energy_mj += whole_mj;
+    lt->energy_frac_mj = energy_mj - (float)whole_mj;
+
+    lt->temp_hist[motor_lifetime_bin(state->temperature_c, MOTOR_LIFETIME_TEMP_BIN_BASE_C,
+                                     1.0f / MOTOR_LIFETIME_TEMP_BIN_WIDTH_C,
+                                     MOTOR_LIFETIME_TEMP_BINS)]++;
+    lt->out_hist[motor_lifetime_bin(out, 0.0f, 1.0f / MOTOR_LIFETIME_OUT_BIN_WIDTH_PCT,
+                                    MOTOR_LIFETIME_OUT_BINS)]++;
+}
@@ -0,0 +1,353 @@
+/**
+ * @file motor_model.c
+ * @brief Portable motor/temperature model and fault evaluation.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include "motor_model.h"
+
+void motor_model_speed_control(const struct motor_model_params *params, struct motor_state *state)
+{
+    /* Simple proportional control based on speed error. */
+    float error = state->setpoint_rpm - state->measured_rpm;
+
+    float step_pct = (error / params->max_rpm) * params->kp_percent;
+    state->control_output_pct += step_pct;
+
+    if (state->control_output_pct < 0.0f) {
+        state->control_output_pct = 0.0f;
+    } else if (state->control_output_pct > 100.0f) {
+        state->control_output_pct = 100.0f;
+    }
+}
+
+/* First order motor model: measured_rpm moves towards target_rpm. */
+void motor_model_first_order_plant(const struct motor_model_params *params,
+                                   struct motor_state *state)
+{
+    float target_rpm = (state->control_output_pct / 100.0f) * params->max_rpm;
+    state->measured_rpm += (target_rpm - state->measured_rpm) * params->speed_filter_alpha;
+}
+
+/* Heating per control period at the current speed (°C). */
+static float motor_model_heating(const struct motor_model_params *params,
+                                 const struct motor_state *state)
+{
+    /* Temperature normalization model */
+    float speed_norm = state->measured_rpm / params->temp_norm_rpm;
+    if (speed_norm < 0.0f) {
+        speed_norm = -speed_norm;
+    }
+    if (speed_norm > 1.0f) {
+        speed_norm = 1.0f;
+    }
+
+    return params->heat_gain * speed_norm * speed_norm;
+}
+
+static void motor_model_temp_clamp(const struct motor_model_params *params,
+                                   struct motor_state *state)
+{
+    if (state->temperature_c < params->ambient_temp_c) {
+        state->temperature_c = params->ambient_temp_c;
+    }
+    if (state->temperature_c > params->max_temp_c) {
+        state->temperature_c = params->max_temp_c;
+    }
+}
+
+/*
+ * Advance the temperature by `periods` control periods at the current speed.
+ *
+ * One period is T' = T + h - c * (T - ambient). Composed n times with h held
+ * constant this is T_n = T_eq + (T - T_eq) * (1 - c)^n with
+ * T_eq = ambient + h / c, which the n > 1 path evaluates directly.
+ */
+static void motor_model_thermal_update(const struct motor_model_params *params,
+                                       struct motor_state *state, uint32_t periods)
+{
+    float heating = motor_model_heating(params, state);
+
+    if (periods <= 1U) {
+        float cooling = params->cool_gain * (state->temperature_c - params->ambient_temp_c);
+        state->temperature_c += (heating - cooling);
+    } else if (params->cool_gain > 0.0f) {
+        float t_eq = params->ambient_temp_c + (heating / params->cool_gain);
+        float decay = powf(1.0f - params->cool_gain, (float)periods);
+        state->temperature_c = t_eq + (state->temperature_c - t_eq) * decay;
+    } else {
+        state->temperature_c += heating * (float)periods;
+    }
+
+    motor_model_temp_clamp(params, state);
+}
+
+/* Temperature-based saturation (safety), actual fault reporting is separate. */
+static void motor_model_output_limits(const struct motor_model_params *params,
+                                      struct motor_state *state)
+{
+    if ((state->temperature_c > params->soft_limit_temp_c) &&
+        (state->control_output_pct > params->soft_limit_output_pct)) {
+        state->control_output_pct = params->soft_limit_output_pct;
+    }
+
+    if ((state->temperature_c > params->hard_limit_temp_c) &&
+        (state->control_output_pct > params->hard_limit_output_pct)) {
+        state->control_output_pct = params->hard_limit_output_pct;
+    }
+}
+
+void motor_model_thermal_step(const struct motor_model_params *params, struct motor_state *state,
+                              uint32_t step, uint32_t thermal_divider)
+{
+    if ((thermal_divider <= 1U) || ((step % thermal_divider) == 0U)) {
+        motor_model_thermal_update(params, state, thermal_divider);
+    }
+
+    motor_model_output_limits(params, state);
+}
+
+void motor_model_step(const struct motor_model_params *params, struct motor_state *state)
+{
+    motor_model_speed_control(params, state);
+    motor_model_first_order_plant(params, state);
+    motor_model_thermal_update(params, state, 1U);
+    motor_model_output_limits(params, state);
+}
+
+void motor_model_step_multirate(const struct motor_model_params *params, struct motor_state *state,
+                                uint32_t step, uint32_t thermal_divider)
+{
+    motor_model_speed_control(params, state);
+    motor_model_first_order_plant(params, state);
+    motor_model_thermal_step(params, state, step, thermal_divider);
+}
+
+/*
+ * Per-period tuning seen as a sampled continuous-time system, period P, and
+ * resampled at dt = n P.
+ *
+ * Speed and temperature are first-order lags: their decay over n periods is
+ * (1 - alpha)^n and (1 - cool_gain)^n.
+ *
+ * The speed loop, in deviations (du, dy) from the equilibrium
+ * u = 100 * sp / max_rpm, y = sp, is linear between output clamps:
+ * (du, dy)' = M (du, dy) with
+ *
+ *   M = [ 1      -k             ]    k = kp / max_rpm, g = max_rpm / 100
+ *       [ a g    1 - a - a g k  ]
+ *
+ * so one step of n periods is M^n, also for fractional n. With eigenvalues
+ * z1, z2 of M, M^n = (z1^n - b z1) I + b M with b = (z1^n - z2^n) / (z1 - z2);
+ * for a complex pair r e^(+/- i theta), b = r^(n-1) sin(n theta) / sin(theta).
+ */
+static int motor_model_loop_power(const double m[2][2], double n, double out[2][2])
+{
+    double half_tr = 0.5 * (m[0][0] + m[1][1]);
+    double det = (m[0][0] * m[1][1]) - (m[0][1] * m[1][0]);
+    double disc = (half_tr * half_tr) - det;
+    double a_n;
+    double b_n;
+
+    if (disc < 0.0) {
+        double r = sqrt(det);
+        double theta = acos(half_tr / r);
+
+        b_n = pow(r, n - 1.0) * sin(n * theta) / sin(theta);
+        a_n = (pow(r, n) * cos(n * theta)) - (b_n * half_tr);
+    } else {
+        double z1 = half_tr + sqrt(disc);
+        double z2 = half_tr - sqrt(disc);
+
+        if (!(z2 > 0.0)) {
+            /* Negative eigenvalues: the tuning oscillates every period, no real M^n. */
+            return -EINVAL;
+        }
+        b_n = (disc > 0.0) ? ((pow(z1, n) - pow(z2, n)) / (z1 - z2)) : (n * pow(z1, n - 1.0));
+        a_n = pow(z1, n) - (b_n * z1);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            out[i][j] = (b_n * m[i][j]) + ((i == j) ? a_n : 0.0);
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Weight of the start-of-step heating. The per-period model adds the heating
+ * H_k at the end of each period k = 1..n, decayed by q^(n - k) with
+ * q = 1 - cool_gain. Over a long step only the heating at both ends is known,
+ * so H_k is interpolated between them along the speed loop envelope
+ * rho^k, rho = sqrt(1 - alpha), and the sum is folded into a single held
+ * heating H_n + w (H_0 - H_n). At n = 1 this gives w = 0, the per-period model.
+ */
+static double motor_model_heat_weight(double alpha, double cool_gain, double n)
+{
+    double q = 1.0 - cool_gain;
+    double rho = sqrt(1.0 - alpha);
+    double rho_n = pow(rho, n);
+    double q_n = pow(q, n);
+    /* sum_{k=1..n} rho^k q^(n-k) */
+    double sum = (fabs(rho - q) > 1e-9) ? (rho * (rho_n - q_n) / (rho - q)) : (n * rho_n);
+
+    return ((cool_gain * sum) - (rho_n * (1.0 - q_n))) / ((1.0 - rho_n) * (1.0 - q_n));
+}
+
+static void motor_model_stage_prepare(const struct motor_model_params *params, double n,
+                                      struct motor_model_stage_coeffs *out)
+{
+    double k = (double)params->kp_percent / (double)params->max_rpm;
+
+    out->ki_dt = (float)(k * n);
+    out->plant_decay = (float)pow(1.0 - (double)params->speed_filter_alpha, n);
+    out->thermal_decay = (float)pow(1.0 - (double)params->cool_gain, n);
+    out->heat_weight =
+        (float)motor_model_heat_weight(params->speed_filter_alpha, params->cool_gain, n);
+}
+
+int motor_model_disc_prepare(const struct motor_model_params *params, float period_s,
+                             enum motor_model_disc method, float dt_s,
+                             struct motor_model_disc_coeffs *out)
+{
+    if (!(period_s > 0.0f) || !(dt_s > 0.0f) || !(params->max_rpm > 0.0f) ||
+        !(params->speed_filter_alpha > 0.0f) || !(params->speed_filter_alpha < 1.0f) ||
+        !(params->cool_gain > 0.0f) || !(params->cool_gain < 1.0f) ||
+        ((method != MOTOR_MODEL_DISC_EXP) && (method != MOTOR_MODEL_DISC_ZOH))) {
+        return -EINVAL;
+    }
+
+    double n = (double)dt_s / (double)period_s;
+    double a = params->speed_filter_alpha;
+    double g = (double)params->max_rpm / 100.0;
+    double k = (double)params->kp_percent / (double)params->max_rpm;
+    const double m[2][2] = {{1.0, -k}, {a * g, 1.0 - a - (a * g * k)}};
+    double phi[2][2];
+
+    if (motor_model_loop_power(m, n, phi) != 0) {
+        return -EINVAL;
+    }
+
+    double substeps = ceil(n);
+
+    out->method = method;
+    motor_model_stage_prepare(params, n, &out->step);
+    motor_model_stage_prepare(params, n / substeps, &out->sub);
+    out->substeps = (uint32_t)substeps;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            out->phi[i][j] = (float)phi[i][j];
+        }
+    }
+    out->rpm_to_pct = (float)(1.0 / g);
+
+    return 0;
+}
+
+/* Thermal: exact first-order response to the heating interpolated over the step. */
+static void motor_model_thermal_decay(const struct motor_model_params *params,
+                                      const struct motor_model_stage_coeffs *c, float heat_start,
+                                      struct motor_state *state)
+{
+    float heat_end = motor_model_heating(params, state);
+    float heating = heat_end + (c->heat_weight * (heat_start - heat_end));
+    float t_eq = params->ambient_temp_c + (heating / params->cool_gain);
+
+    state->temperature_c = t_eq + ((state->temperature_c - t_eq) * c->thermal_decay);
+    motor_model_temp_clamp(params, state);
+}
+
+/*
+ * One step with each stage advanced on its own: the integrator is exact for
+ * the held error and the plant for the held output.
+ */
+static void motor_model_stage_step(const struct motor_model_params *params,
+                                   const struct motor_model_stage_coeffs *c,
+                                   struct motor_state *state)
+{
+    float heat_start = motor_model_heating(params, state);
+    float error = state->setpoint_rpm - state->measured_rpm;
+
+    state->control_output_pct += c->ki_dt * error;
+    state->control_output_pct = fminf(fmaxf(state->control_output_pct, 0.0f), 100.0f);
+
+    float target_rpm = (state->control_output_pct / 100.0f) * params->max_rpm;
+    state->measured_rpm = target_rpm + ((state->measured_rpm - target_rpm) * c->plant_decay);
+
+    motor_model_thermal_decay(params, c, heat_start, state);
+    motor_model_output_limits(params, state);
+}
+
+/*
+ * One step with the exact solution of the linear speed loop. Fails, leaving the
+ * state untouched, when the loop is not linear over the step: the output would
+ * leave 0..100, or the temperature is above the soft limit at either end so
+ * the output limits may cut in during the step.
+ */
+static bool motor_model_zoh_step(const struct motor_model_params *params,
+                                 const struct motor_model_disc_coeffs *c,
+                                 struct motor_state *state)
+{
+    struct motor_state next = *state;
+    float u_eq = state->setpoint_rpm * c->rpm_to_pct;
+    float du = state->control_output_pct - u_eq;
+    float dy = state->measured_rpm - state->setpoint_rpm;
+
+    next.control_output_pct = u_eq + (c->phi[0][0] * du) + (c->phi[0][1] * dy);
+    next.measured_rpm = state->setpoint_rpm + (c->phi[1][0] * du) + (c->phi[1][1] * dy);
+    if ((next.control_output_pct < 0.0f) || (next.control_output_pct > 100.0f)) {
+        return false;
+    }
+
+    motor_model_thermal_decay(params, &c->step, motor_model_heating(params, state), &next);
+    if ((state->temperature_c > params->soft_limit_temp_c) ||
+        (next.temperature_c > params->soft_limit_temp_c)) {
+        return false;
+    }
+
+    *state = next;
+    return true;
+}
+
+void motor_model_step_dt(const struct motor_model_params *params,
+                         const struct motor_model_disc_coeffs *c, struct motor_state *state)
+{
+    if (c->method == MOTOR_MODEL_DISC_EXP) {
+        motor_model_stage_step(params, &c->step, state);
+        return;
+    }
+
+    if (!motor_model_zoh_step(params, c, state)) {
+        for (uint32_t i = 0; i < c->substeps; i++) {
+            motor_model_stage_step(params, &c->sub, state);
+        }
+    }
+}
+
+uint32_t motor_model_fault_eval(const struct motor_state *state, float speed_err_th_rpm,
+                                float soft_temp_c, float hard_temp_c)
+{
+    uint32_t flags = FAULT_NONE;
+
+    float speed_diff = state->setpoint_rpm - state->measured_rpm;
+    if (speed_diff < 0.0f) {
+        speed_diff = -speed_diff;
+    }
+
+    if (speed_diff > speed_err_th_rpm) {
+        flags |= FAULT_SPEED_ERROR;
+    }
+
+    if (state->temperature_c > hard_temp_c) {
+        flags |= FAULT_TEMP_HARD;
+    } else if (state->temperature_c > soft_temp_c) {
+        flags |= FAULT_TEMP_SOFT;
+    }
+
+    return flags;
+}
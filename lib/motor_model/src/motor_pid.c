@@ -0,0 +1,213 @@
+/**
+ * @file motor_pid.c
+ * @brief Speed PID controller with runtime gains and a relay auto-tuner.
+ */
+
+#include <errno.h>
+#include <math.h>
+
+#include "motor_pid.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Shortest dead time used for the gains: the output is held over a period. */
+#define MOTOR_PID_MIN_DEAD_TIME 0.5f
+
+void motor_pid_reset(struct motor_pid_state *pid)
+{
+    *pid = (struct motor_pid_state){0};
+}
+
+/*
+ * Velocity form, on the output applied in the previous period:
+ *
+ *   du = ki e + kp (e - e1) - kd (y - 2 y1 + y2)     (all / max_rpm)
+ *
+ * Terms with a zero gain are skipped, so with kp = kd = 0 du is computed
+ * exactly as the legacy (e / max_rpm) * kp_percent.
+ */
+void motor_pid_speed_control(const struct motor_model_params *params,
+                             const struct motor_pid_gains *gains, struct motor_pid_state *pid,
+                             struct motor_state *state)
+{
+    float error = state->setpoint_rpm - state->measured_rpm;
+
+    if (pid->primed == 0U) {
+        pid->prev_error_rpm = error;
+        pid->prev_rpm[0] = state->measured_rpm;
+        pid->prev_rpm[1] = state->measured_rpm;
+        pid->primed = 1U;
+    }
+
+    float step_pct = (error / params->max_rpm) * gains->ki_pct;
+
+    if (gains->kp_pct != 0.0f) {
+        step_pct += ((error - pid->prev_error_rpm) / params->max_rpm) * gains->kp_pct;
+    }
+    if (gains->kd_pct != 0.0f) {
+        float curvature = state->measured_rpm - (2.0f * pid->prev_rpm[0]) + pid->prev_rpm[1];
+
+        step_pct -= (curvature / params->max_rpm) * gains->kd_pct;
+    }
+
+    pid->prev_error_rpm = error;
+    pid->prev_rpm[1] = pid->prev_rpm[0];
+    pid->prev_rpm[0] = state->measured_rpm;
+
+    state->control_output_pct += step_pct;
+
+    if (state->control_output_pct < 0.0f) {
+        state->control_output_pct = 0.0f;
+    } else if (state->control_output_pct > 100.0f) {
+        state->control_output_pct = 100.0f;
+    }
+}
+
+int motor_pid_tune_start(struct motor_pid_tuner *t, const struct motor_pid_tune_config *cfg,
+                         const struct motor_state *state)
+{
+    float bias = state->control_output_pct;
+
+    if (!(cfg->amplitude_pct > 0.0f) || (cfg->amplitude_pct > 100.0f) ||
+        !(cfg->hysteresis_rpm >= 0.0f) || (cfg->cycles == 0U) || (cfg->max_periods == 0U) ||
+        !(bias > 0.0f) || !(bias < 100.0f)) {
+        return -EINVAL;
+    }
+
+    *t = (struct motor_pid_tuner){
+        .status = MOTOR_PID_TUNE_RUNNING,
+        .cfg = *cfg,
+        .setpoint_rpm = state->setpoint_rpm,
+        .bias_pct = bias,
+        .relay_pct = fminf(cfg->amplitude_pct, fminf(bias, 100.0f - bias)),
+        .high = 1U,
+        .peak_max_rpm = state->measured_rpm,
+        .peak_min_rpm = state->measured_rpm,
+    };
+
+    return 0;
+}
+
+/*
+ * Describing function analysis of the limit cycle, period Tu and amplitude a,
+ * of a relay of swing d and hysteresis h around a plant K e^(-L s) / (1 + T s):
+ *
+ *   |G(j w)| = pi a / (4 d),   arg G(j w) = -pi + asin(h / a),   w = 2 pi / Tu
+ *
+ * K comes from the mean speed and output over the cycles, T from the
+ * magnitude and L from the phase.
+ */
+static int motor_pid_identify(struct motor_pid_tuner *t)
+{
+    float n = (float)t->cycles;
+    float a = t->amp_sum / n;
+    float tu = t->period_sum / n;
+
+    if (!(t->pct_sum > 0.0f) || !(a > 0.0f)) {
+        return -EINVAL;
+    }
+
+    double k = (double)t->rpm_sum / (double)t->pct_sum;
+    double ratio = k / ((M_PI * a) / (4.0 * t->relay_pct));
+
+    /* A first-order lag attenuates: a gain above K is no such plant. */
+    if (!(ratio > 1.0)) {
+        return -EINVAL;
+    }
+
+    double w = 2.0 * M_PI / tu;
+    double tc = sqrt((ratio * ratio) - 1.0) / w;
+    double phase = M_PI - asin(fmin(t->cfg.hysteresis_rpm / a, 1.0)) - atan(w * tc);
+
+    t->ident = (struct motor_pid_ident){
+        .gain_rpm_per_pct = (float)k,
+        .time_constant = (float)tc,
+        .dead_time = (float)(phase / w),
+        .cycle_periods = tu,
+        .cycle_amp_rpm = a,
+    };
+
+    return 0;
+}
+
+void motor_pid_gains_from_ident(const struct motor_model_params *params,
+                                const struct motor_pid_ident *ident, struct motor_pid_gains *out)
+{
+    float dead_time = fmaxf(ident->dead_time, MOTOR_PID_MIN_DEAD_TIME);
+    /* SIMC, closed-loop time constant = dead time. */
+    float kc = ident->time_constant / (ident->gain_rpm_per_pct * 2.0f * dead_time);
+    float ti = fminf(ident->time_constant, 8.0f * dead_time);
+
+    *out = (struct motor_pid_gains){
+        .kp_pct = kc * params->max_rpm,
+        .ki_pct = (kc / ti) * params->max_rpm,
+        .kd_pct = 0.0f,
+    };
+}
+
+/* A switch to high closes a cycle: keep it, unless it is the first (start transient). */
+static void motor_pid_tune_cycle(struct motor_pid_tuner *t)
+{
+    if (t->up_switches >= 2U) {
+        t->amp_sum += 0.5f * (t->peak_max_rpm - t->peak_min_rpm);
+        t->period_sum += (float)(t->periods - t->last_up);
+        t->rpm_sum += t->cycle_rpm_sum;
+        t->pct_sum += t->cycle_pct_sum;
+        t->cycles++;
+    }
+
+    t->up_switches++;
+    t->last_up = t->periods;
+    t->peak_max_rpm = -INFINITY;
+    t->peak_min_rpm = INFINITY;
+    t->cycle_rpm_sum = 0.0f;
+    t->cycle_pct_sum = 0.0f;
+}
+
+enum motor_pid_tune_status motor_pid_tune_step(struct motor_pid_tuner *t,
+                                               const struct motor_model_params *params,
+                                               struct motor_state *state)
+{
+    if (t->status != MOTOR_PID_TUNE_RUNNING) {
+        return t->status;
+    }
+
+    float error = t->setpoint_rpm - state->measured_rpm;
+
+    /* The speed seen now is the response to the previous period's output. */
+    t->peak_max_rpm = fmaxf(t->peak_max_rpm, state->measured_rpm);
+    t->peak_min_rpm = fminf(t->peak_min_rpm, state->measured_rpm);
+    t->cycle_rpm_sum += state->measured_rpm;
+
+    if ((t->high != 0U) && (error < -t->cfg.hysteresis_rpm)) {
+        t->high = 0U;
+    } else if ((t->high == 0U) && (error > t->cfg.hysteresis_rpm)) {
+        t->high = 1U;
+        motor_pid_tune_cycle(t);
+    }
+
+    t->periods++;
+
+    if (t->cycles >= t->cfg.cycles) {
+        if (motor_pid_identify(t) == 0) {
+            motor_pid_gains_from_ident(params, &t->ident, &t->gains);
+            t->status = MOTOR_PID_TUNE_DONE;
+        } else {
+            t->status = MOTOR_PID_TUNE_FAILED;
+        }
+    } else if (t->periods >= t->cfg.max_periods) {
+        t->status = MOTOR_PID_TUNE_FAILED;
+    }
+
+    if (t->status != MOTOR_PID_TUNE_RUNNING) {
+        state->control_output_pct = t->bias_pct;
+        return t->status;
+    }
+
+    state->control_output_pct = t->bias_pct + ((t->high != 0U) ? t->relay_pct : -t->relay_pct);
+    t->cycle_pct_sum += state->control_output_pct;
+
+    return t->status;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file motor_shm_ring.c
+ * @brief Single-writer, multi-reader sample ring for shared memory.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "motor_shm_ring.h"
+
+size_t motor_shm_ring_size(uint32_t capacity)
+{
+    return sizeof(struct motor_shm_ring) + ((size_t)capacity * sizeof(struct motor_shm_slot));
+}
+
+struct motor_shm_ring *motor_shm_ring_init(void *mem, size_t size, uint32_t capacity)
+{
+    if ((capacity == 0U) || ((capacity & (capacity - 1U)) != 0U) ||
+        (size < motor_shm_ring_size(capacity))) {
+        return NULL;
+    }
+
+    struct motor_shm_ring *ring = mem;
+
+    memset(ring, 0, motor_shm_ring_size(capacity));
+    ring->version = MOTOR_SHM_RING_VERSION;
+    ring->slot_size = (uint16_t)sizeof(struct motor_shm_slot);
+    ring->capacity = capacity;
+
+    /* Magic last: a reader that sees it also sees a complete header. */
+    __atomic_store_n(&ring->magic, MOTOR_SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+    return ring;
+}
+
+void motor_shm_ring_write(struct motor_shm_ring *ring, const struct motor_shm_sample *sample)
+{
+    uint32_t pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    struct motor_shm_slot *slot = &ring->slots[pos & (ring->capacity - 1U)];
+
+    /* Seqlock write: invalidate, then the payload, then publish. */
+    __atomic_store_n(&slot->seq, 0U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->sample = *sample;
+    __atomic_store_n(&slot->seq, pos + 1U, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, pos + 1U, __ATOMIC_RELEASE);
+}
+
+int motor_shm_reader_attach(struct motor_shm_reader *rd, const void *mem, size_t size)
+{
+    const struct motor_shm_ring *ring = mem;
+
+    if ((size < sizeof(*ring)) ||
+        (__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != MOTOR_SHM_RING_MAGIC) ||
+        (ring->version != MOTOR_SHM_RING_VERSION) ||
+        (ring->slot_size != sizeof(struct motor_shm_slot)) ||
+        (size < motor_shm_ring_size(ring->capacity))) {
+        return -EINVAL;
+    }
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    rd->ring = ring;
+    rd->next = (head > ring->capacity) ? (head - ring->capacity) : 0U;
+    rd->lost = 0U;
+
+    return 0;
+}
+
+int motor_shm_reader_peek(struct motor_shm_reader *rd, const struct motor_shm_sample **out)
+{
+    const struct motor_shm_ring *ring = rd->ring;
+
+    for (;;) {
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        uint32_t behind = head - rd->next;
+
+        if (behind == 0U) {
+            return -EAGAIN;
+        }
+        if (behind > ring->capacity) {
+            /* Lapped: the oldest unread samples are gone. */
+            rd->lost += behind - ring->capacity;
+            rd->next = head - ring->capacity;
+        }
+
+        const struct motor_shm_slot *slot = &ring->slots[rd->next & (ring->capacity - 1U)];
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == (rd->next + 1U)) {
+            *out = &slot->sample;
+            return 0;
+        }
+
+        /* Being rewritten for a later lap: count it and re-read the head. */
+        rd->lost++;
+        rd->next++;
+    }
+}
+
+int motor_shm_reader_commit(struct motor_shm_reader *rd)
+{
+    const struct motor_shm_slot *slot = &rd->ring->slots[rd->next & (rd->ring->capacity - 1U)];
+
+    /* Order the payload reads before the re-check of the sequence word. */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != (rd->next + 1U)) {
+        return -ESTALE;
+    }
+
+    rd->next++;
+    return 0;
+}
+
+int motor_shm_reader_next(struct motor_shm_reader *rd, struct motor_shm_sample *out)
+{
+    const struct motor_shm_sample *sample;
+    int ret;
+
+    do {
+        ret = motor_shm_reader_peek(rd, &sample);
+        if (ret != 0) {
+            return ret;
+        }
+        *out = *sample;
+    } while (motor_shm_reader_commit(rd) != 0);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file motor_udp_proto.c
+ * @brief Binary datagram format of the UDP telemetry and command link.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "motor_udp_proto.h"
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void put_f32(uint8_t *p, float f)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+    put_le32(p, bits);
+}
+
+static uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static float get_f32(const uint8_t *p)
+{
+    uint32_t bits = get_le32(p);
+    float f;
+
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+size_t motor_udp_telemetry_len(uint16_t count)
+{
+    return MOTOR_UDP_HEADER_LEN + ((size_t)count * MOTOR_UDP_SAMPLE_LEN);
+}
+
+void motor_udp_put_header(uint8_t *buf, enum motor_udp_type type, uint32_t seq, uint16_t count)
+{
+    put_le16(&buf[0], MOTOR_UDP_MAGIC);
+    buf[2] = MOTOR_UDP_VERSION;
+    buf[3] = (uint8_t)type;
+    put_le32(&buf[4], seq);
+    put_le16(&buf[8], count);
+    put_le16(&buf[10], 0U);
+}
+
+void motor_udp_put_sample(uint8_t *buf, uint16_t index, const struct motor_udp_sample *s)
+{
+    uint8_t *p = &buf[motor_udp_telemetry_len(index)];
+
+    put_le32(&p[0], s->seq);
+    put_le32(&p[4], s->uptime_ms);
+    put_f32(&p[8], s->state.setpoint_rpm);
+    put_f32(&p[12], s->state.measured_rpm);
+    put_f32(&p[16], s->state.control_output_pct);
+    put_f32(&p[20], s->state.temperature_c);
+}
+
+void motor_udp_get_sample(const uint8_t *buf, uint16_t index, struct motor_udp_sample *out)
+{
+    const uint8_t *p = &buf[motor_udp_telemetry_len(index)];
+
+    out->seq = get_le32(&p[0]);
+    out->uptime_ms = get_le32(&p[4]);
+    out->state.setpoint_rpm = get_f32(&p[8]);
+    out->state.measured_rpm = get_f32(&p[12]);
+    out->state.control_output_pct = get_f32(&p[16]);
+    out->state.temperature_c = get_f32(&p[20]);
+}
+
+size_t motor_udp_encode_setpoint(uint8_t *buf, uint32_t seq, uint32_t cmd_id, float rpm)
+{
+    motor_udp_put_header(buf, MOTOR_UDP_SETPOINT, seq, 1U);
+    put_le32(&buf[MOTOR_UDP_HEADER_LEN], cmd_id);
+    put_f32(&buf[MOTOR_UDP_HEADER_LEN + 4U], rpm);
+
+    return MOTOR_UDP_HEADER_LEN + MOTOR_UDP_SETPOINT_LEN;
+}
+
+size_t motor_udp_encode_ack(uint8_t *buf, uint32_t seq, uint32_t cmd_id, int32_t status,
+                            uint32_t uptime_ms)
+{
+    motor_udp_put_header(buf, MOTOR_UDP_ACK, seq, 1U);
+    put_le32(&buf[MOTOR_UDP_HEADER_LEN], cmd_id);
+    put_le32(&buf[MOTOR_UDP_HEADER_LEN + 4U], (uint32_t)status);
+    put_le32(&buf[MOTOR_UDP_HEADER_LEN + 8U], uptime_ms);
+
+    return MOTOR_UDP_HEADER_LEN + MOTOR_UDP_ACK_LEN;
+}
+
+int motor_udp_decode(const uint8_t *buf, size_t len, struct motor_udp_msg *out)
+{
+    if ((len < MOTOR_UDP_HEADER_LEN) || (get_le16(&buf[0]) != MOTOR_UDP_MAGIC) ||
+        (buf[2] != MOTOR_UDP_VERSION)) {
+        return -EINVAL;
+    }
+
+    const uint8_t *rec = &buf[MOTOR_UDP_HEADER_LEN];
+    size_t rec_len;
+    uint16_t max_count = 1U;
+
+    out->type = (enum motor_udp_type)buf[3];
+    out->seq = get_le32(&buf[4]);
+    out->count = get_le16(&buf[8]);
+
+    switch (out->type) {
+        case MOTOR_UDP_TELEMETRY:
+            rec_len = MOTOR_UDP_SAMPLE_LEN;
+            max_count = MOTOR_UDP_MAX_SAMPLES;
+            break;
+        case MOTOR_UDP_SETPOINT:
+            rec_len = MOTOR_UDP_SETPOINT_LEN;
+            break;
+        case MOTOR_UDP_ACK:
+            rec_len = MOTOR_UDP_ACK_LEN;
+            break;
+        default:
+            return -EINVAL;
+    }
+
+    if ((out->count == 0U) || (out->count > max_count) ||
+        (len != (MOTOR_UDP_HEADER_LEN + (out->count * rec_len)))) {
+        return -EINVAL;
+    }
+
+    if (out->type == MOTOR_UDP_SETPOINT) {
+        out->cmd_id = get_le32(&rec[0]);
+        out->rpm = get_f32(&rec[4]);
+    } else if (out->type == MOTOR_UDP_ACK) {
+        out->cmd_id = get_le32(&rec[0]);
+        out->status = (int32_t)get_le32(&rec[4]);
+        out->uptime_ms = get_le32(&rec[8]);
+    }
+
+    return 0;
+}
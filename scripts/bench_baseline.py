@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Regenerate the hot-path benchmark baseline from a benchmark run.
+
+Reads the `BENCH:<name>,cycles_per_call=<n>,...` lines the hot_path suite
+prints (twister handler.log, or any console capture) and rewrites the
+baseline table in tests/benchmark/hot_path/src/baseline.h. Several logs can
+be given; the lowest value per function is kept.
+
+    west twister -T tests/benchmark/hot_path -p native_sim
+    scripts/bench_baseline.py twister-out/native_sim*/**/hot_path/handler.log
+"""
+
+import argparse
+import os
+import re
+import sys
+
+BENCH_LINE = re.compile(r"BENCH:(?P<name>[a-z_]+),cycles_per_call=(?P<cycles>\d+)")
+TABLE = re.compile(r"(static const struct bench_baseline bench_baseline\[\] = \{\n)(.*?)(\};)",
+                   re.S)
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tests",
+                              "benchmark", "hot_path", "src", "baseline.h")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="+")
+    parser.add_argument("--header", default=DEFAULT_HEADER)
+    args = parser.parse_args()
+
+    best = {}
+    for path in args.logs:
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = BENCH_LINE.search(line)
+                if m:
+                    name, cycles = m.group("name"), int(m.group("cycles"))
+                    best[name] = min(cycles, best.get(name, cycles))
+
+    if not best:
+        sys.exit("no BENCH: lines found")
+
+    with open(args.header, encoding="utf-8") as f:
+        text = f.read()
+
+    # Keep the table order and any entry the logs do not cover, append new ones.
+    old = {n: int(v) for n, v in re.findall(r'\{"([a-z_]+)", (\d+)\}',
+                                             TABLE.search(text).group(2))}
+    merged = dict(old)
+    merged.update({n: max(v, 1) for n, v in best.items()})
+    order = list(old) + sorted(n for n in best if n not in old)
+    rows = "".join(f'    {{"{n}", {merged[n]}}},\n' for n in order)
+    text = TABLE.sub(lambda m: m.group(1) + rows + m.group(3), text)
+
+    with open(args.header, "w", encoding="utf-8") as f:
+        f.write(text)
+
+    for n in order:
+        if n in best:
+            print(f"{n:<28} {best[n]:>8} cycles/call")
+
+
+if __name__ == "__main__":
+    main()
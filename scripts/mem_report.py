@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Static RAM report for a motor-sim-demo ELF.
+
+Groups every RAM symbol (.bss/.data/.noinit) by the source file that defines
+it, using the debug line info from ``nm -l``. It prints per-module totals,
+the largest symbols, and the per-motor versus shared split. It is normally
+run through the build system:
+
+    west build -t mem_report
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+# Symbols a second motor instance would duplicate (see src/mem_report.c).
+PER_MOTOR_SYMBOLS = {
+    "g_state",
+    "_zbus_message_motor_state_chan",
+    "history",
+    "_k_mem_slab_buf_sample_slab",
+    "sample_slab",
+    "control_stack",
+    "control_thread_data",
+    "cmd_ring",
+    "player",
+}
+
+RAM_TYPES = set("bBdDvV")
+NM_LINE = re.compile(r"^[0-9a-fA-F]+\s+([0-9a-fA-F]+)\s+(\S)\s+(\S+)(?:\s+(\S+):\d+)?$")
+
+
+def module_of(path, app_root):
+    """Application sources group per file; everything else per top directory."""
+    if path is None:
+        return "(no debug info)"
+    path = os.path.normpath(path)
+    if path.startswith(app_root + os.sep):
+        rel = os.path.relpath(path, app_root)
+        if rel.startswith("src" + os.sep):
+            return os.path.splitext(os.path.basename(rel))[0]
+        return rel.split(os.sep)[0]
+    parts = path.split(os.sep)
+    if "zephyr" in parts:
+        idx = len(parts) - 1 - parts[::-1].index("zephyr")
+        sub = parts[idx + 1 : idx + 3]
+        return "zephyr/" + "/".join(sub[:-1] if len(sub) > 1 else sub)
+    return "(other)"
+
+
+def read_symbols(nm, elf):
+    out = subprocess.run([nm, "-S", "-l", "--size-sort", elf], check=True,
+                         capture_output=True, text=True).stdout
+    for line in out.splitlines():
+        m = NM_LINE.match(line.strip())
+        if m and m.group(2) in RAM_TYPES:
+            yield m.group(3), int(m.group(1), 16), m.group(4)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--app-root", default=os.path.dirname(os.path.dirname(
+        os.path.abspath(__file__))))
+    parser.add_argument("--top", type=int, default=15, help="largest symbols to list")
+    args = parser.parse_args()
+
+    app_root = os.path.normpath(args.app_root)
+    modules = collections.Counter()
+    symbols = []
+    per_motor = 0
+
+    for name, size, path in read_symbols(args.nm, args.elf):
+        mod = module_of(path, app_root)
+        modules[mod] += size
+        symbols.append((size, name, mod))
+        if name in PER_MOTOR_SYMBOLS and not mod.startswith("zephyr/"):
+            per_motor += size
+
+    total = sum(modules.values())
+    if total == 0:
+        sys.exit(f"no RAM symbols found in {args.elf}")
+
+    print(f"Static RAM by module ({args.elf}):")
+    for mod, size in modules.most_common():
+        print(f"  {mod:<32} {size:>8} B  {100.0 * size / total:5.1f}%")
+    print(f"  {'total':<32} {total:>8} B")
+
+    print(f"\nLargest {args.top} symbols:")
+    for size, name, mod in sorted(symbols, reverse=True)[: args.top]:
+        print(f"  {name:<40} {size:>8} B  {mod}")
+
+    print(f"\nPer motor: {per_motor} B, shared: {total - per_motor} B")
+
+
+if __name__ == "__main__":
+    main()
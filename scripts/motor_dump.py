@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Decode machine-readable motor_info/motor_dump/motor_lifetime output.
+
+Reads shell output (CSV lines, JSON lines or ':'-prefixed hex frames) from a
+file or stdin and prints one JSON object per record. Hex frames are CRC
+checked. Typical use with a native_sim PTY:
+
+    printf 'motor_dump hex\\n' > /dev/pts/3; timeout 1 cat /dev/pts/3 | scripts/motor_dump.py
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+FRAME_SOF = 0xA5
+RECORD_TAGS = {
+    1: "state",
+    2: "hist",
+    3: "counters",
+    4: "end",
+    5: "event",
+    6: "lifetime",
+    7: "temp_hist",
+    8: "out_hist",
+}
+SAMPLE_FIELDS = ("seq", "t_ms", "sp_rpm", "meas_rpm", "out_pct", "temp_c")
+EVENT_FIELDS = ("id",) + SAMPLE_FIELDS
+U32_FIELDS = {
+    "counters": ("samples", "setpoint_updates", "publish_errors"),
+    "end": ("records",),
+    "lifetime": (
+        "periods",
+        "period_ms",
+        "normal_periods",
+        "soft_periods",
+        "hard_periods",
+        "saturated_periods",
+        "derated_periods",
+        "setpoint_changes",
+        "energy_j",
+    ),
+    "temp_hist": tuple(f"t{20 + 10 * i}" for i in range(11)),
+    "out_hist": tuple(f"o{10 * i}" for i in range(10)),
+}
+
+
+def crc16_ccitt(seed, data):
+    """Same algorithm as Zephyr's crc16_ccitt() (reflected 0x1021)."""
+    for byte in data:
+        e = (seed ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        seed = ((seed >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+    return seed
+
+
+def u32_record(tag, values):
+    names = U32_FIELDS.get(tag, ())
+    rec = {"type": tag}
+    for i, value in enumerate(values):
+        rec[names[i] if i < len(names) else f"field{i}"] = value
+    return rec
+
+
+def decode_hex(line):
+    frame = bytes.fromhex(line[1:])
+    if len(frame) < 5 or frame[0] != FRAME_SOF or frame[2] != len(frame) - 5:
+        raise ValueError("malformed frame")
+    (crc,) = struct.unpack_from("<H", frame, len(frame) - 2)
+    if crc != crc16_ccitt(0xFFFF, frame[1:-2]):
+        raise ValueError("bad CRC")
+    tag = RECORD_TAGS.get(frame[1], f"type{frame[1]}")
+    payload = frame[3:-2]
+    if tag in ("state", "hist"):
+        values = struct.unpack("<IIffff", payload)
+        return dict(zip(("type",) + SAMPLE_FIELDS, (tag,) + values))
+    if tag == "event":
+        values = struct.unpack("<IIIffff", payload)
+        return dict(zip(("type",) + EVENT_FIELDS, (tag,) + values))
+    return u32_record(tag, struct.unpack(f"<{len(payload) // 4}I", payload))
+
+
+def decode_csv(line):
+    cols = line.split(",")
+    tag = cols[0]
+    if tag in ("state", "hist"):
+        values = [int(cols[1]), int(cols[2])] + [float(c) for c in cols[3:7]]
+        return dict(zip(("type",) + SAMPLE_FIELDS, [tag] + values))
+    return u32_record(tag, [int(c) for c in cols[1:]])
+
+
+def decode_line(line):
+    line = line.strip()
+    if line.startswith(":"):
+        return decode_hex(line)
+    if line.startswith("{"):
+        return json.loads(line)
+    if line.split(",", 1)[0] in RECORD_TAGS.values():
+        return decode_csv(line)
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"), default=sys.stdin)
+    args = parser.parse_args()
+
+    for line in args.input:
+        try:
+            rec = decode_line(line)
+        except (ValueError, struct.error) as exc:
+            print(f"skipping line ({exc}): {line.strip()}", file=sys.stderr)
+            continue
+        if rec is not None:
+            print(json.dumps(rec))
+            if rec["type"] == "end":
+                break
+
+
+if __name__ == "__main__":
+    main()
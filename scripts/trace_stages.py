@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Per-stage latencies from a motor-sim-demo CTF trace.
+
+Reads a CTF trace directory (metadata + channel0_0) captured with
+overlay-tracing.conf and pairs the application begin/end named events
+(see src/app_trace.h). For every stage it reports:
+
+- wall time between begin and end (trace clock),
+- cycles between begin and end (arg1 cycle stamps; on native_sim this is
+  the host TSC, the only meaningful cost of compute-only stages there).
+
+It also derives two cross-thread figures:
+
+- publish->wake: end of a state publish to the end of the telemetry sample
+  wait that follows it (hand-off latency),
+- ctrl_period: interval between consecutive control step starts.
+
+Needs the babeltrace2 Python bindings (python3-bt2):
+
+    scripts/trace_stages.py trace/ [--csv]
+"""
+
+import argparse
+import collections
+import sys
+
+try:
+    import bt2
+except ImportError:
+    sys.exit("babeltrace2 Python bindings missing (apt install python3-bt2)")
+
+PHASE_BEGIN = 0
+PHASE_END = 1
+CYCLE_WRAP = 1 << 32
+
+
+def field_str(field):
+    """CTF bounded strings come out as strings or as arrays of char codes."""
+    try:
+        text = str(field)
+    except TypeError:
+        text = "".join(chr(int(c)) for c in field)
+    return text.split("\x00", 1)[0]
+
+
+def read_events(path):
+    """Yield (ns, thread, stage, phase, cycles) for application events."""
+    thread = "?"
+    for msg in bt2.TraceCollectionMessageIterator(path):
+        if type(msg) is not bt2._EventMessageConst:
+            continue
+        ev = msg.event
+        if ev.name == "thread_switched_in":
+            thread = field_str(ev.payload_field["name"]) or str(ev.payload_field["thread_id"])
+        elif ev.name == "named_event":
+            yield (msg.default_clock_snapshot.ns_from_origin, thread,
+                   field_str(ev.payload_field["name"]), int(ev.payload_field["arg0"]),
+                   int(ev.payload_field["arg1"]))
+
+
+def percentile(values, pct):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * pct / 100.0))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("trace", help="CTF trace directory")
+    parser.add_argument("--csv", action="store_true", help="print CSV instead of a table")
+    args = parser.parse_args()
+
+    open_stages = {}
+    wall_us = collections.defaultdict(list)
+    cycles = collections.defaultdict(list)
+    last_publish_end = None
+    last_ctrl_begin = None
+
+    for ns, thread, stage, phase, stamp in read_events(args.trace):
+        key = (stage, thread)
+        if phase == PHASE_BEGIN:
+            open_stages[key] = (ns, stamp)
+            if stage == "ctrl_step":
+                if last_ctrl_begin is not None:
+                    wall_us["ctrl_period"].append((ns - last_ctrl_begin) / 1000.0)
+                last_ctrl_begin = ns
+            continue
+
+        if phase != PHASE_END or key not in open_stages:
+            continue
+        begin_ns, begin_stamp = open_stages.pop(key)
+        wall_us[stage].append((ns - begin_ns) / 1000.0)
+        cycles[stage].append((stamp - begin_stamp) % CYCLE_WRAP)
+
+        if stage == "publish":
+            last_publish_end = ns
+        elif stage == "sample_wait" and last_publish_end is not None:
+            wall_us["publish->wake"].append((ns - last_publish_end) / 1000.0)
+            last_publish_end = None
+
+    if not wall_us:
+        sys.exit("no application trace events (was CONFIG_MOTOR_SIM_TRACE enabled?)")
+
+    header = ("stage", "count", "wall_avg_us", "wall_p99_us", "wall_max_us", "cyc_avg",
+              "cyc_p99", "cyc_max")
+    rows = []
+    for stage in sorted(wall_us):
+        w = wall_us[stage]
+        c = cycles.get(stage)
+        rows.append((stage, len(w), f"{sum(w) / len(w):.1f}", f"{percentile(w, 99):.1f}",
+                     f"{max(w):.1f}",
+                     f"{sum(c) / len(c):.0f}" if c else "-",
+                     f"{percentile(c, 99)}" if c else "-",
+                     f"{max(c)}" if c else "-"))
+
+    if args.csv:
+        print(",".join(header))
+        for row in rows:
+            print(",".join(str(v) for v in row))
+        return
+
+    print(f"{header[0]:<20}" + "".join(f"{h:>13}" for h in header[1:]))
+    for row in rows:
+        print(f"{row[0]:<20}" + "".join(f"{v:>13}" for v in row[1:]))
+
+
+if __name__ == "__main__":
+    main()
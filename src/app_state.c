@@ -3,22 +3,33 @@
  * @brief Shared motor state implementation.
  *
  * Implements the app_state module using a mutex for data protection and a
- * semaphore to signal new samples. Setpoint updates are broadcast using Zbus.
+ * semaphore to signal state changes. Setpoint updates are broadcast using
+ * Zbus. Every feedback update is also recorded in a small history ring so host
+ * tooling can fetch recent samples in one request. The samples are blocks of
+ * the sample pool, written once here and shared by reference with the ring,
+ * the exporters and the readers.
+ *
+ * Telemetry and the watchers are only woken when the state moves beyond the
+ * deadband, so a settled motor wakes nothing but the control loop.
  */
 
 #include <errno.h>
+#include <math.h>
+#include <string.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/zbus/zbus.h>
 #include <zephyr/logging/log.h>
 
 #include "app_state.h"
+#include "app_trace.h"
+#include "sample_pool.h"
+#include "shm_export.h"
+#include "udp_link.h"
 
 LOG_MODULE_REGISTER(app_state, LOG_LEVEL_DBG);
 
-/* Maximum allowed setpoint, should match motor model full scale. */
-#define APP_STATE_MAX_SETPOINT_RPM 10000.0f
-
 /* Internal global state (owned by this module only). */
 static struct motor_state g_state = {
     .setpoint_rpm = 1500.0f,
@@ -27,10 +38,44 @@ static struct motor_state g_state = {
     .temperature_c = 25.0f,
 };
 
+/*
+ * Recent feedback samples (ring of held pool blocks, NULL where the pool was
+ * exhausted) and counters, protected by state_mutex.
+ */
+static const struct app_state_sample *history[APP_STATE_HISTORY_LEN];
+static struct app_state_counters counters;
+
+/* Sample count at which the history was last emptied (init or restore). */
+static uint32_t history_start;
+
 /* Synchronization primitives used internally. */
 static struct k_mutex state_mutex;
 static struct k_sem sample_ready_sem;
 
+/* State at the last signalled change, and the signals to raise on the next one. */
+static struct motor_state last_change;
+static struct k_poll_signal *watchers[APP_STATE_MAX_WATCHERS];
+static size_t watcher_count;
+
+/* Runtime statistics, atomic so they can be read without state_mutex. */
+struct app_state_lock_counters {
+    atomic_t acquisitions;
+    atomic_t contended;
+    atomic_t max_wait_cycles;
+};
+
+static atomic_t publish_errors;
+static atomic_t sample_overruns;
+static struct app_state_lock_counters lock_counters[APP_STATE_CALLER_COUNT];
+
+static const char *const caller_names[APP_STATE_CALLER_COUNT] = {
+    [APP_STATE_CALLER_SET_SETPOINT] = "set_setpoint",
+    [APP_STATE_CALLER_UPDATE_FEEDBACK] = "update_feedback",
+    [APP_STATE_CALLER_GET_SNAPSHOT] = "get_snapshot",
+    [APP_STATE_CALLER_GET_COUNTERS] = "get_counters",
+    [APP_STATE_CALLER_GET_HISTORY] = "get_history",
+};
+
 /* Forward declaration of zbus listener callback. */
 static void motor_state_listener_cb(const struct zbus_channel *chan);
 
@@ -49,6 +94,41 @@ ZBUS_CHAN_DEFINE(motor_state_chan,   /* name */
 /* Last setpoint value observed by the zbus listener. */
 static float last_logged_setpoint = -1.0f;
 
+/**
+ * @brief Raise @p target to @p value if it is larger (lock-free).
+ */
+static void atomic_max_u32(atomic_t *target, uint32_t value)
+{
+    atomic_val_t old = atomic_get(target);
+
+    while (((uint32_t)old < value) && !atomic_cas(target, old, (atomic_val_t)value)) {
+        old = atomic_get(target); /* GCOVR_EXCL_LINE */
+    }
+}
+
+/**
+ * @brief Take the state mutex and account the wait to @p who.
+ *
+ * The uncontended case costs a single non-blocking attempt; only when it
+ * fails is the wait timed.
+ */
+static void app_state_lock(enum app_state_caller who)
+{
+    struct app_state_lock_counters *lc = &lock_counters[who];
+
+    atomic_inc(&lc->acquisitions);
+
+    if (k_mutex_lock(&state_mutex, K_NO_WAIT) == 0) {
+        return;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    (void)k_mutex_lock(&state_mutex, K_FOREVER);
+
+    atomic_inc(&lc->contended);
+    atomic_max_u32(&lc->max_wait_cycles, k_cycle_get_32() - start);
+}
+
 /**
  * @brief Publish current state on zbus.
  *
@@ -56,12 +136,70 @@ static float last_logged_setpoint = -1.0f;
  */
 static void app_state_publish_locked(void)
 {
+    APP_TRACE_BEGIN(APP_TRACE_PUBLISH);
     int err = zbus_chan_pub(&motor_state_chan, &g_state, K_NO_WAIT);
+    APP_TRACE_END(APP_TRACE_PUBLISH);
     if (err != 0) {
+        atomic_inc(&publish_errors);              /* GCOVR_EXCL_LINE */
         LOG_WRN("zbus_chan_pub failed: %d", err); /* GCOVR_EXCL_LINE */
     }
 }
 
+/**
+ * @brief True if @p now moved beyond the deadband from @p then.
+ */
+static bool app_state_moved(const struct motor_state *now, const struct motor_state *then)
+{
+    return (now->setpoint_rpm != then->setpoint_rpm) ||
+           (fabsf(now->measured_rpm - then->measured_rpm) >= APP_STATE_DEADBAND_RPM) ||
+           (fabsf(now->control_output_pct - then->control_output_pct) >=
+            APP_STATE_DEADBAND_PCT) ||
+           (fabsf(now->temperature_c - then->temperature_c) >= APP_STATE_DEADBAND_C);
+}
+
+/**
+ * @brief Wake telemetry and the watchers if the state changed.
+ *
+ * This helper assumes the state mutex is already locked before calling.
+ */
+static void app_state_notify_locked(void)
+{
+    if (!app_state_moved(&g_state, &last_change)) {
+        return;
+    }
+
+    last_change = g_state;
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+    /* A full semaphore means the previous change was never taken. */
+    if (k_sem_count_get(&sample_ready_sem) != 0U) {
+        atomic_inc(&sample_overruns);
+    }
+    k_sem_give(&sample_ready_sem);
+#endif
+
+    for (size_t i = 0; i < watcher_count; i++) {
+        (void)k_poll_signal_raise(watchers[i], (int)counters.samples);
+    }
+}
+
+/**
+ * @brief Release the history samples and start an empty history.
+ *
+ * This helper assumes the state mutex is already locked before calling.
+ */
+static void app_state_clear_history_locked(void)
+{
+    for (size_t i = 0; i < APP_STATE_HISTORY_LEN; i++) {
+        if (history[i] != NULL) {
+            sample_pool_release(history[i]);
+            history[i] = NULL;
+        }
+    }
+
+    history_start = counters.samples;
+}
+
 /**
  * @brief Zbus listener callback for motor_state channel.
  *
@@ -90,6 +228,10 @@ int app_state_init(void)
     k_sem_init(&sample_ready_sem, 0, 1);
 
     k_mutex_lock(&state_mutex, K_FOREVER);
+    memset(&counters, 0, sizeof(counters));
+    app_state_clear_history_locked();
+    last_change = g_state;
+    app_state_reset_stats();
     app_state_publish_locked();
     k_mutex_unlock(&state_mutex);
 
@@ -105,10 +247,12 @@ int app_state_set_setpoint(float rpm)
         return -ERANGE;
     }
 
-    k_mutex_lock(&state_mutex, K_FOREVER);
+    app_state_lock(APP_STATE_CALLER_SET_SETPOINT);
 
     g_state.setpoint_rpm = rpm;
+    counters.setpoint_updates++;
     app_state_publish_locked();
+    app_state_notify_locked();
 
     k_mutex_unlock(&state_mutex);
 
@@ -118,16 +262,41 @@ int app_state_set_setpoint(float rpm)
 
 int app_state_update_feedback(float measured_rpm, float control_output_pct, float temperature_c)
 {
-    k_mutex_lock(&state_mutex, K_FOREVER);
+    /* Outside the mutex: NULL if the pool is exhausted, the sample is then not recorded. */
+    struct app_state_sample *sample = sample_pool_alloc();
+
+    app_state_lock(APP_STATE_CALLER_UPDATE_FEEDBACK);
 
     g_state.measured_rpm = measured_rpm;
     g_state.control_output_pct = control_output_pct;
     g_state.temperature_c = temperature_c;
 
-    app_state_publish_locked();
+    counters.samples++;
+    const struct app_state_sample **slot =
+        &history[(counters.samples - 1U) % APP_STATE_HISTORY_LEN];
+    if (*slot != NULL) {
+        sample_pool_release(*slot);
+    }
+    *slot = sample;
+
+    /*
+     * Filled in place in the pool block. With the pool exhausted, a stack
+     * sample is still exported: the shm ring keeps a copy, not a reference.
+     */
+    struct app_state_sample fallback;
+    struct app_state_sample *out = (sample != NULL) ? sample : &fallback;
+
+    out->seq = counters.samples;
+    out->uptime_ms = k_uptime_get_32();
+    out->state = g_state;
+    shm_export_push(out);
+
+    if (sample != NULL) {
+        udp_link_push(sample);
+    }
 
-    /* Notify listeners (e.g. telemetry) there is a new sample. */
-    k_sem_give(&sample_ready_sem);
+    app_state_publish_locked();
+    app_state_notify_locked();
 
     k_mutex_unlock(&state_mutex);
 
@@ -141,13 +310,129 @@ int app_state_get_snapshot(struct motor_state *out)
         return -EINVAL;
     }
 
-    k_mutex_lock(&state_mutex, K_FOREVER);
+    app_state_lock(APP_STATE_CALLER_GET_SNAPSHOT);
     *out = g_state;
     k_mutex_unlock(&state_mutex);
 
     return 0;
 }
 
+int app_state_get_counters(struct app_state_counters *out)
+{
+    if (out == NULL) {
+        return -EINVAL;
+    }
+
+    app_state_lock(APP_STATE_CALLER_GET_COUNTERS);
+    *out = counters;
+    k_mutex_unlock(&state_mutex);
+
+    out->publish_errors = (uint32_t)atomic_get(&publish_errors);
+
+    return 0;
+}
+
+int app_state_get_stats(struct app_state_stats *out)
+{
+    if (out == NULL) {
+        return -EINVAL;
+    }
+
+    out->publish_errors = (uint32_t)atomic_get(&publish_errors);
+    out->sample_overruns = (uint32_t)atomic_get(&sample_overruns);
+
+    for (size_t i = 0; i < APP_STATE_CALLER_COUNT; i++) {
+        out->lock[i].acquisitions = (uint32_t)atomic_get(&lock_counters[i].acquisitions);
+        out->lock[i].contended = (uint32_t)atomic_get(&lock_counters[i].contended);
+        out->lock[i].max_wait_cycles = (uint32_t)atomic_get(&lock_counters[i].max_wait_cycles);
+    }
+
+    return 0;
+}
+
+void app_state_reset_stats(void)
+{
+    atomic_clear(&publish_errors);
+    atomic_clear(&sample_overruns);
+
+    for (size_t i = 0; i < APP_STATE_CALLER_COUNT; i++) {
+        atomic_clear(&lock_counters[i].acquisitions);
+        atomic_clear(&lock_counters[i].contended);
+        atomic_clear(&lock_counters[i].max_wait_cycles);
+    }
+}
+
+const char *app_state_caller_name(enum app_state_caller caller)
+{
+    if ((unsigned int)caller >= APP_STATE_CALLER_COUNT) {
+        return "?";
+    }
+
+    return caller_names[caller];
+}
+
+/**
+ * @brief Sequence number of the oldest of the newest @p max recorded samples.
+ *
+ * This helper assumes the state mutex is already locked before calling.
+ *
+ * @param max   Samples wanted.
+ * @param count Set to the number of ring slots from there to the newest.
+ */
+static uint32_t app_state_history_first_locked(size_t max, size_t *count)
+{
+    size_t recorded = (size_t)(counters.samples - history_start);
+
+    *count = MIN(MIN(recorded, (size_t)APP_STATE_HISTORY_LEN), max);
+
+    return counters.samples - (uint32_t)*count;
+}
+
+size_t app_state_get_history(struct app_state_sample *out, size_t max)
+{
+    size_t slots;
+    size_t n = 0;
+
+    app_state_lock(APP_STATE_CALLER_GET_HISTORY);
+
+    uint32_t first = app_state_history_first_locked(max, &slots);
+
+    for (size_t i = 0; i < slots; i++) {
+        const struct app_state_sample *s = history[(first + i) % APP_STATE_HISTORY_LEN];
+
+        if (s != NULL) {
+            out[n++] = *s;
+        }
+    }
+
+    k_mutex_unlock(&state_mutex);
+
+    return n;
+}
+
+size_t app_state_hold_history(const struct app_state_sample **out, size_t max)
+{
+    size_t slots;
+    size_t n = 0;
+
+    app_state_lock(APP_STATE_CALLER_GET_HISTORY);
+
+    uint32_t first = app_state_history_first_locked(max, &slots);
+
+    for (size_t i = 0; i < slots; i++) {
+        const struct app_state_sample *s = history[(first + i) % APP_STATE_HISTORY_LEN];
+
+        if (s != NULL) {
+            sample_pool_hold(s);
+            out[n++] = s;
+        }
+    }
+
+    k_mutex_unlock(&state_mutex);
+
+    return n;
+}
+
 int app_state_wait_for_sample(void)
 {
     int ret = k_sem_take(&sample_ready_sem, K_FOREVER);
@@ -157,3 +442,59 @@ int app_state_wait_for_sample(void)
 
     return ret;
 }
+
+int app_state_watch(struct k_poll_signal *signal)
+{
+    int ret = 0;
+
+    k_mutex_lock(&state_mutex, K_FOREVER);
+
+    size_t i = 0;
+    while ((i < watcher_count) && (watchers[i] != signal)) {
+        i++;
+    }
+
+    if (i == watcher_count) {
+        if (watcher_count == APP_STATE_MAX_WATCHERS) {
+            ret = -ENOMEM;
+        } else {
+            watchers[watcher_count++] = signal;
+        }
+    }
+
+    k_mutex_unlock(&state_mutex);
+
+    return ret;
+}
+
+int app_state_restore(const struct motor_state *state, const struct app_state_counters *saved)
+{
+    if ((state->setpoint_rpm < 0.0f) || (state->setpoint_rpm > APP_STATE_MAX_SETPOINT_RPM)) {
+        return -ERANGE;
+    }
+
+    k_mutex_lock(&state_mutex, K_FOREVER);
+
+    g_state = *state;
+    counters.samples = saved->samples;
+    counters.setpoint_updates = saved->setpoint_updates;
+    app_state_clear_history_locked();
+    app_state_publish_locked();
+    app_state_notify_locked();
+
+    k_mutex_unlock(&state_mutex);
+
+    return 0;
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void app_state_test_lock(void)
+{
+    k_mutex_lock(&state_mutex, K_FOREVER);
+}
+
+void app_state_test_unlock(void)
+{
+    k_mutex_unlock(&state_mutex);
+}
+#endif
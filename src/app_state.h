@@ -12,17 +12,81 @@
 
 #include <zephyr/kernel.h>
 
+#include "motor_model.h" /* struct motor_state */
+
+/** Number of feedback samples kept in the history ring. */
+#define APP_STATE_HISTORY_LEN CONFIG_MOTOR_SIM_HISTORY_LEN
+
+/** Maximum allowed setpoint, should match motor model full scale. */
+#define APP_STATE_MAX_SETPOINT_RPM 10000.0f
+
+/**
+ * @name State change deadband
+ *
+ * A feedback update only counts as a state change (and wakes telemetry and
+ * the watchers) once a value has moved at least this far from the last
+ * state that did. Any setpoint change counts.
+ * @{
+ */
+#define APP_STATE_DEADBAND_RPM 1.0f /**< Measured speed (rpm). */
+#define APP_STATE_DEADBAND_PCT 0.1f /**< Control output (%). */
+#define APP_STATE_DEADBAND_C   0.1f /**< Temperature (Celsius). */
+/** @} */
+
+/** Maximum number of signals registered with app_state_watch(). */
+#define APP_STATE_MAX_WATCHERS 4
+
+/**
+ * @brief One feedback sample recorded in the history ring.
+ */
+struct app_state_sample {
+    uint32_t seq;             /**< Sample sequence number (1 = first sample). */
+    uint32_t uptime_ms;       /**< Uptime when the sample was recorded. */
+    struct motor_state state; /**< State right after the feedback update. */
+};
+
+/**
+ * @brief Monotonic app_state counters.
+ */
+struct app_state_counters {
+    uint32_t samples;          /**< Feedback samples recorded since init. */
+    uint32_t setpoint_updates; /**< Accepted setpoint updates since init. */
+    uint32_t publish_errors;   /**< Failed zbus publications since init. */
+};
+
+/**
+ * @brief Callers of the state mutex, for lock-wait accounting.
+ */
+enum app_state_caller {
+    APP_STATE_CALLER_SET_SETPOINT = 0,
+    APP_STATE_CALLER_UPDATE_FEEDBACK,
+    APP_STATE_CALLER_GET_SNAPSHOT,
+    APP_STATE_CALLER_GET_COUNTERS,
+    APP_STATE_CALLER_GET_HISTORY,
+    /** Number of callers (not a caller). */
+    APP_STATE_CALLER_COUNT,
+};
+
 /**
- * @brief Global motor state snapshot.
+ * @brief State mutex statistics of one caller.
+ */
+struct app_state_lock_stats {
+    uint32_t acquisitions;    /**< Times the caller took the state mutex. */
+    uint32_t contended;       /**< Acquisitions that had to wait for another thread. */
+    uint32_t max_wait_cycles; /**< Longest wait for the mutex, in hardware cycles. */
+};
+
+/**
+ * @brief Runtime statistics for contention and data loss.
  *
- * All values are represented in physical units (rpm, °C, percent).
- * This struct is owned and updated by the app_state module.
+ * Updated with atomic operations, so they can be read at any time without
+ * taking the state mutex.
  */
-struct motor_state {
-    float setpoint_rpm;       /**< Target speed in rpm. */
-    float measured_rpm;       /**< Simulated measured speed in rpm. */
-    float control_output_pct; /**< Control output in percent (0..100). */
-    float temperature_c;      /**< Simulated motor temperature in °C. */
+struct app_state_stats {
+    uint32_t publish_errors;  /**< zbus publications that failed (state not broadcast). */
+    /** Changes signalled before telemetry took the previous one (threaded telemetry only). */
+    uint32_t sample_overruns;
+    struct app_state_lock_stats lock[APP_STATE_CALLER_COUNT]; /**< Per-caller mutex stats. */
 };
 
 /**
@@ -51,8 +115,12 @@ int app_state_set_setpoint(float rpm);
  *
  * This function is typically called by the motor control thread after
  * each control step. It updates the measured rpm, control output and
- * temperature in a thread-safe way, publishes the state on zbus, and
- * signals that a new sample is available for telemetry.
+ * temperature in a thread-safe way, exports the sample to shared memory
+ * (CONFIG_MOTOR_SIM_SHM_EXPORT), records it in a sample pool block for the
+ * history and UDP (dropped there if the pool is exhausted) and publishes the
+ * state on zbus.
+ * If the state moved beyond the deadband it also wakes telemetry and raises
+ * the watched signals.
  *
  * @param measured_rpm       Simulated measured speed in rpm.
  * @param control_output_pct Control output in percent (0..100).
@@ -73,13 +141,117 @@ int app_state_update_feedback(float measured_rpm, float control_output_pct, floa
 int app_state_get_snapshot(struct motor_state *out);
 
 /**
- * @brief Block until a new sample is available.
+ * @brief Get a copy of the app_state counters.
+ *
+ * @param out Counters to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if out is NULL.
+ */
+int app_state_get_counters(struct app_state_counters *out);
+
+/**
+ * @brief Get a copy of the runtime statistics.
  *
- * This is intended for threads such as telemetry that want to react
- * whenever the control loop publishes a new feedback sample.
+ * @param out Statistics to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if out is NULL.
+ */
+int app_state_get_stats(struct app_state_stats *out);
+
+/**
+ * @brief Clear the runtime statistics (app_state_init() also clears them).
+ */
+void app_state_reset_stats(void);
+
+/**
+ * @brief Short name of a state mutex caller, for reports.
+ *
+ * @param caller Caller identifier.
+ *
+ * @return Caller name, "?" if out of range.
+ */
+const char *app_state_caller_name(enum app_state_caller caller);
+
+/**
+ * @brief Copy the most recent feedback samples, oldest first.
+ *
+ * For callers that want their own copy; app_state_hold_history() shares the
+ * recorded samples instead. Samples dropped because the sample pool was
+ * exhausted are missing (see sample_pool.h).
+ *
+ * @param out Array to fill. Must not be NULL.
+ * @param max Capacity of @p out in samples.
+ *
+ * @return Number of samples copied (at most APP_STATE_HISTORY_LEN).
+ */
+size_t app_state_get_history(struct app_state_sample *out, size_t max);
+
+/**
+ * @brief Hold the most recent feedback samples, oldest first, without copying.
+ *
+ * Same samples as app_state_get_history(), but @p out receives the recorded
+ * samples themselves, each with a reference taken for the caller. The caller
+ * reads them without any lock and releases each one with
+ * sample_pool_release() when done. Held samples stay valid while new samples
+ * replace them in the ring.
+ *
+ * @param out Array to fill. Must not be NULL.
+ * @param max Capacity of @p out in samples.
+ *
+ * @return Number of samples held (at most APP_STATE_HISTORY_LEN).
+ */
+size_t app_state_hold_history(const struct app_state_sample **out, size_t max);
+
+/**
+ * @brief Block until the state changes.
+ *
+ * This is intended for threads such as telemetry that want to react to the
+ * control loop's output. Samples within the deadband of the last change do
+ * not end the wait, so a settled motor leaves the caller asleep.
+ *
+ * Not signalled with CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE, whose telemetry
+ * slot runs after every control slot instead of waiting.
  *
  * @return 0 on success, negative errno on error.
  */
 int app_state_wait_for_sample(void);
 
+/**
+ * @brief Raise @p signal on every state change.
+ *
+ * For consumers that wait with k_poll() or k_work_poll: each setpoint
+ * change and each feedback update beyond the deadband raises the signal
+ * with the sample count as result. The consumer resets it before reading
+ * the state. Registering a signal twice has no effect; registrations are
+ * kept across app_state_init().
+ *
+ * @param signal Initialized poll signal. Must not be NULL.
+ *
+ * @return 0 on success, -ENOMEM if APP_STATE_MAX_WATCHERS are registered.
+ */
+int app_state_watch(struct k_poll_signal *signal);
+
+/**
+ * @brief Replace the state and counters with checkpointed values.
+ *
+ * Used to resume a checkpoint (see checkpoint.h). The restored state is
+ * published and wakes telemetry and the watchers like any other change. The
+ * history starts empty (its samples are released); new samples are numbered
+ * on from app_state_counters::samples. publish_errors is not restored.
+ *
+ * @param state    State to resume from. Must not be NULL.
+ * @param saved    Counters to resume from. Must not be NULL.
+ *
+ * @return 0 on success, -ERANGE if the setpoint is out of range.
+ */
+int app_state_restore(const struct motor_state *state, const struct app_state_counters *saved);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Hold the state mutex from the calling thread (test-only helper). */
+void app_state_test_lock(void);
+
+/** @brief Release the mutex taken by app_state_test_lock() (test-only helper). */
+void app_state_test_unlock(void);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
 #endif /* APP_STATE_H_ */
@@ -0,0 +1,60 @@
+/**
+ * @file app_trace.h
+ * @brief Application trace points.
+ *
+ * Brackets the main processing stages (control step, publish, sample wait,
+ * fault evaluation, shell commands) with begin/end events. With
+ * CONFIG_MOTOR_SIM_TRACE the events go to Zephyr's tracing subsystem as
+ * named events (CTF `named_event`: name, arg0 = phase, arg1 = cycle stamp);
+ * otherwise they compile to nothing.
+ *
+ * scripts/trace_stages.py turns a captured trace into per-stage latencies.
+ */
+
+#ifndef APP_TRACE_H_
+#define APP_TRACE_H_
+
+#include <stdint.h>
+
+/** Trace stage names (at most 20 characters, the CTF name field size). */
+#define APP_TRACE_CTRL_STEP   "ctrl_step"
+#define APP_TRACE_PUBLISH     "publish"
+#define APP_TRACE_SAMPLE_WAIT "sample_wait"
+#define APP_TRACE_FAULT_EVAL  "fault_eval"
+
+/** Value of arg0 for the begin and end event of a stage. */
+#define APP_TRACE_PHASE_BEGIN 0U
+#define APP_TRACE_PHASE_END   1U
+
+#if defined(CONFIG_MOTOR_SIM_TRACE)
+
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing.h>
+
+/**
+ * @brief Cycle stamp carried in arg1.
+ *
+ * native_sim only advances the trace clock while the CPU idles, so compute
+ * stages would all last 0 ns there; the host TSC gives their real cost.
+ */
+static inline uint32_t app_trace_cycles(void)
+{
+#if defined(CONFIG_ARCH_POSIX) && (defined(__i386__) || defined(__x86_64__))
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+#define APP_TRACE_BEGIN(stage)                                                                     \
+    sys_trace_named_event(stage, APP_TRACE_PHASE_BEGIN, app_trace_cycles())
+#define APP_TRACE_END(stage) sys_trace_named_event(stage, APP_TRACE_PHASE_END, app_trace_cycles())
+
+#else
+
+#define APP_TRACE_BEGIN(stage) ((void)0)
+#define APP_TRACE_END(stage)   ((void)0)
+
+#endif /* CONFIG_MOTOR_SIM_TRACE */
+
+#endif /* APP_TRACE_H_ */
@@ -0,0 +1,395 @@
+/**
+ * @file checkpoint.c
+ * @brief Named checkpoints of the simulation state.
+ *
+ * Each checkpoint is one settings value, CHECKPOINT_SETTINGS_SUBTREE/<name>,
+ * holding a struct checkpoint. Capturing and resuming touch the control
+ * loop's own state, so checkpoint_save() and checkpoint_load() run them on
+ * the loop itself: they post a MOTOR_CMD_CALL command and wait for the next
+ * tick to run it. The settings reads and writes stay in the calling thread.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include "cmdline.h"
+#include "soc.h"
+#endif
+
+#include "checkpoint.h"
+#include "motor_cmd.h"
+#include "trajectory.h"
+
+LOG_MODULE_REGISTER(checkpoint, LOG_LEVEL_INF);
+
+/** Settings key length: subtree, '/', name and NUL. */
+#define CHECKPOINT_KEY_LEN (sizeof(CHECKPOINT_SETTINGS_SUBTREE) + 1 + CHECKPOINT_NAME_MAX)
+
+/* Checkpoint resumed by checkpoint_init(); the command line option replaces the Kconfig one. */
+static const char *boot_name = CONFIG_MOTOR_SIM_CHECKPOINT_BOOT;
+
+/**
+ * @brief A capture or resume handed to the control loop.
+ *
+ * One at a time (request_mutex). Each call is posted with a new generation
+ * number in its argument and only runs if it can claim @ref armed with it,
+ * which the requester clears when it gives up waiting. A call left queued
+ * by a timeout then does nothing when the loop finally drains it.
+ */
+struct checkpoint_request {
+    struct checkpoint cp;
+    int ret;
+    struct k_sem done;
+    /** Generation the loop may still run, 0 when none. */
+    atomic_t armed;
+    /** Generation of the last call posted (request_mutex). */
+    uint32_t gen;
+};
+
+static struct checkpoint_request request;
+static K_MUTEX_DEFINE(request_mutex);
+
+/** Result of a settings lookup by checkpoint_read(). */
+struct checkpoint_lookup {
+    const char *name;
+    struct checkpoint *out;
+    int ret;
+};
+
+/** State of a checkpoint_list() walk. */
+struct checkpoint_walk {
+    checkpoint_list_cb cb;
+    void *user;
+    int count;
+};
+
+#if defined(CONFIG_ARCH_POSIX)
+static void checkpoint_add_options(void)
+{
+    static struct args_struct_t checkpoint_options[] = {
+        {
+            .option = "checkpoint",
+            .name = "name",
+            .type = 's',
+            .dest = (void *)&boot_name,
+            .descript = "Checkpoint to resume at boot instead of starting cold",
+        },
+        ARG_TABLE_ENDMARKER,
+    };
+
+    native_add_command_line_opts(checkpoint_options);
+}
+
+NATIVE_TASK(checkpoint_add_options, PRE_BOOT_1, 1);
+#endif
+
+/**
+ * @brief Build the settings key of @p name.
+ *
+ * @return 0 on success, -EINVAL if the name is empty, too long or contains
+ *         characters other than letters, digits, '_', '-' and '.'.
+ */
+static int checkpoint_key(const char *name, char *key)
+{
+    size_t len = (name != NULL) ? strlen(name) : 0U;
+
+    if ((len == 0U) || (len > CHECKPOINT_NAME_MAX)) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        char c = name[i];
+
+        if (!(((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+              ((c >= '0') && (c <= '9')) || (c == '_') || (c == '-') || (c == '.'))) {
+            return -EINVAL;
+        }
+    }
+
+    (void)snprintf(key, CHECKPOINT_KEY_LEN, CHECKPOINT_SETTINGS_SUBTREE "/%s", name);
+
+    return 0;
+}
+
+void checkpoint_capture(struct checkpoint *out, int64_t now_ms)
+{
+    memset(out, 0, sizeof(*out));
+    out->magic = CHECKPOINT_MAGIC;
+    out->version = CHECKPOINT_VERSION;
+    (void)app_state_get_snapshot(&out->state);
+    (void)app_state_get_counters(&out->counters);
+    motor_control_save(&out->control);
+    fault_monitor_save(&out->fault, now_ms);
+}
+
+int checkpoint_apply(const struct checkpoint *cp, int64_t now_ms)
+{
+    if ((cp->magic != CHECKPOINT_MAGIC) || (cp->version != CHECKPOINT_VERSION)) {
+        return -EINVAL;
+    }
+
+    /* Check everything before changing anything. */
+    if ((cp->state.setpoint_rpm < 0.0f) || (cp->state.setpoint_rpm > APP_STATE_MAX_SETPOINT_RPM)) {
+        return -ERANGE;
+    }
+
+    int ret = motor_control_restore(&cp->control);
+    if (ret != 0) {
+        return ret;
+    }
+
+    trajectory_stop();
+    fault_monitor_restore(&cp->fault, now_ms);
+
+    return app_state_restore(&cp->state, &cp->counters);
+}
+
+/**
+ * @brief Claim the request for the call posted with generation @p arg.
+ *
+ * @return true if the call is still awaited and must run, false if it is
+ *         stale.
+ */
+static bool checkpoint_claim(void *arg)
+{
+    return atomic_cas(&request.armed, (atomic_val_t)(uintptr_t)arg, 0);
+}
+
+static void checkpoint_capture_call(void *arg)
+{
+    if (!checkpoint_claim(arg)) {
+        return;
+    }
+
+    checkpoint_capture(&request.cp, k_uptime_get());
+    request.ret = 0;
+    k_sem_give(&request.done);
+}
+
+static void checkpoint_apply_call(void *arg)
+{
+    if (!checkpoint_claim(arg)) {
+        return;
+    }
+
+    request.ret = checkpoint_apply(&request.cp, k_uptime_get());
+    k_sem_give(&request.done);
+}
+
+/**
+ * @brief Run @p fn on the control loop and wait for it.
+ *
+ * The caller holds request_mutex.
+ */
+static int checkpoint_run_on_loop(void (*fn)(void *arg))
+{
+    /* Never 0, which means no call is armed. */
+    request.gen = (request.gen == UINT32_MAX) ? 1U : (request.gen + 1U);
+
+    const struct motor_cmd cmd = {
+        .type = MOTOR_CMD_CALL,
+        .fn = fn,
+        .arg = (void *)(uintptr_t)request.gen,
+    };
+
+    k_sem_reset(&request.done);
+    atomic_set(&request.armed, (atomic_val_t)request.gen);
+
+    int ret = motor_cmd_post(&cmd);
+    if (ret != 0) {
+        atomic_clear(&request.armed);
+        return ret;
+    }
+
+    if (k_sem_take(&request.done, K_MSEC(CHECKPOINT_LOOP_TIMEOUT_MS)) != 0) {
+        if (atomic_cas(&request.armed, (atomic_val_t)request.gen, 0)) {
+            LOG_WRN("control loop not running, request dropped");
+            return -EAGAIN;
+        }
+
+        /* The loop claimed the call just now: it is running, let it finish. */
+        (void)k_sem_take(&request.done, K_FOREVER);
+    }
+
+    return request.ret;
+}
+
+static int checkpoint_read_cb(const char *key, size_t len, settings_read_cb read_cb,
+                              void *cb_arg, void *param)
+{
+    struct checkpoint_lookup *lookup = param;
+    const char *next;
+
+    if ((len == 0U) || (key == NULL) || !settings_name_steq(key, lookup->name, &next) ||
+        (next != NULL)) {
+        return 0;
+    }
+
+    if (len != sizeof(*lookup->out)) {
+        lookup->ret = -EINVAL;
+        return 0;
+    }
+
+    ssize_t rc = read_cb(cb_arg, lookup->out, len);
+    lookup->ret = (rc == (ssize_t)len) ? 0 : -EIO;
+
+    return 0;
+}
+
+static int checkpoint_list_cb_direct(const char *key, size_t len, settings_read_cb read_cb,
+                                     void *cb_arg, void *param)
+{
+    struct checkpoint_walk *walk = param;
+    struct checkpoint cp;
+    const char *next;
+
+    /* Deleted values, and keys nested deeper than a name, are not checkpoints. */
+    if ((len == 0U) || (key == NULL) || (settings_name_next(key, &next) == 0) ||
+        (next != NULL)) {
+        return 0;
+    }
+
+    bool valid = (len == sizeof(cp)) && (read_cb(cb_arg, &cp, len) == (ssize_t)len);
+
+    walk->cb(key, valid ? &cp : NULL, walk->user);
+    walk->count++;
+
+    return 0;
+}
+
+int checkpoint_init(void)
+{
+    k_sem_init(&request.done, 0, 1);
+
+    int ret = settings_subsys_init();
+    /* GCOVR_EXCL_START */
+    if (ret != 0) {
+        LOG_ERR("settings init failed: %d, checkpoints unavailable", ret);
+        return ret;
+    }
+    /* GCOVR_EXCL_STOP */
+
+    if ((boot_name == NULL) || (boot_name[0] == '\0')) {
+        return 0;
+    }
+
+    /* The control loop has not started: resume in this thread. */
+    k_mutex_lock(&request_mutex, K_FOREVER);
+
+    ret = checkpoint_read(boot_name, &request.cp);
+    if (ret == 0) {
+        ret = checkpoint_apply(&request.cp, k_uptime_get());
+    }
+
+    k_mutex_unlock(&request_mutex);
+
+    if (ret != 0) {
+        LOG_WRN("cannot resume checkpoint '%s' (%d), starting cold", boot_name, ret);
+        return 0;
+    }
+
+    LOG_INF("resumed checkpoint '%s': %u samples, T=%d C", boot_name,
+            request.cp.counters.samples, (int)request.cp.state.temperature_c);
+
+    return 0;
+}
+
+int checkpoint_save(const char *name)
+{
+    char key[CHECKPOINT_KEY_LEN];
+
+    int ret = checkpoint_key(name, key);
+    if (ret != 0) {
+        return ret;
+    }
+
+    k_mutex_lock(&request_mutex, K_FOREVER);
+
+    ret = checkpoint_run_on_loop(checkpoint_capture_call);
+    if (ret == 0) {
+        ret = settings_save_one(key, &request.cp, sizeof(request.cp));
+    }
+
+    k_mutex_unlock(&request_mutex);
+
+    return ret;
+}
+
+int checkpoint_load(const char *name)
+{
+    k_mutex_lock(&request_mutex, K_FOREVER);
+
+    int ret = checkpoint_read(name, &request.cp);
+    if (ret == 0) {
+        ret = checkpoint_run_on_loop(checkpoint_apply_call);
+    }
+
+    k_mutex_unlock(&request_mutex);
+
+    return ret;
+}
+
+int checkpoint_read(const char *name, struct checkpoint *out)
+{
+    char key[CHECKPOINT_KEY_LEN];
+
+    int ret = checkpoint_key(name, key);
+    if (ret != 0) {
+        return ret;
+    }
+
+    struct checkpoint_lookup lookup = {
+        .name = name,
+        .out = out,
+        .ret = -ENOENT,
+    };
+
+    ret = settings_load_subtree_direct(CHECKPOINT_SETTINGS_SUBTREE, checkpoint_read_cb, &lookup);
+    if (ret != 0) {
+        return ret; /* GCOVR_EXCL_LINE */
+    }
+
+    return lookup.ret;
+}
+
+int checkpoint_delete(const char *name)
+{
+    char key[CHECKPOINT_KEY_LEN];
+
+    int ret = checkpoint_key(name, key);
+    if (ret != 0) {
+        return ret;
+    }
+
+    return settings_delete(key);
+}
+
+int checkpoint_list(checkpoint_list_cb cb, void *user)
+{
+    struct checkpoint_walk walk = {
+        .cb = cb,
+        .user = user,
+    };
+
+    int ret = settings_load_subtree_direct(CHECKPOINT_SETTINGS_SUBTREE,
+                                           checkpoint_list_cb_direct, &walk);
+    if (ret != 0) {
+        return ret; /* GCOVR_EXCL_LINE */
+    }
+
+    return walk.count;
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void checkpoint_test_set_boot_name(const char *name)
+{
+    boot_name = name;
+}
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file checkpoint.h
+ * @brief Named checkpoints of the simulation state.
+ *
+ * A checkpoint holds everything the simulation needs to continue from a
+ * point in time: the app_state motor state and counters, the control loop's
+ * period count, speed controller gains and memory, and DC plant state
+ * (including the current loop integrator), and the fault monitor context.
+ * With CONFIG_MOTOR_SIM_CHECKPOINT checkpoints are stored by name through
+ * the settings subsystem, which on native_sim keeps them in NVS on the flash
+ * simulator, itself a host file that survives restarts
+ * (overlay-checkpoint.conf). A scenario can then start at its operating point
+ * instead of heating up from the cold defaults. See docs/checkpoint.md.
+ * Otherwise the calls compile to nothing.
+ */
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stdint.h>
+
+#include "app_state.h"
+#include "fault_monitor.h"
+#include "motor_control.h"
+
+/** Longest checkpoint name, without the terminating NUL. */
+#define CHECKPOINT_NAME_MAX 15
+
+/** Settings subtree the checkpoints are stored under, one key per name. */
+#define CHECKPOINT_SETTINGS_SUBTREE "motor/ckpt"
+
+/** Stored checkpoint identification ("MCKP"). */
+#define CHECKPOINT_MAGIC 0x504B434DU
+
+/** Layout version; bump it whenever struct checkpoint changes. */
+#define CHECKPOINT_VERSION 2U
+
+/** Longest wait for the control loop to run a save or load (ms). */
+#define CHECKPOINT_LOOP_TIMEOUT_MS 1000
+
+/**
+ * @brief Full simulation state, stored as one settings value.
+ */
+struct checkpoint {
+    uint32_t magic;                          /**< CHECKPOINT_MAGIC. */
+    uint32_t version;                        /**< CHECKPOINT_VERSION. */
+    struct motor_state state;                /**< app_state motor state. */
+    struct app_state_counters counters;      /**< app_state counters. */
+    struct motor_control_checkpoint control; /**< Control loop and plant state. */
+    struct fault_monitor_checkpoint fault;   /**< Fault monitor context. */
+};
+
+/**
+ * @brief Called by checkpoint_list() for each stored checkpoint.
+ *
+ * @param name Checkpoint name.
+ * @param cp   Stored checkpoint, NULL if the value has the wrong size.
+ * @param user User pointer given to checkpoint_list().
+ */
+typedef void (*checkpoint_list_cb)(const char *name, const struct checkpoint *cp, void *user);
+
+#if defined(CONFIG_MOTOR_SIM_CHECKPOINT)
+
+/**
+ * @brief Capture the simulation state.
+ *
+ * Call it from the control loop or while the loop is not running.
+ *
+ * @param out    Checkpoint to fill. Must not be NULL.
+ * @param now_ms Current time in ms.
+ */
+void checkpoint_capture(struct checkpoint *out, int64_t now_ms);
+
+/**
+ * @brief Resume the simulation state from @p cp.
+ *
+ * Same calling context as checkpoint_capture(). A running setpoint profile or
+ * auto-tuner is stopped, as it is not part of the checkpoint.
+ *
+ * @param cp     Checkpoint to resume. Must not be NULL.
+ * @param now_ms Current time in ms.
+ *
+ * @return 0 on success, -EINVAL if @p cp is not a checkpoint of this
+ *         version, -ENOTSUP if it was saved with the other plant model,
+ *         -ERANGE if its setpoint is out of range. Nothing is changed on error.
+ */
+int checkpoint_apply(const struct checkpoint *cp, int64_t now_ms);
+
+/**
+ * @brief Initialize the settings storage and resume the boot checkpoint.
+ *
+ * The boot checkpoint is CONFIG_MOTOR_SIM_CHECKPOINT_BOOT, or the name given
+ * with the -checkpoint=<name> command line option on native_sim; none
+ * starts cold. Call it after app_state_init() and before the control loop
+ * starts.
+ *
+ * @return 0 on success (a missing boot checkpoint is logged and the
+ *         simulation starts cold), or the negative errno of the settings
+ *         initialization.
+ */
+int checkpoint_init(void);
+
+/**
+ * @brief Capture the state at the next control tick and store it as @p name.
+ *
+ * An existing checkpoint with the same name is replaced.
+ *
+ * @param name Checkpoint name (letters, digits, '_', '-', '.').
+ *
+ * @return 0 on success, -EINVAL if the name is invalid, -ENOSPC if the
+ *         command queue is full, -EAGAIN if the control loop did not run
+ *         within CHECKPOINT_LOOP_TIMEOUT_MS (the request is then dropped and
+ *         never runs), or the negative errno of the settings write.
+ */
+int checkpoint_save(const char *name);
+
+/**
+ * @brief Resume checkpoint @p name at the next control tick.
+ *
+ * @param name Checkpoint name.
+ *
+ * @return 0 on success, -EINVAL if the name is invalid or the stored value is
+ *         not a checkpoint of this version, -ENOENT if there is no such
+ *         checkpoint, -ENOSPC/-EAGAIN as for checkpoint_save(), or an error
+ *         of checkpoint_apply().
+ */
+int checkpoint_load(const char *name);
+
+/**
+ * @brief Read checkpoint @p name without resuming it.
+ *
+ * @param name Checkpoint name.
+ * @param out  Checkpoint to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if the name is invalid or the stored value
+ *         has the wrong size, -ENOENT if there is no such checkpoint.
+ */
+int checkpoint_read(const char *name, struct checkpoint *out);
+
+/**
+ * @brief Delete checkpoint @p name.
+ *
+ * @param name Checkpoint name.
+ *
+ * @return 0 on success (also if it did not exist), -EINVAL if the name is
+ *         invalid, or the negative errno of the settings write.
+ */
+int checkpoint_delete(const char *name);
+
+/**
+ * @brief Call @p cb for each stored checkpoint.
+ *
+ * @param cb   Callback. Must not be NULL.
+ * @param user Passed to @p cb.
+ *
+ * @return Number of checkpoints, or the negative errno of the settings read.
+ */
+int checkpoint_list(checkpoint_list_cb cb, void *user);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Resume @p name in the next checkpoint_init() (test-only helper). */
+void checkpoint_test_set_boot_name(const char *name);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
+#else
+
+static inline int checkpoint_init(void)
+{
+    return 0;
+}
+
+#endif /* CONFIG_MOTOR_SIM_CHECKPOINT */
+
+#endif /* CHECKPOINT_H_ */
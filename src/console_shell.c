@@ -2,20 +2,207 @@
  * @file console_shell.c
  * @brief Shell command handlers.
  *
- * Registers shell commands used by the demo to set the target speed and print
- * the current motor state.
+ * Registers shell commands used by the demo to set the target speed, print
+ * the current motor state, drive setpoint profiles and tune the speed
+ * controller.
+ *
+ * State output is available in human text and in machine-readable modes for
+ * host tooling: CSV lines, JSON lines and CRC-protected binary frames printed
+ * as hex (one frame per line, prefixed with ':'). Event log records are only
+ * printed as hex frames; the host renders their text. Lifetime statistics
+ * use the same record formats.
  */
 
 #include <stdlib.h>
 #include <errno.h>
+#include <string.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 #include "app_state.h"
+#include "app_trace.h"
+#include "checkpoint.h"
+#include "evlog.h"
+#include "mem_report.h"
+#include "motor_cmd.h"
+#include "motor_control.h"
+#include "sample_pool.h"
+#include "trajectory.h"
+#include "wakeups.h"
 
 LOG_MODULE_REGISTER(console_shell, LOG_LEVEL_INF);
 
+/** Output formats for state records. */
+enum output_format {
+    OUTPUT_TEXT = 0,
+    OUTPUT_CSV,
+    OUTPUT_JSON,
+    OUTPUT_HEX,
+};
+
+/*
+ * Hex frame layout: SOF, type, payload length, payload (little-endian fields)
+ * and CRC16-CCITT (seed 0xffff, little-endian) over type, length and payload.
+ */
+#define FRAME_SOF         0xA5
+#define FRAME_MAX_PAYLOAD 64
+
+/** Record types, shared by the CSV/JSON tag and the hex frame type byte. */
+enum record_type {
+    RECORD_STATE = 1,
+    RECORD_HISTORY = 2,
+    RECORD_COUNTERS = 3,
+    RECORD_END = 4,
+    RECORD_EVENT = 5,
+    RECORD_LIFETIME = 6,
+    RECORD_TEMP_HIST = 7,
+    RECORD_OUT_HIST = 8,
+};
+
+static const char *const record_tags[] = {
+    [RECORD_STATE] = "state",
+    [RECORD_HISTORY] = "hist",
+    [RECORD_COUNTERS] = "counters",
+    [RECORD_END] = "end",
+    [RECORD_EVENT] = "event",
+    [RECORD_LIFETIME] = "lifetime",
+    [RECORD_TEMP_HIST] = "temp_hist",
+    [RECORD_OUT_HIST] = "out_hist",
+};
+
+static int parse_output_format(const char *arg, enum output_format *fmt)
+{
+    static const char *const names[] = {
+        [OUTPUT_TEXT] = "text",
+        [OUTPUT_CSV] = "csv",
+        [OUTPUT_JSON] = "json",
+        [OUTPUT_HEX] = "hex",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(names); i++) {
+        if (strcmp(arg, names[i]) == 0) {
+            *fmt = (enum output_format)i;
+            return 0;
+        }
+    }
+
+    return -EINVAL;
+}
+
+static void print_frame(const struct shell *shell, enum record_type type, const uint8_t *payload,
+                        size_t len)
+{
+    uint8_t frame[3 + FRAME_MAX_PAYLOAD + 2];
+    char hex[(sizeof(frame) * 2U) + 1U];
+
+    frame[0] = FRAME_SOF;
+    frame[1] = (uint8_t)type;
+    frame[2] = (uint8_t)len;
+    memcpy(&frame[3], payload, len);
+
+    uint16_t crc = crc16_ccitt(0xffff, &frame[1], len + 2U);
+    sys_put_le16(crc, &frame[3 + len]);
+
+    (void)bin2hex(frame, len + 5U, hex, sizeof(hex));
+    shell_print(shell, ":%s", hex);
+}
+
+static void print_sample(const struct shell *shell, enum output_format fmt, enum record_type type,
+                         const struct app_state_sample *s)
+{
+    const struct motor_state *st = &s->state;
+
+    if (fmt == OUTPUT_CSV) {
+        shell_print(shell,
+                    "%s,%u,%u,%.3f,%.3f,%.3f,%.3f",
+                    record_tags[type],
+                    s->seq,
+                    s->uptime_ms,
+                    (double)st->setpoint_rpm,
+                    (double)st->measured_rpm,
+                    (double)st->control_output_pct,
+                    (double)st->temperature_c);
+    } else if (fmt == OUTPUT_JSON) {
+        shell_print(shell,
+                    "{\"type\":\"%s\",\"seq\":%u,\"t_ms\":%u,\"sp_rpm\":%.3f,"
+                    "\"meas_rpm\":%.3f,\"out_pct\":%.3f,\"temp_c\":%.3f}",
+                    record_tags[type],
+                    s->seq,
+                    s->uptime_ms,
+                    (double)st->setpoint_rpm,
+                    (double)st->measured_rpm,
+                    (double)st->control_output_pct,
+                    (double)st->temperature_c);
+    } else {
+        const float values[] = {
+            st->setpoint_rpm,
+            st->measured_rpm,
+            st->control_output_pct,
+            st->temperature_c,
+        };
+        uint8_t payload[8 + sizeof(values)];
+
+        sys_put_le32(s->seq, &payload[0]);
+        sys_put_le32(s->uptime_ms, &payload[4]);
+        for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+            uint32_t bits;
+            memcpy(&bits, &values[i], sizeof(bits));
+            sys_put_le32(bits, &payload[8 + (4 * i)]);
+        }
+
+        print_frame(shell, type, payload, sizeof(payload));
+    }
+}
+
+static void print_u32_record(const struct shell *shell, enum output_format fmt,
+                             enum record_type type, const char *const names[],
+                             const uint32_t values[], size_t count)
+{
+    if (fmt == OUTPUT_HEX) {
+        uint8_t payload[FRAME_MAX_PAYLOAD];
+
+        for (size_t i = 0; i < count; i++) {
+            sys_put_le32(values[i], &payload[4 * i]);
+        }
+        print_frame(shell, type, payload, 4 * count);
+        return;
+    }
+
+    bool json = (fmt == OUTPUT_JSON);
+
+    shell_fprintf(shell, SHELL_NORMAL, json ? "{\"type\":\"%s\"" : "%s", record_tags[type]);
+    for (size_t i = 0; i < count; i++) {
+        if (json) {
+            shell_fprintf(shell, SHELL_NORMAL, ",\"%s\":%u", names[i], values[i]);
+        } else {
+            shell_fprintf(shell, SHELL_NORMAL, ",%u", values[i]);
+        }
+    }
+    shell_fprintf(shell, SHELL_NORMAL, json ? "}\n" : "\n");
+}
+
+static void print_counters(const struct shell *shell, enum output_format fmt,
+                           const struct app_state_counters *c)
+{
+    static const char *const names[] = {"samples", "setpoint_updates", "publish_errors"};
+    const uint32_t values[] = {c->samples, c->setpoint_updates, c->publish_errors};
+
+    BUILD_ASSERT(ARRAY_SIZE(names) == ARRAY_SIZE(values));
+    print_u32_record(shell, fmt, RECORD_COUNTERS, names, values, ARRAY_SIZE(values));
+}
+
+static void print_end(const struct shell *shell, enum output_format fmt, uint32_t records)
+{
+    static const char *const names[] = {"records"};
+
+    print_u32_record(shell, fmt, RECORD_END, names, &records, 1);
+}
+
 /**
  * @brief Shell command: set motor speed setpoint.
  *
@@ -44,13 +231,14 @@ static int cmd_motor_set(const struct shell *shell, size_t argc, char **argv)
 
     float rpm = (float)rpm_long;
 
-    int ret = app_state_set_setpoint(rpm);
+    /* Applied by the control loop at its next tick. */
+    int ret = motor_cmd_post_setpoint(rpm);
     if (ret == -ERANGE) {
         shell_error(shell, "rpm out of allowed range");
         return ret;
     } else if (ret != 0) {
-        shell_error(shell, "Failed to set setpoint (err=%d)", ret); /* GCOVR_EXCL_LINE */
-        return ret;                                                 /* GCOVR_EXCL_LINE */
+        shell_error(shell, "Command queue full, try again");
+        return ret;
     }
 
     shell_print(shell, "Setpoint set to %ld rpm", rpm_long);
@@ -59,16 +247,77 @@ static int cmd_motor_set(const struct shell *shell, size_t argc, char **argv)
     return 0;
 }
 
+/**
+ * @brief Shell command: apply a setpoint and profile operations in one tick.
+ *
+ * Usage:
+ *   motor_batch <rpm|stop>...
+ *
+ * Each argument is `stop` (stop the running profile) or a setpoint in rpm,
+ * at most one. Everything is checked before anything is posted; the control
+ * loop then applies the whole batch, in order, at one tick boundary.
+ */
+static int cmd_motor_batch(const struct shell *shell, size_t argc, char **argv)
+{
+    struct motor_cmd cmds[MOTOR_CMD_QUEUE_DEPTH] = {0};
+    size_t count = argc - 1U;
+    size_t setpoints = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const char *arg = argv[i + 1U];
+
+        if (strcmp(arg, "stop") == 0) {
+            cmds[i].type = MOTOR_CMD_PROFILE_STOP;
+            continue;
+        }
+
+        char *end = NULL;
+        long rpm_long = strtol(arg, &end, 10);
+
+        if ((arg == end) || (*end != '\0')) {
+            shell_error(shell, "Invalid command: %s", arg);
+            return -EINVAL;
+        }
+
+        if ((rpm_long < 0) || ((float)rpm_long > APP_STATE_MAX_SETPOINT_RPM)) {
+            shell_error(shell, "rpm out of allowed range: %s", arg);
+            return -ERANGE;
+        }
+
+        if (setpoints++ != 0U) {
+            shell_error(shell, "One setpoint per batch: %s", arg);
+            return -EINVAL;
+        }
+
+        cmds[i].type = MOTOR_CMD_SET_SETPOINT;
+        cmds[i].setpoint_rpm = (float)rpm_long;
+    }
+
+    int ret = motor_cmd_post_batch(cmds, count);
+    if (ret != 0) {
+        shell_error(shell, "Command queue full, try again");
+        return ret;
+    }
+
+    shell_print(shell, "Batch of %u command(s) queued", (unsigned int)count);
+
+    return 0;
+}
+
 /**
  * @brief Shell command: print current motor state snapshot.
  *
  * Usage:
- *   motor_info
+ *   motor_info [text|csv|json|hex]
  */
 static int cmd_motor_info(const struct shell *shell, size_t argc, char **argv)
 {
-    ARG_UNUSED(argc);
-    ARG_UNUSED(argv);
+    enum output_format fmt = OUTPUT_TEXT;
+
+    if ((argc == 2) && (parse_output_format(argv[1], &fmt) != 0)) {
+        shell_error(shell, "Unknown format: %s", argv[1]);
+        return -EINVAL;
+    }
 
     struct motor_state state;
     int ret = app_state_get_snapshot(&state);
@@ -77,6 +326,20 @@ static int cmd_motor_info(const struct shell *shell, size_t argc, char **argv)
         return ret;                                                    /* GCOVR_EXCL_LINE */
     }
 
+    if (fmt != OUTPUT_TEXT) {
+        struct app_state_counters c;
+        (void)app_state_get_counters(&c);
+
+        struct app_state_sample s = {
+            .seq = c.samples,
+            .uptime_ms = k_uptime_get_32(),
+            .state = state,
+        };
+        print_sample(shell, fmt, RECORD_STATE, &s);
+
+        return 0;
+    }
+
     shell_print(shell,
                 "SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C",
                 (int)state.setpoint_rpm,
@@ -87,7 +350,1072 @@ static int cmd_motor_info(const struct shell *shell, size_t argc, char **argv)
     return 0;
 }
 
+/**
+ * @brief Shell command: dump state, counters and history in one response.
+ *
+ * Usage:
+ *   motor_dump [csv|json|hex]
+ *
+ * Prints one `state` record, one `counters` record, up to
+ * APP_STATE_HISTORY_LEN `hist` records (oldest first) and a final `end`
+ * record carrying the number of records printed before it. Defaults to csv.
+ */
+static int cmd_motor_dump(const struct shell *shell, size_t argc, char **argv)
+{
+    /* Shell commands run on the shell thread only: keep the history refs off its stack. */
+    static const struct app_state_sample *hist[APP_STATE_HISTORY_LEN];
+    enum output_format fmt = OUTPUT_CSV;
+
+    if ((argc == 2) &&
+        ((parse_output_format(argv[1], &fmt) != 0) || (fmt == OUTPUT_TEXT))) {
+        shell_error(shell, "Unknown format: %s (use csv, json or hex)", argv[1]);
+        return -EINVAL;
+    }
+
+    struct app_state_counters c;
+    struct app_state_sample now;
+
+    int ret = app_state_get_snapshot(&now.state);
+    if (ret != 0) {
+        shell_error(shell, "Failed to get motor state (err=%d)", ret); /* GCOVR_EXCL_LINE */
+        return ret;                                                    /* GCOVR_EXCL_LINE */
+    }
+    (void)app_state_get_counters(&c);
+    size_t count = app_state_hold_history(hist, ARRAY_SIZE(hist));
+
+    now.seq = c.samples;
+    now.uptime_ms = k_uptime_get_32();
+
+    print_sample(shell, fmt, RECORD_STATE, &now);
+    print_counters(shell, fmt, &c);
+    for (size_t i = 0; i < count; i++) {
+        print_sample(shell, fmt, RECORD_HISTORY, hist[i]);
+        sample_pool_release(hist[i]);
+    }
+    print_end(shell, fmt, (uint32_t)count + 2U);
+
+    return 0;
+}
+
+static void print_thread_usage(const char *name, size_t size, size_t used, void *user_data)
+{
+    const struct shell *shell = user_data;
+
+    shell_print(shell,
+                "  %-20s %6u / %6u B (%u%%)",
+                name,
+                (unsigned int)used,
+                (unsigned int)size,
+                (unsigned int)((used * 100U) / size));
+}
+
+/**
+ * @brief Shell command: print the RAM footprint of the demo.
+ *
+ * Usage:
+ *   motor_mem [budget_bytes]
+ *
+ * Lists the static allocations (per-motor and shared), the per-motor and
+ * shared totals, the stack high-water marks (with CONFIG_THREAD_ANALYZER)
+ * and, if a budget is given, how many motors fit in it.
+ */
+static int cmd_motor_mem(const struct shell *shell, size_t argc, char **argv)
+{
+    long budget = 0;
+
+    if (argc == 2) {
+        char *end = NULL;
+        budget = strtol(argv[1], &end, 10);
+
+        if ((argv[1] == end) || (*end != '\0') || (budget <= 0)) {
+            shell_error(shell, "Invalid budget: %s", argv[1]);
+            return -EINVAL;
+        }
+    }
+
+    const struct mem_report_item *items;
+    size_t count = mem_report_static_items(&items);
+
+    shell_print(shell, "Static RAM:");
+    for (size_t i = 0; i < count; i++) {
+        shell_print(shell,
+                    "  %-14s %-16s %6u B %s",
+                    items[i].module,
+                    items[i].name,
+                    (unsigned int)items[i].bytes,
+                    items[i].per_motor ? "per-motor" : "shared");
+    }
+
+    struct mem_report_budget totals;
+    mem_report_get_budget(&totals);
+    shell_print(shell,
+                "Per motor: %u B, shared: %u B",
+                (unsigned int)totals.per_motor_bytes,
+                (unsigned int)totals.shared_bytes);
+
+    if (budget > 0) {
+        shell_print(shell,
+                    "Motors in %ld B: %u",
+                    budget,
+                    (unsigned int)mem_report_motors_for_budget((size_t)budget));
+    }
+
+    shell_print(shell, "Stacks (used / size):");
+    if (mem_report_threads(print_thread_usage, (void *)shell) != 0) {
+        shell_print(shell, "  enable CONFIG_THREAD_ANALYZER for stack usage"); /* GCOVR_EXCL_LINE */
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: print or clear the app_state runtime statistics.
+ *
+ * Usage:
+ *   motor_stats [reset]
+ *
+ * Shows zbus publish failures, sample overruns (telemetry missed a sample),
+ * the sample pool use and exhaustion count and, per state mutex caller, how
+ * often it had to wait and for how long.
+ */
+static int cmd_motor_stats(const struct shell *shell, size_t argc, char **argv)
+{
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(shell, "Usage: motor_stats [reset]");
+            return -EINVAL;
+        }
+
+        app_state_reset_stats();
+        sample_pool_reset_stats();
+        shell_print(shell, "Statistics cleared");
+        return 0;
+    }
+
+    struct app_state_stats st;
+    struct sample_pool_stats ps;
+    (void)app_state_get_stats(&st);
+    sample_pool_get_stats(&ps);
+
+    shell_print(shell, "publish_errors: %u", st.publish_errors);
+    shell_print(shell, "sample_overruns: %u", st.sample_overruns);
+    shell_print(shell,
+                "sample_pool: %u/%u blocks in use, peak %u, exhausted %u",
+                ps.in_use,
+                ps.blocks,
+                ps.peak_in_use,
+                ps.exhausted);
+    shell_print(shell, "%-16s %10s %10s %14s %12s", "lock caller", "acquired", "contended",
+                "max_wait_cyc", "max_wait_us");
+
+    for (size_t i = 0; i < APP_STATE_CALLER_COUNT; i++) {
+        const struct app_state_lock_stats *ls = &st.lock[i];
+
+        shell_print(shell,
+                    "%-16s %10u %10u %14u %12u",
+                    app_state_caller_name((enum app_state_caller)i),
+                    ls->acquisitions,
+                    ls->contended,
+                    ls->max_wait_cycles,
+                    k_cyc_to_us_ceil32(ls->max_wait_cycles));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: print or clear the per-thread wakeup counts.
+ *
+ * Usage:
+ *   motor_wakeups [reset]
+ *
+ * Shows, for each application thread, how often it woke up since the last
+ * reset and the resulting rate per second.
+ */
+static int cmd_motor_wakeups(const struct shell *shell, size_t argc, char **argv)
+{
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(shell, "Usage: motor_wakeups [reset]");
+            return -EINVAL;
+        }
+
+        wakeups_reset();
+        shell_print(shell, "Wakeup counts cleared");
+        return 0;
+    }
+
+    struct wakeups_report rep;
+    wakeups_get(&rep);
+
+    shell_print(shell, "window_ms: %u", rep.window_ms);
+    shell_print(shell, "%-12s %10s %10s", "thread", "wakeups", "per_s");
+
+    for (size_t i = 0; i < WAKEUPS_THREAD_COUNT; i++) {
+        uint32_t rate = wakeups_rate_centi(rep.count[i], rep.window_ms);
+
+        shell_print(shell,
+                    "%-12s %10u %7u.%02u",
+                    wakeups_thread_name((enum wakeups_thread)i),
+                    rep.count[i],
+                    rate / 100U,
+                    rate % 100U);
+    }
+
+    return 0;
+}
+
+/* Simulated time of @p periods control periods, in seconds. */
+static double lifetime_seconds(uint32_t periods)
+{
+    return ((double)periods * MOTOR_CONTROL_PERIOD_MS) / 1000.0;
+}
+
+static void print_lifetime_records(const struct shell *shell, enum output_format fmt,
+                                   const struct motor_lifetime *lt)
+{
+    static const char *const names[] = {
+        "periods",         "period_ms",       "normal_periods",
+        "soft_periods",    "hard_periods",    "saturated_periods",
+        "derated_periods", "setpoint_changes", "energy_j",
+    };
+    /* Bins are named after their lower edge. */
+    static const char *const temp_names[] = {
+        "t20", "t30", "t40", "t50", "t60", "t70", "t80", "t90", "t100", "t110", "t120",
+    };
+    static const char *const out_names[] = {
+        "o0", "o10", "o20", "o30", "o40", "o50", "o60", "o70", "o80", "o90",
+    };
+    /* Whole joules last 138 days at the rated power; a net return of energy shows as 0. */
+    int64_t energy_j = (lt->energy_mj + 500) / 1000;
+    const uint32_t values[] = {
+        lt->periods,
+        MOTOR_CONTROL_PERIOD_MS,
+        lt->band_periods[MOTOR_LIFETIME_BAND_NORMAL],
+        lt->band_periods[MOTOR_LIFETIME_BAND_SOFT],
+        lt->band_periods[MOTOR_LIFETIME_BAND_HARD],
+        lt->saturated_periods,
+        lt->derated_periods,
+        lt->setpoint_changes,
+        (energy_j > 0) ? (uint32_t)energy_j : 0U,
+    };
+
+    BUILD_ASSERT(ARRAY_SIZE(names) == ARRAY_SIZE(values));
+    BUILD_ASSERT(ARRAY_SIZE(temp_names) == MOTOR_LIFETIME_TEMP_BINS);
+    BUILD_ASSERT(ARRAY_SIZE(out_names) == MOTOR_LIFETIME_OUT_BINS);
+
+    print_u32_record(shell, fmt, RECORD_LIFETIME, names, values, ARRAY_SIZE(values));
+    print_u32_record(shell, fmt, RECORD_TEMP_HIST, temp_names, lt->temp_hist,
+                     MOTOR_LIFETIME_TEMP_BINS);
+    print_u32_record(shell, fmt, RECORD_OUT_HIST, out_names, lt->out_hist,
+                     MOTOR_LIFETIME_OUT_BINS);
+    print_end(shell, fmt, 3U);
+}
+
+static void print_lifetime_text(const struct shell *shell, const struct motor_lifetime *lt)
+{
+    shell_print(shell, "time: %.3f s (%u periods)", lifetime_seconds(lt->periods), lt->periods);
+    shell_print(shell,
+                "bands: normal %.3f s, soft %.3f s, hard %.3f s",
+                lifetime_seconds(lt->band_periods[MOTOR_LIFETIME_BAND_NORMAL]),
+                lifetime_seconds(lt->band_periods[MOTOR_LIFETIME_BAND_SOFT]),
+                lifetime_seconds(lt->band_periods[MOTOR_LIFETIME_BAND_HARD]));
+    shell_print(shell,
+                "saturated: %.3f s, derated: %.3f s",
+                lifetime_seconds(lt->saturated_periods),
+                lifetime_seconds(lt->derated_periods));
+    shell_print(shell, "energy: %.3f J", (double)lt->energy_mj / 1000.0);
+    shell_print(shell, "setpoint_changes: %u", lt->setpoint_changes);
+
+    /* Bins by lower edge; the first and last temperature bins are open-ended. */
+    shell_print(shell, "%-10s %10s", "temp_c", "periods");
+    for (uint32_t i = 0; i < MOTOR_LIFETIME_TEMP_BINS; i++) {
+        float lo = MOTOR_LIFETIME_TEMP_BIN_BASE_C + ((float)i * MOTOR_LIFETIME_TEMP_BIN_WIDTH_C);
+
+        shell_print(shell, "  %-8d %10u", (int)lo, lt->temp_hist[i]);
+    }
+
+    shell_print(shell, "%-10s %10s", "out_pct", "periods");
+    for (uint32_t i = 0; i < MOTOR_LIFETIME_OUT_BINS; i++) {
+        float lo = (float)i * MOTOR_LIFETIME_OUT_BIN_WIDTH_PCT;
+
+        shell_print(shell, "  %-8d %10u", (int)lo, lt->out_hist[i]);
+    }
+}
+
+/**
+ * @brief Shell command: print, export or clear the lifetime statistics.
+ *
+ * Usage:
+ *   motor_lifetime [reset|csv|json|hex]
+ *
+ * Without an argument, prints the time per temperature band, in saturation
+ * and derated, the energy, the setpoint changes and both histograms. The
+ * machine-readable formats print a `lifetime` record (times in periods of
+ * `period_ms`), a `temp_hist` and an `out_hist` record (periods per bin) and
+ * the `end` record, all read in one call.
+ */
+static int cmd_motor_lifetime(const struct shell *shell, size_t argc, char **argv)
+{
+    enum output_format fmt = OUTPUT_TEXT;
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") == 0) {
+            motor_control_reset_lifetime();
+            shell_print(shell, "Lifetime statistics cleared");
+            return 0;
+        }
+
+        if (parse_output_format(argv[1], &fmt) != 0) {
+            shell_error(shell, "Usage: motor_lifetime [reset|csv|json|hex]");
+            return -EINVAL;
+        }
+    }
+
+    struct motor_lifetime lt;
+    motor_control_get_lifetime(&lt);
+
+    if (fmt == OUTPUT_TEXT) {
+        print_lifetime_text(shell, &lt);
+    } else {
+        print_lifetime_records(shell, fmt, &lt);
+    }
+
+    return 0;
+}
+
+/** How long a profile command waits for the control loop to run it (ms). */
+#define PROFILE_LOOP_TIMEOUT_MS 1000
+
+/**
+ * @brief A profile command handed to the control loop.
+ *
+ * The player is the loop's: the shell posts a MOTOR_CMD_CALL and waits for
+ * the tick that runs it, so profile commands apply in the order they were
+ * issued relative to the setpoints queued around them, and their result is
+ * known before it is printed. Same generation scheme as checkpoint requests:
+ * a call left queued by a timeout does nothing when the loop drains it.
+ */
+struct profile_request {
+    struct trajectory_segment segs[TRAJECTORY_MAX_SEGMENTS];
+    size_t count;
+    uint32_t passes;
+    int ret;
+    /** Generation the loop may still run, 0 when none. */
+    atomic_t armed;
+    /** Generation of the last call posted (profile_mutex). */
+    uint32_t gen;
+};
+
+static struct profile_request profile_req;
+static K_SEM_DEFINE(profile_done, 0, 1);
+/* Shell backends each run their own thread. */
+static K_MUTEX_DEFINE(profile_mutex);
+
+/* Claim the request for the call posted with generation @p arg; false if stale. */
+static bool profile_claim(void *arg)
+{
+    return atomic_cas(&profile_req.armed, (atomic_val_t)(uintptr_t)arg, 0);
+}
+
+static void profile_load_call(void *arg)
+{
+    if (!profile_claim(arg)) {
+        return;
+    }
+
+    profile_req.ret = trajectory_load(profile_req.segs, profile_req.count);
+    k_sem_give(&profile_done);
+}
+
+static void profile_start_call(void *arg)
+{
+    if (!profile_claim(arg)) {
+        return;
+    }
+
+    /* From the setpoint in force at this tick, queued ones included. */
+    struct motor_state state;
+    profile_req.ret = app_state_get_snapshot(&state);
+    if (profile_req.ret == 0) {
+        profile_req.ret = trajectory_start(state.setpoint_rpm, profile_req.passes);
+    }
+    k_sem_give(&profile_done);
+}
+
+static void profile_stop_call(void *arg)
+{
+    if (!profile_claim(arg)) {
+        return;
+    }
+
+    trajectory_stop();
+    profile_req.ret = 0;
+    k_sem_give(&profile_done);
+}
+
+/**
+ * @brief Run @p fn on the control loop and wait for its result.
+ *
+ * The caller holds profile_mutex.
+ *
+ * @return The result of @p fn, -ENOSPC if the command queue is full, -EAGAIN
+ *         if the loop did not run it within PROFILE_LOOP_TIMEOUT_MS.
+ */
+static int profile_run_on_loop(void (*fn)(void *arg))
+{
+    /* Never 0, which means no call is armed. */
+    profile_req.gen = (profile_req.gen == UINT32_MAX) ? 1U : (profile_req.gen + 1U);
+
+    const struct motor_cmd cmd = {
+        .type = MOTOR_CMD_CALL,
+        .fn = fn,
+        .arg = (void *)(uintptr_t)profile_req.gen,
+    };
+
+    k_sem_reset(&profile_done);
+    atomic_set(&profile_req.armed, (atomic_val_t)profile_req.gen);
+
+    int ret = motor_cmd_post(&cmd);
+    if (ret != 0) {
+        atomic_clear(&profile_req.armed);
+        return ret;
+    }
+
+    if (k_sem_take(&profile_done, K_MSEC(PROFILE_LOOP_TIMEOUT_MS)) != 0) {
+        if (atomic_cas(&profile_req.armed, (atomic_val_t)profile_req.gen, 0)) {
+            return -EAGAIN;
+        }
+
+        /* The loop claimed the call just now: it is running, let it finish. */
+        (void)k_sem_take(&profile_done, K_FOREVER);
+    }
+
+    return profile_req.ret;
+}
+
+/* Report a failure of profile_run_on_loop() itself, not of the command. */
+static int profile_loop_error(const struct shell *shell, int ret)
+{
+    if (ret == -ENOSPC) {
+        shell_error(shell, "Command queue full, try again");
+    } else {
+        shell_error(shell, "Control loop not running, command dropped");
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Shell command: load a setpoint profile.
+ *
+ * Usage:
+ *   motor_profile load <seg> [<seg> ...]
+ *
+ * Each segment uses the compact form accepted by trajectory_parse_segment(),
+ * e.g. `ramp:3000:2000 step:3000:5000 sine:2000:10000:500:100:2000`. The
+ * control loop loads it at its next tick.
+ */
+static int cmd_motor_profile_load(const struct shell *shell, size_t argc, char **argv)
+{
+    struct trajectory_segment segs[TRAJECTORY_MAX_SEGMENTS];
+    /* The shell limits argc to TRAJECTORY_MAX_SEGMENTS optional arguments. */
+    size_t count = argc - 1U;
+
+    for (size_t i = 0; i < count; i++) {
+        if (trajectory_parse_segment(argv[i + 1U], &segs[i]) != 0) {
+            shell_error(shell, "Invalid segment: %s", argv[i + 1U]);
+            return -EINVAL;
+        }
+    }
+
+    k_mutex_lock(&profile_mutex, K_FOREVER);
+    memcpy(profile_req.segs, segs, count * sizeof(segs[0]));
+    profile_req.count = count;
+    int ret = profile_run_on_loop(profile_load_call);
+    k_mutex_unlock(&profile_mutex);
+
+    if ((ret == -ENOSPC) || (ret == -EAGAIN)) {
+        return profile_loop_error(shell, ret);
+    } else if (ret == -EBUSY) {
+        shell_error(shell, "Profile running, stop it first");
+        return ret;
+    } else if (ret != 0) {
+        shell_error(shell, "Profile rejected (err=%d)", ret);
+        return ret;
+    }
+
+    shell_print(shell, "Profile loaded: %u segments", (unsigned int)count);
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: start the loaded profile.
+ *
+ * Usage:
+ *   motor_profile start [passes]
+ *
+ * passes defaults to 1; 0 repeats the profile until stopped. The control
+ * loop starts it at its next tick, from the setpoint in force then.
+ */
+static int cmd_motor_profile_start(const struct shell *shell, size_t argc, char **argv)
+{
+    long passes = 1;
+
+    if (argc == 2) {
+        char *end = NULL;
+        passes = strtol(argv[1], &end, 10);
+
+        if ((argv[1] == end) || (*end != '\0') || (passes < 0)) {
+            shell_error(shell, "Invalid passes value: %s", argv[1]);
+            return -EINVAL;
+        }
+    }
+
+    k_mutex_lock(&profile_mutex, K_FOREVER);
+    profile_req.passes = (uint32_t)passes;
+    int ret = profile_run_on_loop(profile_start_call);
+    k_mutex_unlock(&profile_mutex);
+
+    if ((ret == -ENOSPC) || (ret == -EAGAIN)) {
+        return profile_loop_error(shell, ret);
+    } else if (ret != 0) {
+        shell_error(shell, "No profile loaded");
+        return ret;
+    }
+
+    shell_print(shell, "Profile started");
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: stop the running profile.
+ *
+ * Usage:
+ *   motor_profile stop
+ *
+ * The control loop stops it at its next tick.
+ */
+static int cmd_motor_profile_stop(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    k_mutex_lock(&profile_mutex, K_FOREVER);
+    int ret = profile_run_on_loop(profile_stop_call);
+    k_mutex_unlock(&profile_mutex);
+
+    if (ret != 0) {
+        return profile_loop_error(shell, ret);
+    }
+
+    shell_print(shell, "Profile stopped");
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: print the profile player status.
+ *
+ * Usage:
+ *   motor_profile status
+ */
+static int cmd_motor_profile_status(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    struct trajectory_status st;
+    (void)trajectory_get_status(&st);
+
+    shell_print(shell,
+                "%s, SEG=%u/%u, T=%u ms, PASSES_LEFT=%u, SP=%d rpm",
+                st.active ? "running" : "idle",
+                (unsigned int)st.segment_index,
+                (unsigned int)st.segment_count,
+                st.elapsed_ms,
+                st.passes_left,
+                (int)st.setpoint_rpm);
+
+    return 0;
+}
+
+/* Parse a non-negative number (gain, amplitude, hysteresis). */
+static int parse_non_negative(const char *arg, float *out)
+{
+    char *end = NULL;
+    float value = strtof(arg, &end);
+
+    if ((arg == end) || (*end != '\0') || !(value >= 0.0f)) {
+        return -EINVAL;
+    }
+
+    *out = value;
+    return 0;
+}
+
+/**
+ * @brief Shell command: print or set the speed controller gains.
+ *
+ * Usage:
+ *   motor_gains [<kp> <ki> <kd>]
+ *
+ * Gains are in % of output per period for a speed of max_rpm (see
+ * motor_pid.h). New gains are applied by the control loop at its next tick.
+ */
+static int cmd_motor_gains(const struct shell *shell, size_t argc, char **argv)
+{
+    if (argc == 1) {
+        struct motor_control_tuning t;
+
+        motor_control_get_tuning(&t);
+        shell_print(shell, "KP=%.3f KI=%.3f KD=%.3f", (double)t.gains.kp_pct,
+                    (double)t.gains.ki_pct, (double)t.gains.kd_pct);
+        return 0;
+    }
+
+    struct motor_pid_gains gains;
+
+    if ((argc != 4) || (parse_non_negative(argv[1], &gains.kp_pct) != 0) ||
+        (parse_non_negative(argv[2], &gains.ki_pct) != 0) ||
+        (parse_non_negative(argv[3], &gains.kd_pct) != 0)) {
+        shell_error(shell, "Usage: motor_gains [<kp> <ki> <kd>], non-negative");
+        return -EINVAL;
+    }
+
+    int ret = motor_control_set_gains(&gains);
+    if (ret == -EINVAL) {
+        shell_error(shell, "Gains must be finite");
+        return ret;
+    } else if (ret != 0) {
+        shell_error(shell, "Command queue full, try again");
+        return ret;
+    }
+
+    shell_print(shell, "Gains set");
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: start the relay auto-tuner.
+ *
+ * Usage:
+ *   motor_tune start [amplitude_pct] [hysteresis_rpm]
+ *
+ * Run it with the motor settled at the setpoint the gains are wanted for.
+ */
+static int cmd_motor_tune_start(const struct shell *shell, size_t argc, char **argv)
+{
+    struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+
+    if (((argc >= 2) && (parse_non_negative(argv[1], &cfg.amplitude_pct) != 0)) ||
+        ((argc >= 3) && (parse_non_negative(argv[2], &cfg.hysteresis_rpm) != 0))) {
+        shell_error(shell, "Invalid relay setting");
+        return -EINVAL;
+    }
+
+    int ret = motor_control_tune_start(&cfg);
+    if (ret == -EINVAL) {
+        shell_error(shell, "Cannot tune: amplitude must be 0..100 and the output off its limits");
+        return ret;
+    } else if (ret == -EBUSY) {
+        shell_error(shell, "Auto-tune already running");
+        return ret;
+    } else if (ret != 0) {
+        shell_error(shell, "Command queue full, try again");
+        return ret;
+    }
+
+    shell_print(shell, "Auto-tune started");
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: abort the relay auto-tuner.
+ *
+ * Usage:
+ *   motor_tune stop
+ */
+static int cmd_motor_tune_stop(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    int ret = motor_control_tune_stop();
+    if (ret != 0) {
+        shell_error(shell, "Command queue full, try again");
+        return ret;
+    }
+
+    shell_print(shell, "Auto-tune stopped");
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: print the auto-tuner state and identified model.
+ *
+ * Usage:
+ *   motor_tune status
+ */
+static int cmd_motor_tune_status(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    static const char *const names[] = {
+        [MOTOR_PID_TUNE_IDLE] = "idle",
+        [MOTOR_PID_TUNE_RUNNING] = "running",
+        [MOTOR_PID_TUNE_DONE] = "done",
+        [MOTOR_PID_TUNE_FAILED] = "failed",
+    };
+    struct motor_control_tuning t;
+
+    motor_control_get_tuning(&t);
+
+    shell_print(shell,
+                "%s, K=%.2f rpm/%%, T=%.2f, L=%.2f, Tu=%.2f periods, A=%.1f rpm, "
+                "KP=%.3f KI=%.3f KD=%.3f",
+                names[t.status],
+                (double)t.ident.gain_rpm_per_pct,
+                (double)t.ident.time_constant,
+                (double)t.ident.dead_time,
+                (double)t.ident.cycle_periods,
+                (double)t.ident.cycle_amp_rpm,
+                (double)t.gains.kp_pct,
+                (double)t.gains.ki_pct,
+                (double)t.gains.kd_pct);
+
+    return 0;
+}
+
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+/**
+ * @brief Shell command: drain the event log.
+ *
+ * Usage:
+ *   motor_evlog dump
+ *
+ * Prints every pending record as an `event` hex frame (oldest first) and a
+ * final `end` frame carrying the number of records printed before it. The
+ * records leave the ring; host/evlog_decode renders their text.
+ */
+static int cmd_motor_evlog_dump(const struct shell *shell, size_t argc, char **argv)
+{
+    /* Shell commands run on the shell thread only: keep the records off its stack. */
+    static struct motor_evlog_record recs[EVLOG_DRAIN_CHUNK];
+    uint32_t records = 0;
+    size_t count;
+
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    /* At most one ring's worth, so new records cannot keep the command going. */
+    do {
+        count = evlog_drain(recs, ARRAY_SIZE(recs));
+        for (size_t i = 0; i < count; i++) {
+            uint8_t payload[MOTOR_EVLOG_RECORD_LEN];
+
+            motor_evlog_encode(payload, &recs[i]);
+            print_frame(shell, RECORD_EVENT, payload, sizeof(payload));
+        }
+        records += (uint32_t)count;
+    } while ((count == ARRAY_SIZE(recs)) && (records < CONFIG_MOTOR_SIM_EVLOG_RECORDS));
+
+    print_end(shell, OUTPUT_HEX, records);
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: print the event log counters.
+ *
+ * Usage:
+ *   motor_evlog stats
+ */
+static int cmd_motor_evlog_stats(const struct shell *shell, size_t argc, char **argv)
+{
+    struct evlog_stats st;
+
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    evlog_get_stats(&st);
+    shell_print(shell, "evlog: %u/%u records pending, written %u, overwritten %u", st.pending,
+                st.capacity, st.written, st.overwritten);
+
+    return 0;
+}
+#endif /* CONFIG_MOTOR_SIM_EVLOG */
+
+#if defined(CONFIG_MOTOR_SIM_CHECKPOINT)
+/**
+ * @brief Shell command: store the simulation state under a name.
+ *
+ * Usage:
+ *   motor_ckpt save <name>
+ */
+static int cmd_motor_ckpt_save(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    int ret = checkpoint_save(argv[1]);
+    if (ret != 0) {
+        shell_error(shell, "Checkpoint '%s' not saved (err=%d)", argv[1], ret);
+        return ret;
+    }
+
+    shell_print(shell, "Checkpoint '%s' saved", argv[1]);
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: resume a stored simulation state.
+ *
+ * Usage:
+ *   motor_ckpt load <name>
+ */
+static int cmd_motor_ckpt_load(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    int ret = checkpoint_load(argv[1]);
+    if (ret == -ENOENT) {
+        shell_error(shell, "No checkpoint '%s'", argv[1]);
+        return ret;
+    } else if (ret != 0) {
+        shell_error(shell, "Checkpoint '%s' not resumed (err=%d)", argv[1], ret);
+        return ret;
+    }
+
+    struct motor_state state;
+    (void)app_state_get_snapshot(&state);
+
+    shell_print(shell, "Checkpoint '%s' resumed: SP=%d rpm, MEAS=%d rpm, T=%d C", argv[1],
+                (int)state.setpoint_rpm, (int)state.measured_rpm, (int)state.temperature_c);
+
+    return 0;
+}
+
+/**
+ * @brief Shell command: delete a stored checkpoint.
+ *
+ * Usage:
+ *   motor_ckpt rm <name>
+ */
+static int cmd_motor_ckpt_rm(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    int ret = checkpoint_delete(argv[1]);
+    if (ret != 0) {
+        shell_error(shell, "Checkpoint '%s' not deleted (err=%d)", argv[1], ret);
+        return ret;
+    }
+
+    shell_print(shell, "Checkpoint '%s' deleted", argv[1]);
+
+    return 0;
+}
+
+static void print_checkpoint(const char *name, const struct checkpoint *cp, void *user)
+{
+    const struct shell *shell = user;
+
+    if (cp == NULL) {
+        shell_print(shell, "  %s (unreadable)", name);
+        return;
+    }
+
+    shell_print(shell, "  %s: SP=%d rpm, MEAS=%d rpm, T=%d C, samples=%u", name,
+                (int)cp->state.setpoint_rpm, (int)cp->state.measured_rpm,
+                (int)cp->state.temperature_c, cp->counters.samples);
+}
+
+/**
+ * @brief Shell command: list the stored checkpoints.
+ *
+ * Usage:
+ *   motor_ckpt list
+ */
+static int cmd_motor_ckpt_list(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    int count = checkpoint_list(print_checkpoint, (void *)shell);
+    if (count < 0) {
+        shell_error(shell, "Cannot read checkpoints (err=%d)", count); /* GCOVR_EXCL_LINE */
+        return count;                                                   /* GCOVR_EXCL_LINE */
+    }
+
+    shell_print(shell, "%d checkpoint(s)", count);
+
+    return 0;
+}
+#endif /* CONFIG_MOTOR_SIM_CHECKPOINT */
+
+/**
+ * @brief Define traced_<handler>(), which brackets a shell handler with trace events.
+ *
+ * The stage name is limited to 20 characters (see app_trace.h).
+ */
+#define TRACED_SHELL_HANDLER(handler, stage)                                                       \
+    static int traced_##handler(const struct shell *shell, size_t argc, char **argv)               \
+    {                                                                                              \
+        APP_TRACE_BEGIN(stage);                                                                    \
+        int ret = handler(shell, argc, argv);                                                      \
+        APP_TRACE_END(stage);                                                                      \
+        return ret;                                                                                \
+    }
+
+TRACED_SHELL_HANDLER(cmd_motor_set, "sh:motor_set")
+TRACED_SHELL_HANDLER(cmd_motor_batch, "sh:motor_batch")
+TRACED_SHELL_HANDLER(cmd_motor_info, "sh:motor_info")
+TRACED_SHELL_HANDLER(cmd_motor_dump, "sh:motor_dump")
+TRACED_SHELL_HANDLER(cmd_motor_mem, "sh:motor_mem")
+TRACED_SHELL_HANDLER(cmd_motor_stats, "sh:motor_stats")
+TRACED_SHELL_HANDLER(cmd_motor_wakeups, "sh:motor_wakeups")
+TRACED_SHELL_HANDLER(cmd_motor_lifetime, "sh:motor_lifetime")
+TRACED_SHELL_HANDLER(cmd_motor_profile_load, "sh:profile_load")
+TRACED_SHELL_HANDLER(cmd_motor_profile_start, "sh:profile_start")
+TRACED_SHELL_HANDLER(cmd_motor_profile_stop, "sh:profile_stop")
+TRACED_SHELL_HANDLER(cmd_motor_profile_status, "sh:profile_status")
+TRACED_SHELL_HANDLER(cmd_motor_gains, "sh:motor_gains")
+TRACED_SHELL_HANDLER(cmd_motor_tune_start, "sh:tune_start")
+TRACED_SHELL_HANDLER(cmd_motor_tune_stop, "sh:tune_stop")
+TRACED_SHELL_HANDLER(cmd_motor_tune_status, "sh:tune_status")
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+TRACED_SHELL_HANDLER(cmd_motor_evlog_dump, "sh:evlog_dump")
+TRACED_SHELL_HANDLER(cmd_motor_evlog_stats, "sh:evlog_stats")
+#endif
+#if defined(CONFIG_MOTOR_SIM_CHECKPOINT)
+TRACED_SHELL_HANDLER(cmd_motor_ckpt_save, "sh:ckpt_save")
+TRACED_SHELL_HANDLER(cmd_motor_ckpt_load, "sh:ckpt_load")
+TRACED_SHELL_HANDLER(cmd_motor_ckpt_rm, "sh:ckpt_rm")
+TRACED_SHELL_HANDLER(cmd_motor_ckpt_list, "sh:ckpt_list")
+#endif
+
 /* Register shell commands. */
-SHELL_CMD_REGISTER(motor_set, NULL, "Set motor speed setpoint (rpm)", cmd_motor_set);
+SHELL_CMD_REGISTER(motor_set, NULL, "Set motor speed setpoint (rpm)", traced_cmd_motor_set);
+
+SHELL_CMD_ARG_REGISTER(motor_batch,
+                       NULL,
+                       "Apply a setpoint and profile stops in one tick <rpm|stop>...",
+                       traced_cmd_motor_batch,
+                       2,
+                       MOTOR_CMD_QUEUE_DEPTH - 1);
+
+SHELL_CMD_ARG_REGISTER(motor_info,
+                       NULL,
+                       "Print current motor state snapshot [text|csv|json|hex]",
+                       traced_cmd_motor_info,
+                       1,
+                       1);
+
+SHELL_CMD_ARG_REGISTER(motor_dump,
+                       NULL,
+                       "Dump state, counters and history [csv|json|hex]",
+                       traced_cmd_motor_dump,
+                       1,
+                       1);
+
+SHELL_CMD_ARG_REGISTER(motor_mem,
+                       NULL,
+                       "Print RAM footprint and motors per budget [budget_bytes]",
+                       traced_cmd_motor_mem,
+                       1,
+                       1);
+
+SHELL_CMD_ARG_REGISTER(motor_stats,
+                       NULL,
+                       "Print publish/overrun/lock-wait statistics [reset]",
+                       traced_cmd_motor_stats,
+                       1,
+                       1);
+
+SHELL_CMD_ARG_REGISTER(motor_wakeups,
+                       NULL,
+                       "Print wakeups per thread and per second [reset]",
+                       traced_cmd_motor_wakeups,
+                       1,
+                       1);
+
+SHELL_CMD_ARG_REGISTER(motor_lifetime,
+                       NULL,
+                       "Print or export lifetime statistics [reset|csv|json|hex]",
+                       traced_cmd_motor_lifetime,
+                       1,
+                       1);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    motor_profile_cmds,
+    SHELL_CMD_ARG(load,
+                  NULL,
+                  "Load profile: step:<rpm>:<ms> ramp:<rpm>:<ms> "
+                  "sine:<rpm>:<ms>:<amp>:<f0_mhz>:<f1_mhz>",
+                  traced_cmd_motor_profile_load,
+                  2,
+                  TRAJECTORY_MAX_SEGMENTS),
+    SHELL_CMD_ARG(start,
+                  NULL,
+                  "Start profile [passes, 0=forever]",
+                  traced_cmd_motor_profile_start,
+                  1,
+                  1),
+    SHELL_CMD_ARG(stop, NULL, "Stop profile", traced_cmd_motor_profile_stop, 1, 0),
+    SHELL_CMD_ARG(status, NULL, "Print profile status", traced_cmd_motor_profile_status, 1, 0),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(motor_profile, &motor_profile_cmds, "Setpoint profile generator", NULL);
+
+SHELL_CMD_ARG_REGISTER(motor_gains,
+                       NULL,
+                       "Print or set speed controller gains [kp ki kd]",
+                       traced_cmd_motor_gains,
+                       1,
+                       3);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    motor_tune_cmds,
+    SHELL_CMD_ARG(start,
+                  NULL,
+                  "Start relay auto-tune [amplitude_pct] [hysteresis_rpm]",
+                  traced_cmd_motor_tune_start,
+                  1,
+                  2),
+    SHELL_CMD_ARG(stop, NULL, "Abort auto-tune", traced_cmd_motor_tune_stop, 1, 0),
+    SHELL_CMD_ARG(status, NULL, "Print auto-tune state and model", traced_cmd_motor_tune_status,
+                  1, 0),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(motor_tune, &motor_tune_cmds, "Speed controller auto-tuning", NULL);
+
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    motor_evlog_cmds,
+    SHELL_CMD_ARG(dump, NULL, "Drain the event records as hex frames", traced_cmd_motor_evlog_dump,
+                  1, 0),
+    SHELL_CMD_ARG(stats, NULL, "Print event log counters", traced_cmd_motor_evlog_stats, 1, 0),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(motor_evlog, &motor_evlog_cmds, "Binary event log", NULL);
+#endif
+
+#if defined(CONFIG_MOTOR_SIM_CHECKPOINT)
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    motor_ckpt_cmds,
+    SHELL_CMD_ARG(save, NULL, "Save the simulation state <name>", traced_cmd_motor_ckpt_save, 2,
+                  0),
+    SHELL_CMD_ARG(load, NULL, "Resume a saved state <name>", traced_cmd_motor_ckpt_load, 2, 0),
+    SHELL_CMD_ARG(rm, NULL, "Delete a saved state <name>", traced_cmd_motor_ckpt_rm, 2, 0),
+    SHELL_CMD_ARG(list, NULL, "List saved states", traced_cmd_motor_ckpt_list, 1, 0),
+    SHELL_SUBCMD_SET_END);
 
-SHELL_CMD_REGISTER(motor_info, NULL, "Print current motor state snapshot", cmd_motor_info);
+SHELL_CMD_REGISTER(motor_ckpt, &motor_ckpt_cmds, "Simulation checkpoints", NULL);
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file cyclic_exec.h
+ * @brief Public API for the optional cyclic executive.
+ *
+ * The cyclic executive runs the control, telemetry and fault monitor bodies as
+ * ordered slots of a fixed minor frame inside a single thread, instead of one
+ * thread (or work item) per module. It is enabled with
+ * CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE and runs on the main thread.
+ */
+
+#ifndef CYCLIC_EXEC_H_
+#define CYCLIC_EXEC_H_
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#include "motor_control.h"
+
+/** Minor frame length: one control period. */
+#define CYCLIC_EXEC_FRAME_MS MOTOR_CONTROL_PERIOD_MS
+
+/** Fault slot runs once every this many frames (2 s). */
+#define CYCLIC_EXEC_FAULT_DIVIDER 40U
+
+/**
+ * @brief Cyclic executive statistics.
+ */
+struct cyclic_exec_stats {
+    uint32_t frames;         /**< Frames executed. */
+    uint32_t overruns;       /**< Frames that finished after the next frame start. */
+    uint32_t control_runs;   /**< Control slot executions. */
+    uint32_t telemetry_runs; /**< Telemetry slot executions. */
+    uint32_t fault_runs;     /**< Fault slot executions. */
+};
+
+/**
+ * @brief Run the executive forever on the calling thread.
+ *
+ * Frames start on an absolute time grid (no drift). If a frame overruns, the
+ * grid is re-anchored to the current time and the overrun is counted.
+ */
+FUNC_NORETURN void cyclic_exec_run(void);
+
+/**
+ * @brief Execute the slots due in one frame.
+ *
+ * Slot order is fixed: control, telemetry, then fault (every
+ * CYCLIC_EXEC_FAULT_DIVIDER frames, starting with the first frame).
+ *
+ * @param now_ms Frame start time in ms.
+ */
+void cyclic_exec_run_frame(int64_t now_ms);
+
+/**
+ * @brief Get a copy of the executive statistics.
+ *
+ * @param out Statistics to fill. Must not be NULL.
+ */
+void cyclic_exec_get_stats(struct cyclic_exec_stats *out);
+
+#endif /* CYCLIC_EXEC_H_ */
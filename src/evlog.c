@@ -0,0 +1,81 @@
+/**
+ * @file evlog.c
+ * @brief Binary event log implementation.
+ *
+ * A ring of CONFIG_MOTOR_SIM_EVLOG_RECORDS records guarded by a spinlock.
+ * Positions are the free-running record sequence numbers, so a record's slot
+ * is its sequence number modulo the capacity and the number of pending
+ * records is the difference between the write and read positions.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "evlog.h"
+
+#define EVLOG_RECORDS CONFIG_MOTOR_SIM_EVLOG_RECORDS
+
+static struct motor_evlog_record ring[EVLOG_RECORDS];
+static struct k_spinlock evlog_lock;
+
+/* Sequence number of the next record, and of the oldest pending one. */
+static uint32_t write_seq;
+static uint32_t read_seq;
+static uint32_t overwritten;
+
+void evlog_put(enum motor_evlog_id id, const struct motor_state *state)
+{
+    uint32_t now_ms = k_uptime_get_32();
+    k_spinlock_key_t key = k_spin_lock(&evlog_lock);
+    struct motor_evlog_record *rec = &ring[write_seq % EVLOG_RECORDS];
+
+    if ((write_seq - read_seq) == EVLOG_RECORDS) {
+        read_seq++;
+        overwritten++;
+    }
+
+    rec->id = (uint32_t)id;
+    rec->seq = write_seq++;
+    rec->uptime_ms = now_ms;
+    rec->state = *state;
+
+    k_spin_unlock(&evlog_lock, key);
+}
+
+size_t evlog_drain(struct motor_evlog_record *out, size_t max)
+{
+    size_t count = 0;
+    k_spinlock_key_t key = k_spin_lock(&evlog_lock);
+
+    while ((count < max) && (read_seq != write_seq)) {
+        out[count++] = ring[read_seq++ % EVLOG_RECORDS];
+    }
+
+    k_spin_unlock(&evlog_lock, key);
+
+    return count;
+}
+
+void evlog_get_stats(struct evlog_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&evlog_lock);
+
+    out->capacity = EVLOG_RECORDS;
+    out->pending = write_seq - read_seq;
+    out->written = write_seq;
+    out->overwritten = overwritten;
+
+    k_spin_unlock(&evlog_lock, key);
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void evlog_test_reset(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&evlog_lock);
+
+    write_seq = 0;
+    read_seq = 0;
+    overwritten = 0;
+
+    k_spin_unlock(&evlog_lock, key);
+}
+#endif
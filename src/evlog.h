@@ -0,0 +1,68 @@
+/**
+ * @file evlog.h
+ * @brief Binary event log for the telemetry and fault reports.
+ *
+ * With CONFIG_MOTOR_SIM_EVLOG the telemetry thread and the fault monitor
+ * record their reports as fixed-size records of raw values
+ * (lib/motor_model/include/motor_evlog.h) in a RAM ring, instead of
+ * formatting log text on the target. Recording an event copies one record
+ * under a spinlock; the shell drains the ring and host/evlog_decode renders
+ * the text. See docs/evlog.md.
+ */
+
+#ifndef EVLOG_H_
+#define EVLOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "motor_evlog.h"
+#include "motor_model.h"
+
+/** Records motor_evlog dump moves out of the ring per evlog_drain() call. */
+#define EVLOG_DRAIN_CHUNK 16
+
+/**
+ * @brief Event log counters.
+ */
+struct evlog_stats {
+    uint32_t capacity;    /**< Records the ring holds (CONFIG_MOTOR_SIM_EVLOG_RECORDS). */
+    uint32_t pending;     /**< Records waiting to be drained. */
+    uint32_t written;     /**< Records written since boot. */
+    uint32_t overwritten; /**< Records replaced before they were drained. */
+};
+
+/**
+ * @brief Record one event.
+ *
+ * Never blocks and never formats: takes the uptime and copies @p state into
+ * the next ring slot. A full ring loses its oldest record.
+ *
+ * @param id    Event to record.
+ * @param state Values the host renders the text from. Must not be NULL.
+ */
+void evlog_put(enum motor_evlog_id id, const struct motor_state *state);
+
+/**
+ * @brief Move the oldest pending records out of the ring.
+ *
+ * @param out Records, oldest first. Must not be NULL.
+ * @param max Capacity of @p out.
+ *
+ * @return Number of records copied, 0 when the ring is empty.
+ */
+size_t evlog_drain(struct motor_evlog_record *out, size_t max);
+
+/**
+ * @brief Get the event log counters.
+ *
+ * @param out Counters to fill. Must not be NULL.
+ */
+void evlog_get_stats(struct evlog_stats *out);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Empty the ring and clear the counters (test-only helper). */
+void evlog_test_reset(void);
+#endif
+
+#endif /* EVLOG_H_ */
@@ -3,24 +3,32 @@
  * @brief Fault monitor work item implementation.
  *
  * Implements a delayable work handler that periodically evaluates
- * speed/temperature conditions and logs faults.
+ * speed/temperature conditions and logs faults. The work item runs on a
+ * dedicated work queue, so shell, logging or other subsystem work queued on
+ * the system work queue cannot delay fault detection.
+ *
+ * When a period passes without a state change and the last checked state is
+ * clear of every threshold, the check would only repeat the previous result.
+ * The monitor then stops the timer and waits with k_work_poll on a signal
+ * app_state raises on the next change, so a settled motor does not wake
+ * fault_wq at all.
  */
 
+#include <errno.h>
+#include <math.h>
+
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 #include "fault_monitor.h"
 #include "app_state.h"
+#include "app_trace.h"
+#include "evlog.h"
+#include "motor_model.h"
+#include "wakeups.h"
 
 LOG_MODULE_REGISTER(fault_monitor, LOG_LEVEL_INF);
 
-/** Period of the fault monitor work item. */
-#ifdef MOTOR_SIM_DEMO_UNIT_TEST
-#define FAULT_MONITOR_PERIOD K_MSEC(20)
-#else
-#define FAULT_MONITOR_PERIOD K_SECONDS(2)
-#endif
-
 /** Absolute speed error threshold (RPM). */
 #define FAULT_SPEED_ERROR_RPM 300.0f
 
@@ -30,11 +38,12 @@ LOG_MODULE_REGISTER(fault_monitor, LOG_LEVEL_INF);
 /** Hard temperature threshold (Celsius). */
 #define HARD_LIMIT_TEMP_C 70.0f
 
-/** Fault logs interval (msecs). */
-#ifdef MOTOR_SIM_DEMO_UNIT_TEST
-#define FAULT_LOG_PERIOD_MS 0
-#else
-#define FAULT_LOG_PERIOD_MS 10000
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+/* The cyclic executive runs the checks on the main thread: no work queue. */
+K_THREAD_STACK_DEFINE(fault_wq_stack, CONFIG_MOTOR_SIM_FAULT_WQ_STACK_SIZE);
+
+/** Dedicated work queue for the fault monitor. */
+static struct k_work_q fault_wq;
 #endif
 
 /**
@@ -45,6 +54,12 @@ LOG_MODULE_REGISTER(fault_monitor, LOG_LEVEL_INF);
 struct fault_monitor_ctx {
     /** Delayable work item used for periodic checks. */
     struct k_work_delayable dwork;
+    /** Work item that waits for a state change while the monitor is idle. */
+    struct k_work_poll idle_work;
+    /** Raised by app_state on every state change. */
+    struct k_poll_signal changed;
+    /** Poll event on @ref changed for @ref idle_work. */
+    struct k_poll_event changed_event;
     /** Speed error threshold in RPM. */
     float speed_error_threshold_rpm;
     /** Soft temperature threshold in Celsius. */
@@ -54,7 +69,15 @@ struct fault_monitor_ctx {
     /** Last time a fault was logged (ms since boot). */
     int64_t last_log_ms;
     int64_t log_period_ms;
+    /** Period of the work item. */
+    k_timeout_t period;
     uint32_t last_fault_flags;
+    /** The last checked state is clear of every threshold (see fault_monitor_clear()). */
+    bool clear;
+    /** Uptime (ticks) at which the next check is due. */
+    int64_t due_ticks;
+    /** Scheduling latency statistics. */
+    struct fault_monitor_stats stats;
 };
 
 /** Single static context for the demo. */
@@ -63,7 +86,8 @@ static struct fault_monitor_ctx fault_ctx = {
     .soft_temp_threshold_c = SOFT_LIMIT_TEMP_C,
     .hard_temp_threshold_c = HARD_LIMIT_TEMP_C,
     .last_log_ms = 0,
-    .log_period_ms = FAULT_LOG_PERIOD_MS,
+    .log_period_ms = FAULT_MONITOR_LOG_PERIOD_MS,
+    .period = K_MSEC(FAULT_MONITOR_PERIOD_MS),
     .last_fault_flags = FAULT_NONE,
 };
 
@@ -82,44 +106,26 @@ static struct fault_monitor_ctx fault_ctx = {
 uint32_t fault_monitor_eval(const struct motor_state *state, float speed_err_th_rpm,
                             float soft_temp_c, float hard_temp_c)
 {
-    uint32_t flags = FAULT_NONE;
-
-    float speed_diff = state->setpoint_rpm - state->measured_rpm;
-    if (speed_diff < 0.0f) {
-        speed_diff = -speed_diff;
-    }
-
-    if (speed_diff > speed_err_th_rpm) {
-        flags |= FAULT_SPEED_ERROR;
-    }
-
-    if (state->temperature_c > hard_temp_c) {
-        flags |= FAULT_TEMP_HARD;
-    } else if (state->temperature_c > soft_temp_c) {
-        flags |= FAULT_TEMP_SOFT;
-    }
-
-    return flags;
+    return motor_model_fault_eval(state, speed_err_th_rpm, soft_temp_c, hard_temp_c);
 }
 
-static void fault_monitor_process(struct fault_monitor_ctx *ctx, const struct motor_state *state,
-                                  int64_t now_ms)
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+/* Binary records of the same reports, rendered on the host (motor_evlog.h). */
+static void fault_monitor_report(uint32_t flags, const struct motor_state *state)
 {
-    uint32_t flags = fault_monitor_eval(state,
-                                        ctx->speed_error_threshold_rpm,
-                                        ctx->soft_temp_threshold_c,
-                                        ctx->hard_temp_threshold_c);
-
-    ctx->last_fault_flags = flags;
-
-    if (flags == FAULT_NONE) {
-        return;
+    if (flags & FAULT_SPEED_ERROR) {
+        evlog_put(MOTOR_EVLOG_FAULT_SPEED, state);
     }
 
-    if ((now_ms - ctx->last_log_ms) < ctx->log_period_ms) {
-        return;
+    if (flags & FAULT_TEMP_HARD) {
+        evlog_put(MOTOR_EVLOG_FAULT_TEMP_HARD, state);
+    } else if (flags & FAULT_TEMP_SOFT) {
+        evlog_put(MOTOR_EVLOG_FAULT_TEMP_SOFT, state);
     }
-
+}
+#else
+static void fault_monitor_report(uint32_t flags, const struct motor_state *state)
+{
     /* Speed fault can be reported together with temp faults. */
     if (flags & FAULT_SPEED_ERROR) {
         float diff = state->setpoint_rpm - state->measured_rpm;
@@ -144,44 +150,207 @@ static void fault_monitor_process(struct fault_monitor_ctx *ctx, const struct mo
                 (int)state->control_output_pct,
                 (int)state->setpoint_rpm);
     }
+}
+#endif /* CONFIG_MOTOR_SIM_EVLOG */
+
+/**
+ * @brief True if no state app_state can reach without a change raises a fault.
+ *
+ * Without a change the state stays within a deadband of the last change,
+ * which is itself within a deadband of @p state, so two deadbands must
+ * separate @p state from every threshold. A setpoint change is always a
+ * change.
+ */
+static bool fault_monitor_clear(const struct fault_monitor_ctx *ctx,
+                                const struct motor_state *state)
+{
+    float speed_diff = fabsf(state->setpoint_rpm - state->measured_rpm);
+
+    return ((speed_diff + (2.0f * APP_STATE_DEADBAND_RPM)) <= ctx->speed_error_threshold_rpm) &&
+           ((state->temperature_c + (2.0f * APP_STATE_DEADBAND_C)) <= ctx->soft_temp_threshold_c);
+}
+
+static void fault_monitor_process(struct fault_monitor_ctx *ctx, const struct motor_state *state,
+                                  int64_t now_ms)
+{
+    uint32_t flags = fault_monitor_eval(state,
+                                        ctx->speed_error_threshold_rpm,
+                                        ctx->soft_temp_threshold_c,
+                                        ctx->hard_temp_threshold_c);
+
+    ctx->last_fault_flags = flags;
+    ctx->clear = fault_monitor_clear(ctx, state);
+
+    if (flags == FAULT_NONE) {
+        return;
+    }
+
+    if ((now_ms - ctx->last_log_ms) < ctx->log_period_ms) {
+        return;
+    }
+
+    fault_monitor_report(flags, state);
 
     ctx->last_log_ms = now_ms;
 }
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+/**
+ * @brief Queue the next check one period from now and record its due time.
+ */
+static void fault_monitor_schedule(struct fault_monitor_ctx *ctx)
+{
+    ctx->due_ticks = k_uptime_ticks() + ctx->period.ticks;
+    (void)k_work_reschedule_for_queue(&fault_wq, &ctx->dwork, ctx->period);
+}
+
+/**
+ * @brief Check now and queue the next check one period later.
+ */
+static void fault_monitor_check(struct fault_monitor_ctx *ctx)
+{
+    /* Reset before reading the state: a change from here on is seen next period. */
+    k_poll_signal_reset(&ctx->changed);
+    fault_monitor_run_once(k_uptime_get());
+    fault_monitor_schedule(ctx);
+}
+
 /**
  * @brief Periodic work handler that checks and logs fault conditions.
  *
+ * Goes idle instead if the state has not changed since the last check and
+ * that check found the state clear of every threshold.
+ *
  * @param work Base work pointer from the workqueue.
  */
 static void fault_monitor_work_handler(struct k_work *work)
 {
     struct k_work_delayable *dwork = k_work_delayable_from_work(work);
     struct fault_monitor_ctx *ctx = CONTAINER_OF(dwork, struct fault_monitor_ctx, dwork);
+    int64_t now_ticks = k_uptime_ticks();
+    uint32_t latency_us = (uint32_t)k_ticks_to_us_ceil64(MAX(now_ticks - ctx->due_ticks, 0));
+
+    wakeups_count(WAKEUPS_FAULT);
+    ctx->stats.runs++;
+    ctx->stats.last_latency_us = latency_us;
+    ctx->stats.max_latency_us = MAX(ctx->stats.max_latency_us, latency_us);
+
+    unsigned int changed;
+    int sample;
+
+    k_poll_signal_check(&ctx->changed, &changed, &sample);
+
+    if ((changed == 0U) && ctx->clear) {
+        /* A change raised after the check above triggers the work right away. */
+        (void)k_work_poll_submit_to_queue(&fault_wq, &ctx->idle_work, &ctx->changed_event, 1,
+                                          K_FOREVER);
+        return;
+    }
+
+    fault_monitor_check(ctx);
+}
+
+/**
+ * @brief Handler of the idle wait: the state changed, check it right away.
+ *
+ * @param work Base work pointer of the triggered work item.
+ */
+static void fault_monitor_idle_handler(struct k_work *work)
+{
+    struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+    struct fault_monitor_ctx *ctx = CONTAINER_OF(pwork, struct fault_monitor_ctx, idle_work);
+
+    wakeups_count(WAKEUPS_FAULT);
+    ctx->stats.idle_wakes++;
+    fault_monitor_check(ctx);
+}
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
+
+void fault_monitor_run_once(int64_t now_ms)
+{
+    APP_TRACE_BEGIN(APP_TRACE_FAULT_EVAL);
 
     struct motor_state state;
     int ret = app_state_get_snapshot(&state);
     if (ret != 0) {
         LOG_ERR("fault_monitor: app_state_get_snapshot failed: %d", ret); /* GCOVR_EXCL_LINE */
-        goto reschedule;                                                  /* GCOVR_EXCL_LINE */
+        APP_TRACE_END(APP_TRACE_FAULT_EVAL);                              /* GCOVR_EXCL_LINE */
+        return;                                                           /* GCOVR_EXCL_LINE */
     }
 
-    fault_monitor_process(ctx, &state, k_uptime_get());
+    fault_monitor_process(&fault_ctx, &state, now_ms);
+
+    APP_TRACE_END(APP_TRACE_FAULT_EVAL);
+}
 
-reschedule:
-    (void)k_work_reschedule(&ctx->dwork, FAULT_MONITOR_PERIOD);
+void fault_monitor_init(const struct fault_monitor_config *cfg)
+{
+    fault_ctx.period = K_MSEC(cfg->period_ms);
+    fault_ctx.log_period_ms = cfg->log_period_ms;
+    fault_ctx.last_log_ms = 0;
+    fault_ctx.last_fault_flags = FAULT_NONE;
+    fault_ctx.clear = false;
 }
 
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 void fault_monitor_start(void)
 {
+    const struct k_work_queue_config cfg = {
+        .name = "fault_wq",
+    };
+
+    k_work_queue_start(&fault_wq, fault_wq_stack, K_THREAD_STACK_SIZEOF(fault_wq_stack),
+                       CONFIG_MOTOR_SIM_FAULT_WQ_PRIORITY, &cfg);
+
     k_work_init_delayable(&fault_ctx.dwork, fault_monitor_work_handler);
-    (void)k_work_schedule(&fault_ctx.dwork, FAULT_MONITOR_PERIOD);
+    k_work_poll_init(&fault_ctx.idle_work, fault_monitor_idle_handler);
+    k_poll_signal_init(&fault_ctx.changed);
+    k_poll_event_init(&fault_ctx.changed_event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+                      &fault_ctx.changed);
+    (void)app_state_watch(&fault_ctx.changed);
+
+    /* The first check always runs: faults present before start are not changes. */
+    (void)k_poll_signal_raise(&fault_ctx.changed, 0);
+
+    fault_monitor_schedule(&fault_ctx);
     LOG_INF("Fault monitor scheduled");
 }
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
+
+void fault_monitor_save(struct fault_monitor_checkpoint *out, int64_t now_ms)
+{
+    out->fault_flags = fault_ctx.last_fault_flags;
+    out->log_age_ms = (uint32_t)CLAMP(now_ms - fault_ctx.last_log_ms, 0, INT32_MAX);
+}
+
+void fault_monitor_restore(const struct fault_monitor_checkpoint *cp, int64_t now_ms)
+{
+    /* Also written by the fault work queue: its next check wins either way. */
+    fault_ctx.last_fault_flags = cp->fault_flags;
+    fault_ctx.clear = false;
+    fault_ctx.last_log_ms = now_ms - cp->log_age_ms;
+}
+
+int fault_monitor_get_stats(struct fault_monitor_stats *out)
+{
+    if (out == NULL) {
+        return -EINVAL;
+    }
+
+    /* Written only from the fault work queue; a torn read just mixes two runs. */
+    *out = fault_ctx.stats;
+
+    return 0;
+}
 
 #ifdef MOTOR_SIM_DEMO_UNIT_TEST
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 void fault_monitor_stop(void)
 {
     (void)k_work_cancel_delayable(&fault_ctx.dwork);
+    (void)k_work_poll_cancel(&fault_ctx.idle_work);
 }
+#endif
 uint32_t fault_monitor_test_process(const struct motor_state *state, int64_t now_ms)
 {
     extern struct fault_monitor_ctx fault_ctx; /* o el nombre real de tu ctx global */
@@ -200,4 +369,14 @@ void fault_monitor_test_set_last_log_ms(int64_t ms)
     extern struct fault_monitor_ctx fault_ctx;
     fault_ctx.last_log_ms = ms;
 }
+
+uint32_t fault_monitor_test_get_flags(void)
+{
+    return fault_ctx.last_fault_flags;
+}
+
+bool fault_monitor_test_is_clear(void)
+{
+    return fault_ctx.clear;
+}
 #endif
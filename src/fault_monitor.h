@@ -9,35 +9,121 @@
 #ifndef FAULT_MONITOR_H_
 #define FAULT_MONITOR_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "motor_model.h" /* enum fault_flags */
+
+/** Period of the fault check in the application (ms). */
+#define FAULT_MONITOR_PERIOD_MS 2000U
+
+/** Shortest interval between two fault logs in the application (ms). */
+#define FAULT_MONITOR_LOG_PERIOD_MS 10000U
+
+/**
+ * @brief Fault monitor timing, set with fault_monitor_init().
+ */
+struct fault_monitor_config {
+    uint32_t period_ms;     /**< Interval between periodic checks (work item only). */
+    uint32_t log_period_ms; /**< Shortest interval between two fault logs; 0 logs every check. */
+};
+
+/** Timing used by the application. */
+#define FAULT_MONITOR_CONFIG_DEFAULT                                                               \
+    {                                                                                              \
+        .period_ms = FAULT_MONITOR_PERIOD_MS, .log_period_ms = FAULT_MONITOR_LOG_PERIOD_MS,        \
+    }
+
 /**
- * @brief Fault flags reported by the fault monitor.
+ * @brief Scheduling statistics of the periodic fault check.
  *
- * These flags are used in production code (work handler) and in unit tests.
+ * Latency is the delay between the time a check was due and the time its
+ * work handler started running.
+ */
+struct fault_monitor_stats {
+    uint32_t runs;            /**< Periodic runs (a check, or going idle). */
+    uint32_t last_latency_us; /**< Latency of the most recent periodic run (us). */
+    uint32_t max_latency_us;  /**< Worst latency since start (us). */
+    uint32_t idle_wakes;      /**< Checks started by a state change while idle. */
+};
+
+/**
+ * @brief Fault monitor context, for checkpoints.
  */
-enum fault_flags {
-    /** No fault condition. */
-    FAULT_NONE = 0,
-    /** Absolute speed error exceeds threshold. */
-    FAULT_SPEED_ERROR = (1u << 0),
-    /** Temperature exceeds soft limit. */
-    FAULT_TEMP_SOFT = (1u << 1),
-    /** Temperature exceeds hard limit. */
-    FAULT_TEMP_HARD = (1u << 2),
+struct fault_monitor_checkpoint {
+    uint32_t fault_flags; /**< Flags found by the most recent check. */
+    uint32_t log_age_ms;  /**< Time since the last fault log (ms), keeps the log rate limit. */
 };
 
+/**
+ * @brief Set the fault monitor timing and forget previous fault logs.
+ *
+ * Optional: without it the monitor uses FAULT_MONITOR_CONFIG_DEFAULT. Call it
+ * before fault_monitor_start() (or before the first fault_monitor_run_once()).
+ * Tests use it to run the checks at a short period, or to log every fault.
+ *
+ * @param cfg Timing to use. Must not be NULL.
+ */
+void fault_monitor_init(const struct fault_monitor_config *cfg);
+
 /**
  * @brief Start the periodic fault monitor.
  *
- * Initializes and schedules a delayable work item that periodically checks:
+ * Starts the dedicated fault work queue (`fault_wq`, priority
+ * CONFIG_MOTOR_SIM_FAULT_WQ_PRIORITY) and schedules on it a delayable work
+ * item that checks every fault_monitor_config::period_ms:
  * - absolute speed error
  * - soft temperature limit
  * - hard temperature limit
  *
- * The monitor logs warnings/errors based on the evaluated flags.
+ * The monitor logs warnings/errors based on the evaluated flags. While the
+ * state stays within the app_state deadband and the last check found it at
+ * least two deadbands from every threshold, it stops checking and waits for
+ * the next state change (see app_state_watch()).
+ *
+ * Not built with CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE, which has no fault_wq.
  */
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 void fault_monitor_start(void);
+#endif
+
+/**
+ * @brief Get the scheduling statistics of the periodic check.
+ *
+ * @param out Statistics snapshot to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if out is NULL.
+ */
+int fault_monitor_get_stats(struct fault_monitor_stats *out);
+
+/**
+ * @brief Run one fault check on the current state without rescheduling.
+ *
+ * This is the body of the periodic work item. It is also called directly by
+ * the cyclic executive from its fault slot.
+ *
+ * @param now_ms Current time in ms, used to rate-limit fault logs.
+ */
+void fault_monitor_run_once(int64_t now_ms);
+
+/**
+ * @brief Copy the fault monitor context.
+ *
+ * @param out    Context to fill. Must not be NULL.
+ * @param now_ms Current time in ms.
+ */
+void fault_monitor_save(struct fault_monitor_checkpoint *out, int64_t now_ms);
+
+/**
+ * @brief Resume the context saved by fault_monitor_save().
+ *
+ * The monitor keeps running; the restored app_state change wakes it if it
+ * is idle, and its next check replaces the restored flags.
+ *
+ * @param cp     Context to resume. Must not be NULL.
+ * @param now_ms Current time in ms.
+ */
+void fault_monitor_restore(const struct fault_monitor_checkpoint *cp, int64_t now_ms);
 
 /* -------------------------------------------------------------------------- */
 /* Unit-test API                                                               */
@@ -66,12 +152,20 @@ void fault_monitor_start(void);
 uint32_t fault_monitor_eval(const struct motor_state *state, float speed_err_th_rpm,
                             float soft_temp_c, float hard_temp_c);
 
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 /** @brief Stop fault monitor work (test-only helper). */
 void fault_monitor_stop(void);
+#endif
 uint32_t fault_monitor_test_process(const struct motor_state *state, int64_t now_ms);
 void fault_monitor_test_set_log_period_ms(int64_t ms);
 void fault_monitor_test_set_last_log_ms(int64_t ms);
 
+/** @brief Flags found by the most recent check (test-only helper). */
+uint32_t fault_monitor_test_get_flags(void);
+
+/** @brief True if the most recent check lets the monitor go idle (test-only helper). */
+bool fault_monitor_test_is_clear(void);
+
 #endif /* MOTOR_SIM_DEMO_UNIT_TEST */
 
 #endif /* FAULT_MONITOR_H_ */
@@ -3,7 +3,7 @@
  * @brief Application entry point.
  *
  * Initializes the application modules, starts background threads/work items,
- * and then idles forever.
+ * and returns: the main thread has nothing left to do.
  */
 
 #include <zephyr/kernel.h>
@@ -11,9 +11,13 @@
 #include <zephyr/logging/log.h>
 
 #include "app_state.h"
+#include "checkpoint.h"
 #include "motor_control.h"
 #include "telemetry.h"
 #include "fault_monitor.h"
+#include "cyclic_exec.h"
+#include "shm_export.h"
+#include "udp_link.h"
 
 LOG_MODULE_REGISTER(motor_sim_main, LOG_LEVEL_INF);
 
@@ -21,8 +25,11 @@ LOG_MODULE_REGISTER(motor_sim_main, LOG_LEVEL_INF);
  * @brief Application entry point.
  *
  * This function initializes the global application state, starts the
- * control, telemetry and fault monitor components, and then sleeps
- * forever. The motor setpoint can be adjusted at runtime using the
+ * control, telemetry and fault monitor components, and returns; the main
+ * thread then exits instead of waking up to sleep again. With
+ * CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE the components are not
+ * started as threads/work items; main runs them as cyclic executive slots
+ * instead. The motor setpoint can be adjusted at runtime using the
  * shell command:
  *
  *   motor_set <rpm>
@@ -42,16 +49,24 @@ int main(void)
         return ret;
     }
 
-    motor_control_start();
-    telemetry_start();
-    fault_monitor_start();
+    /* Optional: a failure only disables checkpoints, the simulation starts cold. */
+    (void)checkpoint_init();
+
+    /* Optional (native_sim): a failure only disables the export. */
+    (void)shm_export_init();
+
+    /* Optional network link: without it the shell is still available. */
+    (void)udp_link_start();
 
     LOG_INF("Use 'motor_set <rpm>' and 'motor_info' in the shell");
 
-    while (true) {
-        k_sleep(K_SECONDS(1));
-    }
+#if defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+    cyclic_exec_run();
+#else
+    motor_control_start();
+    telemetry_start();
+    fault_monitor_start();
 
-    /* Not reached, but keeps the compiler happy. */
     return 0;
+#endif
 }
@@ -0,0 +1,131 @@
+/**
+ * @file mem_report.c
+ * @brief RAM footprint accounting implementation.
+ *
+ * Keeps a static table of the allocations the demo makes, sized from the same
+ * Kconfig options and types the modules use, so the figures follow the build
+ * configuration. Stack high-water marks come from the thread analyzer.
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#if defined(CONFIG_THREAD_ANALYZER)
+#include <zephyr/debug/thread_analyzer.h>
+#endif
+
+#include "app_state.h"
+#include "evlog.h"
+#include "mem_report.h"
+#include "motor_cmd.h"
+#include "motor_control.h"
+#include "motor_lifetime.h"
+#include "sample_pool.h"
+#include "trajectory.h"
+
+/*
+ * Per-motor: everything a second motor instance would duplicate (state and
+ * its zbus message buffer, history and the sample pool sized for it, controller,
+ * control thread and lifetime statistics, command queue, profile table).
+ * Shared: threads and buffers that serve all motors.
+ */
+static const struct mem_report_item items[] = {
+    {"app_state", "state", sizeof(struct motor_state), true},
+    {"app_state", "zbus msg buffer", sizeof(struct motor_state), true},
+    {"app_state", "history ring", sizeof(struct app_state_sample *) * APP_STATE_HISTORY_LEN, true},
+    {"sample_pool", "sample blocks", sizeof(struct sample_pool_block) * SAMPLE_POOL_BLOCKS, true},
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+    {"motor_control", "stack", CONFIG_MOTOR_SIM_CONTROL_STACK_SIZE, true},
+    {"motor_control", "thread", sizeof(struct k_thread), true},
+#endif
+    {"motor_control", "controller", sizeof(struct motor_control_ctx), true},
+    {"motor_control", "lifetime stats", sizeof(struct motor_lifetime), true},
+    {"motor_cmd", "command ring",
+     (sizeof(atomic_t) + sizeof(struct motor_cmd)) * MOTOR_CMD_QUEUE_DEPTH, true},
+    {"trajectory", "profile table",
+     sizeof(struct trajectory_segment) * TRAJECTORY_MAX_SEGMENTS, true},
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+    {"fault_monitor", "fault_wq stack", CONFIG_MOTOR_SIM_FAULT_WQ_STACK_SIZE, false},
+    {"fault_monitor", "fault_wq thread", sizeof(struct k_work_q), false},
+    {"telemetry", "stack", CONFIG_MOTOR_SIM_TELEMETRY_STACK_SIZE, false},
+    {"telemetry", "thread", sizeof(struct k_thread), false},
+#endif
+    {"console_shell", "dump refs", sizeof(struct app_state_sample *) * APP_STATE_HISTORY_LEN,
+     false},
+    {"kernel", "main stack", CONFIG_MAIN_STACK_SIZE, false},
+    {"kernel", "sysworkq stack", CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE, false},
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+    {"evlog", "event ring", sizeof(struct motor_evlog_record) * CONFIG_MOTOR_SIM_EVLOG_RECORDS,
+     false},
+    {"console_shell", "evlog drain buffer", sizeof(struct motor_evlog_record) * EVLOG_DRAIN_CHUNK,
+     false},
+#endif
+#if defined(CONFIG_SHELL_STACK_SIZE)
+    {"shell", "stack", CONFIG_SHELL_STACK_SIZE, false},
+#endif
+#if defined(CONFIG_LOG_BUFFER_SIZE)
+    {"logging", "buffer", CONFIG_LOG_BUFFER_SIZE, false},
+#endif
+};
+
+size_t mem_report_static_items(const struct mem_report_item **out)
+{
+    *out = items;
+    return ARRAY_SIZE(items);
+}
+
+void mem_report_get_budget(struct mem_report_budget *out)
+{
+    out->per_motor_bytes = 0;
+    out->shared_bytes = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+        if (items[i].per_motor) {
+            out->per_motor_bytes += items[i].bytes;
+        } else {
+            out->shared_bytes += items[i].bytes;
+        }
+    }
+}
+
+size_t mem_report_motors_for_budget(size_t budget_bytes)
+{
+    struct mem_report_budget budget;
+
+    mem_report_get_budget(&budget);
+
+    if (budget_bytes <= budget.shared_bytes) {
+        return 0;
+    }
+
+    return (budget_bytes - budget.shared_bytes) / budget.per_motor_bytes;
+}
+
+#if defined(CONFIG_THREAD_ANALYZER)
+/* thread_analyzer_run() has no user data argument: bridge through statics. */
+static mem_report_thread_cb thread_cb;
+static void *thread_cb_data;
+
+static void mem_report_analyzer_cb(struct thread_analyzer_info *info)
+{
+    thread_cb(info->name, info->stack_size, info->stack_used, thread_cb_data);
+}
+#endif
+
+int mem_report_threads(mem_report_thread_cb cb, void *user_data)
+{
+#if defined(CONFIG_THREAD_ANALYZER)
+    thread_cb = cb;
+    thread_cb_data = user_data;
+
+    for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+        thread_analyzer_run(mem_report_analyzer_cb, cpu);
+    }
+
+    return 0;
+#else
+    ARG_UNUSED(cb);
+    ARG_UNUSED(user_data);
+    return -ENOTSUP;
+#endif
+}
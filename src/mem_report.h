@@ -0,0 +1,82 @@
+/**
+ * @file mem_report.h
+ * @brief Public API for RAM footprint accounting.
+ *
+ * The mem_report module lists the static RAM owned by the demo (stacks,
+ * state, buffers), splits it into per-motor and shared cost, and reads the
+ * thread stack high-water marks from the thread analyzer when it is enabled.
+ */
+
+#ifndef MEM_REPORT_H_
+#define MEM_REPORT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief One static RAM allocation.
+ */
+struct mem_report_item {
+    const char *module; /**< Owning module. */
+    const char *name;   /**< Allocation name. */
+    size_t bytes;       /**< Size in bytes. */
+    bool per_motor;     /**< True if every additional motor needs another copy. */
+};
+
+/**
+ * @brief RAM totals split by scaling class.
+ */
+struct mem_report_budget {
+    size_t per_motor_bytes; /**< Cost of one motor instance. */
+    size_t shared_bytes;    /**< Fixed cost independent of the motor count. */
+};
+
+/**
+ * @brief Thread stack usage callback.
+ *
+ * @param name       Thread name.
+ * @param size       Stack size in bytes.
+ * @param used       Stack high-water mark in bytes.
+ * @param user_data  Opaque pointer passed to mem_report_threads().
+ */
+typedef void (*mem_report_thread_cb)(const char *name, size_t size, size_t used,
+                                     void *user_data);
+
+/**
+ * @brief Get the static allocation table.
+ *
+ * @param items Set to the first table entry. Must not be NULL.
+ *
+ * @return Number of entries.
+ */
+size_t mem_report_static_items(const struct mem_report_item **items);
+
+/**
+ * @brief Sum the static allocation table.
+ *
+ * @param out Totals to fill. Must not be NULL.
+ */
+void mem_report_get_budget(struct mem_report_budget *out);
+
+/**
+ * @brief Number of motors that fit in a RAM budget.
+ *
+ * @param budget_bytes Total RAM available to the application.
+ *
+ * @return Motor count, 0 if even the shared cost does not fit.
+ */
+size_t mem_report_motors_for_budget(size_t budget_bytes);
+
+/**
+ * @brief Report the stack high-water mark of every thread.
+ *
+ * Not reentrant: the shell is the only expected caller.
+ *
+ * @param cb        Called once per thread.
+ * @param user_data Passed through to @p cb.
+ *
+ * @return 0 on success, -ENOTSUP without CONFIG_THREAD_ANALYZER.
+ */
+int mem_report_threads(mem_report_thread_cb cb, void *user_data);
+
+#endif /* MEM_REPORT_H_ */
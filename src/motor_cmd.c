@@ -0,0 +1,239 @@
+/**
+ * @file motor_cmd.c
+ * @brief Control loop command queue implementation.
+ *
+ * Bounded MPSC ring with one sequence number per slot (after D. Vyukov's
+ * bounded queue). Positions grow forever; the lap of a position is the
+ * position with the slot index bits cleared. A slot whose sequence equals the
+ * lap is free for that lap, so the zero-initialized ring starts empty.
+ *
+ * A producer claims a position by advancing `head` with a CAS, copies the
+ * command in, then publishes it by setting the sequence to `lap + 1`. The
+ * consumer only reads a slot whose sequence says it is published, and hands
+ * it to the next lap by setting the sequence to `lap + depth`. No producer
+ * ever waits for another one or for the consumer.
+ *
+ * A batch claims all its positions with the same single CAS. Its first slot
+ * records the batch length, and the consumer takes the batch only once every
+ * slot of it is published, so a batch is never split across two ticks.
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+#include "app_state.h"
+#include "motor_cmd.h"
+#include "trajectory.h"
+
+LOG_MODULE_REGISTER(motor_cmd, LOG_LEVEL_DBG);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(MOTOR_CMD_QUEUE_DEPTH) && (MOTOR_CMD_QUEUE_DEPTH >= 2),
+             "command queue depth must be a power of two >= 2");
+
+#define MOTOR_CMD_QUEUE_MASK (MOTOR_CMD_QUEUE_DEPTH - 1)
+#define MOTOR_CMD_LAP(pos)   ((pos) & ~(atomic_val_t)MOTOR_CMD_QUEUE_MASK)
+#define MOTOR_CMD_SLOT(pos)  (&cmd_ring[(pos) & MOTOR_CMD_QUEUE_MASK])
+
+struct motor_cmd_slot {
+    atomic_t seq;
+    /* Commands applied together from this slot on: 1, or the batch length in its first slot. */
+    uint32_t batch;
+    struct motor_cmd cmd;
+};
+
+static struct motor_cmd_slot cmd_ring[MOTOR_CMD_QUEUE_DEPTH];
+
+/* Next position to claim (producers) and to read (consumer only). */
+static atomic_t head;
+static atomic_val_t tail;
+
+static atomic_t posted;
+static atomic_t applied;
+static atomic_t full;
+static atomic_t batches;
+
+int motor_cmd_post_batch(const struct motor_cmd *cmds, size_t count)
+{
+    atomic_val_t pos;
+
+    if ((count == 0U) || (count > MOTOR_CMD_QUEUE_DEPTH)) {
+        return -EINVAL;
+    }
+
+    /* One motor, so one setpoint: a second one would silently replace the first. */
+    size_t setpoints = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (cmds[i].type == MOTOR_CMD_SET_SETPOINT) {
+            setpoints++;
+        }
+    }
+
+    if (setpoints > 1U) {
+        return -EINVAL;
+    }
+
+    while (true) {
+        pos = atomic_get(&head);
+
+        /* < 0: previous lap not consumed yet, > 0: already claimed (stale head). */
+        atomic_val_t diff = 0;
+
+        for (atomic_val_t i = 0; (i < (atomic_val_t)count) && (diff == 0); i++) {
+            diff = atomic_get(&MOTOR_CMD_SLOT(pos + i)->seq) - MOTOR_CMD_LAP(pos + i);
+        }
+
+        if (diff < 0) {
+            atomic_inc(&full);
+            return -ENOSPC;
+        }
+
+        /* A free slot stays free until head passes it, so the CAS claims all of them. */
+        if ((diff == 0) && atomic_cas(&head, pos, pos + (atomic_val_t)count)) {
+            break;
+        }
+
+        /* Another producer got there first: retry with the new head. */
+    }
+
+    for (atomic_val_t i = 0; i < (atomic_val_t)count; i++) {
+        struct motor_cmd_slot *slot = MOTOR_CMD_SLOT(pos + i);
+
+        slot->batch = (i == 0) ? (uint32_t)count : 1U;
+        slot->cmd = cmds[i];
+        atomic_set(&slot->seq, MOTOR_CMD_LAP(pos + i) + 1);
+    }
+
+    atomic_add(&posted, (atomic_val_t)count);
+    if (count > 1U) {
+        atomic_inc(&batches);
+    }
+
+    return 0;
+}
+
+int motor_cmd_post(const struct motor_cmd *cmd)
+{
+    return motor_cmd_post_batch(cmd, 1U);
+}
+
+int motor_cmd_post_setpoint(float rpm)
+{
+    if ((rpm < 0.0f) || (rpm > APP_STATE_MAX_SETPOINT_RPM)) {
+        return -ERANGE;
+    }
+
+    const struct motor_cmd cmd = {
+        .type = MOTOR_CMD_SET_SETPOINT,
+        .setpoint_rpm = rpm,
+    };
+
+    return motor_cmd_post(&cmd);
+}
+
+static size_t motor_cmd_count_applied(size_t count)
+{
+    if (count != 0) {
+        atomic_add(&applied, (atomic_val_t)count);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Apply one command of a batch (a single command is a batch of one).
+ */
+static void motor_cmd_apply(const struct motor_cmd *cmd)
+{
+    switch (cmd->type) {
+    case MOTOR_CMD_SET_SETPOINT: {
+        int ret = app_state_set_setpoint(cmd->setpoint_rpm);
+        /* GCOVR_EXCL_START */
+        if (ret != 0) {
+            LOG_ERR("Setpoint %d rpm rejected: %d", (int)cmd->setpoint_rpm, ret);
+        }
+        /* GCOVR_EXCL_STOP */
+        break;
+    }
+    case MOTOR_CMD_PROFILE_STOP:
+        trajectory_stop();
+        break;
+    case MOTOR_CMD_CALL:
+        cmd->fn(cmd->arg);
+        break;
+    default:
+        LOG_ERR("Unknown command type %d", (int)cmd->type); /* GCOVR_EXCL_LINE */
+        break;                                              /* GCOVR_EXCL_LINE */
+    }
+}
+
+size_t motor_cmd_drain(void)
+{
+    size_t count = 0;
+
+    while (true) {
+        struct motor_cmd_slot *slot = MOTOR_CMD_SLOT(tail);
+
+        if (atomic_get(&slot->seq) != MOTOR_CMD_LAP(tail) + 1) {
+            break;
+        }
+
+        atomic_val_t n = (atomic_val_t)slot->batch;
+
+        /* A batch still being written waits for the next tick as a whole. */
+        for (atomic_val_t i = 1; i < n; i++) {
+            if (atomic_get(&MOTOR_CMD_SLOT(tail + i)->seq) != MOTOR_CMD_LAP(tail + i) + 1) {
+                return motor_cmd_count_applied(count); /* GCOVR_EXCL_LINE */
+            }
+        }
+
+        for (atomic_val_t i = 0; i < n; i++) {
+            slot = MOTOR_CMD_SLOT(tail);
+            struct motor_cmd cmd = slot->cmd;
+
+            /* Hand the slot to the next lap before running the command. */
+            atomic_set(&slot->seq, MOTOR_CMD_LAP(tail) + MOTOR_CMD_QUEUE_DEPTH);
+            tail++;
+
+            motor_cmd_apply(&cmd);
+        }
+
+        count += (size_t)n;
+    }
+
+    return motor_cmd_count_applied(count);
+}
+
+int motor_cmd_get_stats(struct motor_cmd_stats *out)
+{
+    if (out == NULL) {
+        return -EINVAL;
+    }
+
+    out->posted = (uint32_t)atomic_get(&posted);
+    out->applied = (uint32_t)atomic_get(&applied);
+    out->full = (uint32_t)atomic_get(&full);
+    out->batches = (uint32_t)atomic_get(&batches);
+
+    return 0;
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void motor_cmd_test_reset(void)
+{
+    for (size_t i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        atomic_clear(&cmd_ring[i].seq);
+    }
+
+    atomic_clear(&head);
+    tail = 0;
+    atomic_clear(&posted);
+    atomic_clear(&applied);
+    atomic_clear(&full);
+    atomic_clear(&batches);
+}
+#endif
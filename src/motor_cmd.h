@@ -0,0 +1,117 @@
+/**
+ * @file motor_cmd.h
+ * @brief Public API for the control loop command queue.
+ *
+ * Threads other than the control loop (shell, host links) do not touch the
+ * motor state directly. They post commands to a bounded lock-free
+ * multi-producer/single-consumer queue, and the control thread drains it at
+ * the start of each tick. Commands therefore take effect at tick boundaries,
+ * in posting order, and a producer never holds a lock the loop waits on.
+ */
+
+#ifndef MOTOR_CMD_H_
+#define MOTOR_CMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of queue slots (a power of two). */
+#define MOTOR_CMD_QUEUE_DEPTH CONFIG_MOTOR_SIM_CMD_QUEUE_DEPTH
+
+/**
+ * @brief Command types.
+ */
+enum motor_cmd_type {
+    /** Set the speed setpoint to `setpoint_rpm` (at most one per batch). */
+    MOTOR_CMD_SET_SETPOINT = 0,
+    /** Stop the running setpoint profile. */
+    MOTOR_CMD_PROFILE_STOP,
+    /** Call `fn(arg)` on the control loop, between two ticks. */
+    MOTOR_CMD_CALL,
+};
+
+/**
+ * @brief One queued command.
+ */
+struct motor_cmd {
+    enum motor_cmd_type type; /**< Command type. */
+    float setpoint_rpm;       /**< New setpoint, MOTOR_CMD_SET_SETPOINT only. */
+    void (*fn)(void *arg);    /**< Function to call, MOTOR_CMD_CALL only. */
+    void *arg;                /**< Argument passed to fn, MOTOR_CMD_CALL only. */
+};
+
+/**
+ * @brief Queue statistics.
+ */
+struct motor_cmd_stats {
+    uint32_t posted;  /**< Commands accepted since init. */
+    uint32_t applied; /**< Commands applied by the control loop since init. */
+    uint32_t full;    /**< Posts rejected because the queue was full. */
+    uint32_t batches; /**< Batches of more than one command accepted since init. */
+};
+
+/**
+ * @brief Post a command for the next control tick.
+ *
+ * Safe to call from any thread or ISR, concurrently with other producers.
+ * Never blocks.
+ *
+ * @param cmd Command to copy into the queue. Must not be NULL.
+ *
+ * @return 0 on success, -ENOSPC if the queue is full.
+ */
+int motor_cmd_post(const struct motor_cmd *cmd);
+
+/**
+ * @brief Post several commands that take effect in the same control tick.
+ *
+ * The batch is claimed as a whole, so it is never interleaved with other
+ * producers' commands nor split across two ticks: a setpoint and profile
+ * operations in one batch land together. There is one motor, so a batch
+ * holds at most one setpoint. Same calling context as motor_cmd_post().
+ *
+ * @param cmds  Commands, in applying order. Must not be NULL.
+ * @param count Number of commands, 1..MOTOR_CMD_QUEUE_DEPTH.
+ *
+ * @return 0 on success, -EINVAL if @p count is out of range or the batch
+ *         holds more than one MOTOR_CMD_SET_SETPOINT, -ENOSPC if the queue
+ *         cannot take the whole batch (nothing is posted then).
+ */
+int motor_cmd_post_batch(const struct motor_cmd *cmds, size_t count);
+
+/**
+ * @brief Post a setpoint change for the next control tick.
+ *
+ * The range is checked here so callers get the error immediately.
+ *
+ * @param rpm New setpoint in rpm.
+ *
+ * @return 0 on success, -ERANGE if out of allowed range, -ENOSPC if the
+ *         queue is full.
+ */
+int motor_cmd_post_setpoint(float rpm);
+
+/**
+ * @brief Apply every queued command, oldest first.
+ *
+ * Must only be called from the control loop (the single consumer).
+ *
+ * @return Number of commands applied.
+ */
+size_t motor_cmd_drain(void);
+
+/**
+ * @brief Get the queue statistics.
+ *
+ * @param out Statistics to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if out is NULL.
+ */
+int motor_cmd_get_stats(struct motor_cmd_stats *out);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Drop queued commands and clear the statistics (test-only helper). */
+void motor_cmd_test_reset(void);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
+#endif /* MOTOR_CMD_H_ */
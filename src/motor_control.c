@@ -2,44 +2,117 @@
  * @file motor_control.c
  * @brief Motor control loop implementation.
  *
- * Implements the periodic control thread and a simple motor/temperature model
- * used by the demo.
+ * Implements the periodic control thread. The controller and motor/temperature
+ * model themselves live in the portable lib/motor_model library.
  */
 
+#include <errno.h>
+#include <math.h>
+
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
 
 #include "app_state.h"
+#include "app_trace.h"
+#include "motor_cmd.h"
 #include "motor_control.h"
+#include "motor_dc.h"
+#include "motor_lifetime.h"
+#include "motor_model.h"
+#include "motor_pid.h"
+#include "trajectory.h"
+#include "wakeups.h"
 
 LOG_MODULE_REGISTER(motor_control, LOG_LEVEL_DBG);
 
-#define CONTROL_THREAD_STACK_SIZE 1024
+#define CONTROL_THREAD_STACK_SIZE CONFIG_MOTOR_SIM_CONTROL_STACK_SIZE
 #define CONTROL_THREAD_PRIORITY   2
 
-#define CONTROL_PERIOD_MS 50
+#define MOTOR_CONTROL_THREAD_NAME "motor_ctrl"
 
-#define MOTOR_MAX_RPM     10000.0f
-#define AMBIENT_TEMP_C    25.0f
-#define MAX_TEMP_C        130.0f
-#define SOFT_LIMIT_TEMP_C 80.0f
-#define HARD_LIMIT_TEMP_C 100.0f
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+static void control_thread(void *p1, void *p2, void *p3);
+#endif
 
-/* Heat / cooling and dynamic response tuning constants. */
-#define TEMP_NORM_RPM      4000.0f
-#define COOL_GAIN          0.02f
-#define HEAT_GAIN          (COOL_GAIN * 50.0f) /* 1.0f */
-#define SPEED_FILTER_ALPHA 0.2f
-#define KP_PERCENT         10.0f /* proportional effect as % of full output */
+/** Model tuning (see lib/motor_model). */
+static const struct motor_model_params model_params = MOTOR_MODEL_PARAMS_DEFAULT;
 
-#define MOTOR_CONTROL_THREAD_NAME "motor_ctrl"
+/** Control periods run by the loop so far, the index passed to motor_control_step(). */
+static uint32_t control_steps;
 
-static void control_thread(void *p1, void *p2, void *p3);
+/** Time the control thread sleeps between two control periods. */
+static uint32_t thread_period_ms = MOTOR_CONTROL_PERIOD_MS;
+
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+/** DC motor plant under the speed loop (see lib/motor_model/include/motor_dc.h). */
+static const struct motor_dc_params dc_params = MOTOR_DC_PARAMS_DEFAULT;
+#endif
+
+/** The application's controller, owned by the control loop. */
+static struct motor_control_ctx control_ctx = MOTOR_CONTROL_CTX_INIT;
+
+/*
+ * Requests from other threads are copied here under tuning_lock, then applied
+ * by the loop through a MOTOR_CMD_CALL command, so they take effect at a tick
+ * boundary in order with the other commands. The loop publishes the gains and
+ * tuner state for motor_control_get_tuning() under the same lock.
+ */
+static struct k_spinlock tuning_lock;
+static struct motor_pid_gains requested_gains;
+static struct motor_pid_tune_config requested_tune;
+static struct motor_control_tuning published = {
+    .gains = MOTOR_PID_GAINS_DEFAULT,
+};
 
+/* Period timing, written by the control thread only (see motor_control_get_timing()). */
+static atomic_t timed_periods;
+static atomic_t late_sum_us;
+static atomic_t late_max_us;
+static atomic_t missed_periods;
+
+/* Lifetime statistics, updated by the loop and read or cleared by other threads. */
+static struct k_spinlock lifetime_lock;
+static struct motor_lifetime lifetime;
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+/* The cyclic executive runs the loop on the main thread: no thread of its own. */
 K_THREAD_STACK_DEFINE(control_stack, CONTROL_THREAD_STACK_SIZE);
 static struct k_thread control_thread_data;
 static k_tid_t control_tid;
+#endif
+
+/* Called by the control loop whenever the gains or the tuner state of @p ctx change. */
+static void motor_control_publish_tuning(struct motor_control_ctx *ctx)
+{
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+
+    published = (struct motor_control_tuning){
+        .gains = ctx->gains,
+        .status = ctx->tune_pending ? MOTOR_PID_TUNE_RUNNING : ctx->tuner.status,
+        .ident = ctx->tuner.ident,
+    };
+
+    k_spin_unlock(&tuning_lock, key);
+    ctx->tuning_changed = false;
+}
+
+void motor_control_ctx_init(struct motor_control_ctx *ctx)
+{
+    *ctx = (struct motor_control_ctx)MOTOR_CONTROL_CTX_INIT;
+    motor_pid_reset(&ctx->pid);
+}
 
+void motor_control_init(const struct motor_control_config *cfg)
+{
+    thread_period_ms = cfg->period_ms;
+    control_steps = 0U;
+    motor_control_ctx_init(&control_ctx);
+    motor_control_publish_tuning(&control_ctx);
+    motor_control_reset_lifetime();
+}
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 void motor_control_start(void)
 {
     control_tid = k_thread_create(&control_thread_data,
@@ -51,70 +124,397 @@ void motor_control_start(void)
                                   NULL,
                                   CONTROL_THREAD_PRIORITY,
                                   0,
-                                  K_NO_WAIT);
+                                  K_FOREVER);
 
     (void)k_thread_name_set(control_tid, MOTOR_CONTROL_THREAD_NAME);
 
+#if defined(CONFIG_MOTOR_SIM_CONTROL_CPU)
+    /* Affinity can only be changed before the thread starts. */
+    if (CONFIG_MOTOR_SIM_CONTROL_CPU >= 0) {
+        int err = k_thread_cpu_pin(control_tid, CONFIG_MOTOR_SIM_CONTROL_CPU);
+        if (err != 0) {
+            LOG_WRN("Cannot pin '%s' to CPU %d: %d", MOTOR_CONTROL_THREAD_NAME,
+                    CONFIG_MOTOR_SIM_CONTROL_CPU, err);
+        }
+    }
+#endif
+
+    k_thread_start(control_tid);
+
     LOG_INF("Thread '%s' started (tid=%p)", MOTOR_CONTROL_THREAD_NAME, (void *)control_tid);
 }
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
 
-void motor_control_step(struct motor_state *state)
+/*
+ * Speed controller stage: the PID, or the relay while the auto-tuner runs.
+ * Tuner state changes are flagged for the loop to publish: the step itself
+ * touches nothing outside @p ctx and @p state.
+ */
+static void motor_control_speed_control(struct motor_control_ctx *ctx, struct motor_state *state)
 {
-    /* Simple proportional control based on speed error. */
-    float error = state->setpoint_rpm - state->measured_rpm;
+    if (ctx->tune_pending) {
+        ctx->tune_pending = false;
+        if (motor_pid_tune_start(&ctx->tuner, &ctx->tune_cfg, state) != 0) {
+            LOG_WRN("Auto-tune not started: output at %d%%", (int)state->control_output_pct);
+            ctx->tuner.status = MOTOR_PID_TUNE_FAILED;
+            ctx->tuning_changed = true;
+        }
+    }
 
-    float step_pct = (error / MOTOR_MAX_RPM) * KP_PERCENT;
-    state->control_output_pct += step_pct;
+    if (ctx->tuner.status != MOTOR_PID_TUNE_RUNNING) {
+        motor_pid_speed_control(&model_params, &ctx->gains, &ctx->pid, state);
+        return;
+    }
+
+    enum motor_pid_tune_status status = motor_pid_tune_step(&ctx->tuner, &model_params, state);
+    if (status == MOTOR_PID_TUNE_RUNNING) {
+        return;
+    }
 
-    if (state->control_output_pct < 0.0f) {
-        state->control_output_pct = 0.0f;
-    } else if (state->control_output_pct > 100.0f) {
-        state->control_output_pct = 100.0f;
+    if (status == MOTOR_PID_TUNE_DONE) {
+        ctx->gains = ctx->tuner.gains;
+        LOG_INF("Auto-tune done after %u periods: kp=%.2f ki=%.2f kd=%.2f", ctx->tuner.periods,
+                (double)ctx->gains.kp_pct, (double)ctx->gains.ki_pct,
+                (double)ctx->gains.kd_pct);
+    } else {
+        LOG_WRN("Auto-tune failed after %u periods, gains kept", ctx->tuner.periods);
     }
 
-    /* First order motor model: measured_rpm moves towards target_rpm. */
-    float target_rpm = (state->control_output_pct / 100.0f) * MOTOR_MAX_RPM;
-    state->measured_rpm += (target_rpm - state->measured_rpm) * SPEED_FILTER_ALPHA;
+    /* The relay left the output at the bias: restart without a kick. */
+    motor_pid_reset(&ctx->pid);
+    ctx->tuning_changed = true;
+}
 
-    /* Temperature normalization model */
-    float speed_norm = state->measured_rpm / TEMP_NORM_RPM;
-    if (speed_norm < 0.0f) {
-        speed_norm = -speed_norm;
+/*
+ * Lifetime statistics of the period @p ctx just stepped. Done by the loop
+ * rather than the step, so that steps never contend for lifetime_lock.
+ */
+static void motor_control_account(const struct motor_control_ctx *ctx,
+                                  const struct motor_state *state)
+{
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+    float power_w = ctx->dc.voltage_v * ctx->dc.current_a;
+#else
+    ARG_UNUSED(ctx);
+    float power_w = MOTOR_LIFETIME_RATED_POWER_W * (state->control_output_pct / 100.0f);
+#endif
+
+    k_spinlock_key_t key = k_spin_lock(&lifetime_lock);
+    motor_lifetime_update(&model_params, &lifetime, state, power_w, MOTOR_CONTROL_PERIOD_MS);
+    k_spin_unlock(&lifetime_lock, key);
+}
+
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+void motor_control_step(struct motor_control_ctx *ctx, struct motor_state *state, uint32_t step)
+{
+    if (ctx->dc_coeffs.inner_steps == 0U) {
+        int ret = motor_dc_prepare(&dc_params, (float)CONFIG_MOTOR_SIM_DC_CURRENT_LOOP_HZ,
+                                   MOTOR_CONTROL_PERIOD_MS / 1000.0f, &ctx->dc_coeffs);
+        /* GCOVR_EXCL_START */
+        if (ret != 0) {
+            LOG_ERR("Invalid DC model parameters: %d", ret);
+        }
+        /* GCOVR_EXCL_STOP */
     }
-    if (speed_norm > 1.0f) {
-        speed_norm = 1.0f;
+
+    motor_control_speed_control(ctx, state);
+    motor_dc_plant_step(&ctx->dc_coeffs, &ctx->dc, state);
+    motor_model_thermal_step(&model_params, state, step, CONFIG_MOTOR_SIM_THERMAL_DIVIDER);
+}
+#else
+void motor_control_step(struct motor_control_ctx *ctx, struct motor_state *state, uint32_t step)
+{
+    motor_control_speed_control(ctx, state);
+    motor_model_first_order_plant(&model_params, state);
+    motor_model_thermal_step(&model_params, state, step, CONFIG_MOTOR_SIM_THERMAL_DIVIDER);
+}
+#endif
+
+void motor_control_run_once(void)
+{
+    APP_TRACE_BEGIN(APP_TRACE_CTRL_STEP);
+
+    /* Commands posted since the previous tick take effect here, in order. */
+    (void)motor_cmd_drain();
+
+    float profile_rpm;
+    if (trajectory_tick(MOTOR_CONTROL_PERIOD_MS, &profile_rpm)) {
+        (void)app_state_set_setpoint(profile_rpm);
     }
 
-    float heating = HEAT_GAIN * speed_norm * speed_norm;
-    float cooling = COOL_GAIN * (state->temperature_c - AMBIENT_TEMP_C);
-    state->temperature_c += (heating - cooling);
+    struct motor_state state;
+    int ret = app_state_get_snapshot(&state);
+    /* GCOVR_EXCL_START */
+    if (ret != 0) {
+        LOG_ERR("T[%s] app_state_get_snapshot failed: %d", MOTOR_CONTROL_THREAD_NAME, ret);
+        APP_TRACE_END(APP_TRACE_CTRL_STEP);
+        return;
+    }
+    /* GCOVR_EXCL_STOP */
 
-    if (state->temperature_c < AMBIENT_TEMP_C) {
-        state->temperature_c = AMBIENT_TEMP_C;
+    motor_control_step(&control_ctx, &state, control_steps++);
+    motor_control_account(&control_ctx, &state);
+    if (control_ctx.tuning_changed) {
+        motor_control_publish_tuning(&control_ctx);
     }
-    if (state->temperature_c > MAX_TEMP_C) {
-        state->temperature_c = MAX_TEMP_C;
+
+    ret = app_state_update_feedback(
+        state.measured_rpm, state.control_output_pct, state.temperature_c);
+    /* GCOVR_EXCL_START */
+    if (ret != 0) {
+        LOG_ERR("T[%s] app_state_update_feedback failed: %d", MOTOR_CONTROL_THREAD_NAME, ret);
     }
+    /* GCOVR_EXCL_STOP */
+
+    APP_TRACE_END(APP_TRACE_CTRL_STEP);
+}
+
+static void motor_control_apply_gains(void *arg)
+{
+    struct motor_control_ctx *ctx = arg;
+
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+    ctx->gains = requested_gains;
+    k_spin_unlock(&tuning_lock, key);
+
+    motor_control_publish_tuning(ctx);
+}
 
-    /* Temperature-based saturation (safety), actual fault reporting is separate. */
-    if ((state->temperature_c > SOFT_LIMIT_TEMP_C) && (state->control_output_pct > 60.0f)) {
-        state->control_output_pct = 60.0f;
+static void motor_control_apply_tune_start(void *arg)
+{
+    struct motor_control_ctx *ctx = arg;
+
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+    ctx->tune_cfg = requested_tune;
+    k_spin_unlock(&tuning_lock, key);
+
+    /* Started by the next step, which has the operating point. */
+    ctx->tune_pending = true;
+}
+
+static void motor_control_apply_tune_stop(void *arg)
+{
+    struct motor_control_ctx *ctx = arg;
+
+    if (ctx->tune_pending || (ctx->tuner.status == MOTOR_PID_TUNE_RUNNING)) {
+        ctx->tune_pending = false;
+        ctx->tuner.status = MOTOR_PID_TUNE_IDLE;
+        motor_pid_reset(&ctx->pid);
     }
 
-    if ((state->temperature_c > HARD_LIMIT_TEMP_C) && (state->control_output_pct > 10.0f)) {
-        state->control_output_pct = 10.0f;
+    motor_control_publish_tuning(ctx);
+}
+
+/* Run @p fn on the application's controller at the next tick. */
+static int motor_control_call(void (*fn)(void *arg))
+{
+    const struct motor_cmd cmd = {
+        .type = MOTOR_CMD_CALL,
+        .fn = fn,
+        .arg = &control_ctx,
+    };
+
+    return motor_cmd_post(&cmd);
+}
+
+int motor_control_set_gains(const struct motor_pid_gains *gains)
+{
+    const float g[] = {gains->kp_pct, gains->ki_pct, gains->kd_pct};
+
+    for (size_t i = 0; i < ARRAY_SIZE(g); i++) {
+        if (!isfinite(g[i]) || (g[i] < 0.0f)) {
+            return -EINVAL;
+        }
     }
+
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+    requested_gains = *gains;
+    k_spin_unlock(&tuning_lock, key);
+
+    return motor_control_call(motor_control_apply_gains);
+}
+
+int motor_control_tune_start(const struct motor_pid_tune_config *cfg)
+{
+    struct motor_pid_tuner check;
+    struct motor_state state;
+
+    /* Same checks as the loop will make, for an immediate answer. */
+    (void)app_state_get_snapshot(&state);
+    int ret = motor_pid_tune_start(&check, cfg, &state);
+    if (ret != 0) {
+        return ret;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+
+    if (published.status == MOTOR_PID_TUNE_RUNNING) {
+        k_spin_unlock(&tuning_lock, key);
+        return -EBUSY;
+    }
+
+    enum motor_pid_tune_status prev = published.status;
+
+    requested_tune = *cfg;
+    published.status = MOTOR_PID_TUNE_RUNNING;
+    k_spin_unlock(&tuning_lock, key);
+
+    ret = motor_control_call(motor_control_apply_tune_start);
+    if (ret != 0) {
+        key = k_spin_lock(&tuning_lock);
+        published.status = prev;
+        k_spin_unlock(&tuning_lock, key);
+    }
+
+    return ret;
+}
+
+int motor_control_tune_stop(void)
+{
+    return motor_control_call(motor_control_apply_tune_stop);
+}
+
+void motor_control_get_tuning(struct motor_control_tuning *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&tuning_lock);
+    *out = published;
+    k_spin_unlock(&tuning_lock, key);
+}
+
+void motor_control_save(struct motor_control_checkpoint *out)
+{
+    *out = (struct motor_control_checkpoint){
+        .control_steps = control_steps,
+        .dc_model = IS_ENABLED(CONFIG_MOTOR_SIM_DC_MODEL) ? 1U : 0U,
+        .gains = control_ctx.gains,
+        .pid = control_ctx.pid,
+    };
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+    out->dc = control_ctx.dc;
+#endif
+}
+
+int motor_control_restore(const struct motor_control_checkpoint *cp)
+{
+    if (cp->dc_model != (IS_ENABLED(CONFIG_MOTOR_SIM_DC_MODEL) ? 1U : 0U)) {
+        return -ENOTSUP;
+    }
+
+    control_steps = cp->control_steps;
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+    control_ctx.dc = cp->dc;
+#endif
+    control_ctx.gains = cp->gains;
+    control_ctx.pid = cp->pid;
+    control_ctx.tune_pending = false;
+    if (control_ctx.tuner.status == MOTOR_PID_TUNE_RUNNING) {
+        control_ctx.tuner.status = MOTOR_PID_TUNE_IDLE;
+    }
+    motor_control_publish_tuning(&control_ctx);
+
+    return 0;
+}
+
+void motor_control_get_timing(struct motor_control_timing *out)
+{
+    out->periods = (uint32_t)atomic_get(&timed_periods);
+    out->late_sum_us = (uint32_t)atomic_get(&late_sum_us);
+    out->late_max_us = (uint32_t)atomic_get(&late_max_us);
+    out->missed = (uint32_t)atomic_get(&missed_periods);
+}
+
+void motor_control_reset_timing(void)
+{
+    atomic_clear(&timed_periods);
+    atomic_clear(&late_sum_us);
+    atomic_clear(&late_max_us);
+    atomic_clear(&missed_periods);
+}
+
+void motor_control_get_lifetime(struct motor_lifetime *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&lifetime_lock);
+    *out = lifetime;
+    k_spin_unlock(&lifetime_lock, key);
+}
+
+void motor_control_reset_lifetime(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&lifetime_lock);
+    motor_lifetime_reset(&lifetime);
+    k_spin_unlock(&lifetime_lock, key);
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+struct motor_control_ctx *motor_control_test_get_ctx(void)
+{
+    return &control_ctx;
+}
+#endif
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** Clock the period timing uses instead of the cycle counter, if set. */
+static uint64_t (*period_clock_ns)(void);
+
+void motor_control_test_set_period_clock(uint64_t (*now_ns)(void))
+{
+    period_clock_ns = now_ns;
+}
+#endif
+
+/** Timestamp of the period timing: a cycle count, or the test clock in ns. */
+static uint64_t motor_control_period_stamp(void)
+{
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+    if (period_clock_ns != NULL) {
+        return period_clock_ns();
+    }
+#endif
+    return k_cycle_get_32();
+}
+
+/** Time between two motor_control_period_stamp() values (us). */
+static uint32_t motor_control_period_interval_us(uint64_t from, uint64_t to)
+{
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+    if (period_clock_ns != NULL) {
+        return (uint32_t)MIN((to - from) / NSEC_PER_USEC, UINT32_MAX);
+    }
+#endif
+    /* The 32-bit cycle counter wraps: subtract before converting. */
+    return k_cyc_to_us_floor32((uint32_t)to - (uint32_t)from);
+}
+
+/**
+ * @brief Account for the period starting now.
+ *
+ * @param prev Timestamp of the previous period's start.
+ *
+ * @return Timestamp of this period's start.
+ */
+static uint64_t motor_control_time_period(uint64_t prev)
+{
+    uint64_t now = motor_control_period_stamp();
+    uint32_t interval_us = motor_control_period_interval_us(prev, now);
+    uint32_t period_us = thread_period_ms * USEC_PER_MSEC;
+    uint32_t late_us = (interval_us > period_us) ? (interval_us - period_us) : 0U;
+
+    atomic_inc(&timed_periods);
+    atomic_add(&late_sum_us, (atomic_val_t)late_us);
+    atomic_add(&missed_periods, (late_us >= period_us) ? 1 : 0);
+
+    /* Single writer: no compare-and-swap needed. */
+    atomic_set(&late_max_us, (atomic_val_t)MAX(late_us, (uint32_t)atomic_get(&late_max_us)));
+
+    return now;
 }
 
 /**
  * @brief Main motor control loop.
  *
- * This thread:
- * - reads the current setpoint and feedback,
- * - computes a simple proportional correction,
- * - simulates first-order motor dynamics,
- * - updates temperature and applies overtemperature limits (saturation),
- * - publishes feedback back to app_state.
+ * This thread runs motor_control_run_once() every motor_control_config::period_ms
+ * (MOTOR_CONTROL_PERIOD_MS unless motor_control_init() set another period).
  */
 static void control_thread(void *p1, void *p2, void *p3)
 {
@@ -122,28 +522,13 @@ static void control_thread(void *p1, void *p2, void *p3)
     ARG_UNUSED(p2);
     ARG_UNUSED(p3);
 
-    while (true) {
-        struct motor_state state;
-        int ret = app_state_get_snapshot(&state);
-        /* GCOVR_EXCL_START */
-        if (ret != 0) {
-            LOG_ERR("T[%s] app_state_get_snapshot failed: %d", MOTOR_CONTROL_THREAD_NAME, ret);
-            k_msleep(CONTROL_PERIOD_MS);
-            continue;
-        }
-        /* GCOVR_EXCL_STOP */
-
-        motor_control_step(&state);
-
-        ret = app_state_update_feedback(
-            state.measured_rpm, state.control_output_pct, state.temperature_c);
-        /* GCOVR_EXCL_START */
-        if (ret != 0) {
-            LOG_ERR("T[%s] app_state_update_feedback failed: %d", MOTOR_CONTROL_THREAD_NAME, ret);
-        }
-        /* GCOVR_EXCL_STOP */
+    uint64_t start = motor_control_period_stamp();
 
-        k_msleep(CONTROL_PERIOD_MS);
+    while (true) {
+        motor_control_run_once();
+        k_msleep(thread_period_ms);
+        wakeups_count(WAKEUPS_CONTROL);
+        start = motor_control_time_period(start);
     }
 }
 
@@ -155,4 +540,5 @@ void motor_control_stop(void)
         control_tid = NULL;
     }
 }
-#endif
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
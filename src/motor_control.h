@@ -10,6 +10,115 @@
 #ifndef MOTOR_CONTROL_H_
 #define MOTOR_CONTROL_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "motor_dc.h"
+#include "motor_lifetime.h"
+#include "motor_pid.h"
+
+/** Control loop period in milliseconds: the model time each control period advances. */
+#define MOTOR_CONTROL_PERIOD_MS 50
+
+/**
+ * @brief Control thread timing, set with motor_control_init().
+ */
+struct motor_control_config {
+    /**
+     * Time the control thread sleeps between two control periods. Each period
+     * still advances the model by MOTOR_CONTROL_PERIOD_MS, so a shorter sleep
+     * runs the simulation faster than real time.
+     */
+    uint32_t period_ms;
+};
+
+/** Timing used by the application: the model runs in real time. */
+#define MOTOR_CONTROL_CONFIG_DEFAULT                                                               \
+    {                                                                                              \
+        .period_ms = MOTOR_CONTROL_PERIOD_MS,                                                      \
+    }
+
+/**
+ * @brief Control thread period timing, see motor_control_get_timing().
+ *
+ * The lateness of a period is how much longer than motor_control_config::period_ms
+ * the time between its start and the previous period's start was (wakeup
+ * latency, preemption and the loop's own run time).
+ */
+struct motor_control_timing {
+    uint32_t periods;     /**< Periods timed since the last reset. */
+    uint32_t late_sum_us; /**< Sum of the lateness of these periods (us). */
+    uint32_t late_max_us; /**< Largest lateness (us). */
+    uint32_t missed;      /**< Periods late by a whole period or more (a deadline missed). */
+};
+
+/**
+ * @brief Speed controller gains and auto-tuner state, see motor_control_get_tuning().
+ */
+struct motor_control_tuning {
+    struct motor_pid_gains gains;      /**< Gains in use. */
+    enum motor_pid_tune_status status; /**< Auto-tuner state. */
+    struct motor_pid_ident ident;      /**< Model identified by the last successful run. */
+};
+
+/**
+ * @brief Controller and plant state beyond app_state, for checkpoints.
+ */
+struct motor_control_checkpoint {
+    uint32_t control_steps;       /**< Control periods stepped (thermal sub-rate phase). */
+    uint32_t dc_model;            /**< 1 if saved with CONFIG_MOTOR_SIM_DC_MODEL. */
+    struct motor_dc_state dc;     /**< DC plant and current loop integrator (DC model only). */
+    struct motor_pid_gains gains; /**< Speed controller gains. */
+    struct motor_pid_state pid;   /**< Speed controller memory. */
+};
+
+/**
+ * @brief Controller state of one motor, see motor_control_ctx_init().
+ *
+ * Everything motor_control_step() writes besides the motor state, so
+ * instances stepped on different threads share nothing. The application's
+ * own controller is a single static instance driven by the control loop.
+ */
+struct motor_control_ctx {
+    struct motor_pid_gains gains;          /**< Speed controller gains. */
+    struct motor_pid_state pid;            /**< Speed controller memory. */
+    struct motor_pid_tuner tuner;          /**< Relay auto-tuner. */
+    struct motor_pid_tune_config tune_cfg; /**< Settings of the pending experiment. */
+    bool tune_pending;                     /**< Start the experiment at the next step. */
+    bool tuning_changed;                   /**< Gains or tuner state changed by a step. */
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+    struct motor_dc_coeffs dc_coeffs; /**< DC plant discretization, prepared at the first step. */
+    struct motor_dc_state dc;         /**< DC plant and current loop integrator. */
+#endif
+};
+
+/** Static initializer: the state motor_control_ctx_init() sets. */
+#define MOTOR_CONTROL_CTX_INIT {.gains = MOTOR_PID_GAINS_DEFAULT}
+
+/**
+ * @brief Put @p ctx in its power-on state.
+ *
+ * MOTOR_PID_GAINS_DEFAULT, the auto-tuner idle and, with
+ * CONFIG_MOTOR_SIM_DC_MODEL, the DC plant at rest, its discretization
+ * computed at the first step.
+ *
+ * @param ctx Controller to initialize. Must not be NULL.
+ */
+void motor_control_ctx_init(struct motor_control_ctx *ctx);
+
+/**
+ * @brief Set the control thread timing and restart the control period count.
+ *
+ * Optional: without it the thread uses MOTOR_CONTROL_CONFIG_DEFAULT. Call it
+ * before motor_control_start(). Restarting the count (and the DC model's
+ * electrical state) makes repeated runs from app_state_init() identical. The
+ * speed controller is also put back to MOTOR_PID_GAINS_DEFAULT, and the
+ * auto-tuner to idle.
+ *
+ * @param cfg Timing to use. Must not be NULL.
+ */
+void motor_control_init(const struct motor_control_config *cfg);
+
 /**
  * @brief Start the motor control thread.
  *
@@ -18,8 +127,133 @@
  * - updates the control output to follow the setpoint,
  * - simulates motor dynamics and temperature,
  * - writes feedback back into the shared state.
+ *
+ * Not built with CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE, which has no control
+ * thread.
  */
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 void motor_control_start(void);
+#endif
+
+/**
+ * @brief Run one control period without sleeping.
+ *
+ * This is the body of the control thread:
+ * - applies the commands queued since the previous tick (motor_cmd),
+ * - advances the setpoint profile (if one is running),
+ * - reads the current setpoint and feedback,
+ * - runs the speed controller, or the relay experiment while auto-tuning,
+ * - simulates first-order motor dynamics,
+ * - updates temperature and applies overtemperature limits (saturation),
+ * - adds the period to the lifetime statistics,
+ * - publishes feedback back to app_state.
+ *
+ * It is also called directly by the cyclic executive.
+ */
+void motor_control_run_once(void);
+
+/**
+ * @brief Get the control thread's period timing.
+ *
+ * Only periods of the control thread started by motor_control_start() are
+ * timed, not motor_control_run_once() calls from elsewhere.
+ *
+ * @param out Timing to fill. Must not be NULL.
+ */
+void motor_control_get_timing(struct motor_control_timing *out);
+
+/**
+ * @brief Clear the control thread's period timing.
+ */
+void motor_control_reset_timing(void);
+
+/**
+ * @brief Get the lifetime statistics of the motor.
+ *
+ * Every motor_control_run_once() period is accumulated, with the electrical
+ * power of the DC model, or MOTOR_LIFETIME_RATED_POWER_W scaled by the output
+ * without it.
+ * motor_control_init() clears them; checkpoints do not include them.
+ *
+ * @param out Statistics to fill. Must not be NULL.
+ */
+void motor_control_get_lifetime(struct motor_lifetime *out);
+
+/**
+ * @brief Clear the lifetime statistics.
+ */
+void motor_control_reset_lifetime(void);
+
+/**
+ * @brief Set the speed controller gains.
+ *
+ * Applied by the control loop at its next tick, in order with the other
+ * queued commands. The controller works on the output it applied last, so
+ * the change is bumpless. A running auto-tuner replaces the gains again when
+ * it succeeds.
+ *
+ * @param gains New gains. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if a gain is negative or not finite, -ENOSPC
+ *         if the command queue is full.
+ */
+int motor_control_set_gains(const struct motor_pid_gains *gains);
+
+/**
+ * @brief Start the relay auto-tuner at the current operating point.
+ *
+ * The experiment starts at the next control tick and replaces the speed
+ * controller until it ends; the motor should be settled at the setpoint
+ * first. On success the computed gains are applied; on failure the gains are
+ * kept. Follow it with motor_control_get_tuning().
+ *
+ * @param cfg Relay settings. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if a setting is out of range or the output is
+ *         at 0 or 100% (see motor_pid_tune_start()), -EBUSY if the tuner is
+ *         already running, -ENOSPC if the command queue is full.
+ */
+int motor_control_tune_start(const struct motor_pid_tune_config *cfg);
+
+/**
+ * @brief Abort a running auto-tuner at the next control tick.
+ *
+ * The speed controller takes over again with unchanged gains.
+ *
+ * @return 0 on success (also if none is running), -ENOSPC if the command
+ *         queue is full.
+ */
+int motor_control_tune_stop(void);
+
+/**
+ * @brief Get the speed controller gains and the auto-tuner state.
+ *
+ * @param out State to fill. Must not be NULL.
+ */
+void motor_control_get_tuning(struct motor_control_tuning *out);
+
+/**
+ * @brief Copy the controller and plant state.
+ *
+ * Call it from the control loop (e.g. a MOTOR_CMD_CALL command) or while
+ * the loop is not running, so the state is not caught mid-period.
+ *
+ * @param out State to fill. Must not be NULL.
+ */
+void motor_control_save(struct motor_control_checkpoint *out);
+
+/**
+ * @brief Resume the controller and plant state saved by motor_control_save().
+ *
+ * Same calling context as motor_control_save(). A running auto-tuner is
+ * stopped.
+ *
+ * @param cp State to resume. Must not be NULL.
+ *
+ * @return 0 on success, -ENOTSUP if @p cp was saved with the other plant
+ *         model (CONFIG_MOTOR_SIM_DC_MODEL).
+ */
+int motor_control_restore(const struct motor_control_checkpoint *cp);
 
 #ifdef MOTOR_SIM_DEMO_UNIT_TEST
 #include "app_state.h"
@@ -27,19 +261,46 @@ void motor_control_start(void);
 /**
  * @brief Run a single control-loop step on a state snapshot (test-only).
  *
- * This function implements the pure control + model update logic without any
- * threading, sleeps, or synchronization. It is intended for deterministic unit tests.
+ * Runs the speed controller (or the relay experiment) and the plant model of
+ * @p ctx on @p state, without sleeping or taking a lock: the lifetime
+ * statistics are left to motor_control_run_once(). Instances with their own
+ * @p ctx and @p state may be stepped concurrently; one instance must be
+ * stepped by one thread at a time. Tuner state changes are only flagged in
+ * motor_control_ctx::tuning_changed: motor_control_get_tuning() shows the
+ * application's controller once its loop publishes them.
  *
+ * @param ctx   Controller state of this motor.
  * @param state In/out motor state snapshot to be updated.
+ * @param step  Index of the control period, kept by the caller. The thermal
+ *              model is updated when it is a multiple of
+ *              CONFIG_MOTOR_SIM_THERMAL_DIVIDER.
+ */
+void motor_control_step(struct motor_control_ctx *ctx, struct motor_state *state, uint32_t step);
+
+/**
+ * @brief The application's controller, as driven by motor_control_run_once() (test-only).
  */
-void motor_control_step(struct motor_state *state);
+struct motor_control_ctx *motor_control_test_get_ctx(void);
 
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 /**
  * @brief Stop the motor control thread (test-only).
  *
  * Aborts the internal thread created by @ref motor_control_start.
  */
 void motor_control_stop(void);
+
+/**
+ * @brief Time the control periods with @p now_ns instead of the cycle counter (test-only).
+ *
+ * On native_sim the cycle counter stands still while code runs, so CPU load
+ * never shows as lateness; a host clock does. Call it before
+ * motor_control_start().
+ *
+ * @param now_ns Monotonic clock in ns, or NULL for the cycle counter.
+ */
+void motor_control_test_set_period_clock(uint64_t (*now_ns)(void));
+#endif
 #endif /* MOTOR_SIM_DEMO_UNIT_TEST */
 
 #endif /* MOTOR_CONTROL_H_ */
@@ -0,0 +1,75 @@
+/**
+ * @file sample_pool.c
+ * @brief Shared pool of reference-counted sample blocks.
+ *
+ * The blocks come from a k_mem_slab defined at build time. The reference
+ * count is an atomic in the block, so holding and releasing a sample costs
+ * one atomic operation and only the last release touches the slab.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "sample_pool.h"
+
+K_MEM_SLAB_DEFINE_STATIC(sample_slab, sizeof(struct sample_pool_block), SAMPLE_POOL_BLOCKS,
+                         __alignof__(struct sample_pool_block));
+
+static atomic_t peak_in_use;
+static atomic_t exhausted;
+
+static struct sample_pool_block *sample_pool_block_of(const struct app_state_sample *sample)
+{
+    return CONTAINER_OF((struct app_state_sample *)sample, struct sample_pool_block, sample);
+}
+
+struct app_state_sample *sample_pool_alloc(void)
+{
+    void *mem;
+
+    if (k_mem_slab_alloc(&sample_slab, &mem, K_NO_WAIT) != 0) {
+        atomic_inc(&exhausted);
+        return NULL;
+    }
+
+    struct sample_pool_block *block = mem;
+    atomic_val_t used = (atomic_val_t)k_mem_slab_num_used_get(&sample_slab);
+    atomic_val_t peak = atomic_get(&peak_in_use);
+
+    while ((peak < used) && !atomic_cas(&peak_in_use, peak, used)) {
+        peak = atomic_get(&peak_in_use); /* GCOVR_EXCL_LINE */
+    }
+
+    atomic_set(&block->refs, 1);
+
+    return &block->sample;
+}
+
+void sample_pool_hold(const struct app_state_sample *sample)
+{
+    atomic_inc(&sample_pool_block_of(sample)->refs);
+}
+
+void sample_pool_release(const struct app_state_sample *sample)
+{
+    struct sample_pool_block *block = sample_pool_block_of(sample);
+
+    /* atomic_dec() returns the count before the decrement. */
+    if (atomic_dec(&block->refs) == 1) {
+        k_mem_slab_free(&sample_slab, block);
+    }
+}
+
+void sample_pool_get_stats(struct sample_pool_stats *out)
+{
+    out->blocks = SAMPLE_POOL_BLOCKS;
+    out->in_use = k_mem_slab_num_used_get(&sample_slab);
+    out->peak_in_use = (uint32_t)atomic_get(&peak_in_use);
+    out->exhausted = (uint32_t)atomic_get(&exhausted);
+}
+
+void sample_pool_reset_stats(void)
+{
+    atomic_set(&peak_in_use, (atomic_val_t)k_mem_slab_num_used_get(&sample_slab));
+    atomic_clear(&exhausted);
+}
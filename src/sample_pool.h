@@ -0,0 +1,98 @@
+/**
+ * @file sample_pool.h
+ * @brief Public API for the shared pool of reference-counted sample blocks.
+ *
+ * Every feedback sample lives in one block of a statically sized memory slab,
+ * carved at boot. app_state fills the block in place once; the history ring,
+ * the UDP link and readers such as motor_dump then hold references to the
+ * same block instead of keeping their own copies, and the block returns to
+ * the slab when the last reference is released. The pool is sized for every
+ * holder at once, so peak RAM is fixed at build time; if it still runs dry the
+ * sample is dropped and counted, never allocated elsewhere.
+ */
+
+#ifndef SAMPLE_POOL_H_
+#define SAMPLE_POOL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/atomic.h>
+
+#include "app_state.h" /* struct app_state_sample */
+
+#if defined(CONFIG_MOTOR_SIM_UDP)
+/** Blocks the UDP link can hold: the batch being filled and the one being sent. */
+#define SAMPLE_POOL_UDP_BLOCKS (2 * CONFIG_MOTOR_SIM_UDP_BATCH)
+#else
+#define SAMPLE_POOL_UDP_BLOCKS 0
+#endif
+
+/**
+ * Number of blocks in the pool: one per holder slot, one for the sample being
+ * recorded (allocated before the ring releases the sample it replaces), and
+ * the spares.
+ */
+#define SAMPLE_POOL_BLOCKS                                                                         \
+    (APP_STATE_HISTORY_LEN + SAMPLE_POOL_UDP_BLOCKS + 1 + CONFIG_MOTOR_SIM_SAMPLE_POOL_SPARE)
+
+/**
+ * @brief One pool block: a sample and the number of holders.
+ */
+struct sample_pool_block {
+    atomic_t refs;                  /**< Holders of the block; freed when it drops to 0. */
+    struct app_state_sample sample; /**< The sample, written once by its producer. */
+};
+
+/**
+ * @brief Pool usage and exhaustion counters.
+ */
+struct sample_pool_stats {
+    uint32_t blocks;      /**< Blocks in the pool (SAMPLE_POOL_BLOCKS). */
+    uint32_t in_use;      /**< Blocks held right now. */
+    uint32_t peak_in_use; /**< Most blocks held at once since the last reset. */
+    uint32_t exhausted;   /**< Allocations that found the pool empty since the last reset. */
+};
+
+/**
+ * @brief Take a free block for a new sample.
+ *
+ * Never blocks. The caller holds the only reference and fills the sample in
+ * place before handing it out.
+ *
+ * @return Sample to fill, NULL if the pool is exhausted (counted).
+ */
+struct app_state_sample *sample_pool_alloc(void);
+
+/**
+ * @brief Add a holder to a sample.
+ *
+ * Lock-free; safe from any thread.
+ *
+ * @param sample Sample from sample_pool_alloc() the caller already holds (or
+ *               got from a holder under that holder's lock). Must not be NULL.
+ */
+void sample_pool_hold(const struct app_state_sample *sample);
+
+/**
+ * @brief Drop one reference to a sample.
+ *
+ * The block returns to the pool with the last reference; the caller must not
+ * touch the sample afterwards.
+ *
+ * @param sample Held sample. Must not be NULL.
+ */
+void sample_pool_release(const struct app_state_sample *sample);
+
+/**
+ * @brief Get the pool usage and exhaustion counters.
+ *
+ * @param out Counters to fill. Must not be NULL.
+ */
+void sample_pool_get_stats(struct sample_pool_stats *out);
+
+/**
+ * @brief Clear the exhaustion count and restart the peak from the current use.
+ */
+void sample_pool_reset_stats(void);
+
+#endif /* SAMPLE_POOL_H_ */
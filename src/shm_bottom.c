@@ -0,0 +1,66 @@
+/**
+ * @file shm_bottom.c
+ * @brief Host file mapping for the shared-memory exporter (native_sim).
+ *
+ * Runs on the host side of native_sim: uses the host's open/mmap directly.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shm_bottom.h"
+
+void *shm_bottom_map(const char *path, size_t size, bool create)
+{
+    int fd;
+
+    if (create) {
+        /*
+         * A new file rather than truncating the old one: a reader still
+         * mapping the previous run keeps a valid (if stale) ring instead of
+         * faulting on pages that disappeared.
+         */
+        (void)unlink(path);
+        fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    } else {
+        fd = open(path, O_RDWR);
+    }
+    if (fd < 0) {
+        fprintf(stderr, "shm_bottom: open %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    struct stat st;
+    void *addr = NULL;
+
+    if (create && (ftruncate(fd, (off_t)size) != 0)) {
+        /* GCOVR_EXCL_START */
+        fprintf(stderr, "shm_bottom: resize %s: %s\n", path, strerror(errno));
+        /* GCOVR_EXCL_STOP */
+    } else if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < size)) {
+        fprintf(stderr, "shm_bottom: %s is smaller than %zu bytes\n", path, size);
+    } else {
+        addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            /* GCOVR_EXCL_START */
+            fprintf(stderr, "shm_bottom: mmap %s: %s\n", path, strerror(errno));
+            addr = NULL;
+            /* GCOVR_EXCL_STOP */
+        }
+    }
+
+    /* The mapping keeps the file referenced. */
+    (void)close(fd);
+
+    return addr;
+}
+
+void shm_bottom_unmap(void *addr, size_t size)
+{
+    (void)munmap(addr, size);
+}
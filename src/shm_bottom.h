@@ -0,0 +1,35 @@
+/**
+ * @file shm_bottom.h
+ * @brief Host file mapping for the shared-memory exporter (native_sim).
+ *
+ * Implemented in shm_bottom.c, which is built against the host C library as
+ * part of the native simulator runner, not the Zephyr image. Only plain C
+ * types cross this interface.
+ */
+
+#ifndef SHM_BOTTOM_H_
+#define SHM_BOTTOM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Map @p size bytes of the host file @p path read/write and shared.
+ *
+ * @param path   Host file path.
+ * @param size   Bytes to map.
+ * @param create Replace any existing file with a new zero-filled one of
+ *               @p size bytes. Otherwise the file must exist and be at
+ *               least @p size bytes long.
+ *
+ * @return Start of the mapping, or NULL on failure (the host error is printed
+ *         on the host's stderr).
+ */
+void *shm_bottom_map(const char *path, size_t size, bool create);
+
+/**
+ * @brief Unmap a mapping returned by shm_bottom_map().
+ */
+void shm_bottom_unmap(void *addr, size_t size);
+
+#endif /* SHM_BOTTOM_H_ */
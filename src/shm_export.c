@@ -0,0 +1,93 @@
+/**
+ * @file shm_export.c
+ * @brief Shared-memory telemetry exporter (native_sim).
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "cmdline.h"
+#include "soc.h"
+
+#include "motor_shm_ring.h"
+#include "shm_bottom.h"
+#include "shm_export.h"
+
+LOG_MODULE_REGISTER(shm_export, LOG_LEVEL_INF);
+
+BUILD_ASSERT((CONFIG_MOTOR_SIM_SHM_SLOTS & (CONFIG_MOTOR_SIM_SHM_SLOTS - 1)) == 0,
+             "CONFIG_MOTOR_SIM_SHM_SLOTS must be a power of two");
+BUILD_ASSERT(sizeof(struct app_state_sample) == sizeof(struct motor_shm_sample),
+             "exported sample layout out of sync with app_state");
+
+/* Ring file path; the command line option replaces the Kconfig default. */
+static const char *shm_path = CONFIG_MOTOR_SIM_SHM_FILE;
+
+/* Mapped ring, NULL while not exporting. */
+static struct motor_shm_ring *shm_ring;
+
+static void shm_export_add_options(void)
+{
+    static struct args_struct_t shm_options[] = {
+        {
+            .option = "shm-file",
+            .name = "path",
+            .type = 's',
+            .dest = (void *)&shm_path,
+            .descript = "Host file for the shared-memory telemetry ring",
+        },
+        ARG_TABLE_ENDMARKER,
+    };
+
+    native_add_command_line_opts(shm_options);
+}
+
+NATIVE_TASK(shm_export_add_options, PRE_BOOT_1, 1);
+
+int shm_export_init(void)
+{
+    size_t size = motor_shm_ring_size(CONFIG_MOTOR_SIM_SHM_SLOTS);
+    void *mem = shm_bottom_map(shm_path, size, true);
+
+    if (mem == NULL) {
+        LOG_ERR("cannot map %s, samples not exported", shm_path);
+        return -EIO;
+    }
+
+    shm_ring = motor_shm_ring_init(mem, size, CONFIG_MOTOR_SIM_SHM_SLOTS);
+    LOG_INF("exporting samples to %s (%u slots)", shm_path, CONFIG_MOTOR_SIM_SHM_SLOTS);
+
+    return 0;
+}
+
+void shm_export_push(const struct app_state_sample *sample)
+{
+    if (shm_ring == NULL) {
+        return;
+    }
+
+    const struct motor_shm_sample out = {
+        .seq = sample->seq,
+        .uptime_ms = sample->uptime_ms,
+        .state = sample->state,
+    };
+
+    motor_shm_ring_write(shm_ring, &out);
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void shm_export_test_set_path(const char *path)
+{
+    shm_path = path;
+}
+
+void shm_export_test_close(void)
+{
+    if (shm_ring != NULL) {
+        shm_bottom_unmap(shm_ring, motor_shm_ring_size(CONFIG_MOTOR_SIM_SHM_SLOTS));
+        shm_ring = NULL;
+    }
+}
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
@@ -0,0 +1,61 @@
+/**
+ * @file shm_export.h
+ * @brief Shared-memory telemetry exporter (native_sim).
+ *
+ * With CONFIG_MOTOR_SIM_SHM_EXPORT every feedback sample recorded by
+ * app_state is also written into a lib/motor_model shared-memory ring
+ * (motor_shm_ring.h) placed in a host file mapped with mmap. A host process
+ * maps the same file and follows the samples at full rate, without copies
+ * through the shell or the logs (see host/shm_reader and
+ * docs/shm_telemetry.md). Otherwise the calls compile to nothing.
+ */
+
+#ifndef SHM_EXPORT_H_
+#define SHM_EXPORT_H_
+
+#include "app_state.h"
+
+#if defined(CONFIG_MOTOR_SIM_SHM_EXPORT)
+
+/**
+ * @brief Create the ring file and start exporting.
+ *
+ * The file is CONFIG_MOTOR_SIM_SHM_FILE, or the path given with the
+ * -shm-file=<path> command line option. Any existing file is replaced.
+ *
+ * @return 0 on success, -EIO if the file could not be created or mapped
+ *         (samples are then not exported).
+ */
+int shm_export_init(void);
+
+/**
+ * @brief Export one sample.
+ *
+ * Called by app_state with the state mutex held, which makes it the ring's
+ * single writer. Does nothing before a successful shm_export_init().
+ */
+void shm_export_push(const struct app_state_sample *sample);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Use @p path for the next shm_export_init() (test-only helper). */
+void shm_export_test_set_path(const char *path);
+
+/** @brief Unmap the ring and stop exporting (test-only helper). */
+void shm_export_test_close(void);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
+#else
+
+static inline int shm_export_init(void)
+{
+    return 0;
+}
+
+static inline void shm_export_push(const struct app_state_sample *sample)
+{
+    (void)sample;
+}
+
+#endif /* CONFIG_MOTOR_SIM_SHM_EXPORT */
+
+#endif /* SHM_EXPORT_H_ */
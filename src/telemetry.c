@@ -3,22 +3,31 @@
  * @brief Telemetry thread implementation.
  *
  * Implements a telemetry thread that waits for new samples from app_state and
- * logs a snapshot every N samples.
+ * logs a snapshot every N samples, as text or, with CONFIG_MOTOR_SIM_EVLOG,
+ * as a binary event record.
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 #include "app_state.h"
+#include "app_trace.h"
+#include "evlog.h"
 #include "telemetry.h"
+#include "wakeups.h"
 
 LOG_MODULE_REGISTER(telemetry, LOG_LEVEL_DBG);
 
-#define TELEMETRY_THREAD_STACK_SIZE 1024
+#define TELEMETRY_THREAD_STACK_SIZE CONFIG_MOTOR_SIM_TELEMETRY_STACK_SIZE
 #define TELEMETRY_THREAD_PRIORITY   3
 
 #define TELEMETRY_THREAD_NAME "telemetry"
 
+/* Samples seen so far, used to decimate the log output. */
+static int sample_counter;
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+/* The cyclic executive runs telemetry on the main thread: no thread of its own. */
 static void telemetry_thread(void *p1, void *p2, void *p3);
 
 K_THREAD_STACK_DEFINE(telemetry_stack, TELEMETRY_THREAD_STACK_SIZE);
@@ -42,6 +51,7 @@ void telemetry_start(void)
 
     LOG_INF("Thread '%s' started (tid=%p)", TELEMETRY_THREAD_NAME, (void *)telemetry_tid);
 }
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
 
 bool telemetry_should_log(int *counter)
 {
@@ -49,12 +59,42 @@ bool telemetry_should_log(int *counter)
     return ((*counter % 10) == 0);
 }
 
+void telemetry_process_sample(void)
+{
+    /* Reduce log volume by printing every 10th sample. */
+    if (!telemetry_should_log(&sample_counter)) {
+        return;
+    }
+
+    struct motor_state state;
+    int ret = app_state_get_snapshot(&state);
+    /* GCOVR_EXCL_START */
+    if (ret != 0) {
+        LOG_ERR("T[%s] app_state_get_snapshot failed: %d", TELEMETRY_THREAD_NAME, ret);
+        return;
+    }
+    /* GCOVR_EXCL_STOP */
+
+#if defined(CONFIG_MOTOR_SIM_EVLOG)
+    /* Same text, rendered on the host from the raw values (motor_evlog.h). */
+    evlog_put(MOTOR_EVLOG_TELEMETRY, &state);
+#else
+    LOG_INF("T[%s] SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C",
+            TELEMETRY_THREAD_NAME,
+            (int)state.setpoint_rpm,
+            (int)state.measured_rpm,
+            (int)state.control_output_pct,
+            (int)state.temperature_c);
+#endif
+}
+
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 /**
  * @brief Telemetry loop.
  *
- * This thread blocks until app_state signals that a new sample is
- * available, then logs a snapshot of the current motor state every
- * N samples to avoid flooding the log output.
+ * This thread blocks until app_state signals a state change, then hands
+ * the new sample to telemetry_process_sample(). A settled motor leaves it
+ * asleep.
  */
 static void telemetry_thread(void *p1, void *p2, void *p3)
 {
@@ -62,10 +102,11 @@ static void telemetry_thread(void *p1, void *p2, void *p3)
     ARG_UNUSED(p2);
     ARG_UNUSED(p3);
 
-    int counter = 0;
-
     while (true) {
+        APP_TRACE_BEGIN(APP_TRACE_SAMPLE_WAIT);
         int ret = app_state_wait_for_sample();
+        APP_TRACE_END(APP_TRACE_SAMPLE_WAIT);
+        wakeups_count(WAKEUPS_TELEMETRY);
         /* GCOVR_EXCL_START */
         if (ret != 0) {
             LOG_ERR("T[%s] app_state_wait_for_sample failed: %d", TELEMETRY_THREAD_NAME, ret);
@@ -73,26 +114,7 @@ static void telemetry_thread(void *p1, void *p2, void *p3)
         }
         /* GCOVR_EXCL_STOP */
 
-        /* Reduce log volume by printing every 10th sample. */
-        if (!telemetry_should_log(&counter)) {
-            continue;
-        }
-
-        struct motor_state state;
-        ret = app_state_get_snapshot(&state);
-        /* GCOVR_EXCL_START */
-        if (ret != 0) {
-            LOG_ERR("T[%s] app_state_get_snapshot failed: %d", TELEMETRY_THREAD_NAME, ret);
-            continue;
-        }
-        /* GCOVR_EXCL_STOP */
-
-        LOG_INF("T[%s] SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C",
-                TELEMETRY_THREAD_NAME,
-                (int)state.setpoint_rpm,
-                (int)state.measured_rpm,
-                (int)state.control_output_pct,
-                (int)state.temperature_c);
+        telemetry_process_sample();
     }
 }
 
@@ -104,4 +126,5 @@ void telemetry_stop(void)
         telemetry_tid = NULL;
     }
 }
-#endif
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+#endif /* !CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE */
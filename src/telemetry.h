@@ -9,13 +9,24 @@
 #ifndef TELEMETRY_H_
 #define TELEMETRY_H_
 
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 /**
  * @brief Start the telemetry thread.
  *
  * The telemetry thread waits for new samples from app_state and
- * periodically logs a snapshot of the current motor state.
+ * periodically logs a snapshot of the current motor state. Not built with
+ * CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE, which has no telemetry thread.
  */
 void telemetry_start(void);
+#endif
+
+/**
+ * @brief Account for one new sample and log a snapshot every 10th call.
+ *
+ * This is the body of the telemetry thread once a sample is available. It is
+ * also called directly by the cyclic executive after each control slot.
+ */
+void telemetry_process_sample(void);
 
 #ifdef MOTOR_SIM_DEMO_UNIT_TEST
 #include <stdbool.h>
@@ -31,12 +42,14 @@ void telemetry_start(void);
  */
 bool telemetry_should_log(int *counter);
 
+#if !defined(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
 /**
  * @brief Stop the telemetry thread (test-only).
  *
  * Aborts the internal thread created by @ref telemetry_start.
  */
 void telemetry_stop(void);
+#endif
 #endif /* MOTOR_SIM_DEMO_UNIT_TEST */
 
 #endif /* TELEMETRY_H_ */
@@ -0,0 +1,339 @@
+/**
+ * @file trajectory.c
+ * @brief Setpoint trajectory generator implementation.
+ *
+ * Implements a small profile player driven by the control thread. The player
+ * keeps only incremental state (segment index, elapsed time, sine phase), so
+ * each tick costs a handful of float operations regardless of profile length.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "trajectory.h"
+
+LOG_MODULE_REGISTER(trajectory, LOG_LEVEL_INF);
+
+/* Maximum profile setpoint, should match the app_state setpoint range. */
+#define TRAJECTORY_MAX_RPM 10000.0f
+
+#define TRAJECTORY_TWO_PI 6.28318530718f
+
+/* Maximum number of numeric fields in a segment (sine form). */
+#define TRAJECTORY_MAX_FIELDS 5
+
+/**
+ * @brief Internal player context.
+ */
+struct trajectory_player {
+    /** Loaded segment table. */
+    struct trajectory_segment segs[TRAJECTORY_MAX_SEGMENTS];
+    /** Number of loaded segments. */
+    size_t count;
+    /** Segment currently being played. */
+    size_t index;
+    /** Time spent in the current segment (ms). */
+    uint32_t elapsed_ms;
+    /** Setpoint when the current segment was entered. */
+    float seg_start_rpm;
+    /** Sine phase accumulator (rad). */
+    float phase_rad;
+    /** Last setpoint produced. */
+    float last_rpm;
+    /** Remaining passes through the table (when not repeating forever). */
+    uint32_t passes_left;
+    /** Repeat the table until stopped. */
+    bool forever;
+    /** A profile is running. */
+    bool active;
+};
+
+static struct trajectory_player player;
+
+static K_MUTEX_DEFINE(player_mutex);
+
+/**
+ * @brief Quintic smoothstep (zero velocity and acceleration at both ends).
+ *
+ * Using this shape for ramps keeps the acceleration continuous, so the jerk
+ * of the resulting setpoint is bounded.
+ */
+static float trajectory_smootherstep(float u)
+{
+    return u * u * u * (u * (u * 6.0f - 15.0f) + 10.0f);
+}
+
+static bool trajectory_rpm_valid(float rpm)
+{
+    return (rpm >= 0.0f) && (rpm <= TRAJECTORY_MAX_RPM);
+}
+
+static bool trajectory_segment_valid(const struct trajectory_segment *seg)
+{
+    if (seg->duration_ms == 0U) {
+        return false;
+    }
+
+    if (seg->type == TRAJECTORY_SEG_SINE) {
+        return trajectory_rpm_valid(seg->target_rpm - seg->amplitude_rpm) &&
+               trajectory_rpm_valid(seg->target_rpm + seg->amplitude_rpm) &&
+               (seg->amplitude_rpm >= 0.0f) && (seg->freq_start_hz >= 0.0f) &&
+               (seg->freq_end_hz >= 0.0f);
+    }
+
+    return trajectory_rpm_valid(seg->target_rpm);
+}
+
+int trajectory_parse_segment(const char *text, struct trajectory_segment *out)
+{
+    static const struct {
+        const char *name;
+        enum trajectory_seg_type type;
+        int fields;
+    } forms[] = {
+        {"step:", TRAJECTORY_SEG_STEP, 2},
+        {"ramp:", TRAJECTORY_SEG_RAMP, 2},
+        {"sine:", TRAJECTORY_SEG_SINE, 5},
+    };
+
+    const char *p = NULL;
+    size_t form = 0;
+
+    for (form = 0; form < ARRAY_SIZE(forms); form++) {
+        size_t len = strlen(forms[form].name);
+        if (strncmp(text, forms[form].name, len) == 0) {
+            p = text + len;
+            break;
+        }
+    }
+
+    if (p == NULL) {
+        return -EINVAL;
+    }
+
+    long long fields[TRAJECTORY_MAX_FIELDS] = {0};
+
+    for (int i = 0; i < forms[form].fields; i++) {
+        char *end = NULL;
+
+        /* Every field must fit the uint32_t duration, whatever the width of long. */
+        errno = 0;
+        fields[i] = strtoll(p, &end, 10);
+        if ((end == p) || (errno == ERANGE) || (fields[i] < 0) ||
+            (fields[i] > (long long)UINT32_MAX)) {
+            return -EINVAL;
+        }
+
+        bool last = (i == (forms[form].fields - 1));
+        if ((last && (*end != '\0')) || (!last && (*end != ':'))) {
+            return -EINVAL;
+        }
+        p = end + 1;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->type = forms[form].type;
+    out->target_rpm = (float)fields[0];
+    out->duration_ms = (uint32_t)fields[1];
+    out->amplitude_rpm = (float)fields[2];
+    out->freq_start_hz = (float)fields[3] / 1000.0f;
+    out->freq_end_hz = (float)fields[4] / 1000.0f;
+
+    return 0;
+}
+
+int trajectory_load(const struct trajectory_segment *segs, size_t count)
+{
+    if ((segs == NULL) || (count == 0U) || (count > TRAJECTORY_MAX_SEGMENTS)) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!trajectory_segment_valid(&segs[i])) {
+            LOG_WRN("Invalid profile segment %u", (unsigned int)i);
+            return -EINVAL;
+        }
+    }
+
+    k_mutex_lock(&player_mutex, K_FOREVER);
+
+    if (player.active) {
+        k_mutex_unlock(&player_mutex);
+        return -EBUSY;
+    }
+
+    memcpy(player.segs, segs, count * sizeof(segs[0]));
+    player.count = count;
+
+    k_mutex_unlock(&player_mutex);
+
+    LOG_INF("Profile loaded: %u segments", (unsigned int)count);
+
+    return 0;
+}
+
+int trajectory_start(float start_rpm, uint32_t passes)
+{
+    k_mutex_lock(&player_mutex, K_FOREVER);
+
+    if (player.count == 0U) {
+        k_mutex_unlock(&player_mutex);
+        return -ENODATA;
+    }
+
+    player.index = 0;
+    player.elapsed_ms = 0;
+    player.seg_start_rpm = start_rpm;
+    player.phase_rad = 0.0f;
+    player.last_rpm = start_rpm;
+    player.forever = (passes == 0U);
+    player.passes_left = passes;
+    player.active = true;
+
+    k_mutex_unlock(&player_mutex);
+
+    LOG_INF("Profile started (%u passes)", passes);
+
+    return 0;
+}
+
+void trajectory_stop(void)
+{
+    k_mutex_lock(&player_mutex, K_FOREVER);
+    bool was_active = player.active;
+    player.active = false;
+    k_mutex_unlock(&player_mutex);
+
+    if (was_active) {
+        LOG_INF("Profile stopped");
+    }
+}
+
+/**
+ * @brief Move to the next segment, wrapping or finishing at the table end.
+ *
+ * This helper assumes the player mutex is already locked before calling.
+ */
+static void trajectory_next_segment_locked(void)
+{
+    player.index++;
+    player.elapsed_ms = 0;
+    player.phase_rad = 0.0f;
+    player.seg_start_rpm = player.last_rpm;
+
+    if (player.index < player.count) {
+        return;
+    }
+
+    player.index = 0;
+
+    if (!player.forever) {
+        player.passes_left--;
+        if (player.passes_left == 0U) {
+            player.active = false;
+            LOG_INF("Profile finished");
+        }
+    }
+}
+
+/**
+ * @brief Integrate @p dt_ms within the current segment.
+ *
+ * The caller guarantees @p dt_ms does not cross the segment end. This helper
+ * assumes the player mutex is already locked before calling.
+ */
+static void trajectory_advance_segment_locked(uint32_t dt_ms)
+{
+    const struct trajectory_segment *seg = &player.segs[player.index];
+    uint32_t mid_ms = player.elapsed_ms + (dt_ms / 2U);
+
+    player.elapsed_ms += dt_ms;
+
+    float u = (float)player.elapsed_ms / (float)seg->duration_ms;
+
+    switch (seg->type) {
+        case TRAJECTORY_SEG_RAMP:
+            player.last_rpm = player.seg_start_rpm + ((seg->target_rpm - player.seg_start_rpm) *
+                                                      trajectory_smootherstep(u));
+            break;
+        case TRAJECTORY_SEG_SINE: {
+            /* Linear chirp: integrate the instantaneous frequency at the chunk midpoint. */
+            float u_mid = (float)mid_ms / (float)seg->duration_ms;
+            float freq_hz = seg->freq_start_hz + ((seg->freq_end_hz - seg->freq_start_hz) * u_mid);
+
+            player.phase_rad += TRAJECTORY_TWO_PI * freq_hz * ((float)dt_ms / 1000.0f);
+            while (player.phase_rad >= TRAJECTORY_TWO_PI) {
+                player.phase_rad -= TRAJECTORY_TWO_PI;
+            }
+            player.last_rpm = seg->target_rpm + (seg->amplitude_rpm * sinf(player.phase_rad));
+            break;
+        }
+        case TRAJECTORY_SEG_STEP:
+        default:
+            player.last_rpm = seg->target_rpm;
+            break;
+    }
+}
+
+bool trajectory_tick(uint32_t dt_ms, float *setpoint_rpm)
+{
+    k_mutex_lock(&player_mutex, K_FOREVER);
+
+    if (!player.active) {
+        k_mutex_unlock(&player_mutex);
+        return false;
+    }
+
+    /* A tick may span a segment boundary: carry the remainder forward. */
+    while (player.active && (dt_ms > 0U)) {
+        uint32_t remaining = player.segs[player.index].duration_ms - player.elapsed_ms;
+        uint32_t chunk = MIN(dt_ms, remaining);
+
+        trajectory_advance_segment_locked(chunk);
+        dt_ms -= chunk;
+
+        if (player.elapsed_ms >= player.segs[player.index].duration_ms) {
+            trajectory_next_segment_locked();
+        }
+    }
+
+    *setpoint_rpm = CLAMP(player.last_rpm, 0.0f, TRAJECTORY_MAX_RPM);
+
+    k_mutex_unlock(&player_mutex);
+
+    return true;
+}
+
+int trajectory_get_status(struct trajectory_status *out)
+{
+    if (out == NULL) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&player_mutex, K_FOREVER);
+
+    out->active = player.active;
+    out->segment_count = player.count;
+    out->segment_index = player.index;
+    out->elapsed_ms = player.elapsed_ms;
+    out->passes_left = player.forever ? 0U : player.passes_left;
+    out->setpoint_rpm = player.last_rpm;
+
+    k_mutex_unlock(&player_mutex);
+
+    return 0;
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void trajectory_test_reset(void)
+{
+    k_mutex_lock(&player_mutex, K_FOREVER);
+    memset(&player, 0, sizeof(player));
+    k_mutex_unlock(&player_mutex);
+}
+#endif
@@ -0,0 +1,130 @@
+/**
+ * @file trajectory.h
+ * @brief Public API for the setpoint trajectory generator.
+ *
+ * The trajectory module holds a small table of profile segments (steps,
+ * jerk-limited ramps and sine sweeps) and evaluates it incrementally from the
+ * control thread, one tick at a time. This lets long test profiles run on
+ * target without a shell round trip per setpoint change.
+ */
+
+#ifndef TRAJECTORY_H_
+#define TRAJECTORY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Maximum number of segments in a loaded profile. */
+#define TRAJECTORY_MAX_SEGMENTS 16
+
+/**
+ * @brief Profile segment types.
+ */
+enum trajectory_seg_type {
+    /** Jump to the target and hold it for the segment duration. */
+    TRAJECTORY_SEG_STEP = 0,
+    /** Jerk-limited S-curve from the current setpoint to the target. */
+    TRAJECTORY_SEG_RAMP,
+    /** Sine sweep around a center value with a linear frequency chirp. */
+    TRAJECTORY_SEG_SINE,
+};
+
+/**
+ * @brief One segment of a setpoint profile.
+ */
+struct trajectory_segment {
+    enum trajectory_seg_type type; /**< Segment type. */
+    float target_rpm;              /**< Step/ramp end value, or sine center (rpm). */
+    uint32_t duration_ms;          /**< Segment duration in ms (must be > 0). */
+    float amplitude_rpm;           /**< Sine amplitude (rpm), sine only. */
+    float freq_start_hz;           /**< Sine frequency at segment start, sine only. */
+    float freq_end_hz;             /**< Sine frequency at segment end, sine only. */
+};
+
+/**
+ * @brief Snapshot of the trajectory player state.
+ */
+struct trajectory_status {
+    bool active;          /**< True while a profile is running. */
+    size_t segment_count; /**< Number of loaded segments. */
+    size_t segment_index; /**< Segment currently being played. */
+    uint32_t elapsed_ms;  /**< Time spent in the current segment. */
+    uint32_t passes_left; /**< Remaining passes, 0 when repeating forever. */
+    float setpoint_rpm;   /**< Last setpoint produced by the generator. */
+};
+
+/**
+ * @brief Parse one segment from its compact text form.
+ *
+ * Accepted forms (integers only, separated by ':'):
+ * - `step:<rpm>:<ms>`
+ * - `ramp:<rpm>:<ms>`
+ * - `sine:<center_rpm>:<ms>:<amplitude_rpm>:<f_start_mhz>:<f_end_mhz>`
+ *
+ * @param text Segment text. Must not be NULL.
+ * @param out  Parsed segment. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL on syntax error.
+ */
+int trajectory_parse_segment(const char *text, struct trajectory_segment *out);
+
+/**
+ * @brief Replace the loaded profile.
+ *
+ * Every segment is validated (duration > 0 and setpoints within range).
+ *
+ * @param segs  Segment table to copy.
+ * @param count Number of segments (1..TRAJECTORY_MAX_SEGMENTS).
+ *
+ * @return 0 on success, -EINVAL on an invalid table, -EBUSY while running.
+ */
+int trajectory_load(const struct trajectory_segment *segs, size_t count);
+
+/**
+ * @brief Start playing the loaded profile.
+ *
+ * @param start_rpm Setpoint the first ramp segment starts from.
+ * @param passes    Number of passes through the table, 0 repeats forever.
+ *
+ * @return 0 on success, -ENODATA if no profile is loaded.
+ */
+int trajectory_start(float start_rpm, uint32_t passes);
+
+/**
+ * @brief Stop the running profile (no-op when idle).
+ *
+ * The last produced setpoint is left in place.
+ */
+void trajectory_stop(void);
+
+/**
+ * @brief Advance the running profile by one control tick.
+ *
+ * Called from the control loop once per period. The evaluation is
+ * incremental: each call only integrates the time elapsed since the previous
+ * one.
+ *
+ * @param dt_ms        Time elapsed since the previous tick in ms.
+ * @param setpoint_rpm Output setpoint, written only when the function
+ *                     returns true.
+ *
+ * @return true if a profile is running and produced a setpoint.
+ */
+bool trajectory_tick(uint32_t dt_ms, float *setpoint_rpm);
+
+/**
+ * @brief Get the current player status.
+ *
+ * @param out Status snapshot to fill. Must not be NULL.
+ *
+ * @return 0 on success, -EINVAL if out is NULL.
+ */
+int trajectory_get_status(struct trajectory_status *out);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Stop the player and drop the loaded profile (test-only helper). */
+void trajectory_test_reset(void);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
+#endif /* TRAJECTORY_H_ */
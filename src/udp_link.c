@@ -0,0 +1,342 @@
+/**
+ * @file udp_link.c
+ * @brief UDP telemetry and setpoint command link.
+ *
+ * Samples are queued by reference into one of two batches: app_state fills
+ * one while the send thread encodes the other into its datagram buffer,
+ * transmits it and releases the samples back to the sample pool. The
+ * batches are guarded by a spinlock held only for the swap and the queueing
+ * of one sample, so app_state never waits for the network or the encoder.
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/atomic.h>
+
+#include "motor_cmd.h"
+#include "motor_udp_proto.h"
+#include "sample_pool.h"
+#include "udp_link.h"
+#include "wakeups.h"
+
+LOG_MODULE_REGISTER(udp_link, LOG_LEVEL_INF);
+
+BUILD_ASSERT(CONFIG_MOTOR_SIM_UDP_BATCH <= MOTOR_UDP_MAX_SAMPLES,
+             "CONFIG_MOTOR_SIM_UDP_BATCH exceeds one datagram");
+
+#define UDP_LINK_THREAD_PRIORITY 4
+
+/* Held samples of one telemetry datagram being filled or waiting to be sent. */
+struct udp_batch {
+    const struct app_state_sample *samples[CONFIG_MOTOR_SIM_UDP_BATCH];
+    uint16_t count;
+};
+
+static struct udp_batch batches[2];
+static uint8_t tx_buf[MOTOR_UDP_MAX_LEN]; /* Send thread only. */
+static uint8_t fill_idx;     /* Batch app_state writes into. */
+static bool send_pending;    /* The other batch is full and waits for the send thread. */
+static bool running;         /* Sockets open, threads started. */
+static struct k_spinlock batch_lock;
+static K_SEM_DEFINE(send_sem, 0, 1);
+
+static int tx_sock = -1;
+static int rx_sock = -1;
+static struct sockaddr_in collector;
+
+static atomic_t datagrams_sent;
+static atomic_t samples_sent;
+static atomic_t samples_dropped;
+static atomic_t send_errors;
+static atomic_t commands;
+static atomic_t bad_datagrams;
+
+K_THREAD_STACK_DEFINE(udp_tx_stack, CONFIG_MOTOR_SIM_UDP_STACK_SIZE);
+K_THREAD_STACK_DEFINE(udp_rx_stack, CONFIG_MOTOR_SIM_UDP_STACK_SIZE);
+static struct k_thread udp_tx_thread_data;
+static struct k_thread udp_rx_thread_data;
+static k_tid_t udp_tx_tid;
+static k_tid_t udp_rx_tid;
+
+void udp_link_push(const struct app_state_sample *sample)
+{
+    bool wake = false;
+
+    k_spinlock_key_t key = k_spin_lock(&batch_lock);
+
+    if (!running) {
+        k_spin_unlock(&batch_lock, key);
+        return;
+    }
+
+    struct udp_batch *b = &batches[fill_idx];
+
+    if (b->count == CONFIG_MOTOR_SIM_UDP_BATCH) {
+        /* Still full: the send thread has not taken the previous batch. */
+        atomic_inc(&samples_dropped);
+    } else {
+        sample_pool_hold(sample);
+        b->samples[b->count] = sample;
+        b->count++;
+        if ((b->count == CONFIG_MOTOR_SIM_UDP_BATCH) && !send_pending) {
+            send_pending = true;
+            fill_idx ^= 1U;
+            batches[fill_idx].count = 0U;
+            wake = true;
+        }
+    }
+
+    k_spin_unlock(&batch_lock, key);
+
+    /* Outside the lock: waking the send thread may switch to it. */
+    if (wake) {
+        k_sem_give(&send_sem);
+    }
+}
+
+/**
+ * @brief Encode a batch into the datagram buffer and release its samples.
+ */
+static void udp_link_encode(struct udp_batch *b)
+{
+    for (uint16_t i = 0; i < b->count; i++) {
+        const struct app_state_sample *sample = b->samples[i];
+        const struct motor_udp_sample s = {
+            .seq = sample->seq,
+            .uptime_ms = sample->uptime_ms,
+            .state = sample->state,
+        };
+
+        motor_udp_put_sample(tx_buf, i, &s);
+        b->samples[i] = NULL;
+        sample_pool_release(sample);
+    }
+}
+
+static void udp_link_send(struct udp_batch *b)
+{
+    static uint32_t tx_seq;
+
+    udp_link_encode(b);
+    motor_udp_put_header(tx_buf, MOTOR_UDP_TELEMETRY, tx_seq++, b->count);
+
+    ssize_t ret = zsock_sendto(tx_sock, tx_buf, motor_udp_telemetry_len(b->count), 0,
+                               (struct sockaddr *)&collector, sizeof(collector));
+
+    if (ret < 0) {
+        atomic_inc(&send_errors); /* GCOVR_EXCL_LINE */
+    } else {
+        atomic_inc(&datagrams_sent);
+        atomic_add(&samples_sent, b->count);
+    }
+}
+
+/**
+ * @brief Send loop: one datagram per full batch, partial batches on timeout.
+ */
+static void udp_tx_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (true) {
+        (void)k_sem_take(&send_sem, K_MSEC(CONFIG_MOTOR_SIM_UDP_FLUSH_MS));
+        wakeups_count(WAKEUPS_UDP_TX);
+
+        k_spinlock_key_t key = k_spin_lock(&batch_lock);
+
+        if (!send_pending && (batches[fill_idx].count > 0U)) {
+            /* Flush timeout: send what has been queued so far. */
+            send_pending = true;
+            fill_idx ^= 1U;
+            batches[fill_idx].count = 0U;
+        }
+
+        bool pending = send_pending;
+        struct udp_batch *b = &batches[fill_idx ^ 1U];
+
+        k_spin_unlock(&batch_lock, key);
+
+        if (!pending) {
+            continue;
+        }
+
+        udp_link_send(b);
+
+        key = k_spin_lock(&batch_lock);
+        send_pending = false;
+        bool full = (batches[fill_idx].count == CONFIG_MOTOR_SIM_UDP_BATCH);
+        k_spin_unlock(&batch_lock, key);
+
+        if (full) {
+            /* Filled up while we were sending: go again without waiting. */
+            k_sem_give(&send_sem);
+        }
+    }
+}
+
+static void udp_link_handle(const uint8_t *buf, size_t len, const struct sockaddr *from,
+                            socklen_t from_len)
+{
+    static uint32_t ack_seq;
+    struct motor_udp_msg msg;
+
+    if ((motor_udp_decode(buf, len, &msg) != 0) || (msg.type != MOTOR_UDP_SETPOINT)) {
+        atomic_inc(&bad_datagrams);
+        return;
+    }
+
+    atomic_inc(&commands);
+
+    int status = motor_cmd_post_setpoint(msg.rpm);
+    uint8_t ack[MOTOR_UDP_HEADER_LEN + MOTOR_UDP_ACK_LEN];
+    size_t ack_len = motor_udp_encode_ack(ack, ack_seq++, msg.cmd_id, status, k_uptime_get_32());
+
+    if (zsock_sendto(rx_sock, ack, ack_len, 0, from, from_len) < 0) {
+        atomic_inc(&send_errors); /* GCOVR_EXCL_LINE */
+    }
+}
+
+/**
+ * @brief Receive loop: one ack per command datagram.
+ */
+static void udp_rx_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    static uint8_t buf[MOTOR_UDP_MAX_LEN];
+
+    while (true) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = zsock_recvfrom(rx_sock, buf, sizeof(buf), 0, (struct sockaddr *)&from,
+                                     &from_len);
+
+        wakeups_count(WAKEUPS_UDP_RX);
+
+        /* GCOVR_EXCL_START */
+        if (len < 0) {
+            LOG_ERR("recvfrom failed: %d", -errno);
+            k_sleep(K_MSEC(100));
+            continue;
+        }
+        /* GCOVR_EXCL_STOP */
+
+        udp_link_handle(buf, (size_t)len, (struct sockaddr *)&from, from_len);
+    }
+}
+
+static int udp_link_addr(const char *addr, int port, struct sockaddr_in *out)
+{
+    *out = (struct sockaddr_in){
+        .sin_family = AF_INET,
+        .sin_port = htons((uint16_t)port),
+    };
+
+    return (zsock_inet_pton(AF_INET, addr, &out->sin_addr) == 1) ? 0 : -EINVAL;
+}
+
+int udp_link_start(void)
+{
+    struct sockaddr_in local;
+
+    if ((udp_link_addr(CONFIG_MOTOR_SIM_UDP_COLLECTOR_ADDR, CONFIG_MOTOR_SIM_UDP_COLLECTOR_PORT,
+                       &collector) != 0) ||
+        (udp_link_addr(CONFIG_MOTOR_SIM_UDP_CMD_ADDR, CONFIG_MOTOR_SIM_UDP_CMD_PORT, &local) !=
+         0)) {
+        /* GCOVR_EXCL_START */
+        LOG_ERR("invalid collector or command address");
+        return -EINVAL;
+        /* GCOVR_EXCL_STOP */
+    }
+
+    tx_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    rx_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if ((tx_sock < 0) || (rx_sock < 0) ||
+        (zsock_bind(rx_sock, (struct sockaddr *)&local, sizeof(local)) != 0)) {
+        /* GCOVR_EXCL_START */
+        int err = -errno;
+
+        LOG_ERR("cannot open UDP sockets: %d", err);
+        (void)zsock_close(tx_sock);
+        (void)zsock_close(rx_sock);
+        tx_sock = -1;
+        rx_sock = -1;
+        return err;
+        /* GCOVR_EXCL_STOP */
+    }
+
+    udp_tx_tid = k_thread_create(&udp_tx_thread_data, udp_tx_stack,
+                                 K_THREAD_STACK_SIZEOF(udp_tx_stack), udp_tx_thread, NULL, NULL,
+                                 NULL, UDP_LINK_THREAD_PRIORITY, 0, K_NO_WAIT);
+    (void)k_thread_name_set(udp_tx_tid, "udp_tx");
+    udp_rx_tid = k_thread_create(&udp_rx_thread_data, udp_rx_stack,
+                                 K_THREAD_STACK_SIZEOF(udp_rx_stack), udp_rx_thread, NULL, NULL,
+                                 NULL, UDP_LINK_THREAD_PRIORITY, 0, K_NO_WAIT);
+    (void)k_thread_name_set(udp_rx_tid, "udp_rx");
+
+    k_spinlock_key_t key = k_spin_lock(&batch_lock);
+    running = true;
+    k_spin_unlock(&batch_lock, key);
+
+    LOG_INF("telemetry to %s:%d, commands on %s:%d", CONFIG_MOTOR_SIM_UDP_COLLECTOR_ADDR,
+            CONFIG_MOTOR_SIM_UDP_COLLECTOR_PORT, CONFIG_MOTOR_SIM_UDP_CMD_ADDR,
+            CONFIG_MOTOR_SIM_UDP_CMD_PORT);
+
+    return 0;
+}
+
+void udp_link_get_stats(struct udp_link_stats *out)
+{
+    out->datagrams_sent = (uint32_t)atomic_get(&datagrams_sent);
+    out->samples_sent = (uint32_t)atomic_get(&samples_sent);
+    out->samples_dropped = (uint32_t)atomic_get(&samples_dropped);
+    out->send_errors = (uint32_t)atomic_get(&send_errors);
+    out->commands = (uint32_t)atomic_get(&commands);
+    out->bad_datagrams = (uint32_t)atomic_get(&bad_datagrams);
+}
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+void udp_link_test_stop(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&batch_lock);
+
+    running = false;
+    k_spin_unlock(&batch_lock, key);
+
+    if (udp_tx_tid != NULL) {
+        k_thread_abort(udp_tx_tid);
+        k_thread_abort(udp_rx_tid);
+        udp_tx_tid = NULL;
+        udp_rx_tid = NULL;
+        (void)zsock_close(tx_sock);
+        (void)zsock_close(rx_sock);
+    }
+
+    /* Give back the samples still queued (sent ones were cleared by the encoder). */
+    for (size_t i = 0; i < ARRAY_SIZE(batches); i++) {
+        for (uint16_t j = 0; j < batches[i].count; j++) {
+            if (batches[i].samples[j] != NULL) {
+                sample_pool_release(batches[i].samples[j]);
+                batches[i].samples[j] = NULL;
+            }
+        }
+        batches[i].count = 0U;
+    }
+    send_pending = false;
+    k_sem_reset(&send_sem);
+
+    atomic_clear(&datagrams_sent);
+    atomic_clear(&samples_sent);
+    atomic_clear(&samples_dropped);
+    atomic_clear(&send_errors);
+    atomic_clear(&commands);
+    atomic_clear(&bad_datagrams);
+}
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
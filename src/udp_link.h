@@ -0,0 +1,80 @@
+/**
+ * @file udp_link.h
+ * @brief UDP telemetry and setpoint command link.
+ *
+ * With CONFIG_MOTOR_SIM_UDP every feedback sample recorded by app_state is
+ * held (sample_pool.h) in a batch, and a send thread transmits each full batch (or a
+ * partial one after CONFIG_MOTOR_SIM_UDP_FLUSH_MS) as one datagram to the
+ * collector. A receive thread accepts setpoint commands on the command port,
+ * posts them to the control loop's command queue (motor_cmd) and answers each
+ * with an ack. The wire format is lib/motor_model/include/motor_udp_proto.h.
+ * Otherwise the calls compile to nothing.
+ */
+
+#ifndef UDP_LINK_H_
+#define UDP_LINK_H_
+
+#include <stdint.h>
+
+#include "app_state.h"
+
+/**
+ * @brief Link counters.
+ */
+struct udp_link_stats {
+    uint32_t datagrams_sent;  /**< Telemetry datagrams sent. */
+    uint32_t samples_sent;    /**< Samples in those datagrams. */
+    uint32_t samples_dropped; /**< Samples dropped because the previous batch was still queued. */
+    uint32_t send_errors;     /**< Failed telemetry or ack sends. */
+    uint32_t commands;        /**< Valid command datagrams received. */
+    uint32_t bad_datagrams;   /**< Received datagrams that were malformed or not commands. */
+};
+
+#if defined(CONFIG_MOTOR_SIM_UDP)
+
+/**
+ * @brief Open the sockets and start the send and receive threads.
+ *
+ * @return 0 on success, -EINVAL if a configured address is not an IPv4
+ *         address, or the negative errno of the failed socket call.
+ */
+int udp_link_start(void);
+
+/**
+ * @brief Queue one sample for the collector.
+ *
+ * Called by app_state with the state mutex held. The link takes a reference
+ * to the sample and releases it once the sample is encoded into a datagram.
+ * Never blocks: when the current batch is full and the previous one has not
+ * been sent yet, the sample is dropped and counted. Does nothing before
+ * udp_link_start().
+ */
+void udp_link_push(const struct app_state_sample *sample);
+
+/**
+ * @brief Get the link counters.
+ *
+ * @param out Counters to fill. Must not be NULL.
+ */
+void udp_link_get_stats(struct udp_link_stats *out);
+
+#ifdef MOTOR_SIM_DEMO_UNIT_TEST
+/** @brief Stop the threads, close the sockets and clear the counters (test-only helper). */
+void udp_link_test_stop(void);
+#endif /* MOTOR_SIM_DEMO_UNIT_TEST */
+
+#else
+
+static inline int udp_link_start(void)
+{
+    return 0;
+}
+
+static inline void udp_link_push(const struct app_state_sample *sample)
+{
+    (void)sample;
+}
+
+#endif /* CONFIG_MOTOR_SIM_UDP */
+
+#endif /* UDP_LINK_H_ */
@@ -0,0 +1,65 @@
+/**
+ * @file wakeups.c
+ * @brief Per-thread wakeup accounting implementation.
+ *
+ * One atomic counter per thread and the uptime of the last reset. Counting
+ * costs a single atomic increment in the woken thread.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "wakeups.h"
+
+static atomic_t counts[WAKEUPS_THREAD_COUNT];
+static int64_t window_start_ms;
+
+static const char *const thread_names[WAKEUPS_THREAD_COUNT] = {
+    [WAKEUPS_MAIN] = "main",
+    [WAKEUPS_CONTROL] = "motor_ctrl",
+    [WAKEUPS_TELEMETRY] = "telemetry",
+    [WAKEUPS_FAULT] = "fault_wq",
+    [WAKEUPS_UDP_TX] = "udp_tx",
+    [WAKEUPS_UDP_RX] = "udp_rx",
+};
+
+void wakeups_count(enum wakeups_thread thread)
+{
+    atomic_inc(&counts[thread]);
+}
+
+void wakeups_get(struct wakeups_report *out)
+{
+    out->window_ms = (uint32_t)(k_uptime_get() - window_start_ms);
+
+    for (size_t i = 0; i < WAKEUPS_THREAD_COUNT; i++) {
+        out->count[i] = (uint32_t)atomic_get(&counts[i]);
+    }
+}
+
+void wakeups_reset(void)
+{
+    for (size_t i = 0; i < WAKEUPS_THREAD_COUNT; i++) {
+        atomic_clear(&counts[i]);
+    }
+
+    window_start_ms = k_uptime_get();
+}
+
+uint32_t wakeups_rate_centi(uint32_t count, uint32_t window_ms)
+{
+    if (window_ms == 0U) {
+        return 0U;
+    }
+
+    return (uint32_t)(((uint64_t)count * 100000ULL) / window_ms);
+}
+
+const char *wakeups_thread_name(enum wakeups_thread thread)
+{
+    if ((unsigned int)thread >= WAKEUPS_THREAD_COUNT) {
+        return "?";
+    }
+
+    return thread_names[thread];
+}
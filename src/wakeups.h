@@ -0,0 +1,78 @@
+/**
+ * @file wakeups.h
+ * @brief Public API for per-thread wakeup accounting.
+ *
+ * Every application thread (and the fault work item) counts each return from
+ * the wait it blocks in. The counts, over the window since the last reset,
+ * show how often each component wakes the CPU; an idle motor at a constant
+ * setpoint should only wake the control loop.
+ */
+
+#ifndef WAKEUPS_H_
+#define WAKEUPS_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Threads whose wakeups are counted.
+ */
+enum wakeups_thread {
+    WAKEUPS_MAIN = 0,  /**< main (cyclic executive frames only). */
+    WAKEUPS_CONTROL,   /**< motor_ctrl thread. */
+    WAKEUPS_TELEMETRY, /**< telemetry thread. */
+    WAKEUPS_FAULT,     /**< fault_wq work items of the fault monitor. */
+    WAKEUPS_UDP_TX,    /**< udp_tx thread (CONFIG_MOTOR_SIM_UDP). */
+    WAKEUPS_UDP_RX,    /**< udp_rx thread (CONFIG_MOTOR_SIM_UDP). */
+    /** Number of threads (not a thread). */
+    WAKEUPS_THREAD_COUNT,
+};
+
+/**
+ * @brief Wakeup counts over one window.
+ */
+struct wakeups_report {
+    uint32_t window_ms;                   /**< Time since the last reset (or boot). */
+    uint32_t count[WAKEUPS_THREAD_COUNT]; /**< Wakeups of each thread in the window. */
+};
+
+/**
+ * @brief Count one wakeup of @p thread.
+ *
+ * Lock-free; safe from any thread.
+ *
+ * @param thread Thread that woke up.
+ */
+void wakeups_count(enum wakeups_thread thread);
+
+/**
+ * @brief Get the counts since the last reset.
+ *
+ * @param out Report to fill. Must not be NULL.
+ */
+void wakeups_get(struct wakeups_report *out);
+
+/**
+ * @brief Clear the counts and start a new window now.
+ */
+void wakeups_reset(void);
+
+/**
+ * @brief Wakeup rate in hundredths of a wakeup per second.
+ *
+ * @param count     Wakeups in the window.
+ * @param window_ms Window length, 0 gives 0.
+ *
+ * @return count / window in 1/100 s^-1.
+ */
+uint32_t wakeups_rate_centi(uint32_t count, uint32_t window_ms);
+
+/**
+ * @brief Thread name, for reports.
+ *
+ * @param thread Thread identifier.
+ *
+ * @return Name, "?" if out of range.
+ */
+const char *wakeups_thread_name(enum wakeups_thread thread);
+
+#endif /* WAKEUPS_H_ */
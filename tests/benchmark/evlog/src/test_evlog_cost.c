@@ -0,0 +1,150 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/ztest.h>
+
+#include "evlog.h"
+
+#define BENCH_WARMUP 1000U
+#define BENCH_ITERS  10000U
+#define BENCH_ROUNDS 7U
+
+/** Operation under test, called BENCH_ITERS times per round. */
+typedef void (*bench_fn_t)(void);
+
+/* A hot motor: every value is formatted with several digits. */
+static struct motor_state bench_state = {
+    .setpoint_rpm = 1500.0f,
+    .measured_rpm = 1849.9f,
+    .control_output_pct = 42.7f,
+    .temperature_c = 71.6f,
+};
+static char bench_text[MOTOR_EVLOG_TEXT_MAX];
+static volatile uint32_t bench_sink;
+
+static inline uint64_t bench_cycles(void)
+{
+#if defined(CONFIG_ARCH_POSIX) && (defined(__i386__) || defined(__x86_64__))
+    /* native_sim time stands still while the CPU is busy: read the host TSC. */
+    return __builtin_ia32_rdtsc();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+static void bench_empty(void)
+{
+}
+
+/*
+ * The text cases format the message exactly as the LOG_* call sites did,
+ * with Zephyr's own formatter. The log core and the console write that come
+ * on top of it are not included, so the saving measured here is a floor.
+ */
+static void bench_text_telemetry(void)
+{
+    bench_sink += (uint32_t)snprintk(bench_text, sizeof(bench_text),
+                                     "T[%s] SP=%d rpm, MEAS=%d rpm, OUT=%d%%, T=%d C", "telemetry",
+                                     (int)bench_state.setpoint_rpm, (int)bench_state.measured_rpm,
+                                     (int)bench_state.control_output_pct,
+                                     (int)bench_state.temperature_c);
+}
+
+static void bench_text_fault_speed(void)
+{
+    float diff = bench_state.setpoint_rpm - bench_state.measured_rpm;
+
+    if (diff < 0.0f) {
+        diff = -diff;
+    }
+    bench_sink += (uint32_t)snprintk(bench_text, sizeof(bench_text),
+                                     "Fault(speed): |SP-MEAS|=%d rpm (OUT=%d%%, T=%d C)", (int)diff,
+                                     (int)bench_state.control_output_pct,
+                                     (int)bench_state.temperature_c);
+}
+
+static void bench_text_fault_temp(void)
+{
+    bench_sink += (uint32_t)snprintk(bench_text, sizeof(bench_text),
+                                     "Fault(temp hard): T=%d C (OUT=%d%%, SP=%d rpm)",
+                                     (int)bench_state.temperature_c,
+                                     (int)bench_state.control_output_pct,
+                                     (int)bench_state.setpoint_rpm);
+}
+
+static void bench_record_telemetry(void)
+{
+    evlog_put(MOTOR_EVLOG_TELEMETRY, &bench_state);
+}
+
+static void bench_record_fault_speed(void)
+{
+    evlog_put(MOTOR_EVLOG_FAULT_SPEED, &bench_state);
+}
+
+static void bench_record_fault_temp(void)
+{
+    evlog_put(MOTOR_EVLOG_FAULT_TEMP_HARD, &bench_state);
+}
+
+/**
+ * Best-of-rounds cost of one call of @p fn in cycles, including the indirect
+ * call overhead (subtracted by the caller using bench_empty()).
+ */
+static uint32_t bench_measure(bench_fn_t fn)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (uint32_t i = 0; i < BENCH_WARMUP; i++) {
+        fn();
+    }
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint64_t t0 = bench_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            fn();
+        }
+        best = MIN(best, bench_cycles() - t0);
+    }
+
+    return (uint32_t)(best / BENCH_ITERS);
+}
+
+static const struct {
+    const char *name;
+    bench_fn_t text;
+    bench_fn_t record;
+} bench_cases[] = {
+    {"telemetry", bench_text_telemetry, bench_record_telemetry},
+    {"fault_speed", bench_text_fault_speed, bench_record_fault_speed},
+    {"fault_temp_hard", bench_text_fault_temp, bench_record_fault_temp},
+};
+
+ZTEST(evlog_cost, test_record_costs_less_than_text)
+{
+    uint32_t overhead = bench_measure(bench_empty);
+
+    for (size_t i = 0; i < ARRAY_SIZE(bench_cases); i++) {
+        uint32_t text = bench_measure(bench_cases[i].text);
+        uint32_t record = bench_measure(bench_cases[i].record);
+
+        text = (text > overhead) ? (text - overhead) : 0U;
+        record = (record > overhead) ? (record - overhead) : 0U;
+
+        /* Machine-readable: collected by twister (see testcase.yaml). */
+        TC_PRINT("BENCH_EVLOG:%s,text_cycles=%u,record_cycles=%u,saved_cycles=%u\n",
+                 bench_cases[i].name, text, record, (text > record) ? (text - record) : 0U);
+
+        zassert_true(record < text, "%s: record %u >= text %u cycles", bench_cases[i].name,
+                     record, text);
+    }
+
+    /* The last case filled the ring: its records render as the text it formatted. */
+    struct motor_evlog_record rec;
+    char rendered[MOTOR_EVLOG_TEXT_MAX];
+
+    zassert_equal(evlog_drain(&rec, 1), 1U, NULL);
+    zassert_true(motor_evlog_format(&rec, rendered, sizeof(rendered)) > 0, NULL);
+    zassert_str_equal(rendered, bench_text, NULL);
+}
+
+ZTEST_SUITE(evlog_cost, NULL, NULL, NULL, NULL, NULL);
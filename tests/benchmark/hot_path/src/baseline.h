@@ -0,0 +1,43 @@
+/*
+ * Hot-path benchmark baseline (host TSC cycles per call).
+ *
+ * Generated by scripts/bench_baseline.py from three runs of this suite (best
+ * of the three per function), not written by hand. The runs were built with
+ * GCC 12 -Os for x86-64 and linked against minimal kernel stubs: spinlocks
+ * are no-ops and zbus_chan_pub() is a memcpy. The motor_*, fault_monitor_*
+ * and telemetry_* figures are the real code paths. The app_state_* figures
+ * leave out the kernel's share, so regenerate the table from a native_sim run
+ * before relying on them:
+ *   scripts/bench_baseline.py twister-out/native_sim_native/.../hot_path/handler.log
+ */
+
+#ifndef HOT_PATH_BASELINE_H_
+#define HOT_PATH_BASELINE_H_
+
+#include <stdint.h>
+
+/** Allowed slowdown over the baseline before the benchmark fails (%). */
+#define BENCH_TOLERANCE_PCT 50
+
+/**
+ * Allowed slowdown in cycles whatever the percentage: the few-cycle entries
+ * jitter by more than half their baseline between runs.
+ */
+#define BENCH_TOLERANCE_MIN_CYCLES 8
+
+struct bench_baseline {
+    const char *name;
+    uint32_t cycles_per_call;
+};
+
+static const struct bench_baseline bench_baseline[] = {
+    {"motor_control_step", 43},
+    {"fault_monitor_eval", 4},
+    {"app_state_get_snapshot", 112},
+    {"app_state_update_feedback", 233},
+    {"telemetry_should_log", 2},
+    {"motor_dc_current_step", 39},
+    {"motor_shm_ring_write", 3},
+};
+
+#endif /* HOT_PATH_BASELINE_H_ */
@@ -0,0 +1,216 @@
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include "host_clock.h"
+#endif
+
+#include "app_state.h"
+#include "baseline.h"
+#include "fault_monitor.h"
+#include "motor_control.h"
+#include "motor_dc.h"
+#include "motor_shm_ring.h"
+#include "telemetry.h"
+
+#define BENCH_WARMUP 1000U
+#define BENCH_ITERS  10000U
+#define BENCH_ROUNDS 7U
+
+/* Current loop rate used for the DC model cases (the Kconfig default). */
+#define BENCH_DC_LOOP_HZ 10000U
+
+/* Shared-memory ring capacity for the export case (the Kconfig default). */
+#define BENCH_SHM_SLOTS 4096U
+
+/** Operation under test, called BENCH_ITERS times per round. */
+typedef void (*bench_fn_t)(void);
+
+static struct motor_state bench_state;
+static struct motor_control_ctx bench_ctx;
+static struct motor_dc_coeffs bench_dc_coeffs;
+static struct motor_dc_state bench_dc_state;
+static struct motor_shm_ring *bench_shm_ring;
+static struct motor_shm_sample bench_shm_sample;
+static uint64_t bench_shm_mem[(sizeof(struct motor_shm_ring) +
+                               (BENCH_SHM_SLOTS * sizeof(struct motor_shm_slot))) /
+                              sizeof(uint64_t)];
+static int bench_counter;
+static uint32_t bench_steps;
+static volatile uint32_t bench_sink;
+
+static inline uint64_t bench_cycles(void)
+{
+#if defined(CONFIG_ARCH_POSIX) && (defined(__i386__) || defined(__x86_64__))
+    /* native_sim time stands still while the CPU is busy: read the host TSC. */
+    return __builtin_ia32_rdtsc();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+static void bench_empty(void)
+{
+}
+
+static void bench_motor_control_step(void)
+{
+    motor_control_step(&bench_ctx, &bench_state, bench_steps++);
+}
+
+static void bench_fault_monitor_eval(void)
+{
+    bench_sink += fault_monitor_eval(&bench_state, 300.0f, 60.0f, 70.0f);
+}
+
+static void bench_get_snapshot(void)
+{
+    (void)app_state_get_snapshot(&bench_state);
+}
+
+static void bench_update_feedback(void)
+{
+    /* Includes the history push and the zbus publication. */
+    (void)app_state_update_feedback(1500.0f, 40.0f, 45.0f);
+}
+
+static void bench_should_log(void)
+{
+    bench_sink += telemetry_should_log(&bench_counter) ? 1U : 0U;
+}
+
+static void bench_dc_current_step(void)
+{
+    /* Alternate the reference so the PI loop never settles into a fixed point. */
+    float ref = ((bench_counter++ & 1) != 0) ? 4.0f : 3.0f;
+
+    motor_dc_current_step(&bench_dc_coeffs, &bench_dc_state, ref);
+}
+
+static void bench_shm_ring_write(void)
+{
+    bench_shm_sample.seq++;
+    motor_shm_ring_write(bench_shm_ring, &bench_shm_sample);
+}
+
+/**
+ * Best-of-rounds cost of one call of @p fn in cycles, including the indirect
+ * call overhead (subtracted by the caller using bench_empty()).
+ */
+static uint32_t bench_measure(bench_fn_t fn)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (uint32_t i = 0; i < BENCH_WARMUP; i++) {
+        fn();
+    }
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint64_t t0 = bench_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            fn();
+        }
+        best = MIN(best, bench_cycles() - t0);
+    }
+
+    return (uint32_t)(best / BENCH_ITERS);
+}
+
+static const struct {
+    const char *name;
+    bench_fn_t fn;
+} bench_cases[] = {
+    {"motor_control_step", bench_motor_control_step},
+    {"fault_monitor_eval", bench_fault_monitor_eval},
+    {"app_state_get_snapshot", bench_get_snapshot},
+    {"app_state_update_feedback", bench_update_feedback},
+    {"telemetry_should_log", bench_should_log},
+    {"motor_dc_current_step", bench_dc_current_step},
+    {"motor_shm_ring_write", bench_shm_ring_write},
+};
+
+static uint32_t bench_baseline_for(const char *name)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(bench_baseline); i++) {
+        if (strcmp(bench_baseline[i].name, name) == 0) {
+            return bench_baseline[i].cycles_per_call;
+        }
+    }
+    return 0;
+}
+
+static void bench_dc_prepare(void)
+{
+    const struct motor_dc_params params = MOTOR_DC_PARAMS_DEFAULT;
+
+    zassert_equal(motor_dc_prepare(&params, (float)BENCH_DC_LOOP_HZ,
+                                   MOTOR_CONTROL_PERIOD_MS / 1000.0f, &bench_dc_coeffs),
+                  0, NULL);
+}
+
+ZTEST(hot_path, test_cycles_per_call_within_baseline)
+{
+    bench_dc_prepare();
+    bench_shm_ring = motor_shm_ring_init(bench_shm_mem, sizeof(bench_shm_mem), BENCH_SHM_SLOTS);
+    zassert_not_null(bench_shm_ring, NULL);
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_set_setpoint(1500.0f), 0, NULL);
+    zassert_equal(app_state_get_snapshot(&bench_state), 0, NULL);
+    motor_control_ctx_init(&bench_ctx);
+
+    uint32_t overhead = bench_measure(bench_empty);
+    uint32_t failures = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(bench_cases); i++) {
+        uint32_t raw = bench_measure(bench_cases[i].fn);
+        uint32_t cycles = (raw > overhead) ? (raw - overhead) : 0U;
+        uint32_t baseline = bench_baseline_for(bench_cases[i].name);
+
+        zassert_true(baseline > 0U, "no baseline for %s", bench_cases[i].name);
+
+        /* Machine-readable: collected by twister (see testcase.yaml). */
+        TC_PRINT("BENCH:%s,cycles_per_call=%u,baseline=%u\n", bench_cases[i].name, cycles,
+                 baseline);
+
+        uint32_t limit = (uint32_t)(((uint64_t)baseline * (100U + BENCH_TOLERANCE_PCT)) / 100U);
+
+        limit = MAX(limit, baseline + BENCH_TOLERANCE_MIN_CYCLES);
+        if (cycles > limit) {
+            TC_PRINT("REGRESSION: %s %u > %u cycles (+%u%%, at least +%u)\n",
+                     bench_cases[i].name, cycles, baseline, BENCH_TOLERANCE_PCT,
+                     BENCH_TOLERANCE_MIN_CYCLES);
+            failures++;
+        }
+    }
+
+    zassert_equal(failures, 0U, "%u hot-path regressions", failures);
+}
+
+ZTEST(hot_path, test_dc_current_step_within_budget)
+{
+    bench_dc_prepare();
+
+    uint32_t overhead = bench_measure(bench_empty);
+    uint32_t raw = bench_measure(bench_dc_current_step);
+    uint32_t cycles = (raw > overhead) ? (raw - overhead) : 0U;
+
+#if defined(CONFIG_ARCH_POSIX)
+    /* Host wall clock: how fast the inner loop runs compared with real time. */
+    uint64_t t0 = host_clock_us();
+    for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+        bench_dc_current_step();
+    }
+    uint64_t us = MAX(host_clock_us() - t0, 1U);
+    uint64_t steps_per_s = (BENCH_ITERS * 1000000ULL) / us;
+
+    TC_PRINT("BENCH_RATE:motor_dc_current_step,steps_per_s=%llu,realtime_x=%llu\n",
+             (unsigned long long)steps_per_s, (unsigned long long)(steps_per_s / BENCH_DC_LOOP_HZ));
+#endif
+
+    zassert_true(cycles <= MOTOR_DC_STEP_CYCLE_BUDGET, "current step %u > %u cycles", cycles,
+                 MOTOR_DC_STEP_CYCLE_BUDGET);
+}
+
+ZTEST_SUITE(hot_path, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,240 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include "host_clock.h"
+#endif
+
+#include "app_state.h"
+#include "motor_cmd.h"
+#include "motor_control.h"
+
+#define STORM_THREADS     CONFIG_BENCH_STORM_THREADS
+#define STORM_DURATION_MS CONFIG_BENCH_STORM_DURATION_MS
+
+/* Latency samples kept per load level, over all threads. */
+#define STORM_MAX_SAMPLES 32768U
+
+#define STORM_MAX_LEVELS  8
+#define STORM_STACK_SIZE  2048
+#define STORM_THREAD_PRIO K_PRIO_PREEMPT(5)
+
+/* Commands each load thread cycles through, starting at its own index. */
+static const char *const storm_cmds[] = {
+    "motor_set 1200",
+    "motor_info",
+    "motor_set 1800",
+    "motor_info json",
+};
+
+/** One load thread and its results. */
+struct storm_worker {
+    uint32_t index;
+    uint32_t count;     /**< Commands to run. */
+    uint32_t period_us; /**< Time between two command releases. */
+    uint32_t *lat_ns;   /**< Latency of each command (count samples). */
+    uint32_t rejected;  /**< motor_set rejected with a full command queue. */
+    int error;          /**< First unexpected return value, 0 if none. */
+};
+
+static struct storm_worker workers[STORM_THREADS];
+static uint32_t lat_ns[STORM_MAX_SAMPLES];
+
+K_THREAD_STACK_ARRAY_DEFINE(storm_stacks, STORM_THREADS, STORM_STACK_SIZE);
+static struct k_thread storm_threads[STORM_THREADS];
+
+/*
+ * One command at a time, as on a real shell: shell_execute_cmd() copies the
+ * command into the shell's single command buffer before taking its own lock.
+ * Waiting here is part of the latency a client sees.
+ */
+static K_MUTEX_DEFINE(shell_mutex);
+
+static inline uint64_t storm_now_ns(void)
+{
+#if defined(CONFIG_ARCH_POSIX)
+    /* native_sim time stands still while a command runs: read the host clock. */
+    return host_clock_ns();
+#else
+    return k_cyc_to_ns_floor64(k_cycle_get_64());
+#endif
+}
+
+static int storm_execute(const char *cmd)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+
+    k_mutex_lock(&shell_mutex, K_FOREVER);
+    int ret = shell_execute_cmd(sh, cmd);
+    shell_backend_dummy_clear_output(sh);
+    k_mutex_unlock(&shell_mutex);
+
+    return ret;
+}
+
+static void storm_worker(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct storm_worker *w = p1;
+    int64_t release = k_uptime_ticks();
+
+    for (uint32_t i = 0; i < w->count; i++) {
+        /* Open loop: releases stay on their grid even when commands queue up. */
+        release += k_us_to_ticks_ceil64(w->period_us);
+        (void)k_sleep(K_TIMEOUT_ABS_TICKS(release));
+
+        uint64_t t0 = storm_now_ns();
+        int ret = storm_execute(storm_cmds[(w->index + i) % ARRAY_SIZE(storm_cmds)]);
+        uint64_t ns = storm_now_ns() - t0;
+
+        w->lat_ns[i] = (uint32_t)MIN(ns, UINT32_MAX);
+
+        if (ret == -ENOSPC) {
+            w->rejected++;
+        } else if ((ret != 0) && (w->error == 0)) {
+            w->error = ret;
+        }
+    }
+}
+
+static int storm_cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t storm_percentile(const uint32_t *sorted, uint32_t n, uint32_t pct)
+{
+    return (n == 0U) ? 0U : sorted[((n - 1U) * pct) / 100U];
+}
+
+/**
+ * Run one load level: every thread posts @p rate_hz commands per second for
+ * STORM_DURATION_MS while the control thread runs, then print one result line.
+ */
+static void storm_run(uint32_t rate_hz)
+{
+    uint32_t per_thread = (uint32_t)(((uint64_t)rate_hz * STORM_DURATION_MS) / MSEC_PER_SEC);
+    uint32_t total = per_thread * STORM_THREADS;
+
+    zassert_true(total <= STORM_MAX_SAMPLES, "%u Hz x %u threads: too many samples", rate_hz,
+                 STORM_THREADS);
+
+    memset(workers, 0, sizeof(workers));
+    motor_control_reset_timing();
+    int64_t t0 = k_uptime_get();
+
+    for (uint32_t t = 0; t < STORM_THREADS; t++) {
+        workers[t] = (struct storm_worker){
+            .index = t,
+            .count = per_thread,
+            .period_us = (rate_hz > 0U) ? (USEC_PER_SEC / rate_hz) : 0U,
+            .lat_ns = &lat_ns[t * per_thread],
+        };
+        k_thread_create(&storm_threads[t], storm_stacks[t],
+                        K_THREAD_STACK_SIZEOF(storm_stacks[t]), storm_worker, &workers[t], NULL,
+                        NULL, STORM_THREAD_PRIO, 0, K_NO_WAIT);
+    }
+
+    /* Without load the control loop still runs for the whole duration (reference). */
+    k_msleep(STORM_DURATION_MS);
+
+    uint32_t rejected = 0;
+
+    for (uint32_t t = 0; t < STORM_THREADS; t++) {
+        zassert_equal(k_thread_join(&storm_threads[t], K_FOREVER), 0, NULL);
+        zassert_equal(workers[t].error, 0, "thread %u: command failed with %d", t,
+                      workers[t].error);
+        rejected += workers[t].rejected;
+    }
+
+    uint64_t elapsed_ms = MAX(k_uptime_get() - t0, 1);
+    struct motor_control_timing timing;
+
+    motor_control_get_timing(&timing);
+    qsort(lat_ns, total, sizeof(lat_ns[0]), storm_cmp_u32);
+
+    /* Machine-readable: one line per load level (collected by twister, see testcase.yaml). */
+    TC_PRINT("shell_storm,threads=%u,rate_hz=%u,cmds=%u,rejected=%u,cmds_per_s=%llu,"
+             "lat_p50_ns=%u,lat_p90_ns=%u,lat_p99_ns=%u,lat_max_ns=%u,"
+             "ctrl_periods=%u,ctrl_late_mean_us=%u,ctrl_late_max_us=%u,ctrl_missed=%u\n",
+             STORM_THREADS, rate_hz, total, rejected,
+             (unsigned long long)((total * 1000ULL) / elapsed_ms),
+             storm_percentile(lat_ns, total, 50U), storm_percentile(lat_ns, total, 90U),
+             storm_percentile(lat_ns, total, 99U), storm_percentile(lat_ns, total, 100U),
+             timing.periods, timing.late_sum_us / MAX(timing.periods, 1U), timing.late_max_us,
+             timing.missed);
+
+    zassert_true(timing.periods > 0U, "control loop did not run");
+    if (rate_hz == 0U) {
+        zassert_equal(timing.missed, 0U, "reference run already misses deadlines");
+    }
+}
+
+/* Parse CONFIG_BENCH_STORM_RATES ("0,100,1000"). */
+static size_t storm_rates(uint32_t *rates)
+{
+    const char *p = CONFIG_BENCH_STORM_RATES;
+    size_t n = 0;
+
+    while ((*p != '\0') && (n < STORM_MAX_LEVELS)) {
+        char *end;
+
+        rates[n++] = (uint32_t)strtoul(p, &end, 10);
+        zassert_true((end != p) && ((*end == ',') || (*end == '\0')), "bad rate list: %s",
+                     CONFIG_BENCH_STORM_RATES);
+        p = (*end == ',') ? (end + 1) : end;
+    }
+
+    return n;
+}
+
+ZTEST(shell_storm, test_command_load_vs_control_timing)
+{
+    uint32_t rates[STORM_MAX_LEVELS];
+    size_t levels = storm_rates(rates);
+
+    zassert_true(levels > 0U, "no load level");
+
+    for (size_t i = 0; i < levels; i++) {
+        storm_run(rates[i]);
+    }
+}
+
+static void *storm_setup(void)
+{
+    static const struct motor_control_config control_cfg = {
+        .period_ms = CONFIG_BENCH_STORM_CONTROL_PERIOD_MS,
+    };
+
+    zassert_equal(app_state_init(), 0, NULL);
+    motor_cmd_test_reset();
+    motor_control_init(&control_cfg);
+#if defined(CONFIG_ARCH_POSIX)
+    /* Same host clock as the command latencies, so CPU load shows as lateness. */
+    motor_control_test_set_period_clock(host_clock_ns);
+#endif
+    motor_control_start();
+
+    return NULL;
+}
+
+static void storm_teardown(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    motor_control_stop();
+#if defined(CONFIG_ARCH_POSIX)
+    motor_control_test_set_period_clock(NULL);
+#endif
+}
+
+ZTEST_SUITE(shell_storm, NULL, storm_setup, NULL, NULL, storm_teardown);
@@ -0,0 +1,140 @@
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "motor_model.h"
+
+/* Motor model instances partitioned across the CPUs. */
+#define BENCH_MOTORS 64
+
+/* Control steps each instance runs per measurement. */
+#define BENCH_STEPS 20000U
+
+/* Shards are padded to this size so two CPUs never write the same line. */
+#define BENCH_CACHE_LINE 64
+
+#define BENCH_MAX_CPUS     4
+#define BENCH_STACK_SIZE   1024
+#define BENCH_THREAD_PRIO  5
+
+/**
+ * Per-CPU state shard: the instances one CPU owns and its result counters.
+ * Only the owning worker writes it while a measurement runs.
+ */
+struct bench_shard {
+    struct motor_state motors[BENCH_MOTORS];
+    uint32_t count;
+    uint32_t cpu_seen;
+    uint64_t steps;
+} __aligned(BENCH_CACHE_LINE);
+
+BUILD_ASSERT((sizeof(struct bench_shard) % BENCH_CACHE_LINE) == 0,
+             "shards must not share a cache line");
+
+static struct bench_shard shards[BENCH_MAX_CPUS];
+
+/* Read-only while workers run, so every CPU may share it. */
+static const struct motor_model_params bench_params = MOTOR_MODEL_PARAMS_DEFAULT;
+
+K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_MAX_CPUS, BENCH_STACK_SIZE);
+static struct k_thread bench_threads[BENCH_MAX_CPUS];
+
+static K_SEM_DEFINE(start_sem, 0, BENCH_MAX_CPUS);
+static K_SEM_DEFINE(done_sem, 0, BENCH_MAX_CPUS);
+
+static void bench_worker(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct bench_shard *shard = p1;
+
+    (void)k_sem_take(&start_sem, K_FOREVER);
+
+    /*
+     * Pinned: the CPU cannot change under us. Only the model is stepped: the
+     * application's controller state is a single instance and must not be
+     * shared across CPUs.
+     */
+    shard->cpu_seen = arch_curr_cpu()->id;
+
+    for (uint32_t s = 0; s < BENCH_STEPS; s++) {
+        for (uint32_t m = 0; m < shard->count; m++) {
+            motor_model_step(&bench_params, &shard->motors[m]);
+        }
+    }
+    shard->steps = (uint64_t)BENCH_STEPS * shard->count;
+
+    k_sem_give(&done_sem);
+}
+
+/**
+ * Run one measurement with @p cpus pinned workers and return the aggregate
+ * number of model steps per second.
+ */
+static uint64_t bench_run(unsigned int cpus)
+{
+    memset(shards, 0, sizeof(shards));
+
+    /* Round-robin partition, each instance with its own setpoint. */
+    for (unsigned int m = 0; m < BENCH_MOTORS; m++) {
+        struct bench_shard *shard = &shards[m % cpus];
+        struct motor_state *state = &shard->motors[shard->count++];
+
+        state->setpoint_rpm = 500.0f + (100.0f * (float)m);
+        state->temperature_c = 25.0f;
+    }
+
+    for (unsigned int c = 0; c < cpus; c++) {
+        k_tid_t tid = k_thread_create(&bench_threads[c], bench_stacks[c],
+                                      K_THREAD_STACK_SIZEOF(bench_stacks[c]), bench_worker,
+                                      &shards[c], NULL, NULL, BENCH_THREAD_PRIO, 0, K_FOREVER);
+
+        zassert_equal(k_thread_cpu_pin(tid, (int)c), 0, "pin worker %u", c);
+        k_thread_start(tid);
+    }
+
+    int64_t t0 = k_uptime_ticks();
+
+    for (unsigned int c = 0; c < cpus; c++) {
+        k_sem_give(&start_sem);
+    }
+    for (unsigned int c = 0; c < cpus; c++) {
+        (void)k_sem_take(&done_sem, K_FOREVER);
+    }
+
+    uint64_t elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - t0);
+
+    uint64_t total = 0;
+    for (unsigned int c = 0; c < cpus; c++) {
+        zassert_equal(k_thread_join(&bench_threads[c], K_FOREVER), 0, NULL);
+        zassert_equal(shards[c].cpu_seen, c, "worker %u ran on CPU %u", c, shards[c].cpu_seen);
+        total += shards[c].steps;
+    }
+    zassert_equal(total, (uint64_t)BENCH_MOTORS * BENCH_STEPS, NULL);
+
+    return (total * USEC_PER_SEC) / MAX(elapsed_us, 1U);
+}
+
+ZTEST(smp_scaling, test_steps_per_second_by_cpu_count)
+{
+    unsigned int cpus = MIN(arch_num_cpus(), BENCH_MAX_CPUS);
+    uint64_t base = 0;
+
+    for (unsigned int n = 1; n <= cpus; n++) {
+        uint64_t rate = bench_run(n);
+
+        zassert_true(rate > 0U, NULL);
+        if (n == 1U) {
+            base = rate;
+        }
+
+        /* Machine-readable: one line per CPU count, speedup in hundredths. */
+        TC_PRINT("smp_scaling,cpus=%u,motors=%u,steps_per_s=%llu,speedup_x100=%llu\n", n,
+                 BENCH_MOTORS, (unsigned long long)rate,
+                 (unsigned long long)((rate * 100U) / base));
+    }
+}
+
+ZTEST_SUITE(smp_scaling, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,29 @@
+/**
+ * @file host_clock.h
+ * @brief Host wall clock for native_sim tests.
+ *
+ * native_sim's own clocks (k_uptime, native_rtc) are simulated: they stand
+ * still while code runs and only advance while the CPU idles. Rates of
+ * CPU-bound work need the host's clock instead. Implemented in
+ * host_clock_bottom.c, built into the native simulator runner:
+ *
+ *   target_include_directories(app PRIVATE .../tests/common)
+ *   target_sources(native_simulator INTERFACE .../tests/common/host_clock_bottom.c)
+ */
+
+#ifndef HOST_CLOCK_H_
+#define HOST_CLOCK_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Host monotonic clock in microseconds.
+ */
+uint64_t host_clock_us(void);
+
+/**
+ * @brief Host monotonic clock in nanoseconds, for intervals of a few microseconds.
+ */
+uint64_t host_clock_ns(void);
+
+#endif /* HOST_CLOCK_H_ */
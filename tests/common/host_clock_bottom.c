@@ -0,0 +1,24 @@
+/**
+ * @file host_clock_bottom.c
+ * @brief Host wall clock for native_sim tests (host side).
+ */
+
+#include <time.h>
+
+#include "host_clock.h"
+
+uint64_t host_clock_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+uint64_t host_clock_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file test_clock.c
+ * @brief Virtual clock that runs the periodic module bodies for tests.
+ */
+
+#include <zephyr/sys/util.h>
+
+#include "fault_monitor.h"
+#include "motor_control.h"
+#include "telemetry.h"
+#include "test_clock.h"
+
+/* Due time of a body that never runs. */
+#define TEST_CLOCK_NEVER INT64_MAX
+
+static struct test_clock_config clock_cfg;
+static struct test_clock_stats clock_stats;
+static int64_t now_ms;
+static int64_t control_due_ms;
+static int64_t fault_due_ms;
+
+static int64_t first_due(uint32_t period_ms)
+{
+    return (period_ms != 0U) ? (int64_t)period_ms : TEST_CLOCK_NEVER;
+}
+
+void test_clock_init(const struct test_clock_config *cfg)
+{
+    clock_cfg = *cfg;
+    clock_stats = (struct test_clock_stats){0};
+    now_ms = 0;
+    control_due_ms = first_due(cfg->control_period_ms);
+    fault_due_ms = first_due(cfg->fault_period_ms);
+}
+
+int64_t test_clock_now_ms(void)
+{
+    return now_ms;
+}
+
+void test_clock_advance_ms(uint32_t ms)
+{
+    const int64_t end_ms = now_ms + ms;
+
+    while (MIN(control_due_ms, fault_due_ms) <= end_ms) {
+        now_ms = MIN(control_due_ms, fault_due_ms);
+
+        if (control_due_ms == now_ms) {
+            motor_control_run_once();
+            telemetry_process_sample();
+            clock_stats.control_runs++;
+            control_due_ms += clock_cfg.control_period_ms;
+        }
+
+        if (fault_due_ms == now_ms) {
+            fault_monitor_run_once(now_ms);
+            clock_stats.fault_runs++;
+            fault_due_ms += clock_cfg.fault_period_ms;
+        }
+    }
+
+    now_ms = end_ms;
+}
+
+void test_clock_get_stats(struct test_clock_stats *out)
+{
+    *out = clock_stats;
+}
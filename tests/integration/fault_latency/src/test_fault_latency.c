@@ -0,0 +1,113 @@
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "fault_monitor.h"
+
+/* Work items kept permanently queued on the system work queue. */
+#define FLOOD_ITEMS 8
+
+/* CPU time each flood item burns (us). */
+#define FLOOD_ITEM_US 2000
+
+/* Period of the fault check, and of the system work queue probe. */
+#define CHECK_PERIOD_MS 20U
+#define PROBE_PERIOD    K_MSEC(CHECK_PERIOD_MS)
+
+static struct k_work flood_work[FLOOD_ITEMS];
+static atomic_t flooding;
+
+/* A periodic check placed on the system work queue, for comparison. */
+static struct k_work_delayable probe_work;
+static int64_t probe_due_ticks;
+static uint32_t probe_max_latency_us;
+static bool probe_running;
+
+static void flood_handler(struct k_work *work)
+{
+    k_busy_wait(FLOOD_ITEM_US);
+
+    if (atomic_get(&flooding) != 0) {
+        (void)k_work_submit(work);
+    }
+}
+
+static void probe_schedule(void)
+{
+    probe_due_ticks = k_uptime_ticks() + PROBE_PERIOD.ticks;
+    (void)k_work_schedule(&probe_work, PROBE_PERIOD);
+}
+
+static void probe_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    int64_t late_ticks = MAX(k_uptime_ticks() - probe_due_ticks, 0);
+    uint32_t latency_us = (uint32_t)k_ticks_to_us_ceil64(late_ticks);
+
+    probe_max_latency_us = MAX(probe_max_latency_us, latency_us);
+
+    if (probe_running) {
+        probe_schedule();
+    }
+}
+
+ZTEST(fault_latency, test_stats_require_output)
+{
+    zassert_equal(fault_monitor_get_stats(NULL), -EINVAL, NULL);
+}
+
+ZTEST(fault_latency, test_latency_bounded_under_sysworkq_flood)
+{
+    static const struct fault_monitor_config cfg = {.period_ms = CHECK_PERIOD_MS,
+                                                     .log_period_ms = 0U};
+
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* An active fault keeps the check periodic although nothing else changes. */
+    zassert_equal(app_state_update_feedback(0.0f, 0.0f, 80.0f), 0, NULL);
+
+    fault_monitor_init(&cfg);
+    fault_monitor_start();
+
+    atomic_set(&flooding, 1);
+    for (int i = 0; i < FLOOD_ITEMS; i++) {
+        k_work_init(&flood_work[i], flood_handler);
+        zassert_true(k_work_submit(&flood_work[i]) >= 0, NULL);
+    }
+
+    k_work_init_delayable(&probe_work, probe_handler);
+    probe_running = true;
+    probe_schedule();
+
+    k_msleep(1000);
+
+    probe_running = false;
+    atomic_set(&flooding, 0);
+    k_msleep(100);
+    fault_monitor_stop();
+
+    struct fault_monitor_stats st;
+    zassert_equal(fault_monitor_get_stats(&st), 0, NULL);
+
+    uint32_t tick_us = (uint32_t)k_ticks_to_us_ceil32(1);
+
+    TC_PRINT("fault_wq: %u runs, max latency %u us; sysworkq probe max latency %u us\n",
+             st.runs, st.max_latency_us, probe_max_latency_us);
+
+    /* 1 s at a 20 ms period, with slack for the latency itself. */
+    zassert_true(st.runs >= 25U, "fault checks starved: %u runs", st.runs);
+
+    /* At most one flood item ahead of the check, plus timer granularity. */
+    zassert_true(st.max_latency_us <= (FLOOD_ITEM_US + (2U * tick_us)),
+                 "fault latency %u us not bounded by one work item", st.max_latency_us);
+
+    /* The same check on the system work queue waits behind the whole flood. */
+    zassert_true(probe_max_latency_us >= (3U * FLOOD_ITEM_US),
+                 "probe latency %u us: flood had no effect", probe_max_latency_us);
+}
+
+ZTEST_SUITE(fault_latency, NULL, NULL, NULL, NULL, NULL);
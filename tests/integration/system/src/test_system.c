@@ -1,55 +1,231 @@
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 
 #include "app_state.h"
+#include "fault_monitor.h"
 #include "motor_control.h"
+#include "motor_model.h"
 #include "telemetry.h"
-#include "fault_monitor.h"
+#include "test_clock.h"
+#include "trajectory.h"
+#include "wakeups.h"
+
+/* Thresholds of fault_monitor.c. */
+#define SPEED_ERROR_RPM 300.0f
+#define SOFT_LIMIT_C    60.0f
+#define HARD_LIMIT_C    70.0f
+
+/* Model time of each matrix scenario: long enough for every case to settle. */
+#define SCENARIO_MS 30000U
+
+static const struct motor_control_config control_cfg = MOTOR_CONTROL_CONFIG_DEFAULT;
+
+/* The application's periods on the virtual clock. */
+static const struct test_clock_config clock_cfg = {
+    .control_period_ms = MOTOR_CONTROL_PERIOD_MS,
+    .fault_period_ms = FAULT_MONITOR_PERIOD_MS,
+};
+
+/* Start a virtual-time run from rest at the given setpoint and temperature. */
+static void start_run(const struct fault_monitor_config *fault_cfg, float setpoint_rpm,
+                      float temperature_c)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+    motor_control_init(&control_cfg);
+    fault_monitor_init(fault_cfg);
+    trajectory_test_reset();
+    test_clock_init(&clock_cfg);
+
+    zassert_equal(app_state_set_setpoint(setpoint_rpm), 0, NULL);
+    zassert_equal(app_state_update_feedback(0.0f, 0.0f, temperature_c), 0, NULL);
+}
 
-ZTEST(system, test_run_threads_and_work_paths)
+ZTEST(system, test_threads_and_work_item_run_at_injected_periods)
 {
+    static const struct motor_control_config fast_control = {.period_ms = 1U};
+    static const struct fault_monitor_config fast_fault = {.period_ms = 5U, .log_period_ms = 0U};
+    struct app_state_counters before;
+    struct app_state_counters after;
+    struct fault_monitor_stats st;
+    struct motor_control_timing timing;
+    struct wakeups_report rep;
+
     zassert_equal(app_state_init(), 0, NULL);
+    motor_control_init(&fast_control);
+    fault_monitor_init(&fast_fault);
+    trajectory_test_reset();
+    zassert_equal(app_state_get_counters(&before), 0, NULL);
+
+    /* Spinning up from rest: every sample changes the state. */
+    zassert_equal(app_state_set_setpoint(3000.0f), 0, NULL);
+    zassert_equal(app_state_update_feedback(0.0f, 0.0f, 25.0f), 0, NULL);
 
-    /* Start modules (covers *_start() code paths) */
     telemetry_start();
     motor_control_start();
     fault_monitor_start();
 
-    /* Drive telemetry: 25 samples -> ejecuta "skip" y "log" (cada 10) */
-    for (int i = 0; i < 25; i++) {
-        zassert_equal(app_state_update_feedback(100.0f + i, 10.0f, 25.0f), 0, NULL);
-        k_msleep(20);
-    }
+    /* 100 ms of kernel time (simulated on native_sim): 5 s of model time. */
+    k_msleep(100);
 
-    /* Force soft/hard saturation in the motor_control thread. */
-    zassert_equal(app_state_set_setpoint(1500.0f), 0, NULL);
+    zassert_equal(app_state_get_counters(&after), 0, NULL);
+    /* A 1 ms sleep lasts one tick longer, so not quite 100 periods. */
+    zassert_true((after.samples - before.samples) >= 80U, "control periods: %u",
+                 after.samples - before.samples);
+    zassert_equal(fault_monitor_get_stats(&st), 0, NULL);
+    zassert_true(st.runs >= 18U, "fault checks: %u", st.runs);
 
-    zassert_equal(app_state_update_feedback(1500.0f, 90.0f, 90.0f), 0, NULL);
-    k_msleep(150);
+    /* Nothing else runs: every period starts on time, give or take the extra tick. */
+    motor_control_get_timing(&timing);
+    zassert_true(timing.periods >= 80U, "timed periods: %u", timing.periods);
+    zassert_equal(timing.missed, 0U, "late by up to %u us", timing.late_max_us);
+    motor_control_reset_timing();
+    motor_control_get_timing(&timing);
+    zassert_true(timing.periods <= 1U, NULL);
 
-    zassert_equal(app_state_update_feedback(1500.0f, 90.0f, 110.0f), 0, NULL);
-    k_msleep(150);
+    /* Settled (about 30 s of model time), then 50 s at a constant setpoint. */
+    k_msleep(1000);
+    wakeups_reset();
+    k_msleep(1000);
+    wakeups_get(&rep);
 
-    /* Forzar fault_monitor (speed + temp soft/hard) */
-    zassert_equal(app_state_set_setpoint(3000.0f), 0, NULL);
+    TC_PRINT("idle wakeups in %u ms: motor_ctrl %u, telemetry %u, fault_wq %u\n", rep.window_ms,
+             rep.count[WAKEUPS_CONTROL], rep.count[WAKEUPS_TELEMETRY], rep.count[WAKEUPS_FAULT]);
 
-    zassert_equal(app_state_update_feedback(0.0f, 90.0f, 85.0f), 0, NULL);
-    k_msleep(150);
+    /* Only the control loop still wakes up. */
+    zassert_true(rep.count[WAKEUPS_CONTROL] >= 800U, NULL);
+    zassert_equal(rep.count[WAKEUPS_TELEMETRY], 0U, NULL);
+    zassert_equal(rep.count[WAKEUPS_FAULT], 0U, NULL);
 
-    zassert_equal(app_state_update_feedback(0.0f, 90.0f, 105.0f), 0, NULL);
-    k_msleep(150);
+    /* A setpoint change wakes both again, the fault check without waiting a period. */
+    zassert_equal(fault_monitor_get_stats(&st), 0, NULL);
+    uint32_t idle_wakes = st.idle_wakes;
 
-    /* Cubrir rama diff < 0 en fault_monitor: measured > setpoint, y |diff| > threshold */
-    zassert_equal(app_state_set_setpoint(0.0f), 0, NULL);
-    zassert_equal(app_state_update_feedback(500.0f, 50.0f, 25.0f), 0, NULL);
-    k_msleep(150);
+    zassert_equal(app_state_set_setpoint(2000.0f), 0, NULL);
+    k_msleep(2);
+    wakeups_get(&rep);
+    zassert_true(rep.count[WAKEUPS_TELEMETRY] > 0U, NULL);
+    zassert_equal(fault_monitor_get_stats(&st), 0, NULL);
+    zassert_equal(st.idle_wakes, idle_wakes + 1U, NULL);
+    zassert_true((fault_monitor_test_get_flags() & FAULT_SPEED_ERROR) != 0U, NULL);
 
-    /* Stop test-only (evita que queden corriendo y afecte salida del test) */
-#ifdef MOTOR_SIM_DEMO_UNIT_TEST
     motor_control_stop();
     telemetry_stop();
     fault_monitor_stop();
-#endif
+}
+
+ZTEST(system, test_profile_ends_on_the_virtual_clock)
+{
+    static const struct fault_monitor_config fault_cfg = FAULT_MONITOR_CONFIG_DEFAULT;
+    struct trajectory_segment seg;
+    struct motor_state s;
+
+    start_run(&fault_cfg, 0.0f, 25.0f);
+    zassert_equal(trajectory_parse_segment("ramp:2000:200", &seg), 0, NULL);
+    zassert_equal(trajectory_load(&seg, 1), 0, NULL);
+    zassert_equal(trajectory_start(0.0f, 1), 0, NULL);
+
+    test_clock_advance_ms(150U);
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.setpoint_rpm < 2000.0f, "ramp still running at 150 ms");
+
+    test_clock_advance_ms(50U);
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.setpoint_rpm == 2000.0f, "ramp ends at 200 ms");
+}
+
+ZTEST(system, test_fault_checks_follow_the_virtual_clock)
+{
+    static const struct fault_monitor_config fault_cfg = {.period_ms = 250U,
+                                                          .log_period_ms = 0U};
+    static const struct test_clock_config quick_checks = {
+        .control_period_ms = MOTOR_CONTROL_PERIOD_MS,
+        .fault_period_ms = 250U,
+    };
+    struct test_clock_stats st;
+
+    start_run(&fault_cfg, 3000.0f, 25.0f);
+    test_clock_init(&quick_checks);
+
+    /* Nothing runs before the first period is over. */
+    test_clock_advance_ms(49U);
+    test_clock_get_stats(&st);
+    zassert_equal(st.control_runs, 0U, NULL);
+    zassert_equal(fault_monitor_test_get_flags(), FAULT_NONE, NULL);
+
+    /* Still spinning up at the first check. */
+    test_clock_advance_ms(201U);
+    zassert_true((fault_monitor_test_get_flags() & FAULT_SPEED_ERROR) != 0U, NULL);
+
+    /* Settled well before 2 s. */
+    test_clock_advance_ms(1750U);
+    zassert_equal(fault_monitor_test_get_flags(), FAULT_NONE, NULL);
+
+    test_clock_get_stats(&st);
+    zassert_equal(test_clock_now_ms(), 2000, NULL);
+    zassert_equal(st.control_runs, 40U, NULL);
+    zassert_equal(st.fault_runs, 8U, NULL);
+}
+
+ZTEST(system, test_scenario_matrix_matches_the_model)
+{
+    static const float setpoints_rpm[] = {0.0f,    500.0f,  1000.0f, 1500.0f, 2000.0f,
+                                          2500.0f, 3000.0f, 3500.0f, 4000.0f, 4500.0f,
+                                          5000.0f, 5500.0f, 6000.0f, 6500.0f, 7000.0f,
+                                          7500.0f, 8000.0f, 9000.0f, 10000.0f};
+    static const float start_temps_c[] = {25.0f, 50.0f, 70.0f, 90.0f, 110.0f};
+    static const struct motor_model_params params = MOTOR_MODEL_PARAMS_DEFAULT;
+    /* No fault logs: the log period is longer than a scenario. */
+    static const struct fault_monitor_config fault_cfg = {
+        .period_ms = FAULT_MONITOR_PERIOD_MS,
+        .log_period_ms = 2U * SCENARIO_MS,
+    };
+    uint32_t hard_faults = 0U;
+
+    for (size_t i = 0; i < ARRAY_SIZE(setpoints_rpm); i++) {
+        for (size_t j = 0; j < ARRAY_SIZE(start_temps_c); j++) {
+            struct motor_state ref = {
+                .setpoint_rpm = setpoints_rpm[i],
+                .temperature_c = start_temps_c[j],
+            };
+            struct motor_state s;
+            struct test_clock_stats st;
+
+            start_run(&fault_cfg, ref.setpoint_rpm, ref.temperature_c);
+            test_clock_advance_ms(SCENARIO_MS);
+
+            /* The same periods stepped on the model alone. */
+            for (uint32_t k = 0; k < (SCENARIO_MS / MOTOR_CONTROL_PERIOD_MS); k++) {
+                motor_model_step_multirate(&params, &ref, k, CONFIG_MOTOR_SIM_THERMAL_DIVIDER);
+            }
+
+            zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+            zassert_mem_equal(&s, &ref, sizeof(s), "sp %d rpm, T0 %d C",
+                              (int)setpoints_rpm[i], (int)start_temps_c[j]);
+            zassert_within(s.measured_rpm, s.setpoint_rpm, 1.0f, NULL);
+
+            /* The last check ran right after the last control period. */
+            uint32_t flags = fault_monitor_test_get_flags();
+
+            zassert_equal(flags, fault_monitor_eval(&ref, SPEED_ERROR_RPM, SOFT_LIMIT_C,
+                                                    HARD_LIMIT_C),
+                          NULL);
+            hard_faults += ((flags & FAULT_TEMP_HARD) != 0U) ? 1U : 0U;
+
+            test_clock_get_stats(&st);
+            zassert_equal(st.control_runs, SCENARIO_MS / MOTOR_CONTROL_PERIOD_MS, NULL);
+            zassert_equal(st.fault_runs, SCENARIO_MS / FAULT_MONITOR_PERIOD_MS, NULL);
+        }
+    }
+
+    /* The fast settings run hot, the slow ones cool down from any start. */
+    zassert_true((hard_faults > 0U) &&
+                     (hard_faults < (ARRAY_SIZE(setpoints_rpm) * ARRAY_SIZE(start_temps_c))),
+                 "hard faults in %u scenarios", hard_faults);
+
+    TC_PRINT("scenario matrix: %u scenarios, %u s of model time each, %u end hot\n",
+             (unsigned int)(ARRAY_SIZE(setpoints_rpm) * ARRAY_SIZE(start_temps_c)),
+             SCENARIO_MS / 1000U, hard_faults);
 }
 
 ZTEST_SUITE(system, NULL, NULL, NULL, NULL, NULL);
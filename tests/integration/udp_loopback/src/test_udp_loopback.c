@@ -0,0 +1,275 @@
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "host_clock.h"
+#include "motor_cmd.h"
+#include "motor_udp_proto.h"
+#include "sample_pool.h"
+#include "udp_link.h"
+
+#define LOOPBACK "127.0.0.1"
+
+/* Samples pushed through app_state for the throughput measurement. */
+#define TEST_SAMPLES 60000U
+
+/* Setpoint commands for the round-trip measurement. */
+#define TEST_COMMANDS 200U
+
+/* Longest wait for one datagram (real socket, so allow for a slow host). */
+#define TEST_RECV_TIMEOUT_MS 1000
+
+static uint8_t buf[MOTOR_UDP_MAX_LEN];
+
+static int open_socket(int port, struct sockaddr_in *addr)
+{
+    int sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    zassert_true(sock >= 0, "socket: %d", errno);
+
+    *addr = (struct sockaddr_in){.sin_family = AF_INET, .sin_port = htons((uint16_t)port)};
+    zassert_equal(zsock_inet_pton(AF_INET, LOOPBACK, &addr->sin_addr), 1, NULL);
+
+    return sock;
+}
+
+/* Receive one datagram, waiting up to timeout_ms. Returns its length or -EAGAIN. */
+static ssize_t recv_one(int sock, int timeout_ms)
+{
+    struct zsock_pollfd pfd = {.fd = sock, .events = ZSOCK_POLLIN};
+
+    if (zsock_poll(&pfd, 1, timeout_ms) <= 0) {
+        return -EAGAIN;
+    }
+    return zsock_recv(sock, buf, sizeof(buf), 0);
+}
+
+struct rx_check {
+    uint32_t samples;
+    uint32_t datagrams;
+    uint32_t next_sample_seq;
+    uint32_t next_dgram_seq;
+};
+
+/* Decode one telemetry datagram and check it continues the sequence. */
+static void check_telemetry(struct rx_check *rx, ssize_t len)
+{
+    struct motor_udp_msg msg;
+
+    zassert_equal(motor_udp_decode(buf, (size_t)len, &msg), 0, NULL);
+    zassert_equal(msg.type, MOTOR_UDP_TELEMETRY, NULL);
+    if (rx->datagrams > 0U) {
+        zassert_equal(msg.seq, rx->next_dgram_seq, "datagram lost or reordered");
+    }
+    rx->next_dgram_seq = msg.seq + 1U;
+
+    for (uint16_t i = 0; i < msg.count; i++) {
+        struct motor_udp_sample s;
+
+        motor_udp_get_sample(buf, i, &s);
+        zassert_equal(s.seq, rx->next_sample_seq, "sample lost or reordered");
+        rx->next_sample_seq++;
+    }
+
+    rx->samples += msg.count;
+    rx->datagrams++;
+}
+
+static void *udp_loopback_setup(void)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* Below the link threads, so a full batch is sent as soon as it is queued. */
+    k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(10));
+
+    return NULL;
+}
+
+static void udp_loopback_teardown(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    udp_link_test_stop();
+}
+
+ZTEST(udp_loopback, test_telemetry_throughput)
+{
+    struct sockaddr_in addr;
+    int sock = open_socket(CONFIG_MOTOR_SIM_UDP_COLLECTOR_PORT, &addr);
+    struct rx_check rx = {.next_sample_seq = 1U};
+    struct udp_link_stats st;
+    ssize_t len;
+
+    zassert_equal(zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)), 0, "bind: %d", errno);
+    zassert_equal(app_state_init(), 0, "sample numbering restarts at 1");
+
+    uint64_t t0 = host_clock_us();
+
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        zassert_equal(app_state_update_feedback((float)(i % 3000U), 50.0f, 40.0f), 0, NULL);
+
+        /* Take each datagram as it arrives so the host's socket buffer never fills. */
+        while ((len = zsock_recv(sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT)) > 0) {
+            check_telemetry(&rx, len);
+        }
+    }
+
+    /* The last partial batch goes out after the flush timeout. */
+    while ((rx.samples < TEST_SAMPLES) && ((len = recv_one(sock, TEST_RECV_TIMEOUT_MS)) > 0)) {
+        check_telemetry(&rx, len);
+    }
+
+    uint64_t us = MAX(host_clock_us() - t0, 1U);
+
+    udp_link_get_stats(&st);
+    TC_PRINT("BENCH_RATE:udp_telemetry,samples=%u,datagrams=%u,dropped=%u,samples_per_s=%llu,"
+             "datagrams_per_s=%llu\n",
+             rx.samples, rx.datagrams, st.samples_dropped,
+             (unsigned long long)((rx.samples * 1000000ULL) / us),
+             (unsigned long long)((rx.datagrams * 1000000ULL) / us));
+
+    zassert_equal(st.samples_dropped, 0U, NULL);
+    zassert_equal(st.send_errors, 0U, NULL);
+    zassert_equal(rx.samples, TEST_SAMPLES, NULL);
+    zassert_equal(st.samples_sent, TEST_SAMPLES, NULL);
+    zassert_equal(rx.datagrams, st.datagrams_sent, NULL);
+    zassert_true(rx.datagrams <= (TEST_SAMPLES / CONFIG_MOTOR_SIM_UDP_BATCH) + 1U,
+                 "full batches");
+
+    zsock_close(sock);
+}
+
+ZTEST(udp_loopback, test_batch_full_while_sending_drops_and_counts)
+{
+    struct udp_link_stats st;
+
+    /* The link threads cannot run while the scheduler is locked. */
+    k_sched_lock();
+    for (uint32_t i = 0; i < 3U * CONFIG_MOTOR_SIM_UDP_BATCH; i++) {
+        zassert_equal(app_state_update_feedback(100.0f, 10.0f, 30.0f), 0, NULL);
+    }
+    k_sched_unlock();
+
+    /* One batch queued for sending, one full in the buffer, the rest dropped. */
+    udp_link_get_stats(&st);
+    zassert_equal(st.samples_dropped, CONFIG_MOTOR_SIM_UDP_BATCH, NULL);
+
+    /* Both full batches go out back to back. */
+    k_msleep(CONFIG_MOTOR_SIM_UDP_FLUSH_MS);
+    udp_link_get_stats(&st);
+    zassert_equal(st.samples_sent, 2U * CONFIG_MOTOR_SIM_UDP_BATCH, NULL);
+
+    /* The pool covered both batches and the history; sent samples were given back. */
+    struct sample_pool_stats ps;
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.exhausted, 0U, NULL);
+    zassert_equal(ps.in_use, APP_STATE_HISTORY_LEN, "only the history holds blocks");
+}
+
+ZTEST(udp_loopback, test_samples_before_start_are_not_queued)
+{
+    struct udp_link_stats st;
+
+    udp_link_test_stop();
+    zassert_equal(app_state_update_feedback(100.0f, 10.0f, 30.0f), 0, NULL);
+
+    zassert_equal(udp_link_start(), 0, NULL);
+    k_msleep(2 * CONFIG_MOTOR_SIM_UDP_FLUSH_MS);
+    udp_link_get_stats(&st);
+    zassert_equal(st.datagrams_sent, 0U, "nothing to flush");
+    zassert_equal(st.samples_dropped, 0U, NULL);
+}
+
+ZTEST(udp_loopback, test_setpoint_round_trip)
+{
+    struct sockaddr_in dest;
+    int sock = open_socket(CONFIG_MOTOR_SIM_UDP_CMD_PORT, &dest);
+    uint64_t min_us = UINT64_MAX;
+    uint64_t max_us = 0U;
+    uint64_t sum_us = 0U;
+    struct motor_udp_msg msg;
+
+    for (uint32_t i = 0; i < TEST_COMMANDS; i++) {
+        size_t len = motor_udp_encode_setpoint(buf, i, 1000U + i, 100.0f + (float)i);
+        uint64_t t0 = host_clock_us();
+
+        zassert_equal(zsock_sendto(sock, buf, len, 0, (struct sockaddr *)&dest, sizeof(dest)),
+                      (ssize_t)len, NULL);
+
+        ssize_t rlen = recv_one(sock, TEST_RECV_TIMEOUT_MS);
+        uint64_t rtt = host_clock_us() - t0;
+
+        zassert_true(rlen > 0, "no ack for command %u", i);
+        zassert_equal(motor_udp_decode(buf, (size_t)rlen, &msg), 0, NULL);
+        zassert_equal(msg.type, MOTOR_UDP_ACK, NULL);
+        zassert_equal(msg.cmd_id, 1000U + i, NULL);
+        zassert_equal(msg.status, 0, NULL);
+
+        /* Apply it as the control loop would, so the queue never fills. */
+        zassert_equal(motor_cmd_drain(), 1U, NULL);
+
+        min_us = MIN(min_us, rtt);
+        max_us = MAX(max_us, rtt);
+        sum_us += rtt;
+    }
+
+    TC_PRINT("BENCH_RATE:udp_setpoint_rtt,commands=%u,min_us=%llu,avg_us=%llu,max_us=%llu\n",
+             TEST_COMMANDS, (unsigned long long)min_us,
+             (unsigned long long)(sum_us / TEST_COMMANDS), (unsigned long long)max_us);
+
+    struct motor_state s;
+
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.setpoint_rpm == 100.0f + (float)(TEST_COMMANDS - 1U), "last command applied");
+
+    /* Out of range: acknowledged with the error, nothing queued. */
+    size_t len = motor_udp_encode_setpoint(buf, 0U, 7U, APP_STATE_MAX_SETPOINT_RPM + 1.0f);
+
+    zassert_equal(zsock_sendto(sock, buf, len, 0, (struct sockaddr *)&dest, sizeof(dest)),
+                  (ssize_t)len, NULL);
+
+    ssize_t rlen = recv_one(sock, TEST_RECV_TIMEOUT_MS);
+
+    zassert_true(rlen > 0, "no ack for the rejected command");
+    zassert_equal(motor_udp_decode(buf, (size_t)rlen, &msg), 0, NULL);
+    zassert_equal(msg.cmd_id, 7U, NULL);
+    zassert_equal(msg.status, -ERANGE, NULL);
+    zassert_equal(motor_cmd_drain(), 0U, NULL);
+
+    zsock_close(sock);
+}
+
+ZTEST(udp_loopback, test_malformed_datagrams_are_counted_not_acked)
+{
+    struct sockaddr_in dest;
+    int sock = open_socket(CONFIG_MOTOR_SIM_UDP_CMD_PORT, &dest);
+    struct udp_link_stats st;
+    size_t len = motor_udp_encode_ack(buf, 0U, 1U, 0, 0U);
+
+    /* A valid datagram of the wrong type, then garbage. */
+    zassert_equal(zsock_sendto(sock, buf, len, 0, (struct sockaddr *)&dest, sizeof(dest)),
+                  (ssize_t)len, NULL);
+    zassert_equal(zsock_sendto(sock, "hello", 5, 0, (struct sockaddr *)&dest, sizeof(dest)), 5,
+                  NULL);
+
+    zassert_equal(recv_one(sock, 100), -EAGAIN, "no reply");
+    udp_link_get_stats(&st);
+    zassert_equal(st.bad_datagrams, 2U, NULL);
+    zassert_equal(st.commands, 0U, NULL);
+
+    zsock_close(sock);
+}
+
+static void udp_loopback_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+
+    /* Fresh link and counters for every test. */
+    udp_link_test_stop();
+    motor_cmd_test_reset();
+    zassert_equal(udp_link_start(), 0, NULL);
+}
+
+ZTEST_SUITE(udp_loopback, NULL, udp_loopback_setup, udp_loopback_before, NULL,
+            udp_loopback_teardown);
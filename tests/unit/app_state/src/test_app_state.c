@@ -1,7 +1,9 @@
 #include <errno.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 
 #include "app_state.h"
+#include "sample_pool.h"
 
 ZTEST(app_state, test_init_defaults)
 {
@@ -52,4 +54,314 @@ ZTEST(app_state, test_get_snapshot_null)
     zassert_equal(app_state_get_snapshot(NULL), -EINVAL, NULL);
 }
 
+ZTEST(app_state, test_counters_and_history_ring)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_get_counters(NULL), -EINVAL, NULL);
+
+    struct app_state_sample hist[APP_STATE_HISTORY_LEN];
+    zassert_equal(app_state_get_history(hist, ARRAY_SIZE(hist)), 0U, "empty after init");
+
+    zassert_equal(app_state_set_setpoint(1000.0f), 0, NULL);
+
+    /* Overfill the ring: only the newest APP_STATE_HISTORY_LEN samples remain. */
+    for (int i = 1; i <= APP_STATE_HISTORY_LEN + 5; i++) {
+        zassert_equal(app_state_update_feedback((float)i, 0.0f, 25.0f), 0, NULL);
+    }
+
+    struct app_state_counters c;
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    zassert_equal(c.samples, APP_STATE_HISTORY_LEN + 5U, NULL);
+    zassert_equal(c.setpoint_updates, 1U, NULL);
+    zassert_equal(c.publish_errors, 0U, NULL);
+
+    size_t n = app_state_get_history(hist, ARRAY_SIZE(hist));
+    zassert_equal(n, APP_STATE_HISTORY_LEN, NULL);
+    zassert_equal(hist[0].seq, 6U, "oldest first");
+    zassert_true(hist[0].state.measured_rpm == 6.0f, NULL);
+    zassert_equal(hist[n - 1].seq, APP_STATE_HISTORY_LEN + 5U, NULL);
+
+    /* A smaller buffer gets the newest samples. */
+    n = app_state_get_history(hist, 2);
+    zassert_equal(n, 2U, NULL);
+    zassert_equal(hist[1].seq, APP_STATE_HISTORY_LEN + 5U, NULL);
+}
+
+ZTEST(app_state, test_restore_resumes_counters_with_empty_history)
+{
+    const struct motor_state saved = {
+        .setpoint_rpm = 2500.0f,
+        .measured_rpm = 2490.0f,
+        .control_output_pct = 80.0f,
+        .temperature_c = 65.0f,
+    };
+    const struct app_state_counters saved_counters = {.samples = 1000U, .setpoint_updates = 7U};
+    struct app_state_sample hist[APP_STATE_HISTORY_LEN];
+    struct app_state_counters c;
+    struct motor_state s;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_update_feedback(10.0f, 1.0f, 25.0f), 0, NULL);
+    zassert_equal(app_state_wait_for_sample(), 0, NULL);
+
+    struct motor_state bad = saved;
+    bad.setpoint_rpm = -1.0f;
+    zassert_equal(app_state_restore(&bad, &saved_counters), -ERANGE, NULL);
+
+    zassert_equal(app_state_restore(&saved, &saved_counters), 0, NULL);
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_mem_equal(&s, &saved, sizeof(s), NULL);
+    zassert_equal(app_state_wait_for_sample(), 0, "restore is a change");
+    zassert_equal(app_state_get_history(hist, ARRAY_SIZE(hist)), 0U, "history restarts empty");
+
+    /* New samples are numbered on from the restored count. */
+    zassert_equal(app_state_update_feedback(2491.0f, 80.0f, 65.0f), 0, NULL);
+    zassert_equal(app_state_get_history(hist, ARRAY_SIZE(hist)), 1U, NULL);
+    zassert_equal(hist[0].seq, 1001U, NULL);
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    zassert_equal(c.setpoint_updates, 7U, NULL);
+}
+
+ZTEST(app_state, test_held_history_is_shared_not_copied)
+{
+    const struct app_state_sample *a[APP_STATE_HISTORY_LEN];
+    const struct app_state_sample *b[APP_STATE_HISTORY_LEN];
+    struct sample_pool_stats ps;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_update_feedback(1.0f, 0.0f, 25.0f), 0, NULL);
+    zassert_equal(app_state_update_feedback(2.0f, 0.0f, 25.0f), 0, NULL);
+
+    /* Both readers get the recorded samples themselves. */
+    zassert_equal(app_state_hold_history(a, ARRAY_SIZE(a)), 2U, NULL);
+    zassert_equal(app_state_hold_history(b, 1), 1U, "newest only");
+    zassert_equal_ptr(a[1], b[0], NULL);
+    zassert_equal(a[0]->seq, 1U, NULL);
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.in_use, 2U, "no block per reader");
+
+    /* Held samples outlive their place in the ring. */
+    for (int i = 0; i < APP_STATE_HISTORY_LEN; i++) {
+        zassert_equal(app_state_update_feedback(100.0f, 0.0f, 25.0f), 0, NULL);
+    }
+    zassert_true(a[0]->state.measured_rpm == 1.0f, NULL);
+    zassert_true(a[1]->state.measured_rpm == 2.0f, NULL);
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.in_use, APP_STATE_HISTORY_LEN + 2U, NULL);
+
+    sample_pool_release(a[0]);
+    sample_pool_release(a[1]);
+    sample_pool_release(b[0]);
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.in_use, APP_STATE_HISTORY_LEN, "only the ring holds blocks");
+
+    /* init empties the ring and gives its blocks back. */
+    zassert_equal(app_state_init(), 0, NULL);
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.in_use, 0U, NULL);
+}
+
+ZTEST(app_state, test_reader_of_full_history_drops_nothing)
+{
+    const struct app_state_sample *held[APP_STATE_HISTORY_LEN];
+    struct sample_pool_stats ps;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    for (int i = 0; i < APP_STATE_HISTORY_LEN; i++) {
+        zassert_equal(app_state_update_feedback(1.0f, 0.0f, 25.0f), 0, NULL);
+    }
+    sample_pool_reset_stats();
+
+    /* What motor_dump holds while it prints, for as long as it likes. */
+    size_t n = app_state_hold_history(held, ARRAY_SIZE(held));
+    zassert_equal(n, APP_STATE_HISTORY_LEN, NULL);
+    for (int i = 0; i < 2 * APP_STATE_HISTORY_LEN; i++) {
+        zassert_equal(app_state_update_feedback(2.0f, 0.0f, 25.0f), 0, NULL);
+    }
+
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.exhausted, 0U, "the default spares cover a held history");
+
+    for (size_t i = 0; i < n; i++) {
+        sample_pool_release(held[i]);
+    }
+    zassert_equal(app_state_init(), 0, NULL);
+}
+
+ZTEST(app_state, test_exhausted_pool_drops_the_sample)
+{
+    static const struct app_state_sample *held[SAMPLE_POOL_BLOCKS];
+    struct app_state_sample hist[APP_STATE_HISTORY_LEN];
+    struct sample_pool_stats ps;
+    struct app_state_counters c;
+    size_t n = 0;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_update_feedback(1.0f, 0.0f, 25.0f), 0, NULL);
+    sample_pool_reset_stats();
+
+    /* A reader that never lets go takes every free block. */
+    while ((held[n] = sample_pool_alloc()) != NULL) {
+        n++;
+    }
+    zassert_equal(n, SAMPLE_POOL_BLOCKS - 1U, NULL);
+
+    zassert_equal(app_state_update_feedback(2.0f, 0.0f, 25.0f), 0, "the update still lands");
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    zassert_equal(c.samples, 2U, "and is counted");
+    zassert_equal(app_state_get_history(hist, ARRAY_SIZE(hist)), 1U, "but not recorded");
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.exhausted, 2U, "the probe and the sample");
+
+    for (size_t i = 0; i < n; i++) {
+        sample_pool_release(held[i]);
+    }
+
+    /* Recording resumes; the gap shows in the sequence numbers. */
+    zassert_equal(app_state_update_feedback(3.0f, 0.0f, 25.0f), 0, NULL);
+    zassert_equal(app_state_get_history(hist, ARRAY_SIZE(hist)), 2U, NULL);
+    zassert_equal(hist[0].seq, 1U, NULL);
+    zassert_equal(hist[1].seq, 3U, NULL);
+    zassert_equal(app_state_init(), 0, NULL);
+}
+
+ZTEST(app_state, test_stats_overruns_and_reset)
+{
+    struct app_state_stats st;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_get_stats(NULL), -EINVAL, NULL);
+
+    /* Three changes with nobody taking them: the last two overrun. */
+    for (int i = 0; i < 3; i++) {
+        zassert_equal(app_state_update_feedback(1000.0f + (100.0f * i), 10.0f, 25.0f), 0, NULL);
+    }
+    zassert_equal(app_state_wait_for_sample(), 0, NULL);
+    zassert_equal(app_state_update_feedback(2000.0f, 10.0f, 25.0f), 0, "consumed: no overrun");
+
+    /* An unchanged sample signals nothing, so it cannot overrun. */
+    zassert_equal(app_state_update_feedback(2000.0f, 10.0f, 25.0f), 0, NULL);
+
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.sample_overruns, 2U, NULL);
+    zassert_equal(st.publish_errors, 0U, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_UPDATE_FEEDBACK].acquisitions, 5U, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_UPDATE_FEEDBACK].contended, 0U, NULL);
+
+    app_state_reset_stats();
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.sample_overruns, 0U, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_UPDATE_FEEDBACK].acquisitions, 0U, NULL);
+
+    zassert_equal(strcmp(app_state_caller_name(APP_STATE_CALLER_GET_SNAPSHOT), "get_snapshot"), 0,
+                  NULL);
+    zassert_equal(strcmp(app_state_caller_name(APP_STATE_CALLER_COUNT), "?"), 0, NULL);
+}
+
+ZTEST(app_state, test_watchers_see_changes_beyond_the_deadband)
+{
+    static struct k_poll_signal sig;
+    static struct k_poll_signal others[APP_STATE_MAX_WATCHERS];
+    unsigned int raised;
+    int result;
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_set_setpoint(2500.0f), 0, NULL);
+    zassert_equal(app_state_update_feedback(500.0f, 20.0f, 40.0f), 0, NULL);
+
+    k_poll_signal_init(&sig);
+    zassert_equal(app_state_watch(&sig), 0, NULL);
+    zassert_equal(app_state_watch(&sig), 0, "registered once");
+
+    zassert_equal(app_state_update_feedback(600.0f, 20.0f, 40.0f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 1U, NULL);
+    zassert_equal(result, 2, "sample count");
+
+    /* Dither within the deadband of the last change wakes nobody... */
+    k_poll_signal_reset(&sig);
+    zassert_equal(app_state_update_feedback(600.5f, 20.05f, 40.05f), 0, NULL);
+    zassert_equal(app_state_update_feedback(599.5f, 19.95f, 39.95f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 0U, NULL);
+
+    /* ...but slow drift adds up against it. */
+    zassert_equal(app_state_update_feedback(601.0f, 20.0f, 40.0f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 1U, NULL);
+    zassert_equal(result, 5, NULL);
+
+    /* Each field on its own. */
+    k_poll_signal_reset(&sig);
+    zassert_equal(app_state_update_feedback(601.0f, 20.5f, 40.0f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 1U, "output");
+
+    k_poll_signal_reset(&sig);
+    zassert_equal(app_state_update_feedback(601.0f, 20.5f, 41.0f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 1U, "temperature");
+
+    k_poll_signal_reset(&sig);
+    zassert_equal(app_state_set_setpoint(2501.0f), 0, NULL);
+    k_poll_signal_check(&sig, &raised, &result);
+    zassert_equal(raised, 1U, "setpoint");
+
+    /* The table holds APP_STATE_MAX_WATCHERS signals. */
+    for (size_t i = 0; i < (APP_STATE_MAX_WATCHERS - 1); i++) {
+        k_poll_signal_init(&others[i]);
+        zassert_equal(app_state_watch(&others[i]), 0, NULL);
+    }
+    k_poll_signal_init(&others[APP_STATE_MAX_WATCHERS - 1]);
+    zassert_equal(app_state_watch(&others[APP_STATE_MAX_WATCHERS - 1]), -ENOMEM, NULL);
+}
+
+#define CONTENDER_STACK_SIZE 1024
+K_THREAD_STACK_DEFINE(contender_stack, CONTENDER_STACK_SIZE);
+static struct k_thread contender_thread;
+
+static void contender(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct motor_state s;
+    (void)app_state_get_snapshot(&s);
+}
+
+ZTEST(app_state, test_lock_wait_is_measured)
+{
+    struct app_state_stats st;
+
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* Hold the mutex while another thread asks for a snapshot. */
+    app_state_test_lock();
+    k_thread_create(&contender_thread, contender_stack, K_THREAD_STACK_SIZEOF(contender_stack),
+                    contender, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    k_msleep(20);
+    app_state_test_unlock();
+    zassert_equal(k_thread_join(&contender_thread, K_FOREVER), 0, NULL);
+
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].acquisitions, 1U, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].contended, 1U, NULL);
+    zassert_true(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].max_wait_cycles >= k_ms_to_cyc_floor32(10),
+                 "wait %u cycles", st.lock[APP_STATE_CALLER_GET_SNAPSHOT].max_wait_cycles);
+
+    /* A shorter wait does not lower the maximum. */
+    uint32_t max_wait = st.lock[APP_STATE_CALLER_GET_SNAPSHOT].max_wait_cycles;
+    app_state_test_lock();
+    k_thread_create(&contender_thread, contender_stack, K_THREAD_STACK_SIZEOF(contender_stack),
+                    contender, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    k_msleep(5);
+    app_state_test_unlock();
+    zassert_equal(k_thread_join(&contender_thread, K_FOREVER), 0, NULL);
+
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].contended, 2U, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].max_wait_cycles, max_wait, NULL);
+}
+
 ZTEST_SUITE(app_state, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,305 @@
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/settings/settings.h>
+
+#include "app_state.h"
+#include "checkpoint.h"
+#include "motor_cmd.h"
+#include "motor_control.h"
+
+/* Checkpoint names used by the tests, deleted before each one (the flash file persists). */
+static const char *const test_names[] = {"t_cold", "t_warm", "t_list", "t_sh", "t_boot", "t_bad",
+                                        "t_stale"};
+
+static const struct motor_control_config fast_loop = {.period_ms = 2};
+
+static struct motor_state snapshot(void)
+{
+    struct motor_state s;
+
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    return s;
+}
+
+static uint32_t samples(void)
+{
+    struct app_state_counters c;
+
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    return c.samples;
+}
+
+static void run_ticks(int n)
+{
+    for (int i = 0; i < n; i++) {
+        motor_control_run_once();
+    }
+}
+
+static const char *run_and_capture(const char *cmd, int expected_ret)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+    size_t size;
+
+    shell_backend_dummy_clear_output(sh);
+    zassert_equal(shell_execute_cmd(sh, cmd), expected_ret, "%s", cmd);
+
+    return shell_backend_dummy_get_output(sh, &size);
+}
+
+static void *suite_setup(void)
+{
+    zassert_equal(checkpoint_init(), 0, NULL);
+    return NULL;
+}
+
+static void before_each(void *fixture)
+{
+    ARG_UNUSED(fixture);
+
+    const struct motor_state cold = {.setpoint_rpm = 1500.0f, .temperature_c = 25.0f};
+    const struct app_state_counters zero = {0};
+
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_restore(&cold, &zero), 0, NULL);
+    motor_cmd_test_reset();
+    motor_control_init(&fast_loop);
+
+    for (size_t i = 0; i < ARRAY_SIZE(test_names); i++) {
+        (void)checkpoint_delete(test_names[i]);
+    }
+}
+
+static void after_each(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    motor_control_stop();
+}
+
+ZTEST(checkpoint, test_resume_continues_bit_exactly)
+{
+    struct checkpoint cp;
+
+    zassert_equal(app_state_set_setpoint(3000.0f), 0, NULL);
+    run_ticks(200);
+    checkpoint_capture(&cp, k_uptime_get());
+
+    run_ticks(100);
+    struct motor_state expected = snapshot();
+    uint32_t expected_samples = samples();
+
+    /* Rewind and replay the same 100 periods. */
+    zassert_equal(checkpoint_apply(&cp, k_uptime_get()), 0, NULL);
+    zassert_equal(samples(), cp.counters.samples, NULL);
+    zassert_true(snapshot().temperature_c == cp.state.temperature_c, NULL);
+
+    run_ticks(100);
+    struct motor_state replayed = snapshot();
+
+    zassert_mem_equal(&replayed, &expected, sizeof(expected), "warm start diverged");
+    zassert_equal(samples(), expected_samples, NULL);
+}
+
+ZTEST(checkpoint, test_resume_restores_gains_and_stops_tuner)
+{
+    const struct motor_pid_gains tuned = {.kp_pct = 150.0f, .ki_pct = 40.0f};
+    const struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    struct motor_control_tuning t;
+    struct checkpoint cp;
+
+    zassert_equal(motor_control_set_gains(&tuned), 0, NULL);
+    run_ticks(100);
+    checkpoint_capture(&cp, k_uptime_get());
+    zassert_mem_equal(&cp.control.gains, &tuned, sizeof(tuned), NULL);
+
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    run_ticks(3);
+    zassert_equal(checkpoint_apply(&cp, k_uptime_get()), 0, NULL);
+
+    motor_control_get_tuning(&t);
+    zassert_equal(t.status, MOTOR_PID_TUNE_IDLE, "experiment stopped");
+    zassert_mem_equal(&t.gains, &tuned, sizeof(tuned), NULL);
+}
+
+ZTEST(checkpoint, test_apply_rejects_foreign_checkpoints)
+{
+    struct checkpoint good;
+    struct checkpoint bad;
+
+    zassert_equal(app_state_set_setpoint(2000.0f), 0, NULL);
+    checkpoint_capture(&good, k_uptime_get());
+
+    bad = good;
+    bad.magic ^= 1U;
+    zassert_equal(checkpoint_apply(&bad, k_uptime_get()), -EINVAL, NULL);
+
+    bad = good;
+    bad.version++;
+    zassert_equal(checkpoint_apply(&bad, k_uptime_get()), -EINVAL, NULL);
+
+    bad = good;
+    bad.control.dc_model ^= 1U;
+    zassert_equal(checkpoint_apply(&bad, k_uptime_get()), -ENOTSUP, "other plant model");
+
+    bad = good;
+    bad.state.setpoint_rpm = APP_STATE_MAX_SETPOINT_RPM + 1.0f;
+    bad.state.temperature_c = 99.0f;
+    zassert_equal(checkpoint_apply(&bad, k_uptime_get()), -ERANGE, NULL);
+    zassert_true(snapshot().temperature_c == good.state.temperature_c, "nothing changed");
+}
+
+ZTEST(checkpoint, test_save_and_load_on_running_loop)
+{
+    struct checkpoint cold;
+    struct checkpoint warm;
+
+    motor_control_start();
+
+    zassert_equal(checkpoint_save("t_cold"), 0, NULL);
+    zassert_equal(motor_cmd_post_setpoint(3000.0f), 0, NULL);
+    k_msleep(300);
+    zassert_equal(checkpoint_save("t_warm"), 0, NULL);
+
+    zassert_equal(checkpoint_read("t_cold", &cold), 0, NULL);
+    zassert_equal(checkpoint_read("t_warm", &warm), 0, NULL);
+    zassert_true(cold.state.setpoint_rpm == 1500.0f, NULL);
+    zassert_true(warm.state.setpoint_rpm == 3000.0f, NULL);
+    zassert_true(warm.counters.samples > cold.counters.samples + 50U, "%u samples",
+                 warm.counters.samples);
+    zassert_true(warm.state.measured_rpm > cold.state.measured_rpm, NULL);
+
+    zassert_equal(checkpoint_load("t_cold"), 0, NULL);
+    zassert_true(snapshot().setpoint_rpm == 1500.0f, NULL);
+    zassert_true(samples() < warm.counters.samples, "counters rewound");
+}
+
+ZTEST(checkpoint, test_names_missing_and_deleted)
+{
+    struct checkpoint cp;
+
+    zassert_equal(checkpoint_save(""), -EINVAL, NULL);
+    zassert_equal(checkpoint_save("a/b"), -EINVAL, NULL);
+    zassert_equal(checkpoint_save("name_is_16_chars"), -EINVAL, NULL);
+    zassert_equal(checkpoint_load("t_list"), -ENOENT, NULL);
+    zassert_equal(checkpoint_read("t_list", &cp), -ENOENT, NULL);
+
+    /* Nothing drains the queue: the request times out instead of blocking. */
+    zassert_equal(checkpoint_save("t_list"), -EAGAIN, NULL);
+    zassert_equal(checkpoint_read("t_list", &cp), -ENOENT, "not stored");
+
+    motor_control_start();
+    zassert_equal(checkpoint_save("t_list"), 0, NULL);
+    zassert_equal(checkpoint_read("t_list", &cp), 0, NULL);
+    zassert_equal(cp.magic, CHECKPOINT_MAGIC, NULL);
+
+    zassert_equal(checkpoint_delete("t_list"), 0, NULL);
+    zassert_equal(checkpoint_read("t_list", &cp), -ENOENT, NULL);
+    zassert_equal(checkpoint_load("t_list"), -ENOENT, NULL);
+}
+
+static void count_name(const char *name, const struct checkpoint *cp, void *user)
+{
+    if ((strcmp(name, "t_list") == 0) && (cp != NULL)) {
+        (*(int *)user)++;
+    }
+}
+
+ZTEST(checkpoint, test_timed_out_load_never_applies)
+{
+    motor_control_start();
+    zassert_equal(checkpoint_save("t_stale"), 0, NULL);
+    motor_control_stop();
+
+    /* The load times out; its call stays queued and the setpoint moves on. */
+    zassert_equal(checkpoint_load("t_stale"), -EAGAIN, NULL);
+    zassert_equal(app_state_set_setpoint(2500.0f), 0, NULL);
+    run_ticks(1);
+    zassert_true(snapshot().setpoint_rpm == 2500.0f, "stale load ignored");
+
+    /* A stale capture left in the queue does not answer the next request. */
+    zassert_equal(checkpoint_save("t_stale"), -EAGAIN, NULL);
+    zassert_equal(app_state_set_setpoint(3500.0f), 0, NULL);
+    motor_control_start();
+    zassert_equal(checkpoint_save("t_stale"), 0, NULL);
+
+    struct checkpoint cp;
+
+    zassert_equal(checkpoint_read("t_stale", &cp), 0, NULL);
+    zassert_true(cp.state.setpoint_rpm == 3500.0f, NULL);
+}
+
+ZTEST(checkpoint, test_list)
+{
+    int found = 0;
+
+    motor_control_start();
+    zassert_equal(checkpoint_save("t_list"), 0, NULL);
+    zassert_equal(checkpoint_save("t_list"), 0, "replaced, not added");
+    zassert_true(checkpoint_list(count_name, &found) >= 1, NULL);
+    zassert_equal(found, 1, NULL);
+
+    found = 0;
+    zassert_equal(checkpoint_delete("t_list"), 0, NULL);
+    zassert_true(checkpoint_list(count_name, &found) >= 0, NULL);
+    zassert_equal(found, 0, NULL);
+}
+
+ZTEST(checkpoint, test_boot_checkpoint_resumed_by_init)
+{
+    struct checkpoint cp;
+
+    zassert_equal(app_state_set_setpoint(2800.0f), 0, NULL);
+    zassert_equal(app_state_update_feedback(2700.0f, 75.0f, 66.0f), 0, NULL);
+    checkpoint_capture(&cp, k_uptime_get());
+    zassert_equal(settings_save_one(CHECKPOINT_SETTINGS_SUBTREE "/t_boot", &cp, sizeof(cp)), 0,
+                  NULL);
+    zassert_equal(app_state_set_setpoint(100.0f), 0, NULL);
+
+    /* A missing boot checkpoint starts cold. */
+    checkpoint_test_set_boot_name("t_none");
+    zassert_equal(checkpoint_init(), 0, NULL);
+    zassert_true(snapshot().setpoint_rpm == 100.0f, NULL);
+
+    checkpoint_test_set_boot_name("t_boot");
+    zassert_equal(checkpoint_init(), 0, NULL);
+    checkpoint_test_set_boot_name("");
+
+    struct motor_state s = snapshot();
+    zassert_mem_equal(&s, &cp.state, sizeof(s), NULL);
+    zassert_equal(samples(), cp.counters.samples, NULL);
+}
+
+ZTEST(checkpoint, test_wrong_size_value_is_not_a_checkpoint)
+{
+    struct checkpoint cp;
+    const uint32_t junk = CHECKPOINT_MAGIC;
+
+    zassert_equal(settings_save_one(CHECKPOINT_SETTINGS_SUBTREE "/t_bad", &junk, sizeof(junk)), 0,
+                  NULL);
+    zassert_equal(checkpoint_read("t_bad", &cp), -EINVAL, NULL);
+    zassert_equal(checkpoint_load("t_bad"), -EINVAL, NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt list", 0), "t_bad (unreadable)"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt load t_bad", -EINVAL), "not resumed"),
+                     NULL);
+}
+
+ZTEST(checkpoint, test_shell_commands)
+{
+    motor_control_start();
+
+    zassert_not_null(strstr(run_and_capture("motor_ckpt save t_sh", 0), "saved"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt list", 0), "t_sh: SP=1500 rpm"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt load t_sh", 0), "resumed"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt load t_none", -ENOENT), "No checkpoint"),
+                     NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt save bad/name", -EINVAL), "not saved"),
+                     NULL);
+    zassert_not_null(strstr(run_and_capture("motor_ckpt rm t_sh", 0), "deleted"), NULL);
+}
+
+ZTEST_SUITE(checkpoint, NULL, suite_setup, before_each, after_each, NULL);
@@ -1,13 +1,31 @@
 #include <errno.h>
+#include <string.h>
 
 #include <zephyr/ztest.h>
 #include <zephyr/shell/shell.h>
 
 #include "app_state.h"
+#include "motor_cmd.h"
+#include "motor_control.h"
+#include "sample_pool.h"
+#include "trajectory.h"
+#include "wakeups.h"
 
 static void reset_state(void)
 {
     zassert_equal(app_state_init(), 0, NULL);
+    motor_cmd_test_reset();
+}
+
+static const char *run_and_capture(const char *cmd, int expected_ret)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+    size_t size;
+
+    shell_backend_dummy_clear_output(sh);
+    zassert_equal(shell_execute_cmd(sh, cmd), expected_ret, "%s", cmd);
+
+    return shell_backend_dummy_get_output(sh, &size);
 }
 
 ZTEST(console_shell, test_motor_set_valid)
@@ -17,11 +35,28 @@ ZTEST(console_shell, test_motor_set_valid)
     int ret = shell_execute_cmd(NULL, "motor_set 1234");
     zassert_equal(ret, 0, NULL);
 
+    /* Queued: the state only changes when the control loop drains it. */
     struct motor_state s;
     zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.setpoint_rpm == 1500.0f, NULL);
+
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
     zassert_true(s.setpoint_rpm == 1234.0f, NULL);
 }
 
+ZTEST(console_shell, test_motor_set_queue_full)
+{
+    reset_state();
+
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        zassert_equal(shell_execute_cmd(NULL, "motor_set 100"), 0, NULL);
+    }
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_set 100"), -ENOSPC, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile stop"), -ENOSPC, NULL);
+}
+
 ZTEST(console_shell, test_motor_set_out_of_range)
 {
     reset_state();
@@ -46,6 +81,39 @@ ZTEST(console_shell, test_motor_set_bad_arg)
     zassert_equal(ret, -EINVAL, NULL);
 }
 
+ZTEST(console_shell, test_motor_batch)
+{
+    struct app_state_counters c;
+    struct motor_state s;
+
+    reset_state();
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch"), -EINVAL, "needs a command");
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch 100 abc"), -EINVAL, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch 100 -1"), -ERANGE, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch 999999"), -ERANGE, NULL);
+    zassert_equal(motor_cmd_drain(), 0U, "nothing posted from an invalid batch");
+
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    uint32_t updates = c.setpoint_updates;
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch 900 stop 1100"), -EINVAL,
+                  "one setpoint per batch");
+    zassert_equal(motor_cmd_drain(), 0U, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch stop 1100 stop"), 0, NULL);
+    zassert_equal(motor_cmd_drain(), 3U, NULL);
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.setpoint_rpm == 1100.0f, NULL);
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    zassert_equal(c.setpoint_updates, updates + 1U, NULL);
+
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH - 1; i++) {
+        zassert_equal(shell_execute_cmd(NULL, "motor_set 100"), 0, NULL);
+    }
+    zassert_equal(shell_execute_cmd(NULL, "motor_batch stop 200"), -ENOSPC, NULL);
+}
+
 ZTEST(console_shell, test_motor_info_smoke)
 {
     reset_state();
@@ -68,4 +136,330 @@ ZTEST(console_shell, test_motor_set_extra_arg)
     zassert_equal(ret, -EINVAL, NULL);
 }
 
-ZTEST_SUITE(console_shell, NULL, NULL, NULL, NULL, NULL);
+/* Profile commands wait for the control loop, so these tests run one. */
+static void start_fast_loop(void)
+{
+    static const struct motor_control_config fast_loop = {.period_ms = 2};
+
+    reset_state();
+    trajectory_test_reset();
+    motor_control_init(&fast_loop);
+    motor_control_start();
+}
+
+ZTEST(console_shell, test_motor_profile_load_start_stop)
+{
+    start_fast_loop();
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start"), -ENODATA, NULL);
+
+    int ret = shell_execute_cmd(NULL, "motor_profile load ramp:3000:1000 step:3000:500 "
+                                      "sine:2000:2000:500:100:1000");
+    zassert_equal(ret, 0, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start 2"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile status"), 0, NULL);
+
+    struct trajectory_status st;
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true(st.active, NULL);
+    zassert_equal(st.segment_count, 3U, NULL);
+    zassert_equal(st.passes_left, 2U, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load step:100:100"), -EBUSY, NULL);
+
+    const char *out = run_and_capture("motor_profile stop", 0);
+    zassert_not_null(strstr(out, "Profile stopped"), "%s", out);
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_false(st.active, "stopped once the command returns");
+}
+
+ZTEST(console_shell, test_motor_profile_commands_apply_in_order)
+{
+    struct trajectory_status st;
+
+    start_fast_loop();
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load step:100:100"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start 0"), 0, NULL);
+
+    /* The stop has taken effect before the load is handed to the loop. */
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile stop"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load step:200:100"), 0, NULL);
+
+    /* No stale stop is left queued to end the restarted profile. */
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start 0"), 0, NULL);
+    k_msleep(20);
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true(st.active, NULL);
+
+    /* Started from the setpoint queued just before it. */
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile stop"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_set 700"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load ramp:900:60000"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start"), 0, NULL);
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true((st.setpoint_rpm >= 700.0f) && (st.setpoint_rpm < 710.0f), "%d rpm",
+                 (int)st.setpoint_rpm);
+}
+
+ZTEST(console_shell, test_motor_profile_without_loop)
+{
+    reset_state();
+    trajectory_test_reset();
+
+    const char *out = run_and_capture("motor_profile load step:100:100", -EAGAIN);
+    zassert_not_null(strstr(out, "not running"), "%s", out);
+
+    /* The dropped call does nothing when a loop drains it later. */
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start"), -EAGAIN, NULL);
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    struct trajectory_status st;
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_equal(st.segment_count, 0U, NULL);
+}
+
+ZTEST(console_shell, test_motor_profile_bad_args)
+{
+    start_fast_loop();
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load bogus:1:2"), -EINVAL, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load step:20000:100"), -EINVAL, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile load step:100:100"), 0, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start x"), -EINVAL, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_profile start -1"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_info_machine_formats)
+{
+    reset_state();
+    zassert_equal(app_state_update_feedback(1234.5f, 12.25f, 30.5f), 0, NULL);
+
+    const char *out = run_and_capture("motor_info csv", 0);
+    zassert_not_null(strstr(out, "state,1,"), "%s", out);
+    zassert_not_null(strstr(out, ",1234.500,12.250,30.500"), "%s", out);
+
+    out = run_and_capture("motor_info json", 0);
+    zassert_not_null(strstr(out, "\"type\":\"state\""), "%s", out);
+    zassert_not_null(strstr(out, "\"meas_rpm\":1234.500"), "%s", out);
+
+    out = run_and_capture("motor_info hex", 0);
+    /* SOF 0xa5, type 1 (state), 24-byte payload, seq 1 little-endian. */
+    zassert_not_null(strstr(out, ":a5011801000000"), "%s", out);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_info xml"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_dump_bulk_response)
+{
+    reset_state();
+    zassert_equal(app_state_set_setpoint(2000.0f), 0, NULL);
+    for (int i = 0; i < 3; i++) {
+        zassert_equal(app_state_update_feedback(100.0f * i, 5.0f, 25.0f), 0, NULL);
+    }
+
+    const char *out = run_and_capture("motor_dump", 0);
+    zassert_not_null(strstr(out, "state,3,"), "%s", out);
+    zassert_not_null(strstr(out, "counters,3,1,0"), "%s", out);
+    zassert_not_null(strstr(out, "hist,1,"), "%s", out);
+    zassert_not_null(strstr(out, "hist,3,"), "%s", out);
+    zassert_not_null(strstr(out, "end,5"), "%s", out);
+
+    out = run_and_capture("motor_dump json", 0);
+    zassert_not_null(strstr(out, "\"setpoint_updates\":1"), "%s", out);
+    zassert_not_null(strstr(out, "{\"type\":\"end\",\"records\":5}"), "%s", out);
+
+    out = run_and_capture("motor_dump hex", 0);
+    /* End frame: type 4, 4-byte payload, 5 records. */
+    zassert_not_null(strstr(out, ":a5040405000000"), "%s", out);
+
+    /* The dump printed the history in place and let go of it. */
+    struct sample_pool_stats ps;
+    sample_pool_get_stats(&ps);
+    zassert_equal(ps.in_use, 3U, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_dump text"), -EINVAL, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_dump yaml"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_mem_report)
+{
+    reset_state();
+
+    const char *out = run_and_capture("motor_mem", 0);
+    zassert_not_null(strstr(out, "history ring"), "%s", out);
+    zassert_not_null(strstr(out, "sample blocks"), "%s", out);
+    zassert_not_null(strstr(out, "Per motor: "), "%s", out);
+    zassert_not_null(strstr(out, "Stacks (used / size):"), "%s", out);
+    zassert_is_null(strstr(out, "Motors in"), "no budget given");
+
+    out = run_and_capture("motor_mem 1000000", 0);
+    zassert_not_null(strstr(out, "Motors in 1000000 B: "), "%s", out);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_mem -5"), -EINVAL, NULL);
+    zassert_equal(shell_execute_cmd(NULL, "motor_mem lots"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_stats_and_reset)
+{
+    reset_state();
+
+    const char *out = run_and_capture("motor_stats", 0);
+    zassert_not_null(strstr(out, "publish_errors: 0"), "%s", out);
+    zassert_not_null(strstr(out, "sample_overruns: "), "%s", out);
+    zassert_not_null(strstr(out, "sample_pool: 0/"), "%s", out);
+    zassert_not_null(strstr(out, "exhausted 0"), "%s", out);
+    zassert_not_null(strstr(out, "set_setpoint"), "%s", out);
+    zassert_not_null(strstr(out, "get_history"), "%s", out);
+
+    out = run_and_capture("motor_stats reset", 0);
+    zassert_not_null(strstr(out, "Statistics cleared"), "%s", out);
+
+    struct app_state_stats st;
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.lock[APP_STATE_CALLER_GET_SNAPSHOT].acquisitions, 0U, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_stats clear"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_wakeups_and_reset)
+{
+    wakeups_reset();
+    for (int i = 0; i < 20; i++) {
+        wakeups_count(WAKEUPS_CONTROL);
+    }
+    k_msleep(1000);
+
+    const char *out = run_and_capture("motor_wakeups", 0);
+    zassert_not_null(strstr(out, "window_ms: "), "%s", out);
+    zassert_not_null(strstr(out, "motor_ctrl"), "%s", out);
+    zassert_not_null(strstr(out, "fault_wq"), "%s", out);
+    zassert_not_null(strstr(out, " 20 "), "%s", out);
+
+    out = run_and_capture("motor_wakeups reset", 0);
+    zassert_not_null(strstr(out, "Wakeup counts cleared"), "%s", out);
+
+    struct wakeups_report rep;
+    wakeups_get(&rep);
+    zassert_equal(rep.count[WAKEUPS_CONTROL], 0U, NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_wakeups clear"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_lifetime)
+{
+    static const struct motor_control_config loop = MOTOR_CONTROL_CONFIG_DEFAULT;
+
+    reset_state();
+    motor_control_init(&loop);
+    for (int i = 0; i < 20; i++) {
+        motor_control_run_once();
+    }
+
+    const char *out = run_and_capture("motor_lifetime", 0);
+    zassert_not_null(strstr(out, "time: 1.000 s (20 periods)"), "%s", out);
+    zassert_not_null(strstr(out, "bands: normal 1.000 s, soft 0.000 s, hard 0.000 s"), "%s", out);
+    zassert_not_null(strstr(out, "energy: "), "%s", out);
+    zassert_not_null(strstr(out, "out_pct"), "%s", out);
+
+    out = run_and_capture("motor_lifetime csv", 0);
+    zassert_not_null(strstr(out, "lifetime,20,50,20,0,0,"), "%s", out);
+    zassert_not_null(strstr(out, "temp_hist,20,0,"), "%s", out);
+    zassert_not_null(strstr(out, "out_hist,"), "%s", out);
+    zassert_not_null(strstr(out, "end,3"), "%s", out);
+
+    out = run_and_capture("motor_lifetime json", 0);
+    zassert_not_null(strstr(out, "{\"type\":\"lifetime\",\"periods\":20,"), "%s", out);
+    zassert_not_null(strstr(out, "\"t120\":0}"), "%s", out);
+    zassert_not_null(strstr(out, "\"o90\":0}"), "%s", out);
+
+    out = run_and_capture("motor_lifetime hex", 0);
+    /* Type 6 (lifetime), 9 values, 20 periods; 11 and 10 bins; end with 3 records. */
+    zassert_not_null(strstr(out, ":a5062414000000"), "%s", out);
+    zassert_not_null(strstr(out, ":a5072c14000000"), "%s", out);
+    zassert_not_null(strstr(out, ":a50828"), "%s", out);
+    zassert_not_null(strstr(out, ":a5040403000000"), "%s", out);
+
+    out = run_and_capture("motor_lifetime reset", 0);
+    zassert_not_null(strstr(out, "Lifetime statistics cleared"), "%s", out);
+    zassert_not_null(strstr(run_and_capture("motor_lifetime", 0), "(0 periods)"), NULL);
+
+    zassert_equal(shell_execute_cmd(NULL, "motor_lifetime clear"), -EINVAL, NULL);
+}
+
+ZTEST(console_shell, test_motor_gains)
+{
+    static const struct motor_control_config loop = MOTOR_CONTROL_CONFIG_DEFAULT;
+    struct motor_control_tuning t;
+
+    reset_state();
+    motor_control_init(&loop);
+
+    zassert_not_null(strstr(run_and_capture("motor_gains", 0), "KP=0.000 KI=10.000 KD=0.000"),
+                     NULL);
+    zassert_not_null(strstr(run_and_capture("motor_gains 12.5 30 0", 0), "Gains set"), NULL);
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    motor_control_get_tuning(&t);
+    zassert_true((t.gains.kp_pct == 12.5f) && (t.gains.ki_pct == 30.0f), NULL);
+
+    run_and_capture("motor_gains 1 2", -EINVAL);
+    run_and_capture("motor_gains 1 -2 0", -EINVAL);
+    run_and_capture("motor_gains 1 x 0", -EINVAL);
+    zassert_not_null(strstr(run_and_capture("motor_gains 1 inf 0", -EINVAL), "finite"), NULL);
+
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        zassert_equal(shell_execute_cmd(NULL, "motor_set 100"), 0, NULL);
+    }
+    zassert_not_null(strstr(run_and_capture("motor_gains 1 2 0", -ENOSPC), "queue full"), NULL);
+
+    motor_control_init(&loop);
+}
+
+ZTEST(console_shell, test_motor_tune)
+{
+    static const struct motor_control_config loop = MOTOR_CONTROL_CONFIG_DEFAULT;
+
+    reset_state();
+    motor_control_init(&loop);
+
+    /* Settle at the 1500 rpm default setpoint first. */
+    for (int i = 0; i < 300; i++) {
+        motor_control_run_once();
+    }
+
+    zassert_not_null(strstr(run_and_capture("motor_tune status", 0), "idle"), NULL);
+    run_and_capture("motor_tune start x", -EINVAL);
+    run_and_capture("motor_tune start 10 -5", -EINVAL);
+    zassert_not_null(strstr(run_and_capture("motor_tune start 150", -EINVAL), "Cannot tune"),
+                     NULL);
+    zassert_not_null(strstr(run_and_capture("motor_tune start 10 50", 0), "started"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_tune start", -EBUSY), "already running"),
+                     NULL);
+    zassert_not_null(strstr(run_and_capture("motor_tune status", 0), "running"), NULL);
+
+    for (int i = 0; i < 200; i++) {
+        motor_control_run_once();
+    }
+    zassert_not_null(strstr(run_and_capture("motor_tune status", 0), "done, K="), NULL);
+
+    zassert_not_null(strstr(run_and_capture("motor_tune stop", 0), "stopped"), NULL);
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        zassert_equal(shell_execute_cmd(NULL, "motor_set 100"), 0, NULL);
+    }
+    zassert_not_null(strstr(run_and_capture("motor_tune start", -ENOSPC), "queue full"), NULL);
+    zassert_not_null(strstr(run_and_capture("motor_tune stop", -ENOSPC), "queue full"), NULL);
+
+    motor_cmd_test_reset();
+    motor_control_init(&loop);
+}
+
+static void console_shell_after(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    motor_control_stop();
+}
+
+ZTEST_SUITE(console_shell, NULL, NULL, NULL, console_shell_after, NULL);
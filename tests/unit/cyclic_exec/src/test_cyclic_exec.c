@@ -0,0 +1,119 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "cyclic_exec.h"
+#include "wakeups.h"
+
+#define EXEC_STACK_SIZE 2048
+
+K_THREAD_STACK_DEFINE(exec_stack, EXEC_STACK_SIZE);
+static struct k_thread exec_thread_data;
+
+static void exec_entry(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    cyclic_exec_run();
+}
+
+ZTEST(cyclic_exec, test_frames_run_slots_in_order_and_rate)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+
+    struct cyclic_exec_stats before;
+    cyclic_exec_get_stats(&before);
+
+    /* Align to a fault frame so the expected counts do not depend on test order. */
+    int64_t now_ms = 0;
+    while ((before.frames % CYCLIC_EXEC_FAULT_DIVIDER) != 0U) {
+        cyclic_exec_run_frame(now_ms);
+        now_ms += CYCLIC_EXEC_FRAME_MS;
+        cyclic_exec_get_stats(&before);
+    }
+    zassert_equal(app_state_init(), 0, NULL);
+
+    for (uint32_t i = 0; i <= CYCLIC_EXEC_FAULT_DIVIDER; i++) {
+        cyclic_exec_run_frame(now_ms);
+        now_ms += CYCLIC_EXEC_FRAME_MS;
+    }
+
+    struct cyclic_exec_stats after;
+    cyclic_exec_get_stats(&after);
+
+    uint32_t frames = CYCLIC_EXEC_FAULT_DIVIDER + 1U;
+    zassert_equal(after.frames - before.frames, frames, NULL);
+    zassert_equal(after.control_runs - before.control_runs, frames, NULL);
+    zassert_equal(after.telemetry_runs - before.telemetry_runs, frames, NULL);
+    zassert_equal(after.fault_runs - before.fault_runs, 2U, "first and 41st frame");
+
+    /* Every control slot published exactly one feedback sample. */
+    struct app_state_counters c;
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    zassert_equal(c.samples, frames, NULL);
+
+    struct motor_state s;
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.measured_rpm > 0.0f, "motor should spin up towards the default setpoint");
+}
+
+ZTEST(cyclic_exec, test_spin_up_reports_no_sample_overruns)
+{
+    struct app_state_stats st;
+    struct motor_state s;
+
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* Every frame of a spin-up moves the state beyond the deadband. */
+    for (int64_t now_ms = 0; now_ms < 100 * CYCLIC_EXEC_FRAME_MS; now_ms += CYCLIC_EXEC_FRAME_MS) {
+        cyclic_exec_run_frame(now_ms);
+    }
+
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    zassert_true(s.measured_rpm > 500.0f, "%d rpm", (int)s.measured_rpm);
+    zassert_equal(app_state_get_stats(&st), 0, NULL);
+    zassert_equal(st.sample_overruns, 0U, "telemetry runs in every frame, nothing is lost");
+}
+
+ZTEST(cyclic_exec, test_run_loop_keeps_frame_rate)
+{
+    struct cyclic_exec_stats before;
+    cyclic_exec_get_stats(&before);
+    wakeups_reset();
+
+    k_tid_t tid = k_thread_create(&exec_thread_data,
+                                  exec_stack,
+                                  K_THREAD_STACK_SIZEOF(exec_stack),
+                                  exec_entry,
+                                  NULL,
+                                  NULL,
+                                  NULL,
+                                  K_PRIO_PREEMPT(2),
+                                  0,
+                                  K_NO_WAIT);
+
+    k_msleep(10 * CYCLIC_EXEC_FRAME_MS + (CYCLIC_EXEC_FRAME_MS / 2));
+    k_thread_abort(tid);
+
+    struct cyclic_exec_stats after;
+    cyclic_exec_get_stats(&after);
+
+    /* Frames at t = 0, 50, ..., 500 ms. */
+    zassert_equal(after.frames - before.frames, 11U, NULL);
+    zassert_equal(after.overruns, before.overruns, NULL);
+
+    /*
+     * One wakeup per frame after the first, all on the executive: no other
+     * thread exists to wake.
+     */
+    struct wakeups_report rep;
+    wakeups_get(&rep);
+    zassert_equal(rep.count[WAKEUPS_MAIN], 10U, NULL);
+    zassert_equal(rep.count[WAKEUPS_CONTROL], 0U, NULL);
+    zassert_equal(rep.count[WAKEUPS_TELEMETRY], 0U, NULL);
+    zassert_equal(rep.count[WAKEUPS_FAULT], 0U, NULL);
+}
+
+ZTEST_SUITE(cyclic_exec, NULL, NULL, NULL, NULL, NULL);
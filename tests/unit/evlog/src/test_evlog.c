@@ -0,0 +1,213 @@
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+#include "app_state.h"
+#include "evlog.h"
+#include "fault_monitor.h"
+#include "motor_evlog.h"
+#include "telemetry.h"
+
+#define RING CONFIG_MOTOR_SIM_EVLOG_RECORDS
+
+static struct motor_evlog_record out[RING + 1];
+
+static const struct motor_state hot = {
+    .setpoint_rpm = 1500.0f,
+    .measured_rpm = 1849.9f,
+    .control_output_pct = 42.7f,
+    .temperature_c = 71.6f,
+};
+
+static struct evlog_stats stats(void)
+{
+    struct evlog_stats st;
+
+    evlog_get_stats(&st);
+    return st;
+}
+
+static const char *run_and_capture(const char *cmd, int expected_ret)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+    size_t size;
+
+    shell_backend_dummy_clear_output(sh);
+    zassert_equal(shell_execute_cmd(sh, cmd), expected_ret, "%s", cmd);
+
+    return shell_backend_dummy_get_output(sh, &size);
+}
+
+static void before_each(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    evlog_test_reset();
+}
+
+ZTEST(evlog, test_records_drain_in_order)
+{
+    struct motor_state s = hot;
+
+    for (int i = 0; i < 3; i++) {
+        s.measured_rpm = (float)i;
+        evlog_put(MOTOR_EVLOG_TELEMETRY, &s);
+    }
+    zassert_equal(stats().pending, 3U, NULL);
+
+    /* A short buffer takes the oldest first and leaves the rest. */
+    zassert_equal(evlog_drain(out, 2), 2U, NULL);
+    zassert_equal(evlog_drain(&out[2], ARRAY_SIZE(out) - 2U), 1U, NULL);
+    zassert_equal(evlog_drain(out, ARRAY_SIZE(out)), 0U, NULL);
+
+    for (uint32_t i = 0; i < 3U; i++) {
+        zassert_equal(out[i].id, MOTOR_EVLOG_TELEMETRY, NULL);
+        zassert_equal(out[i].seq, i, NULL);
+        zassert_true(out[i].state.measured_rpm == (float)i, NULL);
+        zassert_true(out[i].state.temperature_c == hot.temperature_c, NULL);
+        zassert_true(out[i].uptime_ms <= k_uptime_get_32(), NULL);
+    }
+
+    zassert_equal(stats().pending, 0U, NULL);
+    zassert_equal(stats().written, 3U, NULL);
+}
+
+ZTEST(evlog, test_full_ring_overwrites_the_oldest)
+{
+    for (int i = 0; i < RING + 5; i++) {
+        evlog_put(MOTOR_EVLOG_FAULT_SPEED, &hot);
+    }
+
+    struct evlog_stats st = stats();
+
+    zassert_equal(st.capacity, RING, NULL);
+    zassert_equal(st.pending, RING, NULL);
+    zassert_equal(st.written, RING + 5U, NULL);
+    zassert_equal(st.overwritten, 5U, NULL);
+
+    /* The lost records show as a gap before the oldest kept one. */
+    zassert_equal(evlog_drain(out, ARRAY_SIZE(out)), RING, NULL);
+    zassert_equal(out[0].seq, 5U, NULL);
+    zassert_equal(out[RING - 1].seq, RING + 4U, NULL);
+}
+
+ZTEST(evlog, test_records_render_the_original_text)
+{
+    static const struct {
+        enum motor_evlog_id id;
+        enum motor_evlog_level level;
+        const char *module;
+        const char *text;
+    } cases[] = {
+        {MOTOR_EVLOG_TELEMETRY, MOTOR_EVLOG_LEVEL_INF, "telemetry",
+         "T[telemetry] SP=1500 rpm, MEAS=1849 rpm, OUT=42%, T=71 C"},
+        {MOTOR_EVLOG_FAULT_SPEED, MOTOR_EVLOG_LEVEL_WRN, "fault_monitor",
+         "Fault(speed): |SP-MEAS|=349 rpm (OUT=42%, T=71 C)"},
+        {MOTOR_EVLOG_FAULT_TEMP_HARD, MOTOR_EVLOG_LEVEL_ERR, "fault_monitor",
+         "Fault(temp hard): T=71 C (OUT=42%, SP=1500 rpm)"},
+        {MOTOR_EVLOG_FAULT_TEMP_SOFT, MOTOR_EVLOG_LEVEL_WRN, "fault_monitor",
+         "Fault(temp soft): T=71 C (OUT=42%, SP=1500 rpm)"},
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+        const struct motor_evlog_record rec = {
+            .id = cases[i].id, .seq = 7U, .uptime_ms = 62345U, .state = hot};
+        struct motor_evlog_record got;
+        uint8_t buf[MOTOR_EVLOG_RECORD_LEN];
+        char text[MOTOR_EVLOG_TEXT_MAX];
+        const char *module;
+
+        motor_evlog_encode(buf, &rec);
+        zassert_equal(motor_evlog_decode(buf, sizeof(buf), &got), 0, NULL);
+        zassert_mem_equal(&got, &rec, sizeof(rec), NULL);
+
+        zassert_equal(motor_evlog_level(got.id, &module), cases[i].level, NULL);
+        zassert_str_equal(module, cases[i].module, NULL);
+        zassert_equal(motor_evlog_format(&got, text, sizeof(text)), strlen(cases[i].text), NULL);
+        zassert_str_equal(text, cases[i].text, NULL);
+    }
+}
+
+ZTEST(evlog, test_decode_rejects_bad_records)
+{
+    const struct motor_evlog_record rec = {.id = 99U};
+    struct motor_evlog_record got;
+    uint8_t buf[MOTOR_EVLOG_RECORD_LEN];
+    char text[MOTOR_EVLOG_TEXT_MAX];
+    const char *module;
+
+    motor_evlog_encode(buf, &rec);
+    zassert_equal(motor_evlog_decode(buf, sizeof(buf), &got), -EINVAL, NULL);
+    zassert_equal(motor_evlog_level(rec.id, &module), 0, NULL);
+    zassert_equal(motor_evlog_format(&rec, text, sizeof(text)), -EINVAL, NULL);
+
+    buf[0] = MOTOR_EVLOG_TELEMETRY;
+    zassert_equal(motor_evlog_decode(buf, sizeof(buf) - 1U, &got), -EINVAL, NULL);
+}
+
+ZTEST(evlog, test_telemetry_and_faults_are_recorded)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* Every 10th sample, as the text log did. */
+    for (int i = 0; i < 20; i++) {
+        telemetry_process_sample();
+    }
+    zassert_equal(stats().pending, 2U, NULL);
+
+    /* Speed and hard temperature fault in one check: two records, no soft one. */
+    const struct motor_state fault = {
+        .setpoint_rpm = 1500.0f,
+        .measured_rpm = 100.0f,
+        .control_output_pct = 100.0f,
+        .temperature_c = 95.0f,
+    };
+
+    fault_monitor_test_set_log_period_ms(0);
+    fault_monitor_test_set_last_log_ms(0);
+    (void)fault_monitor_test_process(&fault, 1);
+
+    zassert_equal(evlog_drain(out, ARRAY_SIZE(out)), 4U, NULL);
+    zassert_equal(out[0].id, MOTOR_EVLOG_TELEMETRY, NULL);
+    zassert_true(out[0].state.setpoint_rpm == 1500.0f, NULL);
+    zassert_equal(out[2].id, MOTOR_EVLOG_FAULT_SPEED, NULL);
+    zassert_equal(out[3].id, MOTOR_EVLOG_FAULT_TEMP_HARD, NULL);
+    zassert_true(out[3].state.temperature_c == 95.0f, NULL);
+
+    const struct motor_state warm = {.setpoint_rpm = 1500.0f,
+                                     .measured_rpm = 1500.0f,
+                                     .temperature_c = 65.0f};
+
+    (void)fault_monitor_test_process(&warm, 2);
+    zassert_equal(evlog_drain(out, ARRAY_SIZE(out)), 1U, NULL);
+    zassert_equal(out[0].id, MOTOR_EVLOG_FAULT_TEMP_SOFT, NULL);
+}
+
+ZTEST(evlog, test_shell_dump_and_stats)
+{
+    for (int i = 0; i < RING; i++) {
+        evlog_put(MOTOR_EVLOG_TELEMETRY, &hot);
+    }
+
+    zassert_not_null(strstr(run_and_capture("motor_evlog stats", 0),
+                            "evlog: 20/20 records pending, written 20, overwritten 0"),
+                     NULL);
+
+    /* One event frame (type 5, 28-byte payload) per record, then the end frame. */
+    const char *dump = run_and_capture("motor_evlog dump", 0);
+    size_t frames = 0;
+
+    for (const char *p = strstr(dump, ":a5051c"); p != NULL; p = strstr(p + 1, ":a5051c")) {
+        frames++;
+    }
+    zassert_equal(frames, RING, NULL);
+    zassert_not_null(strstr(dump, ":a50404140000"), "end frame with the record count");
+
+    zassert_equal(stats().pending, 0U, NULL);
+    zassert_not_null(strstr(run_and_capture("motor_evlog dump", 0), ":a50404000000"), NULL);
+}
+
+ZTEST_SUITE(evlog, NULL, NULL, before_each, NULL, NULL);
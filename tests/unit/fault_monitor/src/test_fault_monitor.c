@@ -148,4 +148,58 @@ ZTEST(fault_monitor, test_process_returns_when_rate_limited)
     zassert_true((flags & FAULT_SPEED_ERROR) != 0U, NULL);
 }
 
+ZTEST(fault_monitor, test_idle_only_two_deadbands_from_thresholds)
+{
+    struct motor_state s = {
+        .setpoint_rpm = 1000.0f,
+        .measured_rpm = 1000.0f,
+        .control_output_pct = 10.0f,
+        .temperature_c = 25.0f,
+    };
+
+    fault_monitor_test_set_log_period_ms(10000);
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_NONE, NULL);
+    zassert_true(fault_monitor_test_is_clear(), NULL);
+
+    /* No fault yet, but drift within the deadband could cross the soft limit. */
+    s.temperature_c = 59.9f;
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_NONE, NULL);
+    zassert_false(fault_monitor_test_is_clear(), NULL);
+
+    s.temperature_c = 59.5f;
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_NONE, NULL);
+    zassert_true(fault_monitor_test_is_clear(), NULL);
+
+    /* Same for the speed error, 1 rpm below the threshold. */
+    s.measured_rpm = 701.0f;
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_NONE, NULL);
+    zassert_false(fault_monitor_test_is_clear(), NULL);
+
+    s.measured_rpm = 1301.0f;
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_SPEED_ERROR, NULL);
+    zassert_false(fault_monitor_test_is_clear(), NULL);
+}
+
+ZTEST(fault_monitor, test_init_sets_log_period_and_clears_last_log)
+{
+    static const struct fault_monitor_config log_every_check = {.period_ms = 20U,
+                                                                 .log_period_ms = 0U};
+    static const struct fault_monitor_config app_cfg = FAULT_MONITOR_CONFIG_DEFAULT;
+    struct motor_state s = {
+        .setpoint_rpm = 0.0f,
+        .measured_rpm = 500.0f, /* faster than the setpoint: |diff| = 500 */
+        .control_output_pct = 50.0f,
+        .temperature_c = 25.0f,
+    };
+
+    fault_monitor_test_set_last_log_ms(5000);
+    fault_monitor_init(&log_every_check);
+    zassert_equal(fault_monitor_test_get_flags(), FAULT_NONE, "flags cleared");
+
+    zassert_equal(fault_monitor_test_process(&s, 1), FAULT_SPEED_ERROR, NULL);
+    zassert_equal(fault_monitor_test_get_flags(), FAULT_SPEED_ERROR, NULL);
+
+    fault_monitor_init(&app_cfg);
+}
+
 ZTEST_SUITE(fault_monitor, NULL, NULL, NULL, NULL, NULL);
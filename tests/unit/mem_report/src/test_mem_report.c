@@ -0,0 +1,110 @@
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "mem_report.h"
+#include "sample_pool.h"
+
+ZTEST(mem_report, test_budget_sums_items)
+{
+    const struct mem_report_item *items;
+    size_t count = mem_report_static_items(&items);
+    zassert_true(count > 0U, NULL);
+
+    size_t per_motor = 0;
+    size_t shared = 0;
+    bool found_history = false;
+    bool found_pool = false;
+
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].per_motor) {
+            per_motor += items[i].bytes;
+        } else {
+            shared += items[i].bytes;
+        }
+        if (strcmp(items[i].name, "history ring") == 0) {
+            found_history = true;
+            zassert_equal(items[i].bytes,
+                          sizeof(struct app_state_sample *) * APP_STATE_HISTORY_LEN,
+                          "history follows CONFIG_MOTOR_SIM_HISTORY_LEN");
+        }
+        if (strcmp(items[i].name, "sample blocks") == 0) {
+            found_pool = true;
+            zassert_true(items[i].per_motor, NULL);
+            zassert_equal(items[i].bytes,
+                          sizeof(struct sample_pool_block) *
+                              (APP_STATE_HISTORY_LEN + 1 + CONFIG_MOTOR_SIM_SAMPLE_POOL_SPARE),
+                          "one block per history entry, one being recorded and the spares");
+        }
+    }
+    zassert_true(found_history, NULL);
+    zassert_true(found_pool, NULL);
+
+    struct mem_report_budget b;
+    mem_report_get_budget(&b);
+    zassert_equal(b.per_motor_bytes, per_motor, NULL);
+    zassert_equal(b.shared_bytes, shared, NULL);
+    if (!IS_ENABLED(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)) {
+        zassert_true(b.per_motor_bytes >= CONFIG_MOTOR_SIM_CONTROL_STACK_SIZE, NULL);
+    }
+}
+
+ZTEST(mem_report, test_thread_stacks_follow_the_executive_mode)
+{
+    static const char *const modules[] = {"motor_control", "telemetry", "fault_monitor"};
+    const struct mem_report_item *items;
+    size_t count = mem_report_static_items(&items);
+    size_t stacks = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t m = 0; m < ARRAY_SIZE(modules); m++) {
+            if ((strcmp(items[i].module, modules[m]) == 0) &&
+                (strstr(items[i].name, "stack") != NULL)) {
+                stacks += items[i].bytes;
+            }
+        }
+    }
+
+    /* The cyclic executive runs all three on the main thread: their stacks are not built. */
+    zassert_equal(stacks,
+                  IS_ENABLED(CONFIG_MOTOR_SIM_CYCLIC_EXECUTIVE)
+                      ? 0U
+                      : (CONFIG_MOTOR_SIM_CONTROL_STACK_SIZE +
+                         CONFIG_MOTOR_SIM_TELEMETRY_STACK_SIZE +
+                         CONFIG_MOTOR_SIM_FAULT_WQ_STACK_SIZE),
+                  NULL);
+}
+
+ZTEST(mem_report, test_motors_for_budget)
+{
+    struct mem_report_budget b;
+    mem_report_get_budget(&b);
+
+    zassert_equal(mem_report_motors_for_budget(0), 0U, NULL);
+    zassert_equal(mem_report_motors_for_budget(b.shared_bytes), 0U, NULL);
+    zassert_equal(mem_report_motors_for_budget(b.shared_bytes + b.per_motor_bytes - 1U), 0U,
+                  NULL);
+    zassert_equal(mem_report_motors_for_budget(b.shared_bytes + (4U * b.per_motor_bytes)), 4U,
+                  NULL);
+}
+
+static size_t threads_seen;
+
+static void count_thread(const char *name, size_t size, size_t used, void *user_data)
+{
+    ARG_UNUSED(name);
+    zassert_equal(user_data, &threads_seen, NULL);
+    zassert_true(used <= size, NULL);
+    threads_seen++;
+}
+
+ZTEST(mem_report, test_threads_reports_stack_usage)
+{
+    threads_seen = 0;
+    zassert_equal(mem_report_threads(count_thread, &threads_seen), 0, NULL);
+
+    /* At least the ztest thread and the idle thread. */
+    zassert_true(threads_seen >= 2U, NULL);
+}
+
+ZTEST_SUITE(mem_report, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,283 @@
+#include <errno.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "motor_cmd.h"
+#include "trajectory.h"
+
+static float current_setpoint(void)
+{
+    struct motor_state s;
+
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    return s.setpoint_rpm;
+}
+
+ZTEST(motor_cmd, test_setpoint_applies_on_drain_in_order)
+{
+    zassert_equal(motor_cmd_drain(), 0U, "empty queue");
+
+    zassert_equal(motor_cmd_post_setpoint(1000.0f), 0, NULL);
+    zassert_equal(motor_cmd_post_setpoint(2000.0f), 0, NULL);
+    zassert_true(current_setpoint() == 1500.0f, "nothing applied before the drain");
+
+    zassert_equal(motor_cmd_drain(), 2U, NULL);
+    zassert_true(current_setpoint() == 2000.0f, "last posted wins");
+    zassert_equal(motor_cmd_drain(), 0U, NULL);
+}
+
+ZTEST(motor_cmd, test_setpoint_range_checked_at_post)
+{
+    struct motor_cmd_stats st;
+
+    zassert_equal(motor_cmd_post_setpoint(-1.0f), -ERANGE, NULL);
+    zassert_equal(motor_cmd_post_setpoint(APP_STATE_MAX_SETPOINT_RPM + 1.0f), -ERANGE, NULL);
+
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.posted, 0U, "rejected commands are not queued");
+}
+
+ZTEST(motor_cmd, test_full_queue_rejects_and_recovers)
+{
+    struct motor_cmd_stats st;
+
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        zassert_equal(motor_cmd_post_setpoint((float)i), 0, NULL);
+    }
+    zassert_equal(motor_cmd_post_setpoint(5.0f), -ENOSPC, NULL);
+
+    zassert_equal(motor_cmd_drain(), MOTOR_CMD_QUEUE_DEPTH, NULL);
+    zassert_true(current_setpoint() == (float)(MOTOR_CMD_QUEUE_DEPTH - 1), NULL);
+
+    /* Several laps around the ring keep working after a full queue. */
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH - 1; i++) {
+            zassert_equal(motor_cmd_post_setpoint((float)(lap * 100 + i)), 0, NULL);
+        }
+        zassert_equal(motor_cmd_drain(), MOTOR_CMD_QUEUE_DEPTH - 1, NULL);
+        zassert_true(current_setpoint() == (float)(lap * 100 + MOTOR_CMD_QUEUE_DEPTH - 2), NULL);
+    }
+
+    zassert_equal(motor_cmd_get_stats(NULL), -EINVAL, NULL);
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.posted, 4U * MOTOR_CMD_QUEUE_DEPTH - 3U, NULL);
+    zassert_equal(st.applied, st.posted, NULL);
+    zassert_equal(st.full, 1U, NULL);
+}
+
+ZTEST(motor_cmd, test_profile_stop_is_ordered_with_setpoints)
+{
+    struct trajectory_segment seg;
+    struct trajectory_status st;
+
+    zassert_equal(trajectory_parse_segment("step:800:1000", &seg), 0, NULL);
+    zassert_equal(trajectory_load(&seg, 1), 0, NULL);
+    zassert_equal(trajectory_start(0.0f, 1), 0, NULL);
+
+    const struct motor_cmd stop = {.type = MOTOR_CMD_PROFILE_STOP};
+    zassert_equal(motor_cmd_post(&stop), 0, NULL);
+    zassert_equal(motor_cmd_post_setpoint(300.0f), 0, NULL);
+
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true(st.active, "stop is deferred to the drain");
+
+    zassert_equal(motor_cmd_drain(), 2U, NULL);
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_false(st.active, NULL);
+    zassert_true(current_setpoint() == 300.0f, NULL);
+}
+
+static void record_setpoint(void *arg)
+{
+    *(float *)arg = current_setpoint();
+}
+
+ZTEST(motor_cmd, test_call_runs_in_order_on_drain)
+{
+    float seen = -1.0f;
+    const struct motor_cmd call = {.type = MOTOR_CMD_CALL, .fn = record_setpoint, .arg = &seen};
+
+    zassert_equal(motor_cmd_post_setpoint(700.0f), 0, NULL);
+    zassert_equal(motor_cmd_post(&call), 0, NULL);
+    zassert_equal(motor_cmd_post_setpoint(900.0f), 0, NULL);
+    zassert_true(seen == -1.0f, "call is deferred to the drain");
+
+    zassert_equal(motor_cmd_drain(), 3U, NULL);
+    zassert_true(seen == 700.0f, "call sees the commands posted before it only");
+    zassert_true(current_setpoint() == 900.0f, NULL);
+}
+
+static uint32_t setpoint_updates(void)
+{
+    struct app_state_counters c;
+
+    zassert_equal(app_state_get_counters(&c), 0, NULL);
+    return c.setpoint_updates;
+}
+
+ZTEST(motor_cmd, test_batch_applies_in_one_drain)
+{
+    struct trajectory_segment seg;
+    struct trajectory_status ts;
+    struct motor_cmd_stats st;
+    const struct motor_cmd batch[] = {
+        {.type = MOTOR_CMD_PROFILE_STOP},
+        {.type = MOTOR_CMD_SET_SETPOINT, .setpoint_rpm = 2500.0f},
+    };
+
+    zassert_equal(trajectory_parse_segment("step:800:1000", &seg), 0, NULL);
+    zassert_equal(trajectory_load(&seg, 1), 0, NULL);
+    zassert_equal(trajectory_start(0.0f, 1), 0, NULL);
+
+    uint32_t updates = setpoint_updates();
+
+    zassert_equal(motor_cmd_post_batch(batch, ARRAY_SIZE(batch)), 0, NULL);
+    zassert_equal(setpoint_updates(), updates, "nothing applied before the drain");
+
+    zassert_equal(motor_cmd_drain(), ARRAY_SIZE(batch), NULL);
+    zassert_true(current_setpoint() == 2500.0f, NULL);
+    zassert_equal(setpoint_updates(), updates + 1U, NULL);
+    zassert_equal(trajectory_get_status(&ts), 0, NULL);
+    zassert_false(ts.active, NULL);
+
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.posted, ARRAY_SIZE(batch), NULL);
+    zassert_equal(st.applied, ARRAY_SIZE(batch), NULL);
+    zassert_equal(st.batches, 1U, NULL);
+}
+
+ZTEST(motor_cmd, test_batch_call_sees_earlier_setpoint)
+{
+    float seen = -1.0f;
+    const struct motor_cmd batch[] = {
+        {.type = MOTOR_CMD_SET_SETPOINT, .setpoint_rpm = 600.0f},
+        {.type = MOTOR_CMD_CALL, .fn = record_setpoint, .arg = &seen},
+    };
+
+    zassert_equal(motor_cmd_post_batch(batch, ARRAY_SIZE(batch)), 0, NULL);
+    zassert_equal(motor_cmd_drain(), ARRAY_SIZE(batch), NULL);
+    zassert_true(seen == 600.0f, NULL);
+}
+
+ZTEST(motor_cmd, test_batch_rejects_a_second_setpoint)
+{
+    struct motor_cmd_stats st;
+    const struct motor_cmd batch[] = {
+        {.type = MOTOR_CMD_SET_SETPOINT, .setpoint_rpm = 100.0f},
+        {.type = MOTOR_CMD_PROFILE_STOP},
+        {.type = MOTOR_CMD_SET_SETPOINT, .setpoint_rpm = 200.0f},
+    };
+
+    zassert_equal(motor_cmd_post_batch(batch, ARRAY_SIZE(batch)), -EINVAL, NULL);
+    zassert_equal(motor_cmd_drain(), 0U, "nothing posted");
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.posted, 0U, NULL);
+}
+
+ZTEST(motor_cmd, test_batch_is_all_or_nothing)
+{
+    struct motor_cmd batch[MOTOR_CMD_QUEUE_DEPTH];
+    struct motor_cmd_stats st;
+
+    /* One setpoint last, after profile stops. */
+    for (int i = 0; i < MOTOR_CMD_QUEUE_DEPTH; i++) {
+        batch[i] = (struct motor_cmd){.type = MOTOR_CMD_PROFILE_STOP};
+    }
+    batch[MOTOR_CMD_QUEUE_DEPTH - 1] = (struct motor_cmd){
+        .type = MOTOR_CMD_SET_SETPOINT,
+        .setpoint_rpm = 700.0f,
+    };
+
+    zassert_equal(motor_cmd_post_batch(batch, 0), -EINVAL, NULL);
+    zassert_equal(motor_cmd_post_batch(batch, MOTOR_CMD_QUEUE_DEPTH + 1), -EINVAL, NULL);
+
+    zassert_equal(motor_cmd_post_setpoint(100.0f), 0, NULL);
+    zassert_equal(motor_cmd_post_batch(batch, MOTOR_CMD_QUEUE_DEPTH), -ENOSPC, NULL);
+    zassert_equal(motor_cmd_drain(), 1U, "nothing of the rejected batch was queued");
+
+    /* A batch wrapping around the end of the ring is still taken whole. */
+    zassert_equal(motor_cmd_post_batch(batch, MOTOR_CMD_QUEUE_DEPTH), 0, NULL);
+    zassert_equal(motor_cmd_drain(), MOTOR_CMD_QUEUE_DEPTH, NULL);
+    zassert_true(current_setpoint() == 700.0f, NULL);
+
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.full, 1U, NULL);
+    zassert_equal(st.batches, 1U, NULL);
+    zassert_equal(st.posted, MOTOR_CMD_QUEUE_DEPTH + 1U, NULL);
+}
+
+#define PRODUCERS          3
+#define POSTS_PER_PRODUCER 200
+#define PRODUCER_STACK     1024
+
+K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, PRODUCERS, PRODUCER_STACK);
+static struct k_thread producer_threads[PRODUCERS];
+
+static void producer(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    int id = POINTER_TO_INT(p1);
+
+    for (int i = 0; i < POSTS_PER_PRODUCER; i++) {
+        /* Encode producer and sequence so the consumer can check ordering. */
+        float rpm = (float)(id * 1000 + i);
+
+        /* Sleep (not yield) when full so the consumer's timeout can expire. */
+        while (motor_cmd_post_setpoint(rpm) == -ENOSPC) {
+            k_msleep(1);
+        }
+        if ((i % 8) == 0) {
+            k_yield();
+        }
+    }
+}
+
+ZTEST(motor_cmd, test_concurrent_producers_lose_nothing)
+{
+    for (int p = 0; p < PRODUCERS; p++) {
+        k_thread_create(&producer_threads[p], producer_stacks[p],
+                        K_THREAD_STACK_SIZEOF(producer_stacks[p]), producer, INT_TO_POINTER(p),
+                        NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    }
+
+    /* Act as the control loop: drain until every producer is done. */
+    int last[PRODUCERS] = {-1, -1, -1};
+    size_t total = 0;
+
+    while (total < PRODUCERS * POSTS_PER_PRODUCER) {
+        size_t n = motor_cmd_drain();
+
+        if (n != 0) {
+            /* The last applied command of this batch must follow its producer's order. */
+            int v = (int)current_setpoint();
+            int id = v / 1000;
+
+            zassert_true(id < PRODUCERS, "value %d", v);
+            zassert_true((v % 1000) > last[id], "producer %d went back to %d", id, v % 1000);
+            last[id] = v % 1000;
+        }
+        total += n;
+        k_msleep(1);
+    }
+
+    for (int p = 0; p < PRODUCERS; p++) {
+        zassert_equal(k_thread_join(&producer_threads[p], K_FOREVER), 0, NULL);
+    }
+
+    struct motor_cmd_stats st;
+    zassert_equal(motor_cmd_get_stats(&st), 0, NULL);
+    zassert_equal(st.applied, PRODUCERS * POSTS_PER_PRODUCER, NULL);
+    zassert_equal(st.posted, st.applied, NULL);
+}
+
+static void motor_cmd_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    zassert_equal(app_state_init(), 0, NULL);
+    motor_cmd_test_reset();
+    trajectory_test_reset();
+}
+
+ZTEST_SUITE(motor_cmd, NULL, NULL, motor_cmd_before, NULL, NULL);
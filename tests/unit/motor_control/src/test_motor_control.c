@@ -1,14 +1,27 @@
+#include <errno.h>
 #include <math.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 
 #include "app_state.h"
+#include "motor_cmd.h"
 #include "motor_control.h"
+#include "motor_model.h"
 
 static void assert_float_near(float a, float b, float eps, const char *msg)
 {
     zassert_true(fabsf(a - b) <= eps, "%s (a=%f b=%f)", msg, (double)a, (double)b);
 }
 
+/* One period of a motor with a freshly initialized controller. */
+static void step_fresh(struct motor_state *s)
+{
+    struct motor_control_ctx ctx;
+
+    motor_control_ctx_init(&ctx);
+    motor_control_step(&ctx, s, 0U);
+}
+
 ZTEST(motor_control, test_step_increases_output_and_speed)
 {
     struct motor_state s = {
@@ -18,7 +31,7 @@ ZTEST(motor_control, test_step_increases_output_and_speed)
         .temperature_c = 25.0f,
     };
 
-    motor_control_step(&s);
+    step_fresh(&s);
 
     /* Con KP_PERCENT=10 y error/MOTOR_MAX_RPM=1.0 => +10% */
     assert_float_near(s.control_output_pct, 3.0f, 0.01f, "control output step");
@@ -34,7 +47,7 @@ ZTEST(motor_control, test_output_clamps_0_to_100)
         .control_output_pct = 1.0f,
         .temperature_c = 25.0f,
     };
-    motor_control_step(&s1);
+    step_fresh(&s1);
     zassert_true(s1.control_output_pct >= 0.0f, NULL);
 
     struct motor_state s2 = {
@@ -43,7 +56,7 @@ ZTEST(motor_control, test_output_clamps_0_to_100)
         .control_output_pct = 99.0f,
         .temperature_c = 25.0f,
     };
-    motor_control_step(&s2);
+    step_fresh(&s2);
     zassert_true(s2.control_output_pct <= 100.0f, NULL);
 }
 
@@ -55,7 +68,7 @@ ZTEST(motor_control, test_temperature_clamps_ambient_and_max)
         .control_output_pct = 0.0f,
         .temperature_c = 0.0f,
     };
-    motor_control_step(&low);
+    step_fresh(&low);
     assert_float_near(low.temperature_c, 25.0f, 0.01f, "ambient clamp");
 
     struct motor_state high = {
@@ -64,7 +77,7 @@ ZTEST(motor_control, test_temperature_clamps_ambient_and_max)
         .control_output_pct = 0.0f,
         .temperature_c = 200.0f,
     };
-    motor_control_step(&high);
+    step_fresh(&high);
     /* MAX_TEMP_C in this project is 130. */
     assert_float_near(high.temperature_c, 130.0f, 0.01f, "max clamp");
 }
@@ -77,7 +90,7 @@ ZTEST(motor_control, test_soft_and_hard_temp_saturation)
         .control_output_pct = 90.0f,
         .temperature_c = 90.0f,
     };
-    motor_control_step(&soft);
+    step_fresh(&soft);
     assert_float_near(soft.control_output_pct, 60.0f, 0.01f, "soft saturation");
 
     struct motor_state hard = {
@@ -86,7 +99,7 @@ ZTEST(motor_control, test_soft_and_hard_temp_saturation)
         .control_output_pct = 90.0f,
         .temperature_c = 110.0f,
     };
-    motor_control_step(&hard);
+    step_fresh(&hard);
     assert_float_near(hard.control_output_pct, 10.0f, 0.01f, "hard saturation");
 }
 
@@ -99,10 +112,449 @@ ZTEST(motor_control, test_negative_measured_rpm_branch)
         .temperature_c = 25.0f,
     };
 
-    motor_control_step(&s);
+    step_fresh(&s);
 
     /* We dont seek exact values, just execute the branch and stay healthy */
     zassert_true(s.temperature_c >= 25.0f, NULL);
 }
 
+/* Speed held at temp_norm_rpm: full heating, no change from the speed loop. */
+static const struct motor_state hot_cruise = {
+    .setpoint_rpm = 4000.0f,
+    .measured_rpm = 4000.0f,
+    .control_output_pct = 40.0f,
+    .temperature_c = 40.0f,
+};
+
+ZTEST(motor_control, test_multirate_divider_one_matches_single_rate)
+{
+    const struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_state ref = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+    struct motor_state mr0 = ref;
+    struct motor_state mr1 = ref;
+
+    for (uint32_t i = 0; i < 200; i++) {
+        motor_model_step(&p, &ref);
+        motor_model_step_multirate(&p, &mr0, i, 0);
+        motor_model_step_multirate(&p, &mr1, i, 1);
+    }
+
+    zassert_mem_equal(&ref, &mr0, sizeof(ref), NULL);
+    zassert_mem_equal(&ref, &mr1, sizeof(ref), NULL);
+}
+
+ZTEST(motor_control, test_multirate_thermal_update_is_exact_at_constant_speed)
+{
+    const struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_state ref = hot_cruise;
+    struct motor_state mr = hot_cruise;
+
+    for (uint32_t i = 0; i < 10; i++) {
+        motor_model_step(&p, &ref);
+    }
+
+    /* Step 0 advances the thermal model by all 10 periods at once. */
+    motor_model_step_multirate(&p, &mr, 0, 10);
+    float after_update = mr.temperature_c;
+
+    for (uint32_t i = 1; i < 10; i++) {
+        motor_model_step_multirate(&p, &mr, i, 10);
+        zassert_true(mr.temperature_c == after_update, "no thermal update off the sub-rate");
+    }
+
+    assert_float_near(mr.temperature_c, ref.temperature_c, 1e-3f, "10 periods at once");
+    assert_float_near(mr.measured_rpm, ref.measured_rpm, 1e-3f, "speed loop unaffected");
+}
+
+ZTEST(motor_control, test_multirate_without_cooling_and_limits_every_step)
+{
+    struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_state s = hot_cruise;
+
+    p.cool_gain = 0.0f;
+    motor_model_step_multirate(&p, &s, 0, 10);
+    assert_float_near(s.temperature_c, 40.0f + 10.0f * p.heat_gain, 1e-3f, "pure heating");
+
+    /* Off a thermal step, the output limits still follow the temperature. */
+    struct motor_state soft = {
+        .setpoint_rpm = 9000.0f,
+        .measured_rpm = 9000.0f,
+        .control_output_pct = 90.0f,
+        .temperature_c = 90.0f,
+    };
+    motor_model_step_multirate(&p, &soft, 3, 10);
+    zassert_true(soft.temperature_c == 90.0f, NULL);
+    assert_float_near(soft.control_output_pct, 60.0f, 0.01f, "soft limit off the sub-rate");
+}
+
+#define DISC_PERIOD_S 0.05f
+
+ZTEST(motor_control, test_disc_prepare_rejects_invalid)
+{
+    const struct motor_model_params nominal = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_model_params p = nominal;
+    struct motor_model_disc_coeffs c;
+
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH, 1.0f, &c), 0,
+                  NULL);
+    zassert_equal(c.substeps, 20U, NULL);
+
+    zassert_equal(motor_model_disc_prepare(&p, 0.0f, MOTOR_MODEL_DISC_ZOH, 1.0f, &c), -EINVAL,
+                  NULL);
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH, 0.0f, &c),
+                  -EINVAL, NULL);
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, (enum motor_model_disc)7, 1.0f, &c),
+                  -EINVAL, NULL);
+
+    p.speed_filter_alpha = 1.0f;
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_EXP, 1.0f, &c),
+                  -EINVAL, NULL);
+    p = nominal;
+    p.cool_gain = 0.0f;
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_EXP, 1.0f, &c),
+                  -EINVAL, NULL);
+
+    /* Gain so high the speed loop flips sign every period: no continuous equivalent. */
+    p = nominal;
+    p.kp_percent = 10000.0f;
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH, 1.0f, &c),
+                  -EINVAL, NULL);
+}
+
+ZTEST(motor_control, test_disc_one_period_matches_step)
+{
+    const struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_model_disc_coeffs exp_c;
+    struct motor_model_disc_coeffs zoh_c;
+    struct motor_state ref = {.setpoint_rpm = 6000.0f, .temperature_c = 25.0f};
+    struct motor_state e = ref;
+    struct motor_state z = ref;
+
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_EXP,
+                                           DISC_PERIOD_S, &exp_c),
+                  0, NULL);
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH,
+                                           DISC_PERIOD_S, &zoh_c),
+                  0, NULL);
+
+    /* Up, then down hard enough to saturate the output at 0. */
+    for (uint32_t i = 0; i < 400; i++) {
+        float sp = (i < 200U) ? 6000.0f : 500.0f;
+
+        ref.setpoint_rpm = sp;
+        e.setpoint_rpm = sp;
+        z.setpoint_rpm = sp;
+        motor_model_step(&p, &ref);
+        motor_model_step_dt(&p, &exp_c, &e);
+        motor_model_step_dt(&p, &zoh_c, &z);
+
+        zassert_true(fabsf(e.measured_rpm - ref.measured_rpm) < 0.05f, "exp step %u", i);
+        zassert_true(fabsf(z.measured_rpm - ref.measured_rpm) < 0.05f, "zoh step %u", i);
+        zassert_true(fabsf(z.temperature_c - ref.temperature_c) < 1e-3f, "zoh temp %u", i);
+    }
+}
+
+static void disc_compare(const struct motor_model_params *p, struct motor_state start,
+                         float dt_s, uint32_t steps, float rpm_tol, float temp_tol)
+{
+    struct motor_model_disc_coeffs c;
+    uint32_t periods = (uint32_t)lroundf(dt_s / DISC_PERIOD_S);
+    struct motor_state ref = start;
+    struct motor_state z = start;
+
+    zassert_equal(motor_model_disc_prepare(p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH, dt_s, &c), 0,
+                  NULL);
+
+    for (uint32_t i = 0; i < steps; i++) {
+        for (uint32_t j = 0; j < periods; j++) {
+            motor_model_step(p, &ref);
+        }
+        motor_model_step_dt(p, &c, &z);
+
+        zassert_true(fabsf(z.measured_rpm - ref.measured_rpm) <= rpm_tol, "step %u: %f vs %f", i,
+                     (double)z.measured_rpm, (double)ref.measured_rpm);
+        zassert_true(fabsf(z.temperature_c - ref.temperature_c) <= temp_tol, "step %u: %f vs %f",
+                     i, (double)z.temperature_c, (double)ref.temperature_c);
+    }
+}
+
+ZTEST(motor_control, test_disc_zoh_tracks_reference_at_large_steps)
+{
+    struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    const struct motor_state rest = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+
+    /* Oscillatory loop (complex eigenvalues), 1 s steps. */
+    disc_compare(&p, rest, 1.0f, 60, 0.5f, 5.0f);
+
+    /* Heating above the soft limit: the output limits engage, per-period fallback. */
+    p.heat_gain = 3.0f;
+    struct motor_state hot = hot_cruise;
+    hot.temperature_c = 85.0f;
+    disc_compare(&p, hot, 0.5f, 60, 0.5f, 0.01f);
+
+    /* No speed feedback: real eigenvalues, output held at 30%. */
+    p = (struct motor_model_params)MOTOR_MODEL_PARAMS_DEFAULT;
+    p.kp_percent = 0.0f;
+    struct motor_state open_loop = rest;
+    open_loop.control_output_pct = 30.0f;
+    disc_compare(&p, open_loop, 0.25f, 40, 0.5f, 1.0f);
+}
+
+ZTEST(motor_control, test_disc_zoh_stable_for_very_large_steps)
+{
+    const struct motor_model_params p = MOTOR_MODEL_PARAMS_DEFAULT;
+    struct motor_model_disc_coeffs c;
+    struct motor_state s = {.setpoint_rpm = 5000.0f, .temperature_c = 25.0f};
+
+    /* One-minute steps: the per-period recurrence with scaled gains would diverge. */
+    zassert_equal(motor_model_disc_prepare(&p, DISC_PERIOD_S, MOTOR_MODEL_DISC_ZOH, 60.0f, &c), 0,
+                  NULL);
+    for (uint32_t i = 0; i < 10; i++) {
+        motor_model_step_dt(&p, &c, &s);
+        zassert_true(isfinite(s.measured_rpm), NULL);
+    }
+
+    assert_float_near(s.measured_rpm, 5000.0f, 0.5f, "settled on the setpoint");
+    assert_float_near(s.control_output_pct, 50.0f, 0.01f, "steady-state output");
+    assert_float_near(s.temperature_c, 25.0f + p.heat_gain / p.cool_gain, 0.01f,
+                      "thermal equilibrium at full heating");
+}
+
+#if defined(CONFIG_MOTOR_SIM_DC_MODEL)
+ZTEST(motor_control, test_dc_model_tracks_setpoint)
+{
+    struct motor_state s = {
+        .setpoint_rpm = 3000.0f,
+        .measured_rpm = 0.0f,
+        .control_output_pct = 0.0f,
+        .temperature_c = 25.0f,
+    };
+
+    /* 10 s of control periods: the cascaded loop settles like the first-order model. */
+    struct motor_control_ctx ctx;
+
+    motor_control_ctx_init(&ctx);
+    for (uint32_t i = 0; i < 200; i++) {
+        motor_control_step(&ctx, &s, i);
+    }
+
+    assert_float_near(s.measured_rpm, 3000.0f, 5.0f, "DC model settles on the setpoint");
+    assert_float_near(s.control_output_pct, 30.0f, 0.5f, "3 A of 10 A at 3000 rpm");
+}
+#endif
+
+static const struct motor_control_config test_loop = MOTOR_CONTROL_CONFIG_DEFAULT;
+
+/* Fresh state, queue and controller, settled at @p rpm with the default gains. */
+static void loop_settled_at(float rpm)
+{
+    zassert_equal(app_state_init(), 0, NULL);
+    motor_cmd_test_reset();
+    motor_control_init(&test_loop);
+    zassert_equal(app_state_set_setpoint(rpm), 0, NULL);
+
+    for (int i = 0; i < 300; i++) {
+        motor_control_run_once();
+    }
+}
+
+static enum motor_pid_tune_status tune_status(void)
+{
+    struct motor_control_tuning t;
+
+    motor_control_get_tuning(&t);
+    return t.status;
+}
+
+static bool gains_are(const struct motor_pid_gains *g)
+{
+    struct motor_control_tuning t;
+
+    motor_control_get_tuning(&t);
+    return memcmp(&t.gains, g, sizeof(*g)) == 0;
+}
+
+/* Control loop ticks until the auto-tuner has finished. */
+static enum motor_pid_tune_status run_until_tuned(void)
+{
+    for (int i = 0; (i < 500) && (tune_status() == MOTOR_PID_TUNE_RUNNING); i++) {
+        motor_control_run_once();
+    }
+
+    return tune_status();
+}
+
+ZTEST(motor_control, test_runtime_gains_applied_at_next_tick)
+{
+    const struct motor_pid_gains defaults = MOTOR_PID_GAINS_DEFAULT;
+    const struct motor_pid_gains pi = {.kp_pct = 5.0f, .ki_pct = 20.0f};
+    struct motor_pid_gains bad = pi;
+
+    loop_settled_at(0.0f);
+    zassert_true(gains_are(&defaults), NULL);
+
+    bad.kd_pct = -1.0f;
+    zassert_equal(motor_control_set_gains(&bad), -EINVAL, NULL);
+    bad.kd_pct = NAN;
+    zassert_equal(motor_control_set_gains(&bad), -EINVAL, NULL);
+    bad.kd_pct = INFINITY;
+    zassert_equal(motor_control_set_gains(&bad), -EINVAL, NULL);
+
+    zassert_equal(motor_control_set_gains(&pi), 0, NULL);
+    zassert_true(gains_are(&defaults), "not before the tick");
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    zassert_true(gains_are(&pi), NULL);
+
+    /* Error from 0 to 3000 rpm: 20% x 0.3 (integral) + 5% x 0.3 (error change). */
+    struct motor_state s = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+
+    motor_control_step(motor_control_test_get_ctx(), &s, 0U);
+    assert_float_near(s.control_output_pct, 7.5f, 0.01f, "new gains in use");
+
+    motor_control_init(&test_loop);
+    zassert_true(gains_are(&defaults), "init restores defaults");
+}
+
+ZTEST(motor_control, test_lifetime_counts_every_period)
+{
+    struct motor_lifetime lt;
+    struct motor_state s;
+
+    loop_settled_at(1500.0f);
+    motor_control_get_lifetime(&lt);
+    zassert_equal(lt.periods, 300U, NULL);
+    zassert_equal(lt.band_periods[MOTOR_LIFETIME_BAND_NORMAL], 300U, NULL);
+    zassert_equal(lt.setpoint_changes, 0U, NULL);
+    zassert_true(lt.energy_mj > 0, NULL);
+
+    motor_control_reset_lifetime();
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    step_fresh(&s);
+    motor_control_get_lifetime(&lt);
+    zassert_equal(lt.periods, 0U, "bare steps are not accounted, only loop periods");
+
+    zassert_equal(app_state_set_setpoint(3000.0f), 0, NULL);
+    motor_control_run_once();
+    zassert_equal(app_state_set_setpoint(2000.0f), 0, NULL);
+    motor_control_run_once();
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+
+    motor_control_get_lifetime(&lt);
+    zassert_equal(lt.periods, 2U, NULL);
+    zassert_equal(lt.setpoint_changes, 1U, "the first period after a reset is not a change");
+    zassert_equal(lt.temp_hist[(uint32_t)((s.temperature_c - 20.0f) / 10.0f)], 2U,
+                  "two periods at the temperature of a warm motor");
+
+#if !defined(CONFIG_MOTOR_SIM_DC_MODEL)
+    /* Without an electrical model, the rated power scaled by the output. */
+    motor_control_reset_lifetime();
+    motor_control_run_once();
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    motor_control_get_lifetime(&lt);
+    zassert_equal(lt.energy_mj,
+                  (int64_t)(MOTOR_LIFETIME_RATED_POWER_W * (s.control_output_pct / 100.0f) *
+                            (float)MOTOR_CONTROL_PERIOD_MS),
+                  NULL);
+#endif
+
+    motor_control_init(&test_loop);
+    motor_control_get_lifetime(&lt);
+    zassert_equal(lt.periods, 0U, "init clears the statistics");
+}
+
+ZTEST(motor_control, test_auto_tune_settles_faster)
+{
+    loop_settled_at(1500.0f);
+
+    const struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_RUNNING, "reported at once");
+    zassert_equal(motor_control_tune_start(&cfg), -EBUSY, NULL);
+    zassert_equal(run_until_tuned(), MOTOR_PID_TUNE_DONE, NULL);
+
+    struct motor_control_tuning t;
+
+    motor_control_get_tuning(&t);
+
+    zassert_within(t.ident.gain_rpm_per_pct, 100.0f, 5.0f, NULL);
+    zassert_true(t.gains.kp_pct > 0.0f, NULL);
+
+    /* Step to 3000 rpm: within 2% after 20 periods (the default gains need 38). */
+    zassert_equal(app_state_set_setpoint(3000.0f), 0, NULL);
+    for (int i = 0; i < 20; i++) {
+        motor_control_run_once();
+    }
+
+    struct motor_state s;
+
+    zassert_equal(app_state_get_snapshot(&s), 0, NULL);
+    assert_float_near(s.measured_rpm, 3000.0f, 60.0f, "settled");
+
+    /* Another run is allowed once finished. */
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    zassert_equal(motor_control_tune_stop(), 0, NULL);
+    motor_control_run_once();
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_IDLE, NULL);
+    zassert_true(gains_are(&t.gains), "kept on stop");
+
+    motor_control_init(&test_loop);
+}
+
+ZTEST(motor_control, test_auto_tune_stop_and_failures)
+{
+    struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    const struct motor_pid_gains defaults = MOTOR_PID_GAINS_DEFAULT;
+
+    /* Stopped motor: no operating point for the relay. */
+    loop_settled_at(0.0f);
+    zassert_equal(motor_control_tune_start(&cfg), -EINVAL, NULL);
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_IDLE, NULL);
+
+    /* Stopped mid-way: the gains stay. */
+    loop_settled_at(1500.0f);
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    for (int i = 0; i < 5; i++) {
+        motor_control_run_once();
+    }
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_RUNNING, NULL);
+    zassert_equal(motor_control_tune_stop(), 0, NULL);
+    motor_control_run_once();
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_IDLE, NULL);
+    zassert_true(gains_are(&defaults), NULL);
+
+    /* No limit cycle in time. */
+    cfg.max_periods = 5U;
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    zassert_equal(run_until_tuned(), MOTOR_PID_TUNE_FAILED, NULL);
+    zassert_true(gains_are(&defaults), NULL);
+
+    /* The operating point is gone by the time the loop starts the experiment. */
+    cfg.max_periods = 400U;
+    zassert_equal(motor_control_tune_start(&cfg), 0, NULL);
+    zassert_equal(motor_cmd_drain(), 1U, NULL);
+    struct motor_state s = {.setpoint_rpm = 1500.0f, .temperature_c = 25.0f};
+    struct motor_control_ctx *ctx = motor_control_test_get_ctx();
+
+    motor_control_step(ctx, &s, 0U);
+    zassert_equal(ctx->tuner.status, MOTOR_PID_TUNE_FAILED, NULL);
+    zassert_true(ctx->tuning_changed, NULL);
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_RUNNING, "published by the loop, not the step");
+    motor_control_run_once();
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_FAILED, NULL);
+
+    /* A full queue rejects the request and leaves the state as it was. */
+    const struct motor_cmd stop = {.type = MOTOR_CMD_PROFILE_STOP};
+
+    while (motor_cmd_post(&stop) == 0) {
+    }
+    zassert_equal(motor_control_tune_start(&cfg), -ENOSPC, NULL);
+    zassert_equal(tune_status(), MOTOR_PID_TUNE_FAILED, NULL);
+    zassert_equal(motor_control_set_gains(&defaults), -ENOSPC, NULL);
+    zassert_equal(motor_control_tune_stop(), -ENOSPC, NULL);
+
+    motor_cmd_test_reset();
+    motor_control_init(&test_loop);
+}
+
 ZTEST_SUITE(motor_control, NULL, NULL, NULL, NULL, NULL);
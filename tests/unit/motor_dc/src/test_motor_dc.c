@@ -0,0 +1,120 @@
+#include <errno.h>
+#include <math.h>
+#include <zephyr/ztest.h>
+
+#include "motor_dc.h"
+
+static const struct motor_model_params model = MOTOR_MODEL_PARAMS_DEFAULT;
+
+static void assert_float_near(float a, float b, float eps, const char *msg)
+{
+    zassert_true(fabsf(a - b) <= eps, "%s (a=%f b=%f)", msg, (double)a, (double)b);
+}
+
+static void prepare(const struct motor_dc_params *p, struct motor_dc_coeffs *c)
+{
+    zassert_equal(motor_dc_prepare(p, 10000.0f, 0.05f, c), 0, NULL);
+}
+
+ZTEST(motor_dc, test_prepare_validates_and_counts_inner_steps)
+{
+    struct motor_dc_params p = MOTOR_DC_PARAMS_DEFAULT;
+    struct motor_dc_coeffs c;
+
+    prepare(&p, &c);
+    zassert_equal(c.inner_steps, 500U, "10 kHz in a 50 ms period");
+    assert_float_near(c.dt_over_l, 0.1f, 1e-6f, "dt / L");
+
+    zassert_equal(motor_dc_prepare(&p, 0.0f, 0.05f, &c), -EINVAL, NULL);
+    zassert_equal(motor_dc_prepare(&p, 10000.0f, 0.0f, &c), -EINVAL, NULL);
+    zassert_equal(motor_dc_prepare(&p, 10.0f, 0.01f, &c), -EINVAL, "period below one step");
+
+    p.inductance_h = 0.0f;
+    zassert_equal(motor_dc_prepare(&p, 10000.0f, 0.05f, &c), -EINVAL, NULL);
+    p.inductance_h = 1e-3f;
+    p.resistance_ohm = -1.0f;
+    zassert_equal(motor_dc_prepare(&p, 10000.0f, 0.05f, &c), -EINVAL, NULL);
+    p.resistance_ohm = 1.0f;
+    p.inertia_kg_m2 = 0.0f;
+    zassert_equal(motor_dc_prepare(&p, 10000.0f, 0.05f, &c), -EINVAL, NULL);
+    p.inertia_kg_m2 = 4.3e-5f;
+    p.bus_voltage_v = 0.0f;
+    zassert_equal(motor_dc_prepare(&p, 10000.0f, 0.05f, &c), -EINVAL, NULL);
+}
+
+ZTEST(motor_dc, test_current_loop_settles_within_a_few_ms)
+{
+    const struct motor_dc_params p = MOTOR_DC_PARAMS_DEFAULT;
+    struct motor_dc_coeffs c;
+    struct motor_dc_state s = {0};
+
+    prepare(&p, &c);
+
+    /* 20 steps = 2 ms, two electrical time constants. */
+    for (int i = 0; i < 20; i++) {
+        motor_dc_current_step(&c, &s, 5.0f);
+        zassert_true(s.current_a <= 5.05f, "no overshoot (i=%f)", (double)s.current_a);
+    }
+
+    assert_float_near(s.current_a, 5.0f, 0.1f, "current follows the reference");
+    zassert_true(s.omega_rad_s > 0.0f, "torque accelerates the rotor");
+}
+
+ZTEST(motor_dc, test_voltage_and_integrator_clamped_to_bus)
+{
+    const struct motor_dc_params p = MOTOR_DC_PARAMS_DEFAULT;
+    struct motor_dc_coeffs c;
+    struct motor_dc_state s = {0};
+
+    prepare(&p, &c);
+
+    /* An unreachable reference saturates the drive but the integrator stays bounded. */
+    for (int i = 0; i < 1000; i++) {
+        motor_dc_current_step(&c, &s, 1000.0f);
+    }
+    zassert_true(s.voltage_v == p.bus_voltage_v, NULL);
+    zassert_true(s.integ_v <= p.bus_voltage_v, NULL);
+
+    /* Braking to zero: reverse voltage, but the rotor never turns backwards. */
+    for (int i = 0; i < 50000; i++) {
+        motor_dc_current_step(&c, &s, -1000.0f);
+        zassert_true(s.omega_rad_s >= 0.0f, NULL);
+    }
+    zassert_true(s.voltage_v == -p.bus_voltage_v, NULL);
+    zassert_true(s.integ_v >= -p.bus_voltage_v, NULL);
+    zassert_true(s.omega_rad_s == 0.0f, NULL);
+}
+
+ZTEST(motor_dc, test_cascaded_loop_matches_first_order_and_load_costs_current)
+{
+    struct motor_dc_params p = MOTOR_DC_PARAMS_DEFAULT;
+    struct motor_dc_coeffs c;
+    struct motor_dc_state dc = {0};
+    struct motor_state s = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+    struct motor_state ref = s;
+
+    prepare(&p, &c);
+
+    for (uint32_t i = 0; i < 200; i++) {
+        motor_dc_step(&model, &c, &dc, &s, i, 1);
+        motor_model_step(&model, &ref);
+
+        /* Same mechanical time constant: the speed trajectories stay close. */
+        zassert_true(fabsf(s.measured_rpm - ref.measured_rpm) < 60.0f, "step %u: %f vs %f", i,
+                     (double)s.measured_rpm, (double)ref.measured_rpm);
+    }
+    assert_float_near(s.measured_rpm, 3000.0f, 5.0f, "settled");
+    assert_float_near(dc.current_a, 3.0f, 0.05f, "friction torque at 3000 rpm");
+    assert_float_near(s.temperature_c, ref.temperature_c, 0.5f, "thermal stage shared");
+
+    /* A load torque of 0.02 Nm needs 1 A more for the same speed. */
+    p.load_nm = 0.02f;
+    prepare(&p, &c);
+    for (uint32_t i = 0; i < 200; i++) {
+        motor_dc_step(&model, &c, &dc, &s, i, 1);
+    }
+    assert_float_near(s.measured_rpm, 3000.0f, 5.0f, "speed loop rejects the load");
+    assert_float_near(dc.current_a, 4.0f, 0.05f, "load current");
+}
+
+ZTEST_SUITE(motor_dc, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,185 @@
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "motor_lifetime.h"
+
+#define PERIOD_MS 50U
+
+static const struct motor_model_params model = MOTOR_MODEL_PARAMS_DEFAULT;
+
+static struct motor_lifetime lt;
+
+static void period(float setpoint, float out, float temp, float power_w)
+{
+    const struct motor_state s = {
+        .setpoint_rpm = setpoint,
+        .measured_rpm = setpoint,
+        .control_output_pct = out,
+        .temperature_c = temp,
+    };
+
+    motor_lifetime_update(&model, &lt, &s, power_w, PERIOD_MS);
+}
+
+static uint32_t sum(const uint32_t *v, size_t n)
+{
+    uint32_t total = 0U;
+
+    for (size_t i = 0; i < n; i++) {
+        total += v[i];
+    }
+
+    return total;
+}
+
+static void before_each(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    memset(&lt, 0xa5, sizeof(lt));
+    motor_lifetime_reset(&lt);
+}
+
+ZTEST(motor_lifetime, test_reset_clears_everything)
+{
+    const struct motor_lifetime zero = {0};
+
+    zassert_mem_equal(&lt, &zero, sizeof(lt), NULL);
+}
+
+ZTEST(motor_lifetime, test_bands_split_at_the_limits)
+{
+    /* Strict comparisons, as the output limits use. */
+    zassert_equal(motor_lifetime_band(&model, 25.0f), MOTOR_LIFETIME_BAND_NORMAL, NULL);
+    zassert_equal(motor_lifetime_band(&model, 80.0f), MOTOR_LIFETIME_BAND_NORMAL, NULL);
+    zassert_equal(motor_lifetime_band(&model, 80.5f), MOTOR_LIFETIME_BAND_SOFT, NULL);
+    zassert_equal(motor_lifetime_band(&model, 100.0f), MOTOR_LIFETIME_BAND_SOFT, NULL);
+    zassert_equal(motor_lifetime_band(&model, 100.5f), MOTOR_LIFETIME_BAND_HARD, NULL);
+
+    period(1000.0f, 10.0f, 40.0f, 0.0f);
+    period(1000.0f, 10.0f, 90.0f, 0.0f);
+    period(1000.0f, 10.0f, 90.0f, 0.0f);
+    period(1000.0f, 10.0f, 110.0f, 0.0f);
+
+    zassert_equal(lt.periods, 4U, NULL);
+    zassert_equal(lt.band_periods[MOTOR_LIFETIME_BAND_NORMAL], 1U, NULL);
+    zassert_equal(lt.band_periods[MOTOR_LIFETIME_BAND_SOFT], 2U, NULL);
+    zassert_equal(lt.band_periods[MOTOR_LIFETIME_BAND_HARD], 1U, NULL);
+}
+
+ZTEST(motor_lifetime, test_saturated_and_derated_periods)
+{
+    period(9000.0f, 100.0f, 50.0f, 0.0f); /* saturated */
+    period(9000.0f, 99.0f, 50.0f, 0.0f);  /* below the clamp */
+    period(9000.0f, 60.0f, 85.0f, 0.0f);  /* held at the soft cap */
+    period(3000.0f, 30.0f, 85.0f, 0.0f);  /* soft band, under the cap */
+    period(9000.0f, 10.0f, 105.0f, 0.0f); /* held at the hard cap */
+    period(500.0f, 5.0f, 105.0f, 0.0f);   /* hard band, under the cap */
+    period(9000.0f, 60.0f, 50.0f, 0.0f);  /* cap value, but no limit active */
+
+    zassert_equal(lt.saturated_periods, 1U, NULL);
+    zassert_equal(lt.derated_periods, 2U, NULL);
+}
+
+ZTEST(motor_lifetime, test_energy_integrates_power)
+{
+    /* 360 W for 50 ms is 18 J. */
+    for (int i = 0; i < 1000; i++) {
+        period(9000.0f, 100.0f, 50.0f, MOTOR_LIFETIME_RATED_POWER_W);
+    }
+    zassert_equal(lt.energy_mj, 18000000, NULL);
+
+    /* Energy fed back is subtracted. */
+    period(0.0f, 0.0f, 50.0f, -20.0f);
+    zassert_equal(lt.energy_mj, 18000000 - 1000, NULL);
+
+    /* Small powers over long runs are not rounded away. */
+    for (int i = 0; i < 100000; i++) {
+        period(0.0f, 0.0f, 50.0f, 0.5f);
+    }
+    zassert_equal(lt.energy_mj, 18000000 - 1000 + 2500000, NULL);
+}
+
+ZTEST(motor_lifetime, test_energy_below_one_mj_per_period)
+{
+    /* 10 mW for 50 ms is 0.5 mJ: nothing in a period, 500 mJ in 1000. */
+    for (int i = 0; i < 1000; i++) {
+        period(0.0f, 0.0f, 50.0f, 0.01f);
+    }
+    zassert_within(lt.energy_mj, 500, 1, "%lld mJ", (long long)lt.energy_mj);
+
+    /* 0.7 mJ fed back per period. */
+    for (int i = 0; i < 1000; i++) {
+        period(0.0f, 0.0f, 50.0f, -0.014f);
+    }
+    zassert_within(lt.energy_mj, 500 - 700, 1, "%lld mJ", (long long)lt.energy_mj);
+}
+
+ZTEST(motor_lifetime, test_setpoint_changes)
+{
+    /* The first period after a reset has nothing to compare with. */
+    period(1500.0f, 15.0f, 25.0f, 0.0f);
+    period(1500.0f, 15.0f, 25.0f, 0.0f);
+    zassert_equal(lt.setpoint_changes, 0U, NULL);
+
+    period(2000.0f, 15.0f, 25.0f, 0.0f);
+    period(2000.0f, 15.0f, 25.0f, 0.0f);
+    period(0.0f, 15.0f, 25.0f, 0.0f);
+    zassert_equal(lt.setpoint_changes, 2U, NULL);
+
+    motor_lifetime_reset(&lt);
+    period(3000.0f, 15.0f, 25.0f, 0.0f);
+    zassert_equal(lt.setpoint_changes, 0U, NULL);
+}
+
+ZTEST(motor_lifetime, test_histograms)
+{
+    static const struct {
+        float temp;
+        uint32_t temp_bin;
+        float out;
+        uint32_t out_bin;
+    } cases[] = {
+        {-40.0f, 0U, -5.0f, 0U},  {25.0f, 0U, 0.0f, 0U},   {29.9f, 0U, 9.9f, 0U},
+        {30.0f, 1U, 10.0f, 1U},   {80.0f, 6U, 55.0f, 5U},  {100.0f, 8U, 99.9f, 9U},
+        {125.0f, 10U, 100.0f, 9U}, {500.0f, 10U, 150.0f, 9U},
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+        struct motor_lifetime before = lt;
+
+        period(0.0f, cases[i].out, cases[i].temp, 0.0f);
+        zassert_equal(lt.temp_hist[cases[i].temp_bin], before.temp_hist[cases[i].temp_bin] + 1U,
+                      "case %u", (unsigned int)i);
+        zassert_equal(lt.out_hist[cases[i].out_bin], before.out_hist[cases[i].out_bin] + 1U,
+                      "case %u", (unsigned int)i);
+    }
+
+    /* Every period lands in exactly one bin of each histogram. */
+    zassert_equal(sum(lt.temp_hist, MOTOR_LIFETIME_TEMP_BINS), ARRAY_SIZE(cases), NULL);
+    zassert_equal(sum(lt.out_hist, MOTOR_LIFETIME_OUT_BINS), ARRAY_SIZE(cases), NULL);
+    zassert_equal(sum(lt.band_periods, MOTOR_LIFETIME_BAND_COUNT), lt.periods, NULL);
+}
+
+ZTEST(motor_lifetime, test_model_run_matches_the_state)
+{
+    struct motor_state s = {.setpoint_rpm = 10000.0f, .temperature_c = 110.0f};
+    uint32_t hot = 0U;
+
+    /* Full speed from overheated: derated while cooling down, then saturated. */
+    for (uint32_t k = 0; k < 2000U; k++) {
+        motor_model_step(&model, &s);
+        motor_lifetime_update(&model, &lt, &s, 0.0f, PERIOD_MS);
+        hot += (s.temperature_c > model.soft_limit_temp_c) ? 1U : 0U;
+    }
+
+    zassert_equal(lt.periods, 2000U, NULL);
+    zassert_true((hot > 0U) && (hot < 2000U), NULL);
+    zassert_equal(lt.band_periods[MOTOR_LIFETIME_BAND_SOFT] +
+                      lt.band_periods[MOTOR_LIFETIME_BAND_HARD],
+                  hot, NULL);
+    zassert_true(lt.saturated_periods > 0U, NULL);
+    zassert_true(lt.derated_periods > 0U, NULL);
+    zassert_equal(lt.setpoint_changes, 0U, NULL);
+}
+
+ZTEST_SUITE(motor_lifetime, NULL, NULL, before_each, NULL, NULL);
@@ -0,0 +1,262 @@
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "motor_pid.h"
+
+static const struct motor_model_params model = MOTOR_MODEL_PARAMS_DEFAULT;
+static const struct motor_pid_gains legacy = MOTOR_PID_GAINS_DEFAULT;
+
+/* Settled at 1500 rpm, as after motor_model_step() at that setpoint. */
+static const struct motor_state settled = {
+    .setpoint_rpm = 1500.0f,
+    .measured_rpm = 1500.0f,
+    .control_output_pct = 15.0f,
+    .temperature_c = 25.0f,
+};
+
+static void pid_period(const struct motor_pid_gains *g, struct motor_pid_state *pid,
+                       struct motor_state *s)
+{
+    motor_pid_speed_control(&model, g, pid, s);
+    motor_model_first_order_plant(&model, s);
+    motor_model_thermal_step(&model, s, 0U, 1U);
+}
+
+/* Periods until the speed stays within 2% of the setpoint. */
+static uint32_t settling_periods(const struct motor_pid_gains *g, float setpoint, uint32_t n,
+                                 float *overshoot, float *final_rpm)
+{
+    struct motor_state s = {.setpoint_rpm = setpoint, .temperature_c = 25.0f};
+    struct motor_pid_state pid;
+    uint32_t settled_at = 0U;
+
+    motor_pid_reset(&pid);
+    *overshoot = 0.0f;
+
+    for (uint32_t k = 0; k < n; k++) {
+        pid_period(g, &pid, &s);
+        *overshoot = fmaxf(*overshoot, s.measured_rpm - setpoint);
+        if (fabsf(s.measured_rpm - setpoint) > (0.02f * setpoint)) {
+            settled_at = k + 1U;
+        }
+    }
+
+    *final_rpm = s.measured_rpm;
+    return settled_at;
+}
+
+static enum motor_pid_tune_status run_tuner(struct motor_pid_tuner *t, struct motor_state *s)
+{
+    enum motor_pid_tune_status st = MOTOR_PID_TUNE_RUNNING;
+
+    for (int i = 0; (i < 1000) && (st == MOTOR_PID_TUNE_RUNNING); i++) {
+        st = motor_pid_tune_step(t, &model, s);
+        motor_model_first_order_plant(&model, s);
+    }
+
+    return st;
+}
+
+ZTEST(motor_pid, test_default_gains_match_legacy_controller)
+{
+    struct motor_state a = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+    struct motor_state b = a;
+    struct motor_pid_state pid;
+
+    motor_pid_reset(&pid);
+
+    /* Through saturation, the thermal limits and a setpoint drop. */
+    for (uint32_t k = 0; k < 2000U; k++) {
+        if (k == 200U) {
+            a.setpoint_rpm = 9500.0f;
+            b.setpoint_rpm = 9500.0f;
+        } else if (k == 1500U) {
+            a.setpoint_rpm = 500.0f;
+            b.setpoint_rpm = 500.0f;
+        }
+        motor_model_step(&model, &a);
+        pid_period(&legacy, &pid, &b);
+        zassert_mem_equal(&a, &b, sizeof(a), "diverged at period %u", k);
+    }
+}
+
+ZTEST(motor_pid, test_no_windup_while_output_limited)
+{
+    const struct motor_pid_gains g = {.kp_pct = 20.0f, .ki_pct = 10.0f};
+    struct motor_state s = {.setpoint_rpm = 3000.0f, .temperature_c = 25.0f};
+    struct motor_pid_state pid;
+
+    motor_pid_reset(&pid);
+
+    /* Output capped at 10% (as above the hard temperature limit): the error persists. */
+    for (int i = 0; i < 300; i++) {
+        motor_pid_speed_control(&model, &g, &pid, &s);
+        s.control_output_pct = fminf(s.control_output_pct, model.hard_limit_output_pct);
+        motor_model_first_order_plant(&model, &s);
+    }
+    zassert_within(s.measured_rpm, 1000.0f, 1.0f, NULL);
+
+    /* Cap lifted: the output moves on from the applied 10%, no wound-up jump. */
+    motor_pid_speed_control(&model, &g, &pid, &s);
+    zassert_within(s.control_output_pct, 12.0f, 0.1f, "output %f",
+                   (double)s.control_output_pct);
+}
+
+ZTEST(motor_pid, test_derivative_acts_on_speed_curvature)
+{
+    const struct motor_pid_gains g = {.kd_pct = 100.0f};
+    struct motor_state s = settled;
+    struct motor_pid_state pid;
+
+    /* First call primes the history: no kick. */
+    motor_pid_reset(&pid);
+    motor_pid_speed_control(&model, &g, &pid, &s);
+    zassert_true(s.control_output_pct == 15.0f, NULL);
+
+    /* Constant slope: no curvature, no action. */
+    s.measured_rpm += 100.0f;
+    motor_pid_speed_control(&model, &g, &pid, &s);
+    float after_jump = s.control_output_pct;
+
+    s.measured_rpm += 100.0f;
+    motor_pid_speed_control(&model, &g, &pid, &s);
+    zassert_true(s.control_output_pct == after_jump, NULL);
+
+    /* The speed levels off: the derivative pushes back up. */
+    motor_pid_speed_control(&model, &g, &pid, &s);
+    zassert_true(s.control_output_pct > after_jump, NULL);
+}
+
+ZTEST(motor_pid, test_tune_start_validates)
+{
+    struct motor_pid_tuner t = {0};
+    struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    struct motor_state s = settled;
+
+    cfg.amplitude_pct = 0.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, NULL);
+    cfg.amplitude_pct = 101.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, NULL);
+    cfg.amplitude_pct = 10.0f;
+    cfg.hysteresis_rpm = -1.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, NULL);
+    cfg.hysteresis_rpm = 50.0f;
+    cfg.cycles = 0U;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, NULL);
+    cfg.cycles = 4U;
+    cfg.max_periods = 0U;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, NULL);
+    cfg.max_periods = 400U;
+
+    s.control_output_pct = 0.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, "stopped motor");
+    s.control_output_pct = 100.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), -EINVAL, "saturated output");
+    zassert_equal(t.status, MOTOR_PID_TUNE_IDLE, NULL);
+
+    /* The swing is reduced to stay within 0..100. */
+    s.control_output_pct = 4.0f;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), 0, NULL);
+    zassert_true(t.relay_pct == 4.0f, NULL);
+    zassert_equal(motor_pid_tune_step(&t, &model, &s), MOTOR_PID_TUNE_RUNNING, NULL);
+}
+
+ZTEST(motor_pid, test_relay_identifies_first_order_plant)
+{
+    const struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    struct motor_pid_tuner t;
+    struct motor_state s = settled;
+
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), 0, NULL);
+    zassert_equal(run_tuner(&t, &s), MOTOR_PID_TUNE_DONE, NULL);
+    zassert_true(s.control_output_pct == settled.control_output_pct, "back at the bias");
+
+    /* 100 rpm per %, and a lag of 1 / -ln(1 - alpha) = 4.5 periods. */
+    zassert_within(t.ident.gain_rpm_per_pct, 100.0f, 5.0f, "K=%f",
+                   (double)t.ident.gain_rpm_per_pct);
+    zassert_within(t.ident.time_constant, 4.5f, 1.5f, "T=%f", (double)t.ident.time_constant);
+    zassert_true(t.ident.dead_time < 2.0f, "L=%f", (double)t.ident.dead_time);
+    zassert_true(t.gains.kp_pct > 0.0f, NULL);
+    zassert_true(t.gains.ki_pct > legacy.ki_pct, NULL);
+    zassert_true(t.gains.kd_pct == 0.0f, NULL);
+
+    /* Finished: further steps leave the output alone. */
+    s.control_output_pct = 42.0f;
+    zassert_equal(motor_pid_tune_step(&t, &model, &s), MOTOR_PID_TUNE_DONE, NULL);
+    zassert_true(s.control_output_pct == 42.0f, NULL);
+}
+
+ZTEST(motor_pid, test_tuned_gains_settle_faster_without_overshoot)
+{
+    const struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    struct motor_pid_tuner t;
+    struct motor_state s = settled;
+    float legacy_os;
+    float tuned_os;
+    float legacy_rpm;
+    float tuned_rpm;
+
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), 0, NULL);
+    zassert_equal(run_tuner(&t, &s), MOTOR_PID_TUNE_DONE, NULL);
+
+    uint32_t legacy_n = settling_periods(&legacy, 3000.0f, 200U, &legacy_os, &legacy_rpm);
+    uint32_t tuned_n = settling_periods(&t.gains, 3000.0f, 200U, &tuned_os, &tuned_rpm);
+
+    TC_PRINT("settling 0 -> 3000 rpm: legacy %u periods, tuned %u periods\n", legacy_n, tuned_n);
+    zassert_true(tuned_n * 2U < legacy_n, "legacy %u, tuned %u", legacy_n, tuned_n);
+    zassert_true(tuned_os < 0.02f * 3000.0f, "overshoot %f", (double)tuned_os);
+    zassert_within(tuned_rpm, 3000.0f, 1.0f, "no steady-state error");
+}
+
+ZTEST(motor_pid, test_tune_fails_without_limit_cycle)
+{
+    struct motor_pid_tune_config cfg = MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    struct motor_pid_tuner t;
+    struct motor_state s = settled;
+
+    /* Too few periods for the cycles asked. */
+    cfg.max_periods = 10U;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), 0, NULL);
+    zassert_equal(run_tuner(&t, &s), MOTOR_PID_TUNE_FAILED, NULL);
+    zassert_equal(t.periods, 10U, NULL);
+    zassert_true(s.control_output_pct == settled.control_output_pct, "back at the bias");
+
+    /* A hysteresis wider than the swing can move the speed: the relay never switches. */
+    cfg = (struct motor_pid_tune_config)MOTOR_PID_TUNE_CONFIG_DEFAULT;
+    cfg.amplitude_pct = 1.0f;
+    cfg.hysteresis_rpm = 500.0f;
+    s = settled;
+    zassert_equal(motor_pid_tune_start(&t, &cfg, &s), 0, NULL);
+    zassert_equal(run_tuner(&t, &s), MOTOR_PID_TUNE_FAILED, NULL);
+    zassert_equal(t.cycles, 0U, NULL);
+}
+
+ZTEST(motor_pid, test_gains_from_ident)
+{
+    const struct motor_pid_ident ident = {
+        .gain_rpm_per_pct = 100.0f,
+        .time_constant = 10.0f,
+        .dead_time = 2.0f,
+    };
+    struct motor_pid_gains g;
+
+    /* Kc = 10 / (100 * 2 * 2), Ti = min(10, 16). */
+    motor_pid_gains_from_ident(&model, &ident, &g);
+    zassert_within(g.kp_pct, 250.0f, 1e-3f, NULL);
+    zassert_within(g.ki_pct, 25.0f, 1e-4f, NULL);
+
+    /* Short dead time: floored at half a period, Ti = 8 L. */
+    const struct motor_pid_ident fast = {
+        .gain_rpm_per_pct = 100.0f,
+        .time_constant = 10.0f,
+        .dead_time = 0.1f,
+    };
+
+    motor_pid_gains_from_ident(&model, &fast, &g);
+    zassert_within(g.kp_pct, 1000.0f, 1e-2f, NULL);
+    zassert_within(g.ki_pct, 250.0f, 1e-2f, NULL);
+}
+
+ZTEST_SUITE(motor_pid, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,127 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "sample_pool.h"
+
+#define HOLDERS      3
+#define HOLDER_STACK 1024
+#define HOLDER_LOOPS 10000
+
+static const struct app_state_sample *all[SAMPLE_POOL_BLOCKS];
+
+static uint32_t in_use(void)
+{
+    struct sample_pool_stats st;
+
+    sample_pool_get_stats(&st);
+    return st.in_use;
+}
+
+static void sample_pool_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    zassert_equal(in_use(), 0U, "previous test leaked blocks");
+    sample_pool_reset_stats();
+}
+
+ZTEST(sample_pool, test_last_release_frees_the_block)
+{
+    struct app_state_sample *s = sample_pool_alloc();
+
+    zassert_not_null(s, NULL);
+    s->seq = 7U;
+    zassert_equal(in_use(), 1U, NULL);
+
+    /* Two more holders share the same block: no copy. */
+    sample_pool_hold(s);
+    sample_pool_hold(s);
+    sample_pool_release(s);
+    sample_pool_release(s);
+    zassert_equal(in_use(), 1U, "still held by its producer");
+    zassert_equal(s->seq, 7U, NULL);
+
+    sample_pool_release(s);
+    zassert_equal(in_use(), 0U, NULL);
+}
+
+ZTEST(sample_pool, test_exhaustion_is_counted)
+{
+    struct sample_pool_stats st;
+
+    for (size_t i = 0; i < SAMPLE_POOL_BLOCKS; i++) {
+        all[i] = sample_pool_alloc();
+        zassert_not_null(all[i], "block %u", (unsigned int)i);
+    }
+
+    zassert_is_null(sample_pool_alloc(), NULL);
+    zassert_is_null(sample_pool_alloc(), NULL);
+
+    sample_pool_get_stats(&st);
+    zassert_equal(st.blocks, SAMPLE_POOL_BLOCKS, NULL);
+    zassert_equal(st.in_use, SAMPLE_POOL_BLOCKS, NULL);
+    zassert_equal(st.peak_in_use, SAMPLE_POOL_BLOCKS, NULL);
+    zassert_equal(st.exhausted, 2U, NULL);
+
+    /* A released block is available again. */
+    sample_pool_release(all[0]);
+    all[0] = sample_pool_alloc();
+    zassert_not_null(all[0], NULL);
+
+    for (size_t i = 0; i < SAMPLE_POOL_BLOCKS; i++) {
+        sample_pool_release(all[i]);
+    }
+
+    /* The peak survives the releases; a reset restarts it from the current use. */
+    sample_pool_get_stats(&st);
+    zassert_equal(st.in_use, 0U, NULL);
+    zassert_equal(st.peak_in_use, SAMPLE_POOL_BLOCKS, NULL);
+
+    sample_pool_reset_stats();
+    sample_pool_get_stats(&st);
+    zassert_equal(st.peak_in_use, 0U, NULL);
+    zassert_equal(st.exhausted, 0U, NULL);
+}
+
+K_THREAD_STACK_ARRAY_DEFINE(holder_stacks, HOLDERS, HOLDER_STACK);
+static struct k_thread holder_threads[HOLDERS];
+
+static void holder(void *p1, void *p2, void *p3)
+{
+    const struct app_state_sample *s = p1;
+
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    for (int i = 0; i < HOLDER_LOOPS; i++) {
+        sample_pool_hold(s);
+        zassert_equal(s->seq, 42U, NULL);
+        sample_pool_release(s);
+        if ((i % 100) == 0) {
+            k_yield();
+        }
+    }
+}
+
+ZTEST(sample_pool, test_concurrent_holders_keep_the_count)
+{
+    struct app_state_sample *s = sample_pool_alloc();
+
+    zassert_not_null(s, NULL);
+    s->seq = 42U;
+
+    for (int h = 0; h < HOLDERS; h++) {
+        k_thread_create(&holder_threads[h], holder_stacks[h],
+                        K_THREAD_STACK_SIZEOF(holder_stacks[h]), holder, s, NULL, NULL,
+                        K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    }
+    for (int h = 0; h < HOLDERS; h++) {
+        zassert_equal(k_thread_join(&holder_threads[h], K_FOREVER), 0, NULL);
+    }
+
+    /* Every hold was matched: only the producer's reference is left. */
+    zassert_equal(in_use(), 1U, NULL);
+    sample_pool_release(s);
+    zassert_equal(in_use(), 0U, NULL);
+}
+
+ZTEST_SUITE(sample_pool, NULL, NULL, sample_pool_before, NULL, NULL);
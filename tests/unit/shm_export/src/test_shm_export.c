@@ -0,0 +1,111 @@
+#include <errno.h>
+#include <zephyr/ztest.h>
+
+#include "app_state.h"
+#include "motor_shm_ring.h"
+#include "sample_pool.h"
+#include "shm_bottom.h"
+#include "shm_export.h"
+
+#define SHM_TEST_FILE "shm_export_test.shm"
+
+static size_t ring_size(void)
+{
+    return motor_shm_ring_size(CONFIG_MOTOR_SIM_SHM_SLOTS);
+}
+
+static void shm_export_after(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    shm_export_test_close();
+}
+
+ZTEST(shm_export, test_samples_reach_a_second_mapping)
+{
+    shm_export_test_set_path(SHM_TEST_FILE);
+    zassert_equal(shm_export_init(), 0, NULL);
+    zassert_equal(app_state_init(), 0, NULL);
+
+    /* What a host reader does: its own mapping of the same file. */
+    void *mem = shm_bottom_map(SHM_TEST_FILE, ring_size(), false);
+    struct motor_shm_reader rd;
+    struct motor_shm_sample s;
+
+    zassert_not_null(mem, NULL);
+    zassert_equal(motor_shm_reader_attach(&rd, mem, ring_size()), 0, NULL);
+
+    for (uint32_t i = 1; i <= 3U; i++) {
+        zassert_equal(app_state_update_feedback(100.0f * (float)i, 10.0f, 30.0f), 0, NULL);
+    }
+    for (uint32_t i = 1; i <= 3U; i++) {
+        zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+        zassert_equal(s.seq, i, "same sequence as the app_state history");
+        zassert_true(s.state.measured_rpm == 100.0f * (float)i, NULL);
+        zassert_true(s.state.setpoint_rpm == 1500.0f, NULL);
+    }
+    zassert_equal(motor_shm_reader_next(&rd, &s), -EAGAIN, NULL);
+
+    /* The writer never waits: a reader that falls behind loses the oldest. */
+    for (uint32_t i = 0; i < 2U * CONFIG_MOTOR_SIM_SHM_SLOTS; i++) {
+        zassert_equal(app_state_update_feedback(50.0f, 10.0f, 30.0f), 0, NULL);
+    }
+    zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+    zassert_equal(rd.lost, CONFIG_MOTOR_SIM_SHM_SLOTS, NULL);
+    zassert_equal(s.seq, 3U + CONFIG_MOTOR_SIM_SHM_SLOTS + 1U, NULL);
+
+    shm_bottom_unmap(mem, ring_size());
+}
+
+ZTEST(shm_export, test_exhausted_pool_still_exports)
+{
+    static const struct app_state_sample *held[SAMPLE_POOL_BLOCKS];
+    size_t n = 0;
+
+    shm_export_test_set_path(SHM_TEST_FILE);
+    zassert_equal(shm_export_init(), 0, NULL);
+    zassert_equal(app_state_init(), 0, NULL);
+
+    void *mem = shm_bottom_map(SHM_TEST_FILE, ring_size(), false);
+    struct motor_shm_reader rd;
+    struct motor_shm_sample s;
+
+    zassert_not_null(mem, NULL);
+    zassert_equal(motor_shm_reader_attach(&rd, mem, ring_size()), 0, NULL);
+
+    /* A history reader that never lets go takes every free block. */
+    while ((held[n] = sample_pool_alloc()) != NULL) {
+        n++;
+    }
+    zassert_equal(app_state_update_feedback(200.0f, 10.0f, 30.0f), 0, NULL);
+
+    zassert_equal(motor_shm_reader_next(&rd, &s), 0, "exported without a pool block");
+    zassert_equal(s.seq, 1U, NULL);
+    zassert_true(s.state.measured_rpm == 200.0f, NULL);
+
+    for (size_t i = 0; i < n; i++) {
+        sample_pool_release(held[i]);
+    }
+    shm_bottom_unmap(mem, ring_size());
+    zassert_equal(app_state_init(), 0, NULL);
+}
+
+ZTEST(shm_export, test_map_failure_disables_export)
+{
+    shm_export_test_set_path("no-such-dir/" SHM_TEST_FILE);
+    zassert_equal(shm_export_init(), -EIO, NULL);
+
+    /* Samples are still recorded, just not exported. */
+    zassert_equal(app_state_init(), 0, NULL);
+    zassert_equal(app_state_update_feedback(100.0f, 10.0f, 30.0f), 0, NULL);
+}
+
+ZTEST(shm_export, test_reader_map_checks_file_size)
+{
+    shm_export_test_set_path(SHM_TEST_FILE);
+    zassert_equal(shm_export_init(), 0, NULL);
+
+    zassert_is_null(shm_bottom_map(SHM_TEST_FILE, 2U * ring_size(), false), NULL);
+    zassert_is_null(shm_bottom_map("no-such-dir/" SHM_TEST_FILE, ring_size(), false), NULL);
+}
+
+ZTEST_SUITE(shm_export, NULL, NULL, NULL, shm_export_after, NULL);
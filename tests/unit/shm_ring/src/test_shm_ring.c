@@ -0,0 +1,143 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "motor_shm_ring.h"
+
+#define CAP 8U
+
+static uint64_t mem[(sizeof(struct motor_shm_ring) + (CAP * sizeof(struct motor_shm_slot))) /
+                    sizeof(uint64_t)];
+
+static struct motor_shm_ring *ring;
+
+static void write_n(uint32_t first, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        struct motor_shm_sample s = {.seq = first + i, .uptime_ms = (first + i) * 50U};
+
+        s.state.setpoint_rpm = (float)(first + i);
+        motor_shm_ring_write(ring, &s);
+    }
+}
+
+static void shm_ring_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    ring = motor_shm_ring_init(mem, sizeof(mem), CAP);
+    zassert_not_null(ring, NULL);
+}
+
+ZTEST(shm_ring, test_layout_is_fixed)
+{
+    /* Readers in other processes rely on these offsets. */
+    zassert_equal(sizeof(struct motor_shm_sample), 24U, NULL);
+    zassert_equal(sizeof(struct motor_shm_slot), 32U, NULL);
+    zassert_equal(offsetof(struct motor_shm_ring, head), 64U, NULL);
+    zassert_equal(offsetof(struct motor_shm_ring, slots), 128U, NULL);
+    zassert_equal(motor_shm_ring_size(CAP), sizeof(mem), NULL);
+}
+
+ZTEST(shm_ring, test_init_rejects_bad_capacity_and_size)
+{
+    zassert_is_null(motor_shm_ring_init(mem, sizeof(mem), 0U), NULL);
+    zassert_is_null(motor_shm_ring_init(mem, sizeof(mem), 6U), "not a power of two");
+    zassert_is_null(motor_shm_ring_init(mem, sizeof(mem), 2U * CAP), "too small");
+    zassert_not_null(motor_shm_ring_init(mem, sizeof(mem), 4U), NULL);
+}
+
+ZTEST(shm_ring, test_reads_in_order_then_eagain)
+{
+    struct motor_shm_reader rd;
+    struct motor_shm_sample s;
+
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), 0, NULL);
+    zassert_equal(motor_shm_reader_next(&rd, &s), -EAGAIN, "empty ring");
+
+    write_n(1U, 5U);
+    for (uint32_t i = 1; i <= 5U; i++) {
+        zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+        zassert_equal(s.seq, i, NULL);
+        zassert_equal(s.uptime_ms, i * 50U, NULL);
+        zassert_equal(s.state.setpoint_rpm, (float)i, NULL);
+    }
+    zassert_equal(motor_shm_reader_next(&rd, &s), -EAGAIN, NULL);
+    zassert_equal(rd.lost, 0U, NULL);
+}
+
+ZTEST(shm_ring, test_lapped_reader_skips_and_counts_lost)
+{
+    struct motor_shm_reader rd;
+    struct motor_shm_sample s;
+
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), 0, NULL);
+
+    write_n(1U, 3U * CAP);
+    zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+    zassert_equal(s.seq, (2U * CAP) + 1U, "oldest sample still in the ring");
+    zassert_equal(rd.lost, 2U * CAP, NULL);
+
+    /* A late reader starts at the oldest sample too. */
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), 0, NULL);
+    zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+    zassert_equal(s.seq, (2U * CAP) + 1U, NULL);
+    zassert_equal(rd.lost, 0U, NULL);
+}
+
+ZTEST(shm_ring, test_peek_is_zero_copy_and_detects_overwrite)
+{
+    struct motor_shm_reader rd;
+    const struct motor_shm_sample *p;
+
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), 0, NULL);
+    write_n(1U, 1U);
+
+    zassert_equal(motor_shm_reader_peek(&rd, &p), 0, NULL);
+    zassert_equal_ptr(p, &ring->slots[0].sample, "points into the ring");
+    zassert_equal(p->seq, 1U, NULL);
+
+    /* The writer laps the reader while it holds the pointer. */
+    write_n(2U, CAP);
+    zassert_equal(motor_shm_reader_commit(&rd), -ESTALE, NULL);
+
+    zassert_equal(motor_shm_reader_peek(&rd, &p), 0, NULL);
+    zassert_equal(p->seq, 2U, NULL);
+    zassert_equal(motor_shm_reader_commit(&rd), 0, NULL);
+    zassert_equal(rd.lost, 1U, NULL);
+}
+
+ZTEST(shm_ring, test_slot_being_written_is_skipped)
+{
+    struct motor_shm_reader rd;
+    struct motor_shm_sample s;
+
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), 0, NULL);
+    write_n(1U, 2U);
+
+    /* Slot 0 caught between the writer's invalidate and publish on a later lap. */
+    ring->slots[0].seq = 0U;
+    zassert_equal(motor_shm_reader_next(&rd, &s), 0, NULL);
+    zassert_equal(s.seq, 2U, NULL);
+    zassert_equal(rd.lost, 1U, NULL);
+}
+
+ZTEST(shm_ring, test_attach_validates_header)
+{
+    struct motor_shm_reader rd;
+
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(struct motor_shm_ring) - 1U),
+                  -EINVAL, "shorter than the header");
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem) - 1U), -EINVAL,
+                  "shorter than the slots");
+
+    ring->slot_size++;
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), -EINVAL, NULL);
+    ring->slot_size--;
+    ring->version++;
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), -EINVAL, NULL);
+    ring->version--;
+    ring->magic = 0U;
+    zassert_equal(motor_shm_reader_attach(&rd, mem, sizeof(mem)), -EINVAL, NULL);
+}
+
+ZTEST_SUITE(shm_ring, NULL, NULL, shm_ring_before, NULL, NULL);
@@ -0,0 +1,222 @@
+#include <errno.h>
+#include <math.h>
+#include <zephyr/ztest.h>
+
+#include "trajectory.h"
+
+static void assert_float_near(float a, float b, float eps, const char *msg)
+{
+    zassert_true(fabsf(a - b) <= eps, "%s (a=%f b=%f)", msg, (double)a, (double)b);
+}
+
+static void load_one(const char *text)
+{
+    struct trajectory_segment seg;
+
+    zassert_equal(trajectory_parse_segment(text, &seg), 0, NULL);
+    zassert_equal(trajectory_load(&seg, 1), 0, NULL);
+}
+
+ZTEST(trajectory, test_parse_valid_forms)
+{
+    struct trajectory_segment seg;
+
+    zassert_equal(trajectory_parse_segment("step:1200:500", &seg), 0, NULL);
+    zassert_equal(seg.type, TRAJECTORY_SEG_STEP, NULL);
+    zassert_true(seg.target_rpm == 1200.0f, NULL);
+    zassert_equal(seg.duration_ms, 500U, NULL);
+
+    zassert_equal(trajectory_parse_segment("ramp:3000:2000", &seg), 0, NULL);
+    zassert_equal(seg.type, TRAJECTORY_SEG_RAMP, NULL);
+
+    zassert_equal(trajectory_parse_segment("sine:2000:10000:500:100:2000", &seg), 0, NULL);
+    zassert_equal(seg.type, TRAJECTORY_SEG_SINE, NULL);
+    zassert_true(seg.amplitude_rpm == 500.0f, NULL);
+    assert_float_near(seg.freq_start_hz, 0.1f, 1e-6f, "f0");
+    assert_float_near(seg.freq_end_hz, 2.0f, 1e-6f, "f1");
+}
+
+ZTEST(trajectory, test_parse_rejects_bad_text)
+{
+    struct trajectory_segment seg;
+
+    zassert_equal(trajectory_parse_segment("hold:10:10", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:10", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:10:20:30", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:10x20", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("ramp:-5:100", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("sine:100:100:10", &seg), -EINVAL, NULL);
+
+    /* Out of range instead of wrapped to a short or a huge duration. */
+    zassert_equal(trajectory_parse_segment("step:100:4294967297", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:100:-1", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:100:99999999999999999999", &seg), -EINVAL,
+                  NULL);
+    zassert_equal(trajectory_parse_segment("step:4294967296:100", &seg), -EINVAL, NULL);
+    zassert_equal(trajectory_parse_segment("step:100:4294967295", &seg), 0, "largest duration");
+    zassert_equal(seg.duration_ms, UINT32_MAX, NULL);
+}
+
+ZTEST(trajectory, test_load_validation)
+{
+    struct trajectory_segment seg = {
+        .type = TRAJECTORY_SEG_STEP,
+        .target_rpm = 1000.0f,
+        .duration_ms = 100,
+    };
+
+    zassert_equal(trajectory_load(NULL, 1), -EINVAL, NULL);
+    zassert_equal(trajectory_load(&seg, 0), -EINVAL, NULL);
+    zassert_equal(trajectory_load(&seg, TRAJECTORY_MAX_SEGMENTS + 1), -EINVAL, NULL);
+
+    seg.duration_ms = 0;
+    zassert_equal(trajectory_load(&seg, 1), -EINVAL, "zero duration");
+
+    seg.duration_ms = 100;
+    seg.target_rpm = 20000.0f;
+    zassert_equal(trajectory_load(&seg, 1), -EINVAL, "rpm out of range");
+
+    struct trajectory_segment sine = {
+        .type = TRAJECTORY_SEG_SINE,
+        .target_rpm = 100.0f,
+        .duration_ms = 100,
+        .amplitude_rpm = 500.0f,
+    };
+    zassert_equal(trajectory_load(&sine, 1), -EINVAL, "sine below zero");
+}
+
+ZTEST(trajectory, test_start_requires_profile_and_blocks_reload)
+{
+    struct trajectory_status st;
+
+    zassert_equal(trajectory_get_status(NULL), -EINVAL, NULL);
+    zassert_equal(trajectory_start(0.0f, 1), -ENODATA, NULL);
+
+    load_one("step:500:100");
+    zassert_equal(trajectory_start(0.0f, 1), 0, NULL);
+
+    struct trajectory_segment seg = {
+        .type = TRAJECTORY_SEG_STEP,
+        .target_rpm = 10.0f,
+        .duration_ms = 10,
+    };
+    zassert_equal(trajectory_load(&seg, 1), -EBUSY, NULL);
+
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true(st.active, NULL);
+    zassert_equal(st.passes_left, 1U, NULL);
+
+    trajectory_stop();
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_false(st.active, NULL);
+
+    float sp;
+    zassert_false(trajectory_tick(50, &sp), "idle player must not produce setpoints");
+}
+
+ZTEST(trajectory, test_step_sequence_finishes)
+{
+    struct trajectory_segment segs[2];
+
+    zassert_equal(trajectory_parse_segment("step:1000:100", &segs[0]), 0, NULL);
+    zassert_equal(trajectory_parse_segment("step:2000:100", &segs[1]), 0, NULL);
+    zassert_equal(trajectory_load(segs, 2), 0, NULL);
+    zassert_equal(trajectory_start(0.0f, 1), 0, NULL);
+
+    float sp = 0.0f;
+    zassert_true(trajectory_tick(50, &sp), NULL);
+    zassert_true(sp == 1000.0f, NULL);
+
+    /* Crosses into the second segment: the remainder is carried forward. */
+    zassert_true(trajectory_tick(100, &sp), NULL);
+    zassert_true(sp == 2000.0f, NULL);
+
+    struct trajectory_status st;
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_equal(st.segment_index, 1U, NULL);
+    zassert_equal(st.elapsed_ms, 50U, NULL);
+
+    /* Last tick ends the profile but still reports the final setpoint. */
+    zassert_true(trajectory_tick(50, &sp), NULL);
+    zassert_true(sp == 2000.0f, NULL);
+    zassert_false(trajectory_tick(50, &sp), NULL);
+}
+
+ZTEST(trajectory, test_ramp_is_smooth_and_monotonic)
+{
+    load_one("ramp:3000:1000");
+    zassert_equal(trajectory_start(1000.0f, 1), 0, NULL);
+
+    float prev = 1000.0f;
+    float prev_delta = 0.0f;
+    float sp = 0.0f;
+
+    for (int i = 0; i < 20; i++) {
+        zassert_true(trajectory_tick(50, &sp), NULL);
+        zassert_true(sp >= prev, "ramp must be monotonic");
+
+        float delta = sp - prev;
+        if (i == 0) {
+            /* S-curve: the first increment is much smaller than a linear ramp (100 rpm). */
+            zassert_true(delta < 10.0f, "first delta %f", (double)delta);
+        }
+        if (i == 5) {
+            zassert_true(delta > prev_delta, "ramp accelerates towards the midpoint");
+        }
+        prev_delta = delta;
+        prev = sp;
+    }
+
+    assert_float_near(sp, 3000.0f, 0.01f, "ramp end");
+}
+
+ZTEST(trajectory, test_sine_stays_within_amplitude)
+{
+    load_one("sine:2000:4000:500:1000:3000");
+    zassert_equal(trajectory_start(2000.0f, 1), 0, NULL);
+
+    float sp = 0.0f;
+    float lo = 2000.0f;
+    float hi = 2000.0f;
+
+    for (int i = 0; i < 80; i++) {
+        zassert_true(trajectory_tick(50, &sp), NULL);
+        lo = fminf(lo, sp);
+        hi = fmaxf(hi, sp);
+    }
+
+    zassert_true(lo >= 1499.0f, NULL);
+    zassert_true(hi <= 2501.0f, NULL);
+    zassert_true((hi - lo) > 500.0f, "sweep should swing around the center");
+    zassert_false(trajectory_tick(50, &sp), NULL);
+}
+
+ZTEST(trajectory, test_repeat_passes_and_forever)
+{
+    load_one("step:700:100");
+
+    zassert_equal(trajectory_start(0.0f, 2), 0, NULL);
+    float sp;
+    zassert_true(trajectory_tick(100, &sp), NULL);
+    zassert_true(trajectory_tick(100, &sp), NULL);
+    zassert_false(trajectory_tick(100, &sp), "two passes done");
+
+    zassert_equal(trajectory_start(0.0f, 0), 0, NULL);
+    for (int i = 0; i < 10; i++) {
+        zassert_true(trajectory_tick(100, &sp), NULL);
+    }
+
+    struct trajectory_status st;
+    zassert_equal(trajectory_get_status(&st), 0, NULL);
+    zassert_true(st.active, NULL);
+    zassert_equal(st.passes_left, 0U, "forever reports zero passes left");
+}
+
+static void trajectory_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    trajectory_test_reset();
+}
+
+ZTEST_SUITE(trajectory, NULL, NULL, trajectory_before, NULL, NULL);
@@ -0,0 +1,98 @@
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "motor_udp_proto.h"
+
+static uint8_t buf[MOTOR_UDP_MAX_LEN];
+
+ZTEST(udp_proto, test_max_datagram_fits_mtu)
+{
+    /* 1500-byte MTU minus 20 bytes IPv4 and 8 bytes UDP header. */
+    zassert_true(MOTOR_UDP_MAX_LEN <= 1472U, NULL);
+    zassert_equal(motor_udp_telemetry_len(MOTOR_UDP_MAX_SAMPLES), MOTOR_UDP_MAX_LEN, NULL);
+}
+
+ZTEST(udp_proto, test_telemetry_round_trip_is_little_endian)
+{
+    struct motor_udp_msg msg;
+    struct motor_udp_sample s = {
+        .seq = 0x01020304U,
+        .uptime_ms = 50U,
+        .state = {.setpoint_rpm = 1500.0f, .measured_rpm = -2.5f,
+                  .control_output_pct = 40.0f, .temperature_c = 25.0f},
+    };
+
+    motor_udp_put_header(buf, MOTOR_UDP_TELEMETRY, 7U, 2U);
+    motor_udp_put_sample(buf, 0U, &s);
+    s.seq++;
+    motor_udp_put_sample(buf, 1U, &s);
+
+    static const uint8_t header[] = {0x4d, 0x53, 1, 1, 7, 0, 0, 0, 2, 0, 0, 0};
+
+    zassert_mem_equal(buf, header, sizeof(header), NULL);
+    zassert_equal(buf[12], 0x04, "sample seq, low byte first");
+
+    zassert_equal(motor_udp_decode(buf, motor_udp_telemetry_len(2U), &msg), 0, NULL);
+    zassert_equal(msg.type, MOTOR_UDP_TELEMETRY, NULL);
+    zassert_equal(msg.seq, 7U, NULL);
+    zassert_equal(msg.count, 2U, NULL);
+
+    struct motor_udp_sample out;
+
+    motor_udp_get_sample(buf, 1U, &out);
+    zassert_equal(out.seq, 0x01020305U, NULL);
+    zassert_equal(out.uptime_ms, 50U, NULL);
+    zassert_mem_equal(&out.state, &s.state, sizeof(s.state), NULL);
+}
+
+ZTEST(udp_proto, test_setpoint_and_ack_round_trip)
+{
+    struct motor_udp_msg msg;
+    size_t len = motor_udp_encode_setpoint(buf, 3U, 42U, 2500.0f);
+
+    zassert_equal(len, MOTOR_UDP_HEADER_LEN + MOTOR_UDP_SETPOINT_LEN, NULL);
+    zassert_equal(motor_udp_decode(buf, len, &msg), 0, NULL);
+    zassert_equal(msg.type, MOTOR_UDP_SETPOINT, NULL);
+    zassert_equal(msg.seq, 3U, NULL);
+    zassert_equal(msg.cmd_id, 42U, NULL);
+    zassert_true(msg.rpm == 2500.0f, NULL);
+
+    len = motor_udp_encode_ack(buf, 4U, 42U, -ERANGE, 1234U);
+    zassert_equal(len, MOTOR_UDP_HEADER_LEN + MOTOR_UDP_ACK_LEN, NULL);
+    zassert_equal(motor_udp_decode(buf, len, &msg), 0, NULL);
+    zassert_equal(msg.type, MOTOR_UDP_ACK, NULL);
+    zassert_equal(msg.cmd_id, 42U, NULL);
+    zassert_equal(msg.status, -ERANGE, NULL);
+    zassert_equal(msg.uptime_ms, 1234U, NULL);
+}
+
+ZTEST(udp_proto, test_decode_rejects_malformed)
+{
+    struct motor_udp_msg msg;
+    size_t len = motor_udp_encode_setpoint(buf, 1U, 1U, 100.0f);
+
+    zassert_equal(motor_udp_decode(buf, MOTOR_UDP_HEADER_LEN - 1U, &msg), -EINVAL, "short");
+    zassert_equal(motor_udp_decode(buf, len + 1U, &msg), -EINVAL, "trailing bytes");
+
+    buf[0] ^= 0xffU;
+    zassert_equal(motor_udp_decode(buf, len, &msg), -EINVAL, "magic");
+    buf[0] ^= 0xffU;
+    buf[2] = 2U;
+    zassert_equal(motor_udp_decode(buf, len, &msg), -EINVAL, "version");
+    buf[2] = MOTOR_UDP_VERSION;
+    buf[3] = 9U;
+    zassert_equal(motor_udp_decode(buf, len, &msg), -EINVAL, "type");
+
+    /* A command carries exactly one record; telemetry at most a full batch. */
+    motor_udp_put_header(buf, MOTOR_UDP_SETPOINT, 1U, 2U);
+    zassert_equal(motor_udp_decode(buf, MOTOR_UDP_HEADER_LEN + (2U * MOTOR_UDP_SETPOINT_LEN),
+                                   &msg),
+                  -EINVAL, NULL);
+    motor_udp_put_header(buf, MOTOR_UDP_TELEMETRY, 1U, 0U);
+    zassert_equal(motor_udp_decode(buf, MOTOR_UDP_HEADER_LEN, &msg), -EINVAL, NULL);
+    motor_udp_put_header(buf, MOTOR_UDP_TELEMETRY, 1U, MOTOR_UDP_MAX_SAMPLES + 1U);
+    zassert_equal(motor_udp_decode(buf, MOTOR_UDP_MAX_LEN, &msg), -EINVAL, NULL);
+}
+
+ZTEST_SUITE(udp_proto, NULL, NULL, NULL, NULL, NULL);
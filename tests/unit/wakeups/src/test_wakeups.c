@@ -0,0 +1,51 @@
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "wakeups.h"
+
+ZTEST(wakeups, test_counts_per_thread_and_reset)
+{
+    struct wakeups_report rep;
+
+    wakeups_reset();
+    for (int i = 0; i < 3; i++) {
+        wakeups_count(WAKEUPS_CONTROL);
+    }
+    wakeups_count(WAKEUPS_FAULT);
+
+    k_msleep(100);
+    wakeups_get(&rep);
+    zassert_equal(rep.count[WAKEUPS_CONTROL], 3U, NULL);
+    zassert_equal(rep.count[WAKEUPS_FAULT], 1U, NULL);
+    zassert_equal(rep.count[WAKEUPS_TELEMETRY], 0U, NULL);
+    zassert_true(rep.window_ms >= 100U, "window %u ms", rep.window_ms);
+
+    /* A new window starts empty. */
+    wakeups_reset();
+    wakeups_get(&rep);
+    zassert_equal(rep.count[WAKEUPS_CONTROL], 0U, NULL);
+    zassert_true(rep.window_ms < 100U, "window %u ms", rep.window_ms);
+}
+
+ZTEST(wakeups, test_rate_in_hundredths_per_second)
+{
+    zassert_equal(wakeups_rate_centi(20U, 1000U), 2000U, "20 per s");
+    zassert_equal(wakeups_rate_centi(1U, 2000U), 50U, "0.5 per s");
+    zassert_equal(wakeups_rate_centi(1200U, 60000U), 2000U, NULL);
+    zassert_equal(wakeups_rate_centi(0U, 60000U), 0U, NULL);
+    zassert_equal(wakeups_rate_centi(5U, 0U), 0U, "empty window");
+
+    /* No overflow over a long window at a high rate. */
+    zassert_equal(wakeups_rate_centi(UINT32_MAX, UINT32_MAX), 100000U, "1000 per s");
+}
+
+ZTEST(wakeups, test_thread_names)
+{
+    zassert_equal(strcmp(wakeups_thread_name(WAKEUPS_CONTROL), "motor_ctrl"), 0, NULL);
+    zassert_equal(strcmp(wakeups_thread_name(WAKEUPS_FAULT), "fault_wq"), 0, NULL);
+    zassert_equal(strcmp(wakeups_thread_name(WAKEUPS_THREAD_COUNT), "?"), 0, NULL);
+}
+
+ZTEST_SUITE(wakeups, NULL, NULL, NULL, NULL, NULL);